@@ -0,0 +1,335 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    adc_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Accuracy and cost of the adc_filter chain of the SAADC sampler.
+ *
+ * Synthetic sample blocks, as the SAADC writes them in scan mode, are fed
+ * through adc_filter_block_process() for three channels:
+ * - battery: VDDHDIV5, a slow discharge.
+ * - sensor: an analog input, a slow sine.
+ * - ground: an input near 0 V, whose noise gives negative readings.
+ * Each reading gets a few LSB of noise.
+ *
+ * The published values are checked against the same chain computed in
+ * double precision, and their error against the noise-free signal is
+ * compared with the error of a single reading. The time per block is
+ * given for the fixed-point chain and for the double one.
+ *
+ * A reader thread takes snapshots with adc_filter_read() while blocks are
+ * published, with every channel fed the same readings: a snapshot whose
+ * channels differ was torn.
+ *
+ * Built for the POSIX host target only, see the adc_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "sdk_common.h"
+#include "adc_filter.h"
+#include "ep_host.h"
+
+#define BENCH_BLOCKS        200000
+#define BENCH_PASSES        5           // Fastest pass is reported
+#define CHECK_BLOCKS        4000
+#define SETTLE_BLOCKS       64          // Blocks before the error is measured
+#define SNAPSHOT_BLOCKS     2000000
+
+#define CHANNEL_CNT         3
+#define FRAMES              64          // ADC_SAMPLER_DECIMATION
+#define RESOLUTION          12
+#define NOISE_LSB           6           // Peak noise of a reading
+
+static const adc_filter_channel_t m_channels[CHANNEL_CNT] = {
+    {.full_scale_mv = 18000, .shift = 3},   // battery, VDDHDIV5 with gain 1/6
+    {.full_scale_mv = 3600,  .shift = 0},   // sensor, gain 1/6
+    {.full_scale_mv = 3600,  .shift = 2},   // ground
+};
+
+static char const * m_channel_names[CHANNEL_CNT] = {"battery", "sensor", "ground"};
+
+static int16_t   m_blocks[CHECK_BLOCKS][CHANNEL_CNT * FRAMES];
+static double    m_signal_mv[CHECK_BLOCKS][CHANNEL_CNT];    // Noise-free input, middle of the block
+static uint32_t  m_seed = 1;
+
+static int32_t noise(void)
+{
+    // Triangular, the sum of two uniform values
+    m_seed = m_seed * 1664525u + 1013904223u;
+    int32_t a = (int32_t)((m_seed >> 16) % (NOISE_LSB + 1));
+    m_seed = m_seed * 1664525u + 1013904223u;
+    int32_t b = (int32_t)((m_seed >> 16) % (NOISE_LSB + 1));
+    return a - b;
+}
+
+static double signal_mv(uint32_t channel, double t)
+{
+    switch (channel)
+    {
+        case 0:
+            return 4150.0 - 600.0 * t;
+        case 1:
+            return 1650.0 + 900.0 * sin(6.2832 * 3 * t);
+        default:
+            return 1.0;
+    }
+}
+
+/**
+ * @brief Blocks of readings of the signals, t going from 0 to 1 over all the blocks.
+ */
+static void blocks_generate(void)
+{
+    for (uint32_t block = 0; block < CHECK_BLOCKS; block++)
+    {
+        for (uint32_t frame = 0; frame < FRAMES; frame++)
+        {
+            double t = (block * FRAMES + frame) / (double)(CHECK_BLOCKS * FRAMES);
+
+            for (uint32_t channel = 0; channel < CHANNEL_CNT; channel++)
+            {
+                double  mv  = signal_mv(channel, t);
+                int32_t raw = (int32_t)lround(mv * (1 << RESOLUTION) / m_channels[channel].full_scale_mv) + noise();
+
+                m_blocks[block][frame * CHANNEL_CNT + channel] = (int16_t)MIN(raw, (1 << RESOLUTION) - 1);
+                if (frame == FRAMES / 2)
+                {
+                    m_signal_mv[block][channel] = mv;
+                }
+            }
+        }
+    }
+}
+
+/* The chain of adc_filter.c in double precision */
+typedef struct {
+    double state[CHANNEL_CNT];
+    bool   primed;
+} reference_t;
+
+static void reference_process(reference_t * p_ref, int16_t const * p_samples, double * p_mv)
+{
+    double sum[CHANNEL_CNT] = {0};
+
+    for (uint32_t frame = 0; frame < FRAMES; frame++)
+    {
+        for (uint32_t channel = 0; channel < CHANNEL_CNT; channel++)
+        {
+            sum[channel] += p_samples[frame * CHANNEL_CNT + channel];
+        }
+    }
+    for (uint32_t channel = 0; channel < CHANNEL_CNT; channel++)
+    {
+        double average = (sum[channel] > 0) ? sum[channel] / FRAMES : 0;
+
+        if (p_ref->primed)
+        {
+            p_ref->state[channel] += (average - p_ref->state[channel]) / (1 << m_channels[channel].shift);
+        }
+        else
+        {
+            p_ref->state[channel] = average;
+        }
+        p_mv[channel] = p_ref->state[channel] * m_channels[channel].full_scale_mv / (1 << RESOLUTION);
+    }
+    p_ref->primed = true;
+}
+
+static bool accuracy_check(void)
+{
+    adc_filter_t filter;
+    reference_t  ref      = {0};
+    double       max_diff = 0;
+    double       raw_sq[CHANNEL_CNT]      = {0};
+    double       filtered_sq[CHANNEL_CNT] = {0};
+    uint32_t     measured = 0;
+    bool         ok       = true;
+
+    adc_filter_init(&filter, m_channels, CHANNEL_CNT, RESOLUTION);
+    ok = !adc_filter_read(&filter, (int32_t[CHANNEL_CNT]){0});
+
+    for (uint32_t block = 0; block < CHECK_BLOCKS; block++)
+    {
+        int32_t mv[CHANNEL_CNT];
+        double  ref_mv[CHANNEL_CNT];
+
+        adc_filter_block_process(&filter, m_blocks[block], CHANNEL_CNT * FRAMES);
+        reference_process(&ref, m_blocks[block], ref_mv);
+        ok = ok && adc_filter_read(&filter, mv);
+
+        for (uint32_t channel = 0; channel < CHANNEL_CNT; channel++)
+        {
+            max_diff = MAX(max_diff, fabs(mv[channel] - ref_mv[channel]));
+            ok       = ok && (mv[channel] == adc_filter_value_get(&filter, channel)) && (mv[channel] >= 0);
+
+            if (block >= SETTLE_BLOCKS)
+            {
+                int16_t raw      = m_blocks[block][(FRAMES / 2) * CHANNEL_CNT + channel];
+                double  raw_mv   = raw * (double)m_channels[channel].full_scale_mv / (1 << RESOLUTION);
+                double  raw_err  = raw_mv - m_signal_mv[block][channel];
+                double  filt_err = mv[channel] - m_signal_mv[block][channel];
+
+                raw_sq[channel]      += raw_err * raw_err;
+                filtered_sq[channel] += filt_err * filt_err;
+            }
+        }
+        measured += (block >= SETTLE_BLOCKS) ? 1 : 0;
+    }
+
+    ok = ok && (max_diff <= 1.0);
+    printf("%-8s %12s %12s\n", "channel", "reading mV", "filtered mV");
+    for (uint32_t channel = 0; channel < CHANNEL_CNT; channel++)
+    {
+        printf("%-8s %12.2f %12.2f\n", m_channel_names[channel], sqrt(raw_sq[channel] / measured),
+               sqrt(filtered_sq[channel] / measured));
+    }
+    printf("rms error against the signal, fixed point within %.2f mV of double %s\n", max_diff,
+           ok ? "" : "FAIL");
+    return ok;
+}
+
+static void speed_run(void)
+{
+    adc_filter_t filter;
+    reference_t  ref;
+    double       best_fixed  = 0;
+    double       best_double = 0;
+    double       sink        = 0;
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint64_t start;
+        double time;
+        double mv[CHANNEL_CNT];
+
+        adc_filter_init(&filter, m_channels, CHANNEL_CNT, RESOLUTION);
+        start = ep_host_now_ns();
+        for (uint32_t i = 0; i < BENCH_BLOCKS; i++)
+        {
+            adc_filter_block_process(&filter, m_blocks[i % CHECK_BLOCKS], CHANNEL_CNT * FRAMES);
+        }
+        time       = (ep_host_now_ns() - start) * 1e-9;
+        best_fixed = ((pass == 0) || (time < best_fixed)) ? time : best_fixed;
+        sink      += adc_filter_value_get(&filter, 0);
+
+        memset(&ref, 0, sizeof(ref));
+        start = ep_host_now_ns();
+        for (uint32_t i = 0; i < BENCH_BLOCKS; i++)
+        {
+            reference_process(&ref, m_blocks[i % CHECK_BLOCKS], mv);
+        }
+        time        = (ep_host_now_ns() - start) * 1e-9;
+        best_double = ((pass == 0) || (time < best_double)) ? time : best_double;
+        sink       += mv[0];
+    }
+
+    printf("%-8s %12s %12s %12s\n", "chain", "ns/block", "ns/sample", "Msample/s");
+    printf("%-8s %12.1f %12.2f %12.1f\n", "fixed", best_fixed / BENCH_BLOCKS * 1e9,
+           best_fixed / BENCH_BLOCKS / (CHANNEL_CNT * FRAMES) * 1e9,
+           BENCH_BLOCKS * (double)(CHANNEL_CNT * FRAMES) / best_fixed / 1e6);
+    printf("%-8s %12.1f %12.2f %12.1f\n", "double", best_double / BENCH_BLOCKS * 1e9,
+           best_double / BENCH_BLOCKS / (CHANNEL_CNT * FRAMES) * 1e9,
+           BENCH_BLOCKS * (double)(CHANNEL_CNT * FRAMES) / best_double / 1e6);
+    if (sink == 0)
+    {
+        printf("\n");
+    }
+}
+
+/* Snapshot check: every channel gets the same readings and settings */
+static const adc_filter_channel_t m_same_channels[ADC_FILTER_MAX_CHANNELS] = {
+    {.full_scale_mv = 3600, .shift = 2}, {.full_scale_mv = 3600, .shift = 2},
+    {.full_scale_mv = 3600, .shift = 2}, {.full_scale_mv = 3600, .shift = 2},
+};
+
+static adc_filter_t      m_same_filter;
+static volatile bool     m_writing;
+static volatile uint32_t m_torn;
+static volatile uint32_t m_snapshots;
+
+static void * reader_thread(void * p_arg)
+{
+    (void)p_arg;
+    while (m_writing)
+    {
+        int32_t mv[ADC_FILTER_MAX_CHANNELS];
+
+        if (adc_filter_read(&m_same_filter, mv))
+        {
+            for (uint32_t channel = 1; channel < ADC_FILTER_MAX_CHANNELS; channel++)
+            {
+                if (mv[channel] != mv[0])
+                {
+                    m_torn++;
+                    break;
+                }
+            }
+            m_snapshots++;
+        }
+    }
+    return NULL;
+}
+
+static bool snapshot_check(void)
+{
+    static int16_t block[ADC_FILTER_MAX_CHANNELS * FRAMES];
+    pthread_t      reader;
+
+    adc_filter_init(&m_same_filter, m_same_channels, ADC_FILTER_MAX_CHANNELS, RESOLUTION);
+    m_writing = true;
+    pthread_create(&reader, NULL, reader_thread, NULL);
+
+    for (uint32_t i = 0; i < SNAPSHOT_BLOCKS; i++)
+    {
+        int16_t value = (int16_t)((i * 37u) % (1 << RESOLUTION));
+
+        for (uint32_t k = 0; k < ARRAY_SIZE(block); k++)
+        {
+            block[k] = value;
+        }
+        adc_filter_block_process(&m_same_filter, block, ARRAY_SIZE(block));
+    }
+    m_writing = false;
+    pthread_join(reader, NULL);
+
+    printf("snapshots: %u blocks published, %u read, %u torn %s\n", SNAPSHOT_BLOCKS,
+           (unsigned)m_snapshots, (unsigned)m_torn, m_torn ? "FAIL" : "");
+    return m_torn == 0;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+
+    printf("adc_filter, %d channels, %d frames per block, %d bit readings, noise +-%d LSB\n",
+           CHANNEL_CNT, FRAMES, RESOLUTION, NOISE_LSB);
+    blocks_generate();
+    failures += accuracy_check() ? 0 : 1;
+    speed_run();
+    failures += snapshot_check() ? 0 : 1;
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    crc32_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Differential test and throughput of the CRC32_CONFIG_IMPLEMENTATION variants.
+ *
+ * crc32.c is built once per implementation, with crc32_compute renamed after
+ * it, see the crc32_bench target of HOST/Makefile. The bitwise loop is the
+ * reference:
+ * - check value: crc32_compute of "123456789" is 0xCBF43926 for every one,
+ * - random test: random buffers of random length, 0 to TEST_MAX_SIZE bytes,
+ *   at each offset from an 8-byte boundary, computed in one call and chained
+ *   over a random split, must give the CRC of the bitwise loop.
+ * The report gives the throughput of each implementation on 4 KB blocks, as
+ * from flash pages, and the size of its tables.
+ *
+ * Built for the POSIX host target only, see the crc32_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "ep_host.h"
+
+#define TEST_BUFFERS    4000
+#define TEST_MAX_SIZE   1100
+#define BENCH_SIZE      (1024 * 1024)
+#define BENCH_PASSES    5           // Fastest pass is reported
+
+#define CRC32_CHECK     0xCBF43926u // CRC-32 of "123456789"
+
+uint32_t crc32_compute_bitwise(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
+uint32_t crc32_compute_nibble(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
+uint32_t crc32_compute_table(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
+uint32_t crc32_compute_slice4(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
+uint32_t crc32_compute_slice8(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
+
+typedef struct {
+    const char * name;
+    uint32_t     (* compute)(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
+    uint32_t     table_size;        // Bytes of constant tables
+} impl_t;
+
+static const impl_t m_impls[] = {
+    {"bitwise",    crc32_compute_bitwise, 0},
+    {"nibble",     crc32_compute_nibble,  16 * sizeof(uint32_t)},
+    {"table",      crc32_compute_table,   256 * sizeof(uint32_t)},
+    {"slice-by-4", crc32_compute_slice4,  4 * 256 * sizeof(uint32_t)},
+    {"slice-by-8", crc32_compute_slice8,  8 * 256 * sizeof(uint32_t)},
+};
+
+#define IMPL_COUNT      (sizeof(m_impls) / sizeof(m_impls[0]))
+
+static uint8_t  m_buffer[TEST_MAX_SIZE + 8];
+static uint8_t  m_image[BENCH_SIZE];
+static uint32_t m_failures;
+static uint32_t m_seed = 1;
+
+static uint32_t rand32(void)
+{
+    // xorshift32, the same sequence on every run
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return m_seed;
+}
+
+static void check_value_test(void)
+{
+    static const uint8_t check[] = "123456789";
+
+    for (size_t i = 0; i < IMPL_COUNT; i++)
+    {
+        uint32_t crc = m_impls[i].compute(check, 9, NULL);
+
+        if (crc != CRC32_CHECK)
+        {
+            printf("FAIL %s: check value %08x\n", m_impls[i].name, crc);
+            m_failures++;
+        }
+    }
+}
+
+static void random_test(void)
+{
+    for (uint32_t n = 0; n < TEST_BUFFERS; n++)
+    {
+        uint32_t size   = rand32() % (TEST_MAX_SIZE + 1);
+        uint32_t split  = (size > 0) ? rand32() % (size + 1) : 0;
+        uint32_t offset = n % 8;
+        uint8_t * p_data = &m_buffer[offset];
+        uint32_t expected;
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            p_data[i] = (uint8_t)rand32();
+        }
+        expected = crc32_compute_bitwise(p_data, size, NULL);
+
+        for (size_t i = 1; i < IMPL_COUNT; i++)
+        {
+            uint32_t crc     = m_impls[i].compute(p_data, size, NULL);
+            uint32_t chained = m_impls[i].compute(p_data, split, NULL);
+
+            chained = m_impls[i].compute(p_data + split, size - split, &chained);
+            if ((crc != expected) || (chained != expected))
+            {
+                printf("FAIL %s: %u bytes at offset %u, split at %u: %08x, chained %08x instead of %08x\n",
+                       m_impls[i].name, size, offset, split, crc, chained, expected);
+                m_failures++;
+            }
+        }
+    }
+}
+
+/**
+ * @return double Throughput in MB/s
+ */
+static double throughput(impl_t const * p_impl)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t sink = 0;
+
+    for (int pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint64_t start = ep_host_now_ns();
+        uint32_t crc   = 0;
+
+        for (size_t offset = 0; offset < BENCH_SIZE; offset += 4096)
+        {
+            crc = p_impl->compute(&m_image[offset], 4096, (offset == 0) ? NULL : &crc);
+        }
+        sink += crc;
+
+        uint64_t ns = ep_host_now_ns() - start;
+
+        if (ns < best)
+        {
+            best = ns;
+        }
+    }
+    (void)sink;
+
+    return (double)BENCH_SIZE / 1e6 / ((double)best / 1e9);
+}
+
+int main(void)
+{
+    check_value_test();
+    random_test();
+    printf("CRC-32 differential test, %d random buffers: %s\n", TEST_BUFFERS, m_failures ? "FAILED" : "passed");
+
+    for (size_t i = 0; i < sizeof(m_image); i++)
+    {
+        m_image[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    printf("%-12s %10s %10s %9s\n", "impl", "table B", "MB/s", "speedup");
+    double reference = throughput(&m_impls[0]);
+    for (size_t i = 0; i < IMPL_COUNT; i++)
+    {
+        double mbps = (i == 0) ? reference : throughput(&m_impls[i]);
+
+        printf("%-12s %10u %10.1f %9.1f\n", m_impls[i].name, m_impls[i].table_size, mbps, mbps / reference);
+    }
+    printf("%s\n\n", m_failures ? "FAILED" : "passed");
+
+    return m_failures ? 1 : 0;
+}
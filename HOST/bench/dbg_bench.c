@@ -0,0 +1,351 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    dbg_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Code size and caller latency of the DBGI macro.
+ *
+ * Built once per macro mode, see the dbg_bench target of HOST/Makefile:
+ * - immediate: tx_enqueue() of uart_helper formats the message in the caller.
+ * - deferred: DEBUG_UART_DEFERRED_LOG. The call site is described at compile
+ *   time and the caller only copies the arguments, the log task formats them.
+ *
+ * SITE() defines a function with one DBGI call, in the dbg_bench_sites
+ * section, and the message printf would make of it. The report gives the
+ * code size of the call sites and the constant data they add, and the time
+ * a call takes in the caller. Every message sent to the debug UART queue is
+ * checked against printf.
+ *
+ * The FreeRTOS calls of uart_helper_host.c and uart_deferred_log.c are
+ * stubbed: tasks are threads, the critical section is a mutex, and the
+ * debug UART TX queue keeps the last item sent. The log task runs between
+ * bursts of calls, as a task of the lowest priority would.
+ *
+ * Built for the POSIX host target only, see the dbg_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "uart_helper.h"
+#include "ep_host.h"
+
+#define BENCH_ROUNDS    20000
+#define BENCH_PASSES    5           // Fastest pass is reported
+
+#if DEBUG_UART_DEFERRED_LOG
+#define MODE_NAME       "deferred"
+#else
+#define MODE_NAME       "immediate"
+#endif
+
+/* Arguments of the call sites, global so that they are not folded into the calls */
+static const char * m_state_names[] = {"idle", "sampling", "sending"};
+static int          m_sensor        = 3;
+static uint32_t     m_reading       = 1234;
+static unsigned long m_reg_addr     = 0x40001000UL;
+static uint8_t      m_reg_val       = 0x5a;
+static double       m_temperature   = 21.375;
+static uint64_t     m_uptime_us     = 81234567890ULL;
+static uint8_t      m_buffer[16];
+
+typedef struct {
+    void (* call)(void);
+    void (* expect)(char * p_buf, size_t size);
+} site_t;
+
+#define SITE(name, ...)                                                                             \
+    static void __attribute__((noinline, section("dbg_bench_sites"))) name(void)                    \
+    {                                                                                               \
+        DBGI(__VA_ARGS__);                                                                          \
+    }                                                                                               \
+    static void CONCAT_2(name, _expect)(char * p_buf, size_t size)                                  \
+    {                                                                                               \
+        int n = snprintf(p_buf, size, "%s%s[%s:%d]: ", ANSI_COLOR_RST, "[INF]", #name, __LINE__);   \
+        n += snprintf(&p_buf[n], size - n, __VA_ARGS__);                                            \
+        snprintf(&p_buf[n], size - n, "%s\r\n", ANSI_COLOR_RST);                                    \
+    }
+
+SITE(site_plain, "boot complete")
+SITE(site_int, "sensor %d reads %u", m_sensor, (unsigned)m_reading)
+SITE(site_hex, "reg 0x%08lx = 0x%02x", m_reg_addr, m_reg_val)
+SITE(site_str, "state %s -> %s", m_state_names[1], m_state_names[2])
+SITE(site_float, "temperature %.2f C", m_temperature)
+SITE(site_u64, "uptime %llu us", (unsigned long long)m_uptime_us)
+SITE(site_mixed, "%s: %d/%d %5.1f%%", "battery", m_sensor, 100, m_temperature)
+SITE(site_ptr, "buffer at %p", (void *)m_buffer)
+
+#define SITE_ENTRY(name) { name, CONCAT_2(name, _expect) }
+
+static const site_t m_sites[] = {
+    SITE_ENTRY(site_plain),
+    SITE_ENTRY(site_int),
+    SITE_ENTRY(site_hex),
+    SITE_ENTRY(site_str),
+    SITE_ENTRY(site_float),
+    SITE_ENTRY(site_u64),
+    SITE_ENTRY(site_mixed),
+    SITE_ENTRY(site_ptr),
+};
+
+#define SITE_COUNT      ARRAY_SIZE(m_sites)
+
+extern const uint8_t __start_dbg_bench_sites[];
+extern const uint8_t __stop_dbg_bench_sites[];
+
+/* FreeRTOS stand-ins */
+static pthread_mutex_t m_critical = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t m_notify_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  m_notify_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t        m_notify_count;
+
+static uint8_t         m_queues[8];
+static uint32_t        m_queue_count;
+static QueueHandle_t   m_tx_queue;
+static char            m_tx_item[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+static volatile uint32_t m_tx_count;
+
+void vPortEnterCritical(void)
+{
+    pthread_mutex_lock(&m_critical);
+}
+
+void vPortExitCritical(void)
+{
+    pthread_mutex_unlock(&m_critical);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return 0;
+}
+
+QueueHandle_t xQueueGenericCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                  const uint8_t ucQueueType)
+{
+    QueueHandle_t queue = (QueueHandle_t)&m_queues[m_queue_count++];
+
+    (void)uxQueueLength;
+    (void)ucQueueType;
+    if (uxItemSize == DEBUG_UART_TX_QUEUE_ITEM_SIZE)
+    {
+        m_tx_queue = queue;
+    }
+    return queue;
+}
+
+QueueHandle_t xQueueCreateMutex(const uint8_t ucQueueType)
+{
+    return xQueueGenericCreate(1, 0, ucQueueType);
+}
+
+BaseType_t xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait)
+{
+    (void)xQueue;
+    (void)xTicksToWait;
+    return pdTRUE;
+}
+
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                             TickType_t xTicksToWait, const BaseType_t xCopyPosition)
+{
+    (void)xTicksToWait;
+    (void)xCopyPosition;
+    if (xQueue == m_tx_queue)
+    {
+        memcpy(m_tx_item, pvItemToQueue, DEBUG_UART_TX_QUEUE_ITEM_SIZE);
+        __atomic_add_fetch(&m_tx_count, 1, __ATOMIC_RELEASE);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait)
+{
+    // Items are taken in xQueueGenericSend, the TX task of uart_helper_host.c waits forever
+    (void)xQueue;
+    (void)pvBuffer;
+    (void)xTicksToWait;
+    pthread_mutex_lock(&m_notify_mutex);
+    for (;;)
+    {
+        pthread_cond_wait(&m_notify_cond, &m_notify_mutex);
+    }
+    return pdFALSE;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName,
+                       const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    static uint8_t handles[4];
+    static uint32_t count;
+    pthread_t thread;
+
+    (void)pcName;
+    (void)usStackDepth;
+    (void)uxPriority;
+    pthread_create(&thread, NULL, (void * (*)(void *))pxTaskCode, pvParameters);
+    pthread_detach(thread);
+    if (pxCreatedTask != NULL)
+    {
+        *pxCreatedTask = (TaskHandle_t)&handles[count++];
+    }
+    return pdPASS;
+}
+
+/*
+ * Only the log task of uart_deferred_log.c uses notifications. It has the lowest priority on the
+ * target, so a notification does not wake it: it runs once the caller waits in tx_wait().
+ */
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              uint32_t * pulPreviousNotificationValue)
+{
+    (void)xTaskToNotify;
+    (void)ulValue;
+    (void)eAction;
+    (void)pulPreviousNotificationValue;
+    pthread_mutex_lock(&m_notify_mutex);
+    m_notify_count++;
+    pthread_mutex_unlock(&m_notify_mutex);
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    uint32_t count;
+
+    (void)xClearCountOnExit;
+    (void)xTicksToWait;
+    pthread_mutex_lock(&m_notify_mutex);
+    while (m_notify_count == 0)
+    {
+        pthread_cond_wait(&m_notify_cond, &m_notify_mutex);
+    }
+    count          = m_notify_count;
+    m_notify_count = 0;
+    pthread_mutex_unlock(&m_notify_mutex);
+    return count;
+}
+
+/**
+ * @brief Waits until the debug UART queue got count items.
+ */
+static void tx_wait(uint32_t count)
+{
+    pthread_mutex_lock(&m_notify_mutex);
+    pthread_cond_broadcast(&m_notify_cond);
+    pthread_mutex_unlock(&m_notify_mutex);
+    while (__atomic_load_n(&m_tx_count, __ATOMIC_ACQUIRE) < count)
+    {
+        sched_yield();
+    }
+}
+
+static uint32_t sites_check(void)
+{
+    static char expected[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+    uint32_t    failures = 0;
+
+    for (uint32_t i = 0; i < SITE_COUNT; i++)
+    {
+        uint32_t count = m_tx_count;
+
+        m_sites[i].call();
+        tx_wait(count + 1);
+        m_sites[i].expect(expected, sizeof(expected));
+        if (strcmp(m_tx_item, expected) != 0)
+        {
+            printf("FAIL site %u: \"%s\" instead of \"%s\"\n", i, m_tx_item, expected);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/**
+ * @return double Mean time of a call in the caller, in seconds
+ */
+static double sites_time(void)
+{
+    double time = 0;
+
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+    {
+        uint32_t count = m_tx_count;
+        uint64_t start = ep_host_now_ns();
+
+        for (uint32_t i = 0; i < SITE_COUNT; i++)
+        {
+            m_sites[i].call();
+        }
+        time += (ep_host_now_ns() - start) * 1e-9;
+
+        // Deferred: the log task formats the records before the next round
+        tx_wait(count + SITE_COUNT);
+    }
+    return time / (BENCH_ROUNDS * SITE_COUNT);
+}
+
+int main(void)
+{
+    uint32_t failures;
+    size_t   code_size  = (size_t)(__stop_dbg_bench_sites - __start_dbg_bench_sites);
+    size_t   const_size = 0;
+    double   best       = 0;
+
+    init_uart(MAIN_LOOP);
+    uart_helper.dbgi             = true;
+    uart_helper.dbg_header_style = DEBUG_HEADER_COMPACT;
+#if DEBUG_UART_DEFERRED_LOG
+    deferred_log_init();
+    const_size = SITE_COUNT * sizeof(deferred_log_site_t);
+#endif
+
+    failures = sites_check();
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        double time = sites_time();
+        best = ((pass == 0) || (time < best)) ? time : best;
+    }
+#if DEBUG_UART_DEFERRED_LOG
+    if (deferred_log_dropped_get() != 0)
+    {
+        printf("FAIL %u records dropped\n", deferred_log_dropped_get());
+        failures++;
+    }
+#endif
+
+    printf("DBGI %s, %u call sites\n", MODE_NAME, (unsigned)SITE_COUNT);
+    printf("%-10s %9s %10s %9s\n", "mode", "code B", "const B", "ns/call");
+    printf("%-10s %9.1f %10.1f %9.1f\n", MODE_NAME, (double)code_size / SITE_COUNT,
+           (double)const_size / SITE_COUNT, best * 1e9);
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,413 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    dlog_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Deferred log records decoded by dlog_decode against the log task.
+ *
+ * Runs uart_deferred_log.c with the FreeRTOS stand-ins of dbg_bench.c. Each
+ * round first moves the ring offsets with records the log task formats, then
+ * holds the task and fills the ring with call sites of every argument type
+ * until a record is dropped, so the records wrap at a different place each
+ * round. The bench then writes its .bss as a RAM image and runs dlog_decode
+ * on its own ELF file, built without PIE so that the ELF addresses are the
+ * run-time ones. Once the task runs again, each line it formats, colors
+ * removed, must be the line dlog_decode printed for the same record. The
+ * report gives the bytes a record takes in the ring against the length of
+ * its formatted line.
+ *
+ * Built for the POSIX host target only, see the dlog_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "uart_helper.h"
+
+#define BENCH_ROUNDS    24
+#define ITEM_COUNT      128         // Lines kept from the debug UART queue, a ring holds fewer
+
+/* Arguments of the call sites */
+static const char * m_state_names[] = {"idle", "sampling", "sending"};
+static const char   m_long_name[]   = "a string argument longer than DEFERRED_LOG_MAX_STR_LEN, "
+                                      "stored truncated to its first characters";
+static uint8_t      m_buffer[16];
+
+static void site_plain(uint32_t i)
+{
+    (void)i;
+    DBGI("boot complete");
+}
+
+static void site_int(uint32_t i)
+{
+    DBGI("sensor %d reads %u, %hd", -(int)i, (unsigned)(i * 37), (short)-i);
+}
+
+static void site_hex(uint32_t i)
+{
+    DBGW("reg 0x%08lx = 0x%02x", 0x40001000UL + 4 * i, (unsigned)(i & 0xff));
+}
+
+static void site_str(uint32_t i)
+{
+    DBGI("state %s -> %-9s|", m_state_names[i % 3], m_state_names[(i + 1) % 3]);
+}
+
+static void site_long_str(uint32_t i)
+{
+    DBGE("%s (%u)", &m_long_name[i % 8], (unsigned)i);
+}
+
+static void site_float(uint32_t i)
+{
+    DBGI("temperature %.2f C, %e, %g", 21.375 + i, 1.5e-3 * i, (float)i / 8);
+}
+
+static void site_u64(uint32_t i)
+{
+    DBGI("uptime %llu us, %lld", 81234567890ULL * i, -(long long)i);
+}
+
+static void site_mixed(uint32_t i)
+{
+    DBGW("%s: %d/%d %5.1f%% '%c' %p", "battery", (int)i, 100, 100.0 / (i + 1), 'a' + (int)(i % 26),
+         (void *)&m_buffer[i % 16]);
+}
+
+static void site_filler(uint32_t i)
+{
+    DBGI("filler %u", (unsigned)i);
+}
+
+static void (* const m_sites[])(uint32_t) = {
+    site_plain, site_int, site_hex, site_str, site_long_str, site_float, site_u64, site_mixed,
+};
+
+#define SITE_COUNT      ARRAY_SIZE(m_sites)
+
+/* Provided by the GNU linker around .bss, where the ring and its offsets are */
+extern char __bss_start[];
+extern char _end[];
+
+/* FreeRTOS stand-ins, those of dbg_bench.c. While m_held is set the log task is not woken. */
+static pthread_mutex_t m_critical = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t m_notify_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  m_notify_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t        m_notify_count;
+static bool            m_held;
+
+static uint8_t         m_queues[8];
+static uint32_t        m_queue_count;
+static QueueHandle_t   m_tx_queue;
+static char            m_tx_items[ITEM_COUNT][DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+static volatile uint32_t m_tx_count;
+static TickType_t      m_tick;
+
+void vPortEnterCritical(void)
+{
+    pthread_mutex_lock(&m_critical);
+}
+
+void vPortExitCritical(void)
+{
+    pthread_mutex_unlock(&m_critical);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return m_tick++;
+}
+
+QueueHandle_t xQueueGenericCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                  const uint8_t ucQueueType)
+{
+    QueueHandle_t queue = (QueueHandle_t)&m_queues[m_queue_count++];
+
+    (void)uxQueueLength;
+    (void)ucQueueType;
+    if (uxItemSize == DEBUG_UART_TX_QUEUE_ITEM_SIZE)
+    {
+        m_tx_queue = queue;
+    }
+    return queue;
+}
+
+QueueHandle_t xQueueCreateMutex(const uint8_t ucQueueType)
+{
+    return xQueueGenericCreate(1, 0, ucQueueType);
+}
+
+BaseType_t xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait)
+{
+    (void)xQueue;
+    (void)xTicksToWait;
+    return pdTRUE;
+}
+
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                             TickType_t xTicksToWait, const BaseType_t xCopyPosition)
+{
+    (void)xTicksToWait;
+    (void)xCopyPosition;
+    if (xQueue == m_tx_queue)
+    {
+        memcpy(m_tx_items[m_tx_count % ITEM_COUNT], pvItemToQueue, DEBUG_UART_TX_QUEUE_ITEM_SIZE);
+        __atomic_add_fetch(&m_tx_count, 1, __ATOMIC_RELEASE);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait)
+{
+    // Items are taken in xQueueGenericSend, the TX task of uart_helper_host.c waits forever
+    (void)xQueue;
+    (void)pvBuffer;
+    (void)xTicksToWait;
+    pthread_mutex_lock(&m_notify_mutex);
+    for (;;)
+    {
+        pthread_cond_wait(&m_notify_cond, &m_notify_mutex);
+    }
+    return pdFALSE;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName,
+                       const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    static uint8_t handles[4];
+    static uint32_t count;
+    pthread_t thread;
+
+    (void)pcName;
+    (void)usStackDepth;
+    (void)uxPriority;
+    pthread_create(&thread, NULL, (void * (*)(void *))pxTaskCode, pvParameters);
+    pthread_detach(thread);
+    if (pxCreatedTask != NULL)
+    {
+        *pxCreatedTask = (TaskHandle_t)&handles[count++];
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              uint32_t * pulPreviousNotificationValue)
+{
+    (void)xTaskToNotify;
+    (void)ulValue;
+    (void)eAction;
+    (void)pulPreviousNotificationValue;
+    pthread_mutex_lock(&m_notify_mutex);
+    m_notify_count++;
+    pthread_cond_broadcast(&m_notify_cond);
+    pthread_mutex_unlock(&m_notify_mutex);
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    uint32_t count;
+
+    (void)xClearCountOnExit;
+    (void)xTicksToWait;
+    pthread_mutex_lock(&m_notify_mutex);
+    while ((m_notify_count == 0) || m_held)
+    {
+        pthread_cond_wait(&m_notify_cond, &m_notify_mutex);
+    }
+    count          = m_notify_count;
+    m_notify_count = 0;
+    pthread_mutex_unlock(&m_notify_mutex);
+    return count;
+}
+
+static void task_hold(bool held)
+{
+    pthread_mutex_lock(&m_notify_mutex);
+    m_held = held;
+    m_notify_count++;
+    pthread_cond_broadcast(&m_notify_cond);
+    pthread_mutex_unlock(&m_notify_mutex);
+}
+
+/**
+ * @brief Waits until the debug UART queue got count items.
+ */
+static void tx_wait(uint32_t count)
+{
+    while (__atomic_load_n(&m_tx_count, __ATOMIC_ACQUIRE) < count)
+    {
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Removes the ANSI color sequences and the line end of a formatted line, in place.
+ */
+static void line_strip(char * p_line)
+{
+    char * p_dst = p_line;
+
+    for (char * p_src = p_line; *p_src != '\0'; p_src++)
+    {
+        if (*p_src == '\x1b')
+        {
+            p_src += strcspn(p_src, "m");
+            if (*p_src == '\0')
+            {
+                break;
+            }
+            continue;
+        }
+        if ((*p_src != '\r') && (*p_src != '\n'))
+        {
+            *p_dst++ = *p_src;
+        }
+    }
+    *p_dst = '\0';
+}
+
+/**
+ * @brief Writes .bss as a RAM image and decodes it with dlog_decode.
+ *
+ * @return uint32_t Number of lines read from dlog_decode, up to ITEM_COUNT, stored in p_lines
+ */
+static uint32_t ring_decode(const char * p_decoder, const char * p_image, char (* p_lines)[DEBUG_UART_TX_QUEUE_ITEM_SIZE])
+{
+    static char command[512];
+    FILE *      p_file = fopen(p_image, "wb");
+    uint32_t    count  = 0;
+
+    if ((p_file == NULL) || (fwrite(__bss_start, 1, (size_t)(_end - __bss_start), p_file) != (size_t)(_end - __bss_start)))
+    {
+        perror(p_image);
+        exit(1);
+    }
+    fclose(p_file);
+
+    snprintf(command, sizeof(command), "%s /proc/%d/exe %s %p 2>/dev/null", p_decoder, (int)getpid(), p_image,
+             (void *)__bss_start);
+    p_file = popen(command, "r");
+    while ((p_file != NULL) && (count < ITEM_COUNT) &&
+           (fgets(p_lines[count], DEBUG_UART_TX_QUEUE_ITEM_SIZE, p_file) != NULL))
+    {
+        line_strip(p_lines[count++]);
+    }
+    if ((p_file == NULL) || (pclose(p_file) != 0))
+    {
+        printf("FAIL %s exited with an error\n", p_decoder);
+    }
+    return count;
+}
+
+int main(int argc, char * argv[])
+{
+    static char decoded[ITEM_COUNT][DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+    static char image[256];
+    uint32_t    failures  = 0;
+    uint32_t    records   = 0;
+    size_t      text_size = 0;
+    uint32_t    site      = 0;
+
+    if (argc != 2)
+    {
+        printf("usage: %s dlog_decode\n", argv[0]);
+        return 1;
+    }
+    snprintf(image, sizeof(image), "%s.ram", argv[0]);
+
+    init_uart(MAIN_LOOP);
+    uart_helper.dbgi             = true;
+    uart_helper.dbgw             = true;
+    uart_helper.dbge             = true;
+    uart_helper.dbg_header_style = DEBUG_HEADER_FULL;
+    deferred_log_init();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        uint32_t count   = m_tx_count;
+        uint32_t dropped = deferred_log_dropped_get();
+        uint32_t pushed  = 0;
+        uint32_t lines;
+
+        // Formatted at once, moves the ring offsets by a few records
+        for (uint32_t i = 0; i < round % 7; i++)
+        {
+            site_filler(i);
+        }
+        tx_wait(count + round % 7);
+
+        // Held task: full ring, the last record is dropped
+        task_hold(true);
+        while (deferred_log_dropped_get() == dropped)
+        {
+            m_sites[site % SITE_COUNT](site);
+            site++;
+            pushed++;
+        }
+        pushed--;
+
+        lines = ring_decode(argv[1], image, decoded);
+        if (lines != pushed)
+        {
+            printf("FAIL round %u: %u records decoded instead of %u\n", round, lines, pushed);
+            failures++;
+        }
+
+        count = m_tx_count;
+        task_hold(false);
+        tx_wait(count + pushed + 1);      // The dropped record warning follows the records
+
+        for (uint32_t i = 0; i < MIN(lines, pushed); i++)
+        {
+            char * p_line = m_tx_items[(count + i) % ITEM_COUNT];
+
+            line_strip(p_line);
+            if (strcmp(p_line, decoded[i]) != 0)
+            {
+                printf("FAIL round %u record %u: \"%s\" instead of \"%s\"\n", round, i, decoded[i], p_line);
+                failures++;
+            }
+            text_size += strlen(p_line);
+        }
+        records += pushed;
+    }
+    remove(image);
+
+    printf("Deferred log records decoded from a RAM image, %u rounds\n", BENCH_ROUNDS);
+    printf("%-10s %10s %14s %13s\n", "records", "ring B", "ring B/record", "text B/line");
+    printf("%-10u %10u %14.1f %13.1f\n", records, DEFERRED_LOG_RING_SIZE,
+           (double)(BENCH_ROUNDS * DEFERRED_LOG_RING_SIZE) / records, (double)text_size / records);
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
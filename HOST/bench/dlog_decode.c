@@ -0,0 +1,608 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    dlog_decode.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host decoder of the deferred log records left in a RAM image.
+ *
+ * Records pushed with DEBUG_UART_DEFERRED_LOG are formatted by the low
+ * priority log task, and a fault or a watchdog reset can come before it runs.
+ * This tool prints the records still in the ring of uart_deferred_log.c from
+ * a RAM image, e.g. "dump binary memory ram.bin 0x20000000 0x20040000" in gdb
+ * or "nrfjprog --readram ram.bin", and the ELF file of the firmware:
+ *
+ *     dlog_decode firmware.elf ram.bin [ram base, 0x20000000 by default]
+ *
+ * The ring, its read offset and fill level are found by their symbols in the
+ * ELF file, local to uart_deferred_log.c. A record only holds the address of
+ * its call site, the site and its format string are read from the ELF file.
+ * Records are printed oldest first, with the FULL debug header and the type
+ * tag of uart_deferred_log.c, without colors. Each conversion is printed by
+ * snprintf with its stored argument, as message_format() does, with the
+ * length modifier of the stored size: a "%lu" of a 32-bit target is read as
+ * 32 bits. The pointer size, 4 or 8 bytes, comes from the ELF class, so the
+ * host build decodes too, see the dlog_bench target of HOST/Makefile.
+ *
+ * Built for the POSIX host only, see the dlog_decode target of HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+
+#define RAM_BASE_DEFAULT    0x20000000UL
+#define LINE_SIZE           1024
+#define SPEC_SIZE           16
+
+#define ALIGN4(n)           (((n) + 3u) & ~3u)
+
+/* deferred_log_arg_type_enum of uart_deferred_log.h */
+enum {
+    ARG_U32     = 1,
+    ARG_U64     = 2,
+    ARG_DOUBLE  = 3,
+    ARG_PTR     = 4,
+    ARG_STR     = 5,
+};
+
+typedef struct {
+    const uint8_t * p_data;
+    size_t          size;
+} blob_t;
+
+/* ELF file of the firmware: allocated sections and the symbol table */
+typedef struct {
+    blob_t          file;
+    uint32_t        ptr_size;       // 4 for ELFCLASS32, 8 for ELFCLASS64
+    uint32_t        shnum;
+    uint64_t        shoff;
+    uint32_t        shentsize;
+} elf_t;
+
+typedef struct {
+    uint64_t        addr;
+    uint64_t        size;
+    uint64_t        offset;
+    uint32_t        type;
+    uint32_t        link;
+    uint64_t        flags;
+    uint64_t        entsize;
+} section_t;
+
+/* deferred_log_site_t, read from the ELF file */
+typedef struct {
+    const char *    format;
+    const char *    func;
+    uint16_t        line;
+    uint8_t         level;
+    uint8_t         nargs;
+    uint32_t        arg_types;
+} site_t;
+
+static const char * m_tags[] = {"[INF]", "[WRN]", "[ERR]"};
+
+static uint64_t le_get(const uint8_t * p_src, uint32_t size)
+{
+    uint64_t val = 0;
+
+    for (uint32_t i = size; i > 0; i--)
+    {
+        val = (val << 8) | p_src[i - 1];
+    }
+    return val;
+}
+
+static int file_load(const char * p_path, blob_t * p_blob)
+{
+    FILE *    p_file = fopen(p_path, "rb");
+    uint8_t * p_data;
+    long      size;
+
+    if (p_file == NULL)
+    {
+        perror(p_path);
+        return -1;
+    }
+    fseek(p_file, 0, SEEK_END);
+    size = ftell(p_file);
+    fseek(p_file, 0, SEEK_SET);
+    p_data = malloc((size > 0) ? (size_t)size : 1);
+    if ((size < 0) || (p_data == NULL) || (fread(p_data, 1, (size_t)size, p_file) != (size_t)size))
+    {
+        fprintf(stderr, "%s: read error\n", p_path);
+        fclose(p_file);
+        free(p_data);
+        return -1;
+    }
+    fclose(p_file);
+    p_blob->p_data = p_data;
+    p_blob->size   = (size_t)size;
+    return 0;
+}
+
+/**
+ * @brief Gets the bytes of the file at [offset, offset + size), NULL if out of the file.
+ */
+static const uint8_t * blob_at(blob_t const * p_blob, uint64_t offset, uint64_t size)
+{
+    if ((offset > p_blob->size) || (size > p_blob->size - offset))
+    {
+        return NULL;
+    }
+    return p_blob->p_data + offset;
+}
+
+static int elf_open(elf_t * p_elf)
+{
+    const uint8_t * p_ident = blob_at(&p_elf->file, 0, EI_NIDENT);
+
+    if ((p_ident == NULL) || (memcmp(p_ident, ELFMAG, SELFMAG) != 0) || (p_ident[EI_DATA] != ELFDATA2LSB))
+    {
+        fprintf(stderr, "not a little endian ELF file\n");
+        return -1;
+    }
+    if (blob_at(&p_elf->file, 0, (p_ident[EI_CLASS] == ELFCLASS32) ? sizeof(Elf32_Ehdr) : sizeof(Elf64_Ehdr)) == NULL)
+    {
+        fprintf(stderr, "ELF header out of the file\n");
+        return -1;
+    }
+    if (p_ident[EI_CLASS] == ELFCLASS32)
+    {
+        const uint8_t * p_ehdr = blob_at(&p_elf->file, 0, sizeof(Elf32_Ehdr));
+
+        p_elf->ptr_size  = 4;
+        p_elf->shoff     = le_get(p_ehdr + offsetof(Elf32_Ehdr, e_shoff), 4);
+        p_elf->shentsize = le_get(p_ehdr + offsetof(Elf32_Ehdr, e_shentsize), 2);
+        p_elf->shnum     = le_get(p_ehdr + offsetof(Elf32_Ehdr, e_shnum), 2);
+    }
+    else
+    {
+        const uint8_t * p_ehdr = blob_at(&p_elf->file, 0, sizeof(Elf64_Ehdr));
+
+        p_elf->ptr_size  = 8;
+        p_elf->shoff     = le_get(p_ehdr + offsetof(Elf64_Ehdr, e_shoff), 8);
+        p_elf->shentsize = le_get(p_ehdr + offsetof(Elf64_Ehdr, e_shentsize), 2);
+        p_elf->shnum     = le_get(p_ehdr + offsetof(Elf64_Ehdr, e_shnum), 2);
+    }
+    if ((p_elf->shentsize == 0) ||
+        (blob_at(&p_elf->file, p_elf->shoff, (uint64_t)p_elf->shnum * p_elf->shentsize) == NULL))
+    {
+        fprintf(stderr, "ELF section headers out of the file\n");
+        return -1;
+    }
+    return 0;
+}
+
+static void section_get(elf_t const * p_elf, uint32_t index, section_t * p_sec)
+{
+    const uint8_t * p_shdr = p_elf->file.p_data + p_elf->shoff + (uint64_t)index * p_elf->shentsize;
+
+    if (p_elf->ptr_size == 4)
+    {
+        p_sec->type    = le_get(p_shdr + offsetof(Elf32_Shdr, sh_type), 4);
+        p_sec->flags   = le_get(p_shdr + offsetof(Elf32_Shdr, sh_flags), 4);
+        p_sec->addr    = le_get(p_shdr + offsetof(Elf32_Shdr, sh_addr), 4);
+        p_sec->offset  = le_get(p_shdr + offsetof(Elf32_Shdr, sh_offset), 4);
+        p_sec->size    = le_get(p_shdr + offsetof(Elf32_Shdr, sh_size), 4);
+        p_sec->link    = le_get(p_shdr + offsetof(Elf32_Shdr, sh_link), 4);
+        p_sec->entsize = le_get(p_shdr + offsetof(Elf32_Shdr, sh_entsize), 4);
+    }
+    else
+    {
+        p_sec->type    = le_get(p_shdr + offsetof(Elf64_Shdr, sh_type), 4);
+        p_sec->flags   = le_get(p_shdr + offsetof(Elf64_Shdr, sh_flags), 8);
+        p_sec->addr    = le_get(p_shdr + offsetof(Elf64_Shdr, sh_addr), 8);
+        p_sec->offset  = le_get(p_shdr + offsetof(Elf64_Shdr, sh_offset), 8);
+        p_sec->size    = le_get(p_shdr + offsetof(Elf64_Shdr, sh_size), 8);
+        p_sec->link    = le_get(p_shdr + offsetof(Elf64_Shdr, sh_link), 4);
+        p_sec->entsize = le_get(p_shdr + offsetof(Elf64_Shdr, sh_entsize), 8);
+    }
+}
+
+/**
+ * @brief Gets the constant data at a target address, from the section holding it.
+ *
+ * @param p_avail   Set to the bytes available from addr to the end of the section
+ *
+ * @return const uint8_t* The data, NULL if no section of the file holds size bytes at addr
+ */
+static const uint8_t * elf_at(elf_t const * p_elf, uint64_t addr, uint64_t size, uint64_t * p_avail)
+{
+    for (uint32_t i = 1; i < p_elf->shnum; i++)
+    {
+        section_t sec;
+
+        section_get(p_elf, i, &sec);
+        if (!(sec.flags & SHF_ALLOC) || (sec.type == SHT_NOBITS) ||
+            (addr < sec.addr) || (addr - sec.addr >= sec.size) || (size > sec.size - (addr - sec.addr)))
+        {
+            continue;
+        }
+        if (p_avail != NULL)
+        {
+            *p_avail = sec.size - (addr - sec.addr);
+        }
+        return blob_at(&p_elf->file, sec.offset + (addr - sec.addr), size);
+    }
+    return NULL;
+}
+
+static const char * elf_str(elf_t const * p_elf, uint64_t addr)
+{
+    uint64_t     avail;
+    const char * p_str = (const char *)elf_at(p_elf, addr, 1, &avail);
+
+    return ((p_str != NULL) && (memchr(p_str, '\0', avail) != NULL)) ? p_str : NULL;
+}
+
+/**
+ * @brief Finds a symbol, preferring a local one of the given source file.
+ *
+ * @return int 0 if found, with its address and size
+ */
+static int elf_symbol(elf_t const * p_elf, const char * p_file, const char * p_name,
+                      uint64_t * p_addr, uint64_t * p_size)
+{
+    int found = -1;
+
+    for (uint32_t i = 1; i < p_elf->shnum; i++)
+    {
+        section_t       symtab;
+        section_t       strtab;
+        const uint8_t * p_syms;
+        const char *    p_in_file = "";
+
+        section_get(p_elf, i, &symtab);
+        if ((symtab.type != SHT_SYMTAB) || (symtab.entsize == 0) || (symtab.link >= p_elf->shnum))
+        {
+            continue;
+        }
+        section_get(p_elf, symtab.link, &strtab);
+        p_syms = blob_at(&p_elf->file, symtab.offset, symtab.size);
+        if ((p_syms == NULL) || (blob_at(&p_elf->file, strtab.offset, strtab.size) == NULL))
+        {
+            continue;
+        }
+
+        for (uint64_t n = 1; n < symtab.size / symtab.entsize; n++)
+        {
+            const uint8_t * p_sym = p_syms + n * symtab.entsize;
+            uint32_t        name;
+            uint8_t         info;
+            uint64_t        value;
+            uint64_t        size;
+            const char *    p_sym_name;
+
+            if (p_elf->ptr_size == 4)
+            {
+                name  = le_get(p_sym + offsetof(Elf32_Sym, st_name), 4);
+                info  = p_sym[offsetof(Elf32_Sym, st_info)];
+                value = le_get(p_sym + offsetof(Elf32_Sym, st_value), 4);
+                size  = le_get(p_sym + offsetof(Elf32_Sym, st_size), 4);
+            }
+            else
+            {
+                name  = le_get(p_sym + offsetof(Elf64_Sym, st_name), 4);
+                info  = p_sym[offsetof(Elf64_Sym, st_info)];
+                value = le_get(p_sym + offsetof(Elf64_Sym, st_value), 8);
+                size  = le_get(p_sym + offsetof(Elf64_Sym, st_size), 8);
+            }
+            if ((name >= strtab.size) || (memchr(p_elf->file.p_data + strtab.offset + name, '\0',
+                                                  strtab.size - name) == NULL))
+            {
+                continue;
+            }
+            p_sym_name = (const char *)p_elf->file.p_data + strtab.offset + name;
+
+            // Local symbols follow the STT_FILE symbol of their source file
+            if (ELF32_ST_TYPE(info) == STT_FILE)
+            {
+                const char * p_base = strrchr(p_sym_name, '/');
+                p_in_file = (p_base != NULL) ? p_base + 1 : p_sym_name;
+                continue;
+            }
+            if ((ELF32_ST_TYPE(info) != STT_OBJECT) || (strcmp(p_sym_name, p_name) != 0))
+            {
+                continue;
+            }
+            if ((found != 0) || (strcmp(p_in_file, p_file) == 0))
+            {
+                *p_addr = value;
+                *p_size = size;
+                found   = (strcmp(p_in_file, p_file) == 0) ? 0 : 1;
+            }
+        }
+    }
+    return (found >= 0) ? 0 : -1;
+}
+
+static const uint8_t * ram_at(blob_t const * p_ram, uint64_t base, uint64_t addr, uint64_t size)
+{
+    return (addr < base) ? NULL : blob_at(p_ram, addr - base, size);
+}
+
+/**
+ * @brief Reads the call site of a record from the ELF file.
+ */
+static int site_get(elf_t const * p_elf, uint64_t addr, site_t * p_site)
+{
+    uint32_t        ptr = p_elf->ptr_size;
+    const uint8_t * p_raw = elf_at(p_elf, addr, 2 * ptr + 8, NULL);
+
+    if (p_raw == NULL)
+    {
+        return -1;
+    }
+    p_site->format    = elf_str(p_elf, le_get(p_raw, ptr));
+    p_site->func      = elf_str(p_elf, le_get(p_raw + ptr, ptr));
+    p_site->line      = le_get(p_raw + 2 * ptr, 2);
+    p_site->level     = p_raw[2 * ptr + 2];
+    p_site->nargs     = p_raw[2 * ptr + 3];
+    p_site->arg_types = le_get(p_raw + 2 * ptr + 4, 4);
+    return ((p_site->format != NULL) && (p_site->func != NULL)) ? 0 : -1;
+}
+
+/**
+ * @brief Formats the message of a record like message_format() of uart_deferred_log.c. The
+ * length modifier of an integer conversion is replaced by the one of the stored size. An
+ * argument that does not fit its conversion, or runs past the record, is printed as "(?)".
+ *
+ * @return size_t Number of characters written to p_buf, NUL excluded
+ */
+static size_t message_format(char * p_buf, size_t size, site_t const * p_site, uint32_t ptr_size,
+                             const uint8_t * p_args, const uint8_t * p_end)
+{
+    const char * p_fmt = p_site->format;
+    uint32_t     arg   = 0;
+    size_t       n     = 0;
+
+    while ((*p_fmt != '\0') && (n + 1 < size))
+    {
+        char     spec[SPEC_SIZE + 2];
+        size_t   spec_len;
+        size_t   len = 0;
+        char     conv;
+        uint32_t type;
+        uint32_t arg_size;
+        int      ret = -1;
+
+        if (*p_fmt != '%')
+        {
+            p_buf[n++] = *p_fmt++;
+            continue;
+        }
+
+        spec_len = strspn(p_fmt + 1, "-+ #0123456789.hlLjzt") + 2;
+        conv     = p_fmt[spec_len - 1];
+        if ((conv == '\0') || (spec_len >= SPEC_SIZE) || (strchr("diouxXcfFeEgGaAsp%", conv) == NULL) ||
+            ((conv != '%') && (arg >= p_site->nargs)))
+        {
+            p_buf[n++] = *p_fmt++;
+            continue;
+        }
+        if (conv == '%')
+        {
+            p_buf[n++] = '%';
+            p_fmt += spec_len;
+            continue;
+        }
+
+        // Flags, width, precision and 'h' modifiers are kept, the other length modifiers dropped
+        for (size_t i = 0; i < spec_len - 1; i++)
+        {
+            if (strchr("lLjzt", p_fmt[i]) == NULL)
+            {
+                spec[len++] = p_fmt[i];
+            }
+        }
+        p_fmt += spec_len;
+
+        type = (p_site->arg_types >> (4 * (arg + 1))) & 0xF;
+        arg++;
+        switch (type)
+        {
+            case ARG_U64:
+            case ARG_DOUBLE:    arg_size = 8; break;
+            case ARG_PTR:       arg_size = ALIGN4(ptr_size); break;
+            case ARG_STR:       arg_size = 0; break;
+            default:            arg_size = 4; break;
+        }
+        if (((type == ARG_STR) && (memchr(p_args, '\0', (size_t)(p_end - p_args)) == NULL)) ||
+            (arg_size > (size_t)(p_end - p_args)))
+        {
+            // Corrupt record, nothing more to read
+            n += snprintf(&p_buf[n], size - n, "(?)");
+            break;
+        }
+        if (type == ARG_STR)
+        {
+            arg_size = ALIGN4(strlen((const char *)p_args) + 1);
+        }
+
+        if ((type == ARG_DOUBLE) && (strchr("fFeEgGaA", conv) != NULL))
+        {
+            double val;
+            memcpy(&val, p_args, sizeof(val));
+            spec[len++] = conv;
+            spec[len]   = '\0';
+            ret = snprintf(&p_buf[n], size - n, spec, val);
+        }
+        else if ((type == ARG_STR) && (conv == 's'))
+        {
+            spec[len++] = conv;
+            spec[len]   = '\0';
+            ret = snprintf(&p_buf[n], size - n, spec, (const char *)p_args);
+        }
+        else if ((type != ARG_DOUBLE) && (type != ARG_STR) && (strchr("diouxXcp", conv) != NULL))
+        {
+            uint64_t val = le_get(p_args, (type == ARG_PTR) ? ptr_size : arg_size);
+
+            if (conv == 'p')
+            {
+                spec[len++] = conv;
+                spec[len]   = '\0';
+                ret = snprintf(&p_buf[n], size - n, spec, (void *)(uintptr_t)val);
+            }
+            else if ((arg_size == 4) || (conv == 'c'))
+            {
+                spec[len++] = conv;
+                spec[len]   = '\0';
+                ret = snprintf(&p_buf[n], size - n, spec, (unsigned int)val);
+            }
+            else
+            {
+                spec[len++] = 'l';
+                spec[len++] = 'l';
+                spec[len++] = conv;
+                spec[len]   = '\0';
+                ret = snprintf(&p_buf[n], size - n, spec, (unsigned long long)val);
+            }
+        }
+        else
+        {
+            ret = snprintf(&p_buf[n], size - n, "(?)");
+        }
+        p_args += arg_size;
+
+        if (ret > 0)
+        {
+            n = (n + (size_t)ret < size - 1) ? n + (size_t)ret : size - 1;
+        }
+    }
+
+    p_buf[n] = '\0';
+    return n;
+}
+
+int main(int argc, char * argv[])
+{
+    static char     line[LINE_SIZE];
+    elf_t           elf = {0};
+    blob_t          ram;
+    uint64_t        base = RAM_BASE_DEFAULT;
+    uint64_t        ring_addr, ring_size, addr, size;
+    const uint8_t * p_ring;
+    const uint8_t * p_val;
+    uint32_t        rd_idx, used, dropped;
+    uint32_t        hdr_size;
+    uint32_t        records = 0;
+
+    if ((argc < 3) || (argc > 4))
+    {
+        fprintf(stderr, "usage: %s firmware.elf ram.bin [ram base address]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 4)
+    {
+        base = strtoull(argv[3], NULL, 0);
+    }
+    if ((file_load(argv[1], &elf.file) != 0) || (elf_open(&elf) != 0) || (file_load(argv[2], &ram) != 0))
+    {
+        return 1;
+    }
+
+    if (elf_symbol(&elf, "uart_deferred_log.c", "m_ring", &ring_addr, &ring_size) != 0)
+    {
+        fprintf(stderr, "m_ring not found, is DEBUG_UART_DEFERRED_LOG set?\n");
+        return 1;
+    }
+    p_ring = ram_at(&ram, base, ring_addr, ring_size);
+    if ((p_ring == NULL) || (ring_size == 0))
+    {
+        fprintf(stderr, "m_ring at 0x%llx is not in the RAM image\n", (unsigned long long)ring_addr);
+        return 1;
+    }
+
+    const char * names[]  = {"m_rd_idx", "m_used", "m_dropped"};
+    uint32_t   * p_vals[] = {&rd_idx, &used, &dropped};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if ((elf_symbol(&elf, "uart_deferred_log.c", names[i], &addr, &size) != 0) ||
+            ((p_val = ram_at(&ram, base, addr, sizeof(uint32_t))) == NULL))
+        {
+            fprintf(stderr, "%s not found\n", names[i]);
+            return 1;
+        }
+        *p_vals[i] = le_get(p_val, sizeof(uint32_t));
+    }
+
+    // deferred_log_hdr_t: len, reserved, timestamp, then the site pointer, aligned to its size
+    hdr_size = (elf.ptr_size == 4) ? 12 : 16;
+
+    if ((rd_idx >= ring_size) || (used > ring_size))
+    {
+        fprintf(stderr, "bad ring state, read offset %u, %u bytes used\n", rd_idx, used);
+        return 1;
+    }
+
+    while (used > 0)
+    {
+        const uint8_t * p_rec = p_ring + rd_idx;
+        uint32_t        len   = (ring_size - rd_idx >= 2) ? (uint32_t)le_get(p_rec, 2) : 0;
+        site_t          site;
+
+        if (len == 0)
+        {
+            // Unused tail of the ring, the record continues at offset 0
+            if (ring_size - rd_idx > used)
+            {
+                break;
+            }
+            used  -= ring_size - rd_idx;
+            rd_idx = 0;
+            continue;
+        }
+        if ((len < hdr_size) || (len > used) || (len > ring_size - rd_idx))
+        {
+            break;
+        }
+
+        uint32_t timestamp = le_get(p_rec + 4, 4);
+        uint64_t site_addr = le_get(p_rec + 8, elf.ptr_size);
+        if (site_get(&elf, site_addr, &site) == 0)
+        {
+            uint32_t level = (site.level < 2) ? site.level : 2;
+            size_t   n     = snprintf(line, sizeof(line), "%s[%s:%u @%lu]: ", m_tags[level], site.func,
+                                      (unsigned)site.line, (unsigned long)timestamp);
+
+            message_format(&line[n], sizeof(line) - n, &site, elf.ptr_size, p_rec + hdr_size, p_rec + len);
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "[???][site 0x%llx @%lu]: unknown call site",
+                     (unsigned long long)site_addr, (unsigned long)timestamp);
+        }
+        printf("%s\n", line);
+        records++;
+
+        rd_idx = (rd_idx + len) % ring_size;
+        used  -= len;
+    }
+
+    fprintf(stderr, "%u records, %u records dropped since startup\n", records, dropped);
+    if (used > 0)
+    {
+        fprintf(stderr, "corrupt record at offset %u, %u bytes not decoded\n", rd_idx, used);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,674 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    fds_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief fds_record_write_batch() under power loss, its flash operations, and
+ * searches with and without the record index.
+ *
+ * fds runs on the simulated flash of HOST/sim/nrf_fstorage_host.c, with the
+ * CRC checks on. Every boot is a forked process, so it starts with fresh fds
+ * state and only the flash survives from one boot to the next. Built once per
+ * search mode, see the fds_bench target of HOST/Makefile: scanning the pages,
+ * and FDS_INDEX_ENABLED.
+ *
+ * - power cuts: a boot writes a record, then CUT_RECORDS records, and powers
+ *   off after n flash operations. The next boot checks that the first record
+ *   is intact and counts the others. This is repeated for every n until the
+ *   writes complete. With fds_record_write_batch() every boot must find all
+ *   of the records or none; one fds_record_write() per record is shown for
+ *   comparison. After a complete batch, the next boot also deletes a record,
+ *   runs garbage collection and checks the rest again.
+ * - flash operations: nrf_fstorage writes and words programmed per record,
+ *   and the queue entries used, for BENCH_RECORDS records of several sizes.
+ * - searches: LOOKUP_FILES * LOOKUP_KEYS records are written, some updated
+ *   and some deleted, and garbage is collected. Every record is then looked
+ *   up, in this boot and after a reboot, and checked against what was
+ *   written. Reported in microseconds per fds_record_find() of one record,
+ *   per fds_record_find_in_file() of a whole file and per
+ *   fds_record_find_by_key() of every record with a key.
+ * - update: a record is updated one flash operation at a time. After each
+ *   one, fds_record_find() must find the old or the new copy.
+ *
+ * Built for the POSIX host target only, see the fds_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "sdk_common.h"
+#include "fds.h"
+#include "ep_host.h"
+
+#define FILE_ID         0x1000
+#define BASE_FILE_ID    0x2000
+#define CUT_RECORDS     8
+#define CUT_WORDS       7           // With FDS_BATCH_BUFFER_WORDS 64, a header spans two writes
+#define BENCH_RECORDS   8
+#define MAX_WORDS       32
+#define LOOKUP_FILE_ID  0x3000      // Files LOOKUP_FILE_ID + 1 to LOOKUP_FILE_ID + LOOKUP_FILES
+#define LOOKUP_FILES    16
+#define LOOKUP_KEYS     256
+#define LOOKUP_ROUNDS   4096
+
+#if FDS_INDEX_ENABLED
+#define MODE_NAME       "record index"
+#else
+#define MODE_NAME       "page scan"
+#endif
+
+/* Results of a check boot */
+enum {
+    FOUND_NONE,
+    FOUND_ALL,
+    FOUND_PARTIAL,
+    FOUND_ERROR,
+};
+
+static uint32_t     m_data[CUT_RECORDS][MAX_WORDS];
+static uint32_t     m_base_data[2] = { 0xB0B0B0B0, 0x5EED5EED };
+static fds_record_t m_records[CUT_RECORDS];
+static uint32_t     m_lookup_data[LOOKUP_KEYS][LOOKUP_FILES];
+static fds_record_t m_lookup_records[LOOKUP_FILES];
+static bool         m_initialized;
+static int          m_event_errors;
+
+static void fds_handler(fds_evt_t const * p_evt)
+{
+    if (p_evt->result != NRF_SUCCESS)
+    {
+        m_event_errors++;
+    }
+    if ((p_evt->id == FDS_EVT_INIT) && (p_evt->result == NRF_SUCCESS))
+    {
+        m_initialized = true;
+    }
+}
+
+static void records_init(uint16_t words)
+{
+    for (uint16_t i = 0; i < CUT_RECORDS; i++)
+    {
+        for (uint16_t w = 0; w < words; w++)
+        {
+            m_data[i][w] = 0xA5000000 | ((uint32_t)i << 16) | w;
+        }
+        m_records[i].file_id           = FILE_ID;
+        m_records[i].key               = i + 1;
+        m_records[i].data.p_data       = m_data[i];
+        m_records[i].data.length_words = words;
+    }
+}
+
+/* The flash operations complete within the fds calls, so fds is idle on return */
+static void boot(void)
+{
+    (void)fds_register(fds_handler);
+    if ((fds_init() != NRF_SUCCESS) || !m_initialized)
+    {
+        printf("FAIL fds_init\n");
+        exit(FOUND_ERROR);
+    }
+}
+
+static int run_boot(void (*p_boot)(int), int arg)
+{
+    int   status;
+    pid_t pid;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0)
+    {
+        p_boot(arg);
+        exit(0);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status))
+    {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+static bool record_matches(fds_record_desc_t * p_desc, uint32_t const * p_expected, uint16_t words)
+{
+    fds_flash_record_t record;
+    bool               match;
+
+    if (fds_record_open(p_desc, &record) != NRF_SUCCESS)
+    {
+        return false;
+    }
+    match = (record.p_header->length_words == words) &&
+            (memcmp(record.p_data, p_expected, words * sizeof(uint32_t)) == 0);
+    (void)fds_record_close(p_desc);
+
+    return match;
+}
+
+/* Checks the first record and counts the others, each must be found once with its data */
+static int records_check(uint16_t words)
+{
+    fds_record_desc_t desc;
+    fds_find_token_t  token = { 0 };
+    uint32_t          found = 0;
+    uint16_t          count = 0;
+
+    if ((fds_record_find(BASE_FILE_ID, 1, &desc, &token) != NRF_SUCCESS) ||
+        !record_matches(&desc, m_base_data, ARRAY_SIZE(m_base_data)))
+    {
+        printf("FAIL first record lost\n");
+        return FOUND_ERROR;
+    }
+
+    memset(&token, 0, sizeof(token));
+    while (fds_record_find_in_file(FILE_ID, &desc, &token) == NRF_SUCCESS)
+    {
+        fds_flash_record_t record;
+        uint16_t           key;
+
+        if (fds_record_open(&desc, &record) != NRF_SUCCESS)
+        {
+            printf("FAIL record does not open\n");
+            return FOUND_ERROR;
+        }
+        key = record.p_header->record_key;
+        (void)fds_record_close(&desc);
+
+        if ((key == 0) || (key > CUT_RECORDS) || (found & (1u << key)) ||
+            !record_matches(&desc, m_data[key - 1], words))
+        {
+            printf("FAIL record %u is wrong\n", key);
+            return FOUND_ERROR;
+        }
+        found |= 1u << key;
+        count++;
+    }
+
+    return (count == 0) ? FOUND_NONE : (count == CUT_RECORDS) ? FOUND_ALL : FOUND_PARTIAL;
+}
+
+/* Arg: cut << 1 | batch */
+static void write_boot(int arg)
+{
+    uint32_t const     cut  = (uint32_t)arg >> 1;
+    fds_record_t const base =
+    {
+        .file_id = BASE_FILE_ID,
+        .key     = 1,
+        .data    = { .p_data = m_base_data, .length_words = ARRAY_SIZE(m_base_data) },
+    };
+    ret_code_t ret = NRF_SUCCESS;
+
+    boot();
+    if (fds_record_write(NULL, &base) != NRF_SUCCESS)
+    {
+        exit(FOUND_ERROR);
+    }
+
+    ep_host_flash_power_cut(cut);
+    if (arg & 1)
+    {
+        ret = fds_record_write_batch(NULL, m_records, CUT_RECORDS);
+    }
+    else
+    {
+        for (uint16_t i = 0; (i < CUT_RECORDS) && (ret == NRF_SUCCESS); i++)
+        {
+            ret = fds_record_write(NULL, &m_records[i]);
+        }
+    }
+    ep_host_flash_power_cut(UINT32_MAX);
+
+    exit(((ret == NRF_SUCCESS) && (m_event_errors == 0)) ? 0 : FOUND_ERROR);
+}
+
+/* Arg: batch. Checks, then keeps using the file system and checks again. */
+static void check_boot(int arg)
+{
+    int                     found;
+    fds_record_desc_t       desc;
+    fds_find_token_t        token = { 0 };
+    fds_stat_t              stat;
+    static uint32_t const   extra = 0xE7E7E7E7;
+    fds_record_t const      extra_record =
+    {
+        .file_id = BASE_FILE_ID,
+        .key     = 2,
+        .data    = { .p_data = &extra, .length_words = 1 },
+    };
+
+    boot();
+    found = records_check(CUT_WORDS);
+
+    if ((found == FOUND_ALL) && (arg & 1))
+    {
+        // Delete one record of the batch, and move the rest out of it
+        if ((fds_record_find(FILE_ID, 1, &desc, &token) != NRF_SUCCESS) ||
+            (fds_record_delete(&desc) != NRF_SUCCESS))
+        {
+            exit(FOUND_ERROR);
+        }
+        memset(&token, 0, sizeof(token));
+        if (fds_record_find(FILE_ID, 1, &desc, &token) == NRF_SUCCESS)
+        {
+            printf("FAIL deleted record of the batch still found\n");
+            exit(FOUND_ERROR);
+        }
+    }
+
+    if ((fds_record_write(NULL, &extra_record) != NRF_SUCCESS) || (fds_gc() != NRF_SUCCESS) ||
+        (m_event_errors != 0) || (fds_stat(&stat) != NRF_SUCCESS))
+    {
+        printf("FAIL write or garbage collection after reboot\n");
+        exit(FOUND_ERROR);
+    }
+    if ((stat.dirty_records != 0) || (stat.freeable_words != 0) || stat.corruption)
+    {
+        printf("FAIL %u dirty records, %u freeable words after garbage collection\n",
+               stat.dirty_records, stat.freeable_words);
+        exit(FOUND_ERROR);
+    }
+
+    if ((found == FOUND_ALL) && (arg & 1))
+    {
+        // Record 1 is gone; put the same data back under its key to count all again
+        fds_record_t const again = m_records[0];
+
+        if (fds_record_write(NULL, &again) != NRF_SUCCESS)
+        {
+            exit(FOUND_ERROR);
+        }
+    }
+    if (records_check(CUT_WORDS) != found)
+    {
+        printf("FAIL records changed after garbage collection\n");
+        exit(FOUND_ERROR);
+    }
+
+    exit(found);
+}
+
+static int cut_test(int batch)
+{
+    uint32_t counts[FOUND_ERROR + 1] = { 0 };
+    uint32_t cuts = 0;
+
+    for (uint32_t cut = 0; ; cut++)
+    {
+        int written;
+        int found;
+
+        ep_host_flash_erase_all();
+        written = run_boot(write_boot, (int)(cut << 1) | batch);
+        found   = run_boot(check_boot, batch);
+
+        if ((written != 0) && (written != EP_HOST_FLASH_POWER_CUT))
+        {
+            found = FOUND_ERROR;
+        }
+        if ((found < 0) || (found > FOUND_ERROR) || ((written == 0) && (found != FOUND_ALL)))
+        {
+            found = FOUND_ERROR;
+        }
+        counts[found]++;
+        if (written != EP_HOST_FLASH_POWER_CUT)
+        {
+            break;
+        }
+        cuts++;
+    }
+
+    printf("%-22s %5u cuts: %5u none, %5u all, %5u partial, %5u errors\n",
+           batch ? "fds_record_write_batch" : "fds_record_write", cuts,
+           counts[FOUND_NONE], counts[FOUND_ALL], counts[FOUND_PARTIAL], counts[FOUND_ERROR]);
+
+    return (counts[FOUND_ERROR] != 0) || (batch && (counts[FOUND_PARTIAL] != 0));
+}
+
+/* Arg: record length in words */
+static void ops_boot(int words)
+{
+    ep_host_flash_stats_t before;
+    ep_host_flash_stats_t single;
+    ep_host_flash_stats_t batch;
+
+    records_init((uint16_t)words);
+    boot();
+
+    before = ep_host_flash_stats_get();
+    for (uint16_t i = 0; i < BENCH_RECORDS; i++)
+    {
+        (void)fds_record_write(NULL, &m_records[i]);
+    }
+    single = ep_host_flash_stats_get();
+    (void)fds_record_write_batch(NULL, m_records, BENCH_RECORDS);
+    batch = ep_host_flash_stats_get();
+
+    printf("%6d | %9.2f %9.2f %7d | %9.2f %9.2f %7d\n", words,
+           (double)(single.writes - before.writes) / BENCH_RECORDS,
+           (double)(single.words_written - before.words_written) / BENCH_RECORDS,
+           BENCH_RECORDS,
+           (double)(batch.writes - single.writes) / BENCH_RECORDS,
+           (double)(batch.words_written - single.words_written) / BENCH_RECORDS, 1);
+
+    exit(((m_event_errors == 0) && (batch.overwrites == 0)) ? 0 : 1);
+}
+
+/* Version of a record of the search test: 0 deleted, 1 as written, 2 updated */
+static uint32_t lookup_version(uint16_t file, uint16_t key)
+{
+    uint32_t const i = (uint32_t)key * LOOKUP_FILES + file;
+
+    return ((i % 7) == 3) ? 0 : ((i % 5) == 1) ? 2 : 1;
+}
+
+static uint32_t lookup_value(uint16_t file, uint16_t key, uint32_t version)
+{
+    return ((uint32_t)file << 24) | ((uint32_t)key << 8) | version;
+}
+
+/* Every record is found once, with its data, and the files and keys hold the right counts */
+static bool lookup_check(void)
+{
+    uint16_t file_counts[LOOKUP_FILES] = { 0 };
+
+    for (uint16_t key = 0; key < LOOKUP_KEYS; key++)
+    {
+        uint16_t key_count = 0;
+        fds_record_desc_t desc;
+        fds_find_token_t  token = { 0 };
+
+        for (uint16_t file = 0; file < LOOKUP_FILES; file++)
+        {
+            uint32_t const version  = lookup_version(file, key);
+            uint32_t const expected = lookup_value(file, key, version);
+
+            memset(&token, 0, sizeof(token));
+            if (fds_record_find(LOOKUP_FILE_ID + 1 + file, key + 1, &desc, &token) != NRF_SUCCESS)
+            {
+                if (version != 0)
+                {
+                    printf("FAIL record %u/%u not found\n", file, key);
+                    return false;
+                }
+                continue;
+            }
+            if ((version == 0) || !record_matches(&desc, &expected, 1) ||
+                (fds_record_find(LOOKUP_FILE_ID + 1 + file, key + 1, &desc, &token) == NRF_SUCCESS))
+            {
+                printf("FAIL record %u/%u is wrong or found twice\n", file, key);
+                return false;
+            }
+            file_counts[file]++;
+            key_count++;
+        }
+
+        memset(&token, 0, sizeof(token));
+        while (fds_record_find_by_key(key + 1, &desc, &token) == NRF_SUCCESS)
+        {
+            key_count--;
+        }
+        if (key_count != 0)
+        {
+            printf("FAIL fds_record_find_by_key of key %u\n", key);
+            return false;
+        }
+    }
+
+    for (uint16_t file = 0; file < LOOKUP_FILES; file++)
+    {
+        fds_record_desc_t desc;
+        fds_find_token_t  token = { 0 };
+
+        while (fds_record_find_in_file(LOOKUP_FILE_ID + 1 + file, &desc, &token) == NRF_SUCCESS)
+        {
+            file_counts[file]--;
+        }
+        if (file_counts[file] != 0)
+        {
+            printf("FAIL fds_record_find_in_file of file %u\n", file);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void lookup_write_boot(int arg)
+{
+    fds_stat_t stat;
+
+    (void)arg;
+    boot();
+
+    // A batch per key, a record per file
+    for (uint16_t key = 0; key < LOOKUP_KEYS; key++)
+    {
+        for (uint16_t file = 0; file < LOOKUP_FILES; file++)
+        {
+            m_lookup_data[key][file] = lookup_value(file, key, 1);
+            m_lookup_records[file].file_id           = LOOKUP_FILE_ID + 1 + file;
+            m_lookup_records[file].key               = key + 1;
+            m_lookup_records[file].data.p_data       = &m_lookup_data[key][file];
+            m_lookup_records[file].data.length_words = 1;
+        }
+        if (fds_record_write_batch(NULL, m_lookup_records, LOOKUP_FILES) != NRF_SUCCESS)
+        {
+            printf("FAIL fds_record_write_batch of key %u\n", key);
+            exit(1);
+        }
+    }
+
+    for (uint16_t key = 0; key < LOOKUP_KEYS; key++)
+    {
+        for (uint16_t file = 0; file < LOOKUP_FILES; file++)
+        {
+            uint32_t const    version = lookup_version(file, key);
+            fds_record_desc_t desc;
+            fds_find_token_t  token   = { 0 };
+            ret_code_t        ret     = NRF_SUCCESS;
+
+            if (version == 1)
+            {
+                continue;
+            }
+            if (fds_record_find(LOOKUP_FILE_ID + 1 + file, key + 1, &desc, &token) != NRF_SUCCESS)
+            {
+                printf("FAIL record %u/%u not found\n", file, key);
+                exit(1);
+            }
+            if (version == 0)
+            {
+                ret = fds_record_delete(&desc);
+            }
+            else
+            {
+                m_lookup_data[key][file] = lookup_value(file, key, version);
+                m_lookup_records[0]      = (fds_record_t)
+                {
+                    .file_id = LOOKUP_FILE_ID + 1 + file,
+                    .key     = key + 1,
+                    .data    = { .p_data = &m_lookup_data[key][file], .length_words = 1 },
+                };
+                ret = fds_record_update(&desc, &m_lookup_records[0]);
+            }
+            if (ret != NRF_SUCCESS)
+            {
+                printf("FAIL update or delete of record %u/%u\n", file, key);
+                exit(1);
+            }
+        }
+    }
+
+    if ((fds_gc() != NRF_SUCCESS) || (fds_stat(&stat) != NRF_SUCCESS) ||
+        (stat.dirty_records != 0) || (m_event_errors != 0) || !lookup_check())
+    {
+        printf("FAIL records after updates, deletions and garbage collection\n");
+        exit(1);
+    }
+
+    exit(0);
+}
+
+static void lookup_boot(int arg)
+{
+    uint64_t          start;
+    double            find_us;
+    double            file_us;
+    double            key_us;
+    uint32_t          found = 0;
+    fds_record_desc_t desc;
+
+    (void)arg;
+    boot();
+    if (!lookup_check())
+    {
+        exit(1);
+    }
+
+    start = ep_host_now_ns();
+    for (uint32_t i = 0; i < LOOKUP_ROUNDS; i++)
+    {
+        fds_find_token_t token = { 0 };
+        uint16_t const   file  = (uint16_t)((i * 7) % LOOKUP_FILES);
+        uint16_t const   key   = (uint16_t)((i * 2654435761u >> 16) % LOOKUP_KEYS);
+
+        found += (fds_record_find(LOOKUP_FILE_ID + 1 + file, key + 1, &desc, &token) == NRF_SUCCESS);
+    }
+    find_us = (double)(ep_host_now_ns() - start) / 1e3 / LOOKUP_ROUNDS;
+
+    start = ep_host_now_ns();
+    for (uint16_t file = 0; file < LOOKUP_FILES; file++)
+    {
+        fds_find_token_t token = { 0 };
+
+        while (fds_record_find_in_file(LOOKUP_FILE_ID + 1 + file, &desc, &token) == NRF_SUCCESS)
+        {
+            found++;
+        }
+    }
+    file_us = (double)(ep_host_now_ns() - start) / 1e3 / LOOKUP_FILES;
+
+    start = ep_host_now_ns();
+    for (uint16_t key = 0; key < LOOKUP_KEYS; key += LOOKUP_KEYS / 16)
+    {
+        fds_find_token_t token = { 0 };
+
+        while (fds_record_find_by_key(key + 1, &desc, &token) == NRF_SUCCESS)
+        {
+            found++;
+        }
+    }
+    key_us = (double)(ep_host_now_ns() - start) / 1e3 / 16;
+
+    printf("%-14s %10.2f us per record, %u records\n", "find", find_us,
+           LOOKUP_FILES * LOOKUP_KEYS);
+    printf("%-14s %10.2f us per file of %u keys\n", "find in file", file_us, LOOKUP_KEYS);
+    printf("%-14s %10.2f us per key in %u files\n", "find by key", key_us, LOOKUP_FILES);
+
+    exit((found > 0) ? 0 : 1);
+}
+
+static void update_boot(int arg)
+{
+    static uint32_t   data[2] = { 0x01D01D01, 0x0E70E70E };
+    fds_record_t      record  = {
+        .file_id = FILE_ID,
+        .key     = 1,
+        .data    = { .p_data = &data[0], .length_words = 1 },
+    };
+    fds_record_desc_t desc;
+    uint32_t          ops    = 0;
+    uint32_t          missed = 0;
+
+    (void)arg;
+    boot();
+    if (fds_record_write(&desc, &record) != NRF_SUCCESS)
+    {
+        printf("FAIL fds_record_write\n");
+        exit(1);
+    }
+
+    record.data.p_data = &data[1];
+    ep_host_flash_async(true);
+    if (fds_record_update(&desc, &record) != NRF_SUCCESS)
+    {
+        printf("FAIL fds_record_update\n");
+        exit(1);
+    }
+    do
+    {
+        fds_find_token_t  token = { 0 };
+        fds_record_desc_t found;
+
+        missed += (fds_record_find(FILE_ID, 1, &found, &token) != NRF_SUCCESS);
+    } while (ep_host_flash_process() && ++ops);
+    ep_host_flash_async(false);
+
+    if (!record_matches(&desc, &data[1], 1))
+    {
+        printf("FAIL updated record\n");
+        exit(1);
+    }
+    printf("%-14s %10u flash operations, record not found after %u\n", "update", ops, missed);
+
+    exit(((missed == 0) && (m_event_errors == 0)) ? 0 : 1);
+}
+
+int main(void)
+{
+    static int const sizes[] = { 1, 4, 16, 32 };
+    int              failures = 0;
+
+    ep_host_flash_map();
+
+    printf("fds, searches by %s\n", MODE_NAME);
+    printf("power cuts during %d records of %d words, then reboot\n", CUT_RECORDS, CUT_WORDS);
+    records_init(CUT_WORDS);
+    (void)cut_test(0);
+    failures += cut_test(1);
+
+    printf("\nflash writes and words programmed per record, and queue entries, for %d records\n",
+           BENCH_RECORDS);
+    printf("%6s | %27s | %27s\n", "", "fds_record_write", "fds_record_write_batch");
+    printf("%6s | %9s %9s %7s | %9s %9s %7s\n", "words", "writes", "words", "queue",
+           "writes", "words", "queue");
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        ep_host_flash_erase_all();
+        failures += (run_boot(ops_boot, sizes[i]) != 0);
+    }
+
+    printf("\nsearches of records written, updated and deleted, after reboot\n");
+    ep_host_flash_erase_all();
+    failures += (run_boot(lookup_write_boot, 0) != 0);
+    failures += (run_boot(lookup_boot, 0) != 0);
+    ep_host_flash_erase_all();
+    failures += (run_boot(update_boot, 0) != 0);
+
+    printf("\n%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,362 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    fds_gc_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Latency of fds record updates while garbage is collected.
+ *
+ * fds runs on the simulated flash of HOST/sim/nrf_fstorage_host.c, in its
+ * asynchronous mode: every flash operation takes the time of the NVMC, and
+ * virtual time is the time the flash was busy plus the time fds was idle.
+ * STATIC_RECORDS records that never change are written, interleaved with
+ * CONFIG_RECORDS records that are then updated in turn, one every PERIOD_US,
+ * UPDATES times, queued as they are due while the queue has room. The latency
+ * of an update runs from the time it is due to FDS_EVT_UPDATE. Built once per mode, see the fds_gc_bench target of
+ * HOST/Makefile:
+ *
+ * - blocking: fds_gc() is called when GC_WORDS words can be freed, and runs
+ *   to completion before the updates queued behind it.
+ * - incremental: FDS_GC_AUTO_WORDS starts garbage collection at the same
+ *   point, and FDS_GC_INCREMENTAL lets the updates run in between its steps.
+ *
+ * A reboot then checks that every record is found once, with its last data.
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "sdk_common.h"
+#include "fds.h"
+#include "ep_host.h"
+
+#define STATIC_FILE_ID  0x1000
+#define CONFIG_FILE_ID  0x2000
+#define STATIC_RECORDS  64
+#define STATIC_WORDS    40
+#define CONFIG_RECORDS  32
+#define CONFIG_WORDS    16
+#define UPDATES         4000
+#define PERIOD_US       20000
+#define GC_WORDS        2048
+
+#if FDS_GC_INCREMENTAL
+#define MODE_NAME       "incremental"
+STATIC_ASSERT(FDS_GC_AUTO_WORDS == GC_WORDS);
+#else
+#define MODE_NAME       "blocking"
+#endif
+
+static uint32_t          m_static_data[STATIC_RECORDS][STATIC_WORDS];
+static uint32_t          m_config_data[CONFIG_RECORDS][CONFIG_WORDS];
+static fds_record_desc_t m_config_desc[CONFIG_RECORDS];
+static uint32_t          m_latency_us[UPDATES];
+static uint64_t          m_idle_us;
+static uint64_t          m_start_us;
+static uint32_t          m_updates_done;
+static uint32_t          m_gc_runs;
+static bool              m_gc_running;
+static bool              m_initialized;
+static int               m_event_errors;
+
+static uint64_t now_us(void)
+{
+    return ep_host_flash_stats_get().busy_us + m_idle_us;
+}
+
+static uint64_t due_us(uint32_t update)
+{
+    return m_start_us + (uint64_t)update * PERIOD_US;
+}
+
+static void fds_handler(fds_evt_t const * p_evt)
+{
+    if (p_evt->result != NRF_SUCCESS)
+    {
+        m_event_errors++;
+    }
+    switch (p_evt->id)
+    {
+        case FDS_EVT_INIT:
+            m_initialized = (p_evt->result == NRF_SUCCESS);
+            break;
+
+        // Updates complete in the order they are queued
+        case FDS_EVT_UPDATE:
+            m_latency_us[m_updates_done] = (uint32_t)(now_us() - due_us(m_updates_done));
+            m_updates_done++;
+            break;
+
+        case FDS_EVT_GC:
+            m_gc_runs++;
+            m_gc_running = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void config_value(uint16_t i, uint32_t version)
+{
+    for (uint16_t w = 0; w < CONFIG_WORDS; w++)
+    {
+        m_config_data[i][w] = ((uint32_t)i << 24) | (version << 8) | w;
+    }
+}
+
+static void boot(void)
+{
+    (void)fds_register(fds_handler);
+    if ((fds_init() != NRF_SUCCESS) || !m_initialized)
+    {
+        printf("FAIL fds_init\n");
+        exit(1);
+    }
+}
+
+static int run_boot(void (*p_boot)(void))
+{
+    int   status;
+    pid_t pid;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0)
+    {
+        p_boot();
+        exit(0);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status))
+    {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+static int latency_cmp(void const * p_a, void const * p_b)
+{
+    uint32_t const a = *(uint32_t const *)p_a;
+    uint32_t const b = *(uint32_t const *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+/* Writes the records with the flash synchronous, then updates them with it asynchronous */
+static void churn_boot(void)
+{
+    fds_record_t          record = { 0 };
+    uint64_t              sum_us = 0;
+    uint32_t              issued = 0;
+    ep_host_flash_stats_t before;
+
+    boot();
+    for (uint16_t i = 0; i < STATIC_RECORDS; i++)
+    {
+        for (uint16_t w = 0; w < STATIC_WORDS; w++)
+        {
+            m_static_data[i][w] = 0x5A000000 | ((uint32_t)i << 8) | w;
+        }
+        record.file_id           = STATIC_FILE_ID;
+        record.key               = i + 1;
+        record.data.p_data       = m_static_data[i];
+        record.data.length_words = STATIC_WORDS;
+        if (fds_record_write(NULL, &record) != NRF_SUCCESS)
+        {
+            exit(1);
+        }
+        if ((i % (STATIC_RECORDS / CONFIG_RECORDS)) == 0)
+        {
+            uint16_t const c = i / (STATIC_RECORDS / CONFIG_RECORDS);
+
+            config_value(c, 0);
+            record.file_id           = CONFIG_FILE_ID;
+            record.key               = c + 1;
+            record.data.p_data       = m_config_data[c];
+            record.data.length_words = CONFIG_WORDS;
+            if (fds_record_write(&m_config_desc[c], &record) != NRF_SUCCESS)
+            {
+                exit(1);
+            }
+        }
+    }
+
+    before = ep_host_flash_stats_get();
+    ep_host_flash_async(true);
+    m_start_us = now_us();
+    while (m_updates_done < UPDATES)
+    {
+        // An update due before the flash operation started completes is queued behind it
+        if ((issued < UPDATES) && (due_us(issued) <= now_us() + ep_host_flash_pending_us()))
+        {
+            uint16_t const c = issued % CONFIG_RECORDS;
+            ret_code_t     ret;
+
+#if !FDS_GC_INCREMENTAL
+            fds_stat_t stat;
+
+            if (!m_gc_running && (fds_stat(&stat) == NRF_SUCCESS) && (stat.freeable_words >= GC_WORDS))
+            {
+                m_gc_running = (fds_gc() == NRF_SUCCESS);
+            }
+#endif
+            config_value(c, issued / CONFIG_RECORDS + 1);
+            record.file_id           = CONFIG_FILE_ID;
+            record.key               = c + 1;
+            record.data.p_data       = m_config_data[c];
+            record.data.length_words = CONFIG_WORDS;
+
+            ret = fds_record_update(&m_config_desc[c], &record);
+            if (ret == NRF_SUCCESS)
+            {
+                issued++;
+                continue;
+            }
+            if (ret != FDS_ERR_NO_SPACE_IN_QUEUES)
+            {
+                printf("FAIL fds_record_update %u\n", issued);
+                exit(1);
+            }
+            // Wait for the queue to drain.
+        }
+
+        if (!ep_host_flash_process())
+        {
+            if (m_updates_done < issued)
+            {
+                printf("FAIL update %u does not complete\n", m_updates_done);
+                exit(1);
+            }
+            m_idle_us += due_us(issued) - now_us();
+        }
+    }
+
+    // Let garbage collection finish, the check boot sees what it leaves
+    while (ep_host_flash_process())
+    {
+    }
+    ep_host_flash_async(false);
+
+    for (uint32_t i = 0; i < UPDATES; i++)
+    {
+        sum_us += m_latency_us[i];
+    }
+    qsort(m_latency_us, UPDATES, sizeof(m_latency_us[0]), latency_cmp);
+    printf("%-12s %6u %8u %9.2f %9.2f %9.2f %9.1f\n", MODE_NAME, UPDATES, m_gc_runs,
+           (double)sum_us / UPDATES / 1000,
+           (double)m_latency_us[UPDATES * 99 / 100] / 1000,
+           (double)m_latency_us[UPDATES - 1] / 1000,
+           (double)(ep_host_flash_stats_get().busy_us - before.busy_us) / 1000);
+
+    exit(((m_event_errors == 0) && (m_gc_runs > 0)) ? 0 : 1);
+}
+
+static bool record_matches(fds_record_desc_t * p_desc, uint32_t const * p_expected, uint16_t words)
+{
+    fds_flash_record_t record;
+    bool               match;
+
+    if (fds_record_open(p_desc, &record) != NRF_SUCCESS)
+    {
+        return false;
+    }
+    match = (record.p_header->length_words == words) &&
+            (memcmp(record.p_data, p_expected, words * sizeof(uint32_t)) == 0);
+    (void)fds_record_close(p_desc);
+
+    return match;
+}
+
+/* Every record is found once, with its last data */
+static void check_boot(void)
+{
+    fds_record_desc_t desc;
+    fds_find_token_t  token;
+    fds_stat_t        stat;
+    uint16_t          count = 0;
+
+    boot();
+    for (uint16_t i = 0; i < STATIC_RECORDS; i++)
+    {
+        for (uint16_t w = 0; w < STATIC_WORDS; w++)
+        {
+            m_static_data[i][w] = 0x5A000000 | ((uint32_t)i << 8) | w;
+        }
+        memset(&token, 0, sizeof(token));
+        if ((fds_record_find(STATIC_FILE_ID, i + 1, &desc, &token) != NRF_SUCCESS) ||
+            !record_matches(&desc, m_static_data[i], STATIC_WORDS) ||
+            (fds_record_find(STATIC_FILE_ID, i + 1, &desc, &token) == NRF_SUCCESS))
+        {
+            printf("FAIL static record %u\n", i);
+            exit(1);
+        }
+    }
+    for (uint16_t c = 0; c < CONFIG_RECORDS; c++)
+    {
+        // The last update of record c was update number (UPDATES - 1) - ((UPDATES - 1 - c) % CONFIG_RECORDS)
+        uint32_t const last = (UPDATES - 1) - ((UPDATES - 1 - c) % CONFIG_RECORDS);
+
+        config_value(c, last / CONFIG_RECORDS + 1);
+        memset(&token, 0, sizeof(token));
+        if ((fds_record_find(CONFIG_FILE_ID, c + 1, &desc, &token) != NRF_SUCCESS) ||
+            !record_matches(&desc, m_config_data[c], CONFIG_WORDS) ||
+            (fds_record_find(CONFIG_FILE_ID, c + 1, &desc, &token) == NRF_SUCCESS))
+        {
+            printf("FAIL config record %u\n", c);
+            exit(1);
+        }
+    }
+
+    memset(&token, 0, sizeof(token));
+    while (fds_record_find_in_file(CONFIG_FILE_ID, &desc, &token) == NRF_SUCCESS)
+    {
+        count++;
+    }
+    if ((count != CONFIG_RECORDS) || (fds_stat(&stat) != NRF_SUCCESS) || stat.corruption)
+    {
+        printf("FAIL %u config records\n", count);
+        exit(1);
+    }
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    ep_host_flash_map();
+
+    printf("fds garbage collection, %d records of %d words updated every %d ms, "
+           "%d records of %d words kept\n",
+           CONFIG_RECORDS, CONFIG_WORDS, PERIOD_US / 1000, STATIC_RECORDS, STATIC_WORDS);
+    printf("%-12s %6s %8s %9s %9s %9s %9s\n", "mode", "updates", "gc runs",
+           "mean ms", "p99 ms", "worst ms", "flash ms");
+
+    ep_host_flash_erase_all();
+    failures += (run_boot(churn_boot) != 0);
+    failures += (run_boot(check_boot) != 0);
+
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    fds_host_stubs.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief What the fds benches need besides fds, nrf_fstorage and the
+ * simulated flash on the POSIX host.
+ *
+ * Built for the POSIX host target only, see the fds bench targets of
+ * HOST/Makefile.
+ */
+
+#include <stdint.h>
+
+#include "sdk_common.h"
+#include "nrf_atfifo.h"
+#include "nrf_atomic.h"
+#include "nrf_fstorage.h"
+
+/* nrf_atomic.c is Cortex-M assembly, fds only needs these */
+uint32_t nrf_atomic_u32_add(nrf_atomic_u32_t * p_data, uint32_t value)
+{
+    return __atomic_add_fetch(p_data, value, __ATOMIC_SEQ_CST);
+}
+
+uint32_t nrf_atomic_u32_sub(nrf_atomic_u32_t * p_data, uint32_t value)
+{
+    return __atomic_sub_fetch(p_data, value, __ATOMIC_SEQ_CST);
+}
+
+uint32_t nrf_atomic_u32_fetch_add(nrf_atomic_u32_t * p_data, uint32_t value)
+{
+    return __atomic_fetch_add(p_data, value, __ATOMIC_SEQ_CST);
+}
+
+uint32_t nrf_atomic_flag_set_fetch(nrf_atomic_flag_t * p_data)
+{
+    return __atomic_exchange_n(p_data, 1, __ATOMIC_SEQ_CST);
+}
+
+/* nrf_atfifo.c is Cortex-M assembly too. Single threaded FIFO: tail.wr is the
+ * next free item, tail.rd the end of the stored items, head.rd the first one. */
+ret_code_t nrf_atfifo_init(nrf_atfifo_t * const p_fifo, void * p_buf, uint16_t buf_size, uint16_t item_size)
+{
+    p_fifo->p_buf     = p_buf;
+    p_fifo->tail.tag  = 0;
+    p_fifo->head.tag  = 0;
+    p_fifo->buf_size  = buf_size;
+    p_fifo->item_size = item_size;
+    return NRF_SUCCESS;
+}
+
+void * nrf_atfifo_item_alloc(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_put_t * p_context)
+{
+    uint16_t const wr = p_fifo->tail.pos.wr;
+
+    (void)p_context;
+    if ((wr + p_fifo->item_size) % p_fifo->buf_size == p_fifo->head.pos.rd)
+    {
+        return NULL;
+    }
+    p_fifo->tail.pos.wr = (wr + p_fifo->item_size) % p_fifo->buf_size;
+    return (uint8_t *)p_fifo->p_buf + wr;
+}
+
+bool nrf_atfifo_item_put(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_put_t * p_context)
+{
+    (void)p_context;
+    p_fifo->tail.pos.rd = p_fifo->tail.pos.wr;
+    return true;
+}
+
+void * nrf_atfifo_item_get(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t * p_context)
+{
+    (void)p_context;
+    if (p_fifo->head.pos.rd == p_fifo->tail.pos.rd)
+    {
+        return NULL;
+    }
+    return (uint8_t *)p_fifo->p_buf + p_fifo->head.pos.rd;
+}
+
+bool nrf_atfifo_item_free(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t * p_context)
+{
+    (void)p_context;
+    p_fifo->head.pos.rd = (p_fifo->head.pos.rd + p_fifo->item_size) % p_fifo->buf_size;
+    return true;
+}
+
+/* The linker only makes section bounds for sections named like C identifiers, not for
+ * .fs_data. fds never asks nrf_fstorage_is_busy() about all instances, an empty set will do. */
+nrf_fstorage_t * __start_fs_data;
+extern void *    __stop_fs_data __attribute__((alias("__start_fs_data")));
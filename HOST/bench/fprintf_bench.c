@@ -0,0 +1,306 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    fprintf_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Formatted bytes per second and fwrite calls per line of nrf_fprintf.
+ *
+ * Built once per engine, see the fprintf_bench target of HOST/Makefile:
+ * - char: the SDK engine, every character is added and checked on its own.
+ * - span: NRF_FPRINTF_SPAN_COPY. Literal text, strings, digits and padding
+ *   are copied to the IO buffer in spans.
+ *
+ * Two kinds of lines are printed, each followed by a soft flush:
+ * - log: the way nrf_log_str_formatter prints a log, with color, timestamp,
+ *   severity and module, message and line end in separate nrf_fprintf calls.
+ * - cli: the way nrf_cli prints its help, a padded command name and a text.
+ *
+ * With the line policy the context has no flush_threshold, so every line is
+ * flushed as the log backends do. With the batched policy the lines are
+ * collected until 3/4 of the IO buffer is used. The fwrite callback copies
+ * the data out, as a transport would.
+ *
+ * The output of both engines is checked against snprintf, and the
+ * flush_timeout of nrf_fprintf_buffer_flush_stale() is checked.
+ *
+ * Built for the POSIX host target only, see the fprintf_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sdk_common.h"
+#include "nrf_fprintf.h"
+#include "ep_host.h"
+
+#define BENCH_LINES         200000
+#define BENCH_PASSES        5           // Fastest pass is reported
+#define CHECK_LINES         500
+#define MAX_IO_BUFFER_SIZE  1024
+
+#if NRF_MODULE_ENABLED(NRF_FPRINTF_SPAN_COPY)
+#define MODE_NAME           "span"
+#else
+#define MODE_NAME           "char"
+#endif
+
+#define COLOR_CODE          "\x1B[0;32m"
+#define COLOR_RESET         "\x1B[0m"
+
+static char         m_io_buffer[MAX_IO_BUFFER_SIZE];
+static char         m_sink[MAX_IO_BUFFER_SIZE];
+static uint32_t     m_fwrite_calls;
+static size_t       m_fwrite_bytes;
+
+/* Output kept for the check against snprintf, NULL while timing */
+static char *       mp_capture;
+static size_t       m_capture_len;
+
+static char const * m_states[] = {"idle", "sampling", "sending", "sleeping"};
+
+static char const * m_commands[][2] = {
+    {"log", "Commands for controlling the logger, enable, disable, status and list the modules"},
+    {"history", "Command history, the last commands entered in this session"},
+    {"fds", "Flash data storage: write, read, delete and collect the garbage of records"},
+    {"stats", "Run-time statistics of the FreeRTOS tasks, CPU time and stack usage"},
+};
+
+typedef enum
+{
+    LINES_LOG,  ///< Log lines, as nrf_log_str_formatter prints them
+    LINES_CLI,  ///< Help lines, as nrf_cli prints them
+} lines_t;
+
+static void bench_fwrite(void const * p_user_ctx, char const * p_str, size_t length)
+{
+    (void)p_user_ctx;
+    memcpy(m_sink, p_str, length);
+    if (mp_capture != NULL)
+    {
+        memcpy(&mp_capture[m_capture_len], p_str, length);
+        m_capture_len += length;
+    }
+    m_fwrite_calls++;
+    m_fwrite_bytes += length;
+}
+
+/**
+ * @brief Prints line i, as nrf_log_str_formatter prints a log with arguments.
+ */
+static void log_line_print(nrf_fprintf_ctx_t * p_ctx, uint32_t i)
+{
+    nrf_fprintf(p_ctx, "%s", COLOR_CODE);
+    nrf_fprintf(p_ctx, "[%08u] ", i * 31u);
+    nrf_fprintf(p_ctx, "<%s> %s: ", "info", "app");
+    switch (i % 4)
+    {
+        case 0:
+            nrf_fprintf(p_ctx, "sensor %d reads %u mV, limit %5d", (int)(i % 7) - 3, i * 7u, 4200);
+            break;
+        case 1:
+            nrf_fprintf(p_ctx, "reg 0x%08X = 0x%02X", 0x40001000u + i * 4u, i & 0xFFu);
+            break;
+        case 2:
+            nrf_fprintf(p_ctx, "state %-8s-> %s", m_states[i % 4], m_states[(i + 1) % 4]);
+            break;
+        default:
+            nrf_fprintf(p_ctx, "connection parameters updated, interval %u units, latency %u, timeout %u ms",
+                        6u + (i % 40), i % 4, 4000u);
+            break;
+    }
+    nrf_fprintf(p_ctx, "%s\n", COLOR_RESET);
+}
+
+static void line_print(nrf_fprintf_ctx_t * p_ctx, lines_t lines, uint32_t i)
+{
+    if (lines == LINES_LOG)
+    {
+        log_line_print(p_ctx, i);
+    }
+    else
+    {
+        nrf_fprintf(p_ctx, "  %-16s: %s\n", m_commands[i % 4][0], m_commands[i % 4][1]);
+    }
+    nrf_fprintf_buffer_flush_soft(p_ctx);
+}
+
+/**
+ * @brief The line of line_print() from snprintf, with the CR nrf_fprintf adds before LF.
+ */
+static int line_expect(char * p_buf, size_t size, lines_t lines, uint32_t i)
+{
+    int n;
+
+    if (lines == LINES_CLI)
+    {
+        return snprintf(p_buf, size, "  %-16s: %s\r\n", m_commands[i % 4][0], m_commands[i % 4][1]);
+    }
+
+    n = snprintf(p_buf, size, "%s[%08u] <%s> %s: ", COLOR_CODE, i * 31u, "info", "app");
+
+    switch (i % 4)
+    {
+        case 0:
+            n += snprintf(&p_buf[n], size - n, "sensor %d reads %u mV, limit %5d", (int)(i % 7) - 3, i * 7u, 4200);
+            break;
+        case 1:
+            n += snprintf(&p_buf[n], size - n, "reg 0x%08X = 0x%02X", 0x40001000u + i * 4u, i & 0xFFu);
+            break;
+        case 2:
+            n += snprintf(&p_buf[n], size - n, "state %-8s-> %s", m_states[i % 4], m_states[(i + 1) % 4]);
+            break;
+        default:
+            n += snprintf(&p_buf[n], size - n,
+                          "connection parameters updated, interval %u units, latency %u, timeout %u ms",
+                          6u + (i % 40), i % 4, 4000u);
+            break;
+    }
+    n += snprintf(&p_buf[n], size - n, "%s\r\n", COLOR_RESET);
+    return n;
+}
+
+static void ctx_init(nrf_fprintf_ctx_t * p_ctx, size_t size, size_t threshold)
+{
+    nrf_fprintf_ctx_t ctx = {
+        .p_io_buffer     = m_io_buffer,
+        .io_buffer_size  = size,
+        .io_buffer_cnt   = 0,
+        .auto_flush      = false,
+        .p_user_ctx      = NULL,
+        .fwrite          = bench_fwrite,
+        .flush_threshold = threshold,
+    };
+    memcpy(p_ctx, &ctx, sizeof(ctx));
+}
+
+static bool output_check(lines_t lines, size_t size, size_t threshold)
+{
+    static char       capture[CHECK_LINES * 160];
+    static char       expected[CHECK_LINES * 160];
+    size_t            expected_len = 0;
+    nrf_fprintf_ctx_t ctx;
+
+    ctx_init(&ctx, size, threshold);
+    mp_capture    = capture;
+    m_capture_len = 0;
+    for (uint32_t i = 0; i < CHECK_LINES; i++)
+    {
+        line_print(&ctx, lines, i);
+        expected_len += line_expect(&expected[expected_len], sizeof(expected) - expected_len, lines, i);
+    }
+    nrf_fprintf_buffer_flush(&ctx);
+    mp_capture = NULL;
+
+    if ((m_capture_len != expected_len) || (memcmp(capture, expected, expected_len) != 0))
+    {
+        printf("FAIL output of a %u byte buffer differs from snprintf\n", (unsigned)size);
+        return false;
+    }
+    return true;
+}
+
+static bool timeout_check(void)
+{
+    nrf_fprintf_ctx_t ctx;
+    uint32_t          calls;
+    bool              ok;
+
+    ctx_init(&ctx, MAX_IO_BUFFER_SIZE, MAX_IO_BUFFER_SIZE);
+    ctx.flush_timeout = 10;
+
+    line_print(&ctx, LINES_LOG, 0);
+    calls = m_fwrite_calls;
+    nrf_fprintf_buffer_flush_stale(&ctx, 100);  // Records the age of the data
+    nrf_fprintf_buffer_flush_stale(&ctx, 109);
+    ok = (m_fwrite_calls == calls);
+    nrf_fprintf_buffer_flush_stale(&ctx, 110);
+    ok = ok && (m_fwrite_calls == calls + 1) && (ctx.io_buffer_cnt == 0);
+
+    // An empty buffer forgets the age, new data waits for a full timeout again
+    nrf_fprintf_buffer_flush_stale(&ctx, 200);
+    line_print(&ctx, LINES_LOG, 1);
+    nrf_fprintf_buffer_flush_stale(&ctx, 205);
+    nrf_fprintf_buffer_flush_stale(&ctx, 214);
+    ok = ok && (m_fwrite_calls == calls + 1);
+    nrf_fprintf_buffer_flush_stale(&ctx, 215);
+    ok = ok && (m_fwrite_calls == calls + 2);
+
+    if (!ok)
+    {
+        printf("FAIL nrf_fprintf_buffer_flush_stale\n");
+    }
+    return ok;
+}
+
+static bool run(lines_t lines, size_t size, char const * p_policy, size_t threshold)
+{
+    nrf_fprintf_ctx_t ctx;
+    double            best = 0;
+    bool              ok   = output_check(lines, size, threshold);
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint64_t start;
+        double time;
+
+        ctx_init(&ctx, size, threshold);
+        m_fwrite_calls = 0;
+        m_fwrite_bytes = 0;
+
+        start = ep_host_now_ns();
+        for (uint32_t i = 0; i < BENCH_LINES; i++)
+        {
+            line_print(&ctx, lines, i);
+        }
+        nrf_fprintf_buffer_flush(&ctx);
+        time = (ep_host_now_ns() - start) * 1e-9;
+
+        best = ((pass == 0) || (time < best)) ? time : best;
+    }
+
+    printf("%-6s %-5s %7u %-8s %9.1f %10.2f %10.1f %s\n", MODE_NAME,
+           (lines == LINES_LOG) ? "log" : "cli", (unsigned)size, p_policy,
+           m_fwrite_bytes / best / 1e6, (double)m_fwrite_calls / BENCH_LINES,
+           (double)m_fwrite_bytes / m_fwrite_calls, ok ? "" : "FAIL");
+    return ok;
+}
+
+int main(void)
+{
+    static const size_t sizes[] = {64, MAX_IO_BUFFER_SIZE};
+    uint32_t failures = 0;
+
+    printf("nrf_fprintf %s engine, %d log lines per run\n", MODE_NAME, BENCH_LINES);
+    printf("%-6s %-5s %7s %-8s %9s %10s %10s\n", "engine", "lines", "buffer", "policy", "MB/s",
+           "calls/line", "B/call");
+    for (lines_t lines = LINES_LOG; lines <= LINES_CLI; lines++)
+    {
+        for (uint32_t i = 0; i < ARRAY_SIZE(sizes); i++)
+        {
+            failures += run(lines, sizes[i], "line", 0) ? 0 : 1;
+            failures += run(lines, sizes[i], "batched", sizes[i] * 3 / 4) ? 0 : 1;
+        }
+    }
+    failures += timeout_check() ? 0 : 1;
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,392 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    gfx_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Text rendering and display flushes of nrf_gfx on a host frame buffer LCD.
+ *
+ * The real nrf_gfx draws into a 240x320 RGB565 frame buffer, behind an
+ * nrf_lcd_t that counts the bytes an SPI panel of the ILI9341 kind would be
+ * sent: a window of WINDOW_BYTES and 2 bytes per pixel for each draw call
+ * when the panel is written directly, and the same for each display of the
+ * frame buffer when it is not.
+ *
+ * - text: a screen of text in a 10x16 font is printed over and over. Host
+ *   characters per second, LCD calls and panel bytes per character.
+ * - update: a value field of a screen of text is cleared and printed again,
+ *   and nrf_gfx_display() is called. Panel bytes per update.
+ *
+ * The frame buffer is checked against a reference rendering of the text,
+ * and the panel against the frame buffer after every display. The bench is
+ * built with NRF_GFX_SPAN_BLIT_ENABLED and NRF_GFX_DIRTY_RECT_ENABLED off and
+ * on, see the gfx_bench target of HOST/Makefile.
+ *
+ * Built for the POSIX host target only, see the gfx_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdk_common.h"
+#include "nrf_gfx.h"
+#include "ep_host.h"
+
+#define LCD_WIDTH           240
+#define LCD_HEIGHT          320
+#define WINDOW_BYTES        11          // Column and page address set and memory write, with their data
+#define SPI_MHZ             8
+#define BACKGROUND          0x0000
+#define FOREGROUND          0xFFFF
+
+#define FONT_SCALE          2           // 5x8 glyphs drawn as 10x16
+#define FONT_WIDTH          (5 * FONT_SCALE)
+#define FONT_HEIGHT         (8 * FONT_SCALE)
+#define FONT_LINE_BYTES     CEIL_DIV(FONT_WIDTH, 8)
+#define FONT_START          ' '
+#define FONT_END            'Z'
+#define FONT_GLYPHS         (FONT_END - FONT_START + 1)
+#define FONT_SPACING        2
+
+#define TEXT_LINES          18
+#define TEXT_LINE_LENGTH    19
+#define TEXT_LINE_HEIGHT    (FONT_HEIGHT + FONT_HEIGHT / 10)
+#define TEXT_REPEATS        200
+#define UPDATES             100
+#define FIELD_X             120
+#define FIELD_LINE          5
+#define FIELD_WIDTH         60
+
+#define BENCH_CHECK(_call)                                  \
+    do {                                                    \
+        if ((_call) != NRF_SUCCESS)                         \
+        {                                                   \
+            printf("%s FAILED\n", #_call);                  \
+            exit(1);                                        \
+        }                                                   \
+    } while (0)
+
+#define GLYPH(_idx) {.widthBits = FONT_WIDTH, .offset = (_idx) * FONT_HEIGHT * FONT_LINE_BYTES}
+#define GLYPHS_4(_idx) GLYPH(_idx), GLYPH((_idx) + 1), GLYPH((_idx) + 2), GLYPH((_idx) + 3)
+#define GLYPHS_16(_idx) GLYPHS_4(_idx), GLYPHS_4((_idx) + 4), GLYPHS_4((_idx) + 8), GLYPHS_4((_idx) + 12)
+
+/* Columns of the 5x8 glyphs from ' ' to 'Z', LSB on top */
+static const uint8_t m_glyph_columns[FONT_GLYPHS][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x00, 0x14, 0x00, 0x00},
+    {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3E, 0x41, 0x5D, 0x59, 0x4E},
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x41, 0x51, 0x73}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43},
+};
+
+static const FONT_CHAR_INFO m_char_info[FONT_GLYPHS] = {
+    GLYPHS_16(0), GLYPHS_16(16), GLYPHS_16(32), GLYPHS_4(48), GLYPHS_4(52), GLYPH(56), GLYPH(57), GLYPH(58)
+};
+
+static uint8_t m_glyph_data[FONT_GLYPHS * FONT_HEIGHT * FONT_LINE_BYTES];
+
+static const nrf_gfx_font_desc_t m_font = {
+    .height      = FONT_HEIGHT,
+    .startChar   = FONT_START,
+    .endChar     = FONT_END,
+    .spacePixels = FONT_SPACING,
+    .charInfo    = m_char_info,
+    .data        = m_glyph_data,
+};
+
+static const char * const m_words[] = {
+    "THE", "QUICK", "BROWN", "FOX", "JUMPS", "OVER", "13", "LAZY", "DOGS:", "24.5%", "-7", "#42", "RSSI", "@3V3?"
+};
+
+/**
+ * @brief Host frame buffer LCD
+ */
+typedef struct {
+    uint32_t calls;             // Draw calls
+    uint64_t direct_bytes;      // Sent by the draw calls to a panel without frame buffer
+    uint32_t displays;
+    uint64_t display_bytes;     // Sent by the displays of the frame buffer
+} lcd_stats_t;
+
+static uint16_t     m_frame[LCD_HEIGHT][LCD_WIDTH];
+static uint16_t     m_panel[LCD_HEIGHT][LCD_WIDTH];
+static uint16_t     m_reference[LCD_HEIGHT][LCD_WIDTH];
+static lcd_stats_t  m_stats;
+static char         m_text[TEXT_LINES][TEXT_LINE_LENGTH + 1];
+
+static ret_code_t lcd_init(void)
+{
+    return NRF_SUCCESS;
+}
+
+static void lcd_uninit(void)
+{
+}
+
+static void lcd_pixel_draw(uint16_t x, uint16_t y, uint32_t color)
+{
+    m_frame[y][x] = (uint16_t)color;
+    m_stats.calls++;
+    m_stats.direct_bytes += WINDOW_BYTES + 2;
+}
+
+static void lcd_rect_draw(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint32_t color)
+{
+    for (uint32_t i = y; i < y + height; i++)
+    {
+        for (uint32_t j = x; j < x + width; j++)
+        {
+            m_frame[i][j] = (uint16_t)color;
+        }
+    }
+    m_stats.calls++;
+    m_stats.direct_bytes += WINDOW_BYTES + 2 * width * height;
+}
+
+static void lcd_display_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    for (uint32_t i = y; i < y + height; i++)
+    {
+        memcpy(&m_panel[i][x], &m_frame[i][x], 2 * width);
+    }
+    m_stats.displays++;
+    m_stats.display_bytes += WINDOW_BYTES + 2 * width * height;
+}
+
+static void lcd_display(void)
+{
+    lcd_display_rect(0, 0, LCD_WIDTH, LCD_HEIGHT);
+}
+
+static void lcd_rotation_set(nrf_lcd_rotation_t rotation)
+{
+    (void)rotation;
+}
+
+static void lcd_display_invert(bool invert)
+{
+    (void)invert;
+}
+
+static lcd_cb_t m_lcd_cb = {
+    .height = LCD_HEIGHT,
+    .width  = LCD_WIDTH,
+};
+
+static const nrf_lcd_t m_lcd = {
+    .lcd_init           = lcd_init,
+    .lcd_uninit         = lcd_uninit,
+    .lcd_pixel_draw     = lcd_pixel_draw,
+    .lcd_rect_draw      = lcd_rect_draw,
+    .lcd_display        = lcd_display,
+    .lcd_rotation_set   = lcd_rotation_set,
+    .lcd_display_invert = lcd_display_invert,
+    .p_lcd_cb           = &m_lcd_cb,
+    .lcd_display_rect   = lcd_display_rect,
+};
+
+/**
+ * @brief Scales the 5x8 glyphs to the rows of the font
+ */
+static void font_build(void)
+{
+    for (uint32_t glyph = 0; glyph < FONT_GLYPHS; glyph++)
+    {
+        for (uint32_t y = 0; y < FONT_HEIGHT; y++)
+        {
+            uint8_t * p_line = &m_glyph_data[m_char_info[glyph].offset + y * FONT_LINE_BYTES];
+
+            for (uint32_t x = 0; x < FONT_WIDTH; x++)
+            {
+                if (m_glyph_columns[glyph][x / FONT_SCALE] & (1 << (y / FONT_SCALE)))
+                {
+                    p_line[x / 8] |= 0x80 >> (x % 8);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Fills the lines of text with the words, separated by spaces
+ */
+static void text_build(void)
+{
+    uint32_t word = 0;
+
+    for (uint32_t line = 0; line < TEXT_LINES; line++)
+    {
+        uint32_t length = 0;
+
+        while (length < TEXT_LINE_LENGTH)
+        {
+            length += (uint32_t)snprintf(&m_text[line][length], TEXT_LINE_LENGTH + 1 - length, "%s ",
+                                         m_words[word++ % ARRAY_SIZE(m_words)]);
+        }
+    }
+}
+
+static void text_print(void)
+{
+    for (uint32_t line = 0; line < TEXT_LINES; line++)
+    {
+        nrf_gfx_point_t const point = NRF_GFX_POINT(0, line * TEXT_LINE_HEIGHT);
+
+        BENCH_CHECK(nrf_gfx_print(&m_lcd, &point, FOREGROUND, m_text[line], &m_font, false));
+    }
+}
+
+/**
+ * @brief Renders a string into the reference frame, one bit at a time
+ */
+static void reference_print(uint16_t x, uint16_t y, char const * p_string)
+{
+    for (; *p_string != '\0'; p_string++)
+    {
+        FONT_CHAR_INFO const * p_info = &m_char_info[*p_string - FONT_START];
+
+        if (*p_string == ' ')
+        {
+            x += FONT_HEIGHT / 2;
+            continue;
+        }
+        for (uint32_t i = 0; i < FONT_HEIGHT; i++)
+        {
+            for (uint32_t j = 0; j < FONT_LINE_BYTES * 8; j++)
+            {
+                if ((m_glyph_data[p_info->offset + i * FONT_LINE_BYTES + j / 8] & (0x80 >> (j % 8))) &&
+                    (x + j < LCD_WIDTH))
+                {
+                    m_reference[y + i][x + j] = FOREGROUND;
+                }
+            }
+        }
+        x += p_info->widthBits + FONT_SPACING;
+    }
+}
+
+static bool text_run(void)
+{
+    uint32_t chars = 0;
+    uint64_t start;
+    double   host_s;
+    bool     ok;
+
+    nrf_gfx_screen_fill(&m_lcd, BACKGROUND);
+    memset(m_reference, 0, sizeof(m_reference));
+    for (uint32_t line = 0; line < TEXT_LINES; line++)
+    {
+        chars += (uint32_t)strlen(m_text[line]);
+        reference_print(0, (uint16_t)(line * TEXT_LINE_HEIGHT), m_text[line]);
+    }
+    chars *= TEXT_REPEATS;
+
+    memset(&m_stats, 0, sizeof(m_stats));
+    start = ep_host_now_ns();
+    for (uint32_t i = 0; i < TEXT_REPEATS; i++)
+    {
+        text_print();
+    }
+    host_s = (ep_host_now_ns() - start) * 1e-9;
+
+    ok = (memcmp(m_frame, m_reference, sizeof(m_frame)) == 0);
+    printf("%-8s %10u %10.0f %10.1f %10.1f %12.0f %s\n", "text", chars, chars / host_s / 1000.0,
+           (double)m_stats.calls / chars, (double)m_stats.direct_bytes / chars,
+           chars / (m_stats.direct_bytes * 8.0 / (SPI_MHZ * 1e6)), ok ? "" : "frame FAILED");
+    return ok;
+}
+
+static bool update_run(void)
+{
+    nrf_gfx_rect_t const field = NRF_GFX_RECT(FIELD_X, FIELD_LINE * TEXT_LINE_HEIGHT, FIELD_WIDTH, FONT_HEIGHT);
+    nrf_gfx_point_t const point = NRF_GFX_POINT(FIELD_X, FIELD_LINE * TEXT_LINE_HEIGHT);
+    uint64_t full_bytes;
+    uint64_t idle_bytes;
+    bool     ok = true;
+
+    nrf_gfx_screen_fill(&m_lcd, BACKGROUND);
+    text_print();
+    memset(&m_stats, 0, sizeof(m_stats));
+    nrf_gfx_display(&m_lcd);
+    full_bytes = m_stats.display_bytes;
+    ok = ok && (memcmp(m_panel, m_frame, sizeof(m_frame)) == 0);
+
+    memset(&m_stats, 0, sizeof(m_stats));
+    for (uint32_t i = 0; i < UPDATES; i++)
+    {
+        char value[8];
+
+        (void)snprintf(value, sizeof(value), "%4.1f", (double)(i * 37 % 1000) / 10.0);
+        BENCH_CHECK(nrf_gfx_rect_draw(&m_lcd, &field, 1, BACKGROUND, true));
+        BENCH_CHECK(nrf_gfx_print(&m_lcd, &point, FOREGROUND, value, &m_font, false));
+        nrf_gfx_display(&m_lcd);
+        ok = ok && (memcmp(m_panel, m_frame, sizeof(m_frame)) == 0);
+    }
+
+    // Nothing drawn since the last display
+    idle_bytes = m_stats.display_bytes;
+    nrf_gfx_display(&m_lcd);
+    idle_bytes = m_stats.display_bytes - idle_bytes;
+
+    printf("%-8s %10u %10llu %10llu %10llu %12.0f %s\n", "update", UPDATES,
+           (unsigned long long)full_bytes, (unsigned long long)(m_stats.display_bytes - idle_bytes) / UPDATES,
+           (unsigned long long)idle_bytes,
+           UPDATES / ((m_stats.display_bytes - idle_bytes) * 8.0 / (SPI_MHZ * 1e6)), ok ? "" : "panel FAILED");
+    return ok;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+
+    printf("nrf_gfx, span blit %s, dirty rectangle %s, %ux%u RGB565, panel SPI at %d MHz\n",
+           NRF_GFX_SPAN_BLIT_ENABLED ? "on" : "off", NRF_GFX_DIRTY_RECT_ENABLED ? "on" : "off",
+           LCD_WIDTH, LCD_HEIGHT, SPI_MHZ);
+
+    font_build();
+    text_build();
+    BENCH_CHECK(nrf_gfx_init(&m_lcd));
+
+    printf("%-8s %10s %10s %10s %10s %12s\n", "run", "chars", "kchar/s", "calls/ch", "bytes/ch", "SPI char/s");
+    failures += text_run() ? 0 : 1;
+    printf("%-8s %10s %10s %10s %10s %12s\n", "run", "updates", "full B", "update B", "idle B", "SPI upd/s");
+    failures += update_run() ? 0 : 1;
+
+    nrf_gfx_uninit(&m_lcd);
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,251 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    hash_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Known-answer tests and throughput of the portable SHA-256 and CRC-32.
+ *
+ * The FIPS 180-2 SHA-256 vectors are hashed with the sha256 library and
+ * through nrf_crypto_hash on the nRF SW backend, both in one piece and
+ * streamed in irregular chunks with nrf_crypto_hash_updatev(). CRC-32 is
+ * checked against the standard check value, in one piece and chained.
+ *
+ * The CC310 and Oberon backends are binary libraries for the Cortex-M4 and
+ * cannot run here; they are listed as not measured.
+ *
+ * Built for the POSIX host target only, see the hash_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sha256.h"
+#include "crc32.h"
+#include "nrf_crypto_hash.h"
+#include "ep_host.h"
+
+#define BENCH_SIZE      (256 * 1024)    // Image size hashed per pass
+#define BENCH_PASSES    20              // Fastest pass is reported
+
+typedef struct {
+    const char * p_message;
+    uint32_t     repeat;
+    const char * p_digest;
+} kat_t;
+
+static const kat_t m_kats[] = {
+    { "abc", 1,
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { "", 1,
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+    { "a", 1000000,
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+};
+
+static uint8_t m_image[BENCH_SIZE];
+static int     m_failures;
+
+static void check(const char * p_what, const uint8_t * p_digest, const char * p_expected)
+{
+    char hex[NRF_CRYPTO_HASH_SIZE_SHA256 * 2 + 1];
+
+    for (int i = 0; i < NRF_CRYPTO_HASH_SIZE_SHA256; i++)
+    {
+        sprintf(&hex[2 * i], "%02x", p_digest[i]);
+    }
+    if (strcmp(hex, p_expected) != 0)
+    {
+        printf("FAIL %s: %s\n", p_what, hex);
+        m_failures++;
+    }
+}
+
+/* Feeds the message in chunks of 1, 2, 3, ... 97 bytes, then again from 1 */
+static void kat_streamed(const kat_t * p_kat)
+{
+    static nrf_crypto_hash_context_t context;
+    static uint8_t                   message[1000000];
+    size_t                           part = strlen(p_kat->p_message);
+    size_t                           size = part * p_kat->repeat;
+    nrf_crypto_hash_segment_t        segments[4];
+    uint8_t                          digest[NRF_CRYPTO_HASH_SIZE_SHA256];
+    size_t                           digest_size = sizeof(digest);
+    size_t                           offset = 0;
+    size_t                           chunk  = 1;
+
+    for (uint32_t i = 0; i < p_kat->repeat; i++)
+    {
+        memcpy(&message[i * part], p_kat->p_message, part);
+    }
+
+    nrf_crypto_hash_init(&context, &g_nrf_crypto_hash_sha256_info);
+    while (offset < size)
+    {
+        size_t count = 0;
+
+        // A few segments per call, one of them empty
+        for (int i = 0; (i < 3) && (offset < size); i++)
+        {
+            size_t length = MIN(chunk, size - offset);
+
+            segments[count].p_data = &message[offset];
+            segments[count].size   = length;
+            count++;
+            offset += length;
+            chunk   = (chunk % 97) + 1;
+        }
+        segments[count].p_data = NULL;
+        segments[count].size   = 0;
+        count++;
+
+        if (nrf_crypto_hash_updatev(&context, segments, count) != NRF_SUCCESS)
+        {
+            m_failures++;
+        }
+    }
+    nrf_crypto_hash_finalize(&context, digest, &digest_size);
+    check("nrf_crypto_hash_updatev", digest, p_kat->p_digest);
+}
+
+static void kat_sha256(const kat_t * p_kat)
+{
+    sha256_context_t ctx;
+    uint8_t          digest[NRF_CRYPTO_HASH_SIZE_SHA256];
+    uint8_t          digest_le[NRF_CRYPTO_HASH_SIZE_SHA256];
+
+    sha256_init(&ctx);
+    for (uint32_t i = 0; i < p_kat->repeat; i++)
+    {
+        sha256_update(&ctx, (const uint8_t *)p_kat->p_message, strlen(p_kat->p_message));
+    }
+    sha256_final(&ctx, digest, false);
+    check("sha256_update", digest, p_kat->p_digest);
+
+    sha256_init(&ctx);
+    for (uint32_t i = 0; i < p_kat->repeat; i++)
+    {
+        sha256_update(&ctx, (const uint8_t *)p_kat->p_message, strlen(p_kat->p_message));
+    }
+    sha256_final(&ctx, digest_le, true);
+    for (int i = 0; i < NRF_CRYPTO_HASH_SIZE_SHA256; i++)
+    {
+        if (digest_le[i] != digest[NRF_CRYPTO_HASH_SIZE_SHA256 - 1 - i])
+        {
+            printf("FAIL sha256_final little endian\n");
+            m_failures++;
+            break;
+        }
+    }
+}
+
+static void kat_crc32(void)
+{
+    const uint8_t * p_check = (const uint8_t *)"123456789";
+    uint32_t        crc;
+
+    crc = crc32_compute(p_check, 9, NULL);
+    if (crc != 0xCBF43926)
+    {
+        printf("FAIL crc32_compute: %08x\n", crc);
+        m_failures++;
+    }
+
+    crc = crc32_compute(p_check, 4, NULL);
+    crc = crc32_compute(p_check + 4, 5, &crc);
+    if (crc != 0xCBF43926)
+    {
+        printf("FAIL crc32_compute chained: %08x\n", crc);
+        m_failures++;
+    }
+}
+
+static double throughput(int sha256)
+{
+    static nrf_crypto_hash_context_t context;
+    uint64_t                         best = UINT64_MAX;
+    volatile uint32_t                sink = 0;
+
+    for (int pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint64_t start = ep_host_now_ns();
+
+        if (sha256)
+        {
+            uint8_t digest[NRF_CRYPTO_HASH_SIZE_SHA256];
+            size_t  digest_size = sizeof(digest);
+
+            // 4 KB chunks, as from flash pages
+            nrf_crypto_hash_init(&context, &g_nrf_crypto_hash_sha256_info);
+            for (size_t offset = 0; offset < BENCH_SIZE; offset += 4096)
+            {
+                nrf_crypto_hash_update(&context, &m_image[offset], 4096);
+            }
+            nrf_crypto_hash_finalize(&context, digest, &digest_size);
+            sink += digest[0];
+        }
+        else
+        {
+            uint32_t crc = 0;
+
+            for (size_t offset = 0; offset < BENCH_SIZE; offset += 4096)
+            {
+                crc = crc32_compute(&m_image[offset], 4096, (offset == 0) ? NULL : &crc);
+            }
+            sink += crc;
+        }
+
+        uint64_t ns = ep_host_now_ns() - start;
+
+        if (ns < best)
+        {
+            best = ns;
+        }
+    }
+    (void)sink;
+
+    return (double)BENCH_SIZE / 1e6 / ((double)best / 1e9);
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(m_kats) / sizeof(m_kats[0]); i++)
+    {
+        kat_sha256(&m_kats[i]);
+        kat_streamed(&m_kats[i]);
+    }
+    kat_crc32();
+    printf("known-answer tests: %s\n", m_failures ? "FAILED" : "passed");
+
+    for (size_t i = 0; i < sizeof(m_image); i++)
+    {
+        m_image[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    printf("%-28s %10s\n", "backend", "MB/s");
+    printf("%-28s %10.1f\n", "sha256 nrf_sw (portable C)", throughput(1));
+    printf("%-28s %10s\n", "sha256 cc310", "target only");
+    printf("%-28s %10s\n", "sha256 oberon", "target only");
+    printf("%-28s %10.1f\n", "crc32 (CRC32_CONFIG_IMPL.)", throughput(0));
+
+    return m_failures ? 1 : 0;
+}
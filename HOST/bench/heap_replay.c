@@ -0,0 +1,454 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    heap_replay.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Replays an alloc/free trace through one FreeRTOS MemMang heap.
+ *
+ * The benchmark is linked once per heap (heap_4, heap_tlsf) and reports the
+ * worst-case and 99.9th percentile latency of pvPortMalloc/vPortFree, the
+ * failed allocations and the peak fragmentation, defined as
+ * 1 - largest free block / free bytes after each call.
+ *
+ * The trace is replayed BENCH_PASSES times, each pass in a forked child so it
+ * starts from a fresh heap, and every call keeps its fastest time over the
+ * passes. Host preemption therefore does not show up as allocator latency.
+ * The heap is read before each call, as the SRAM of the target has no cache
+ * to miss in.
+ *
+ * The max is still set by the host: a few calls stay at 300 to 650 ns over
+ * all the passes, on other trace entries from one run to the next, for both
+ * heaps. On the synthetic trace it does not show a worst case gain of
+ * heap_tlsf, compare the p99.9 latency.
+ *
+ * The trace is the file given as argument, in the format written by the host
+ * build with EP_HOST_HEAP_TRACE ("m <id> <size>" and "f <id>" lines). Without
+ * an argument a synthetic trace of log and message buffers is replayed.
+ *
+ * Built for the POSIX host target only, see the heap_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ep_host.h"
+
+#ifndef HEAP_NAME
+#define HEAP_NAME "heap"
+#endif
+
+#define BENCH_PASSES        9
+#define MAX_LIVE            1024        // Live allocations tracked at once
+#define MAX_OPS             (1 << 20)   // Trace length limit
+#define SYNTHETIC_OPS       200000
+#define SYNTHETIC_LIVE      64          // Live allocations the synthetic trace aims for
+
+typedef struct {
+    char               type;            // 'm' or 'f'
+    unsigned long long id;
+    size_t             size;
+} op_t;
+
+typedef struct {
+    unsigned long long id;
+    void *             ptr;
+} live_t;
+
+/* Results of one pass, written by the child into shared memory */
+typedef struct {
+    uint32_t failed;
+    size_t   min_ever_free;
+    double   peak_fragmentation;
+    size_t   peak_free_blocks;
+    uint32_t ns[];                      // Per trace entry, UINT32_MAX for skipped frees
+} pass_t;
+
+static op_t     m_ops[MAX_OPS];
+static uint32_t m_op_count;
+
+static live_t   m_live[MAX_LIVE];
+static uint32_t m_live_count;
+
+static uint8_t * m_heap_start;          // Range of the heap, found by warm_up()
+static uint8_t * m_heap_end;
+
+/* The heap only needs the scheduler lock, there is no scheduler here */
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+void vPortTraceMalloc(void * pvAddress, size_t xSize)
+{
+    (void)pvAddress;
+    (void)xSize;
+}
+
+void vPortTraceFree(uintptr_t uxAddress)
+{
+    (void)uxAddress;
+}
+
+static void op_add(char type, unsigned long long id, size_t size)
+{
+    if (m_op_count == MAX_OPS)
+    {
+        fprintf(stderr, "heap_replay: trace longer than %d entries\n", MAX_OPS);
+        exit(1);
+    }
+    m_ops[m_op_count].type = type;
+    m_ops[m_op_count].id   = id;
+    m_ops[m_op_count].size = size;
+    m_op_count++;
+}
+
+static int load_file(const char * path)
+{
+    FILE *             file = fopen(path, "r");
+    char               line[128];
+    unsigned long long id;
+    size_t             size;
+
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (sscanf(line, "m %llx %zu", &id, &size) == 2)
+        {
+            op_add('m', id, size);
+        }
+        else if (sscanf(line, "f %llx", &id) == 1)
+        {
+            op_add('f', id, 0);
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+/* Deterministic mix of short lived log lines, messages and small objects */
+static void load_synthetic(void)
+{
+    static unsigned long long live[SYNTHETIC_LIVE * 2];
+    uint32_t                  live_count = 0;
+    uint32_t                  seed       = 0x2545F491;
+    unsigned long long        id         = 0;
+
+    for (uint32_t op = 0; op < SYNTHETIC_OPS; op++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t r = seed >> 8;
+
+        if ((live_count == 0) ||
+            ((live_count < SYNTHETIC_LIVE * 2) && ((r % SYNTHETIC_LIVE) >= live_count / 2)))
+        {
+            size_t size;
+
+            switch (r % 32)
+            {
+                case 0:             size = 512 + (r >> 5) % 1024;  break;   // Message buffer
+                case 1: case 2:
+                case 3: case 4:
+                case 5: case 6:     size = 64 + (r >> 5) % 448;    break;   // Log line
+                default:            size = 8 + (r >> 5) % 120;     break;   // Small object
+            }
+            live[live_count++] = ++id;
+            op_add('m', id, size);
+        }
+        else
+        {
+            uint32_t index = (r >> 5) % live_count;
+
+            op_add('f', live[index], 0);
+            live[index] = live[--live_count];
+        }
+    }
+}
+
+static void sample_fragmentation(pass_t * p_pass)
+{
+    HeapFragmentationReport_t report;
+
+    vPortGetHeapFragmentationReport(&report);
+
+    if (report.xFreeBytes > 0)
+    {
+        double fragmentation = 1.0 - (double)report.xLargestFreeBlock / (double)report.xFreeBytes;
+
+        if (fragmentation > p_pass->peak_fragmentation)
+        {
+            p_pass->peak_fragmentation = fragmentation;
+        }
+    }
+    if (report.xFreeBlocks > p_pass->peak_free_blocks)
+    {
+        p_pass->peak_free_blocks = report.xFreeBlocks;
+    }
+}
+
+static int live_find(unsigned long long id)
+{
+    for (uint32_t i = 0; i < m_live_count; i++)
+    {
+        if (m_live[i].id == id)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Touches the whole heap in chunks, so neither the heap setup nor the first
+page faults are counted. The heap is left as one free block again. */
+static void warm_up(void)
+{
+    static void * chunks[configTOTAL_HEAP_SIZE / 64];
+    uint32_t      count = 0;
+
+    for (size_t size = 1024; size >= 64; size /= 2)
+    {
+        while (count < sizeof(chunks) / sizeof(chunks[0]))
+        {
+            void * ptr = pvPortMalloc(size);
+
+            if (ptr == NULL)
+            {
+                break;
+            }
+            memset(ptr, 0, size);
+            chunks[count++] = ptr;
+            if ((m_heap_start == NULL) || ((uint8_t *)ptr < m_heap_start))
+            {
+                m_heap_start = ptr;
+            }
+            if ((uint8_t *)ptr + size > m_heap_end)
+            {
+                m_heap_end = (uint8_t *)ptr + size;
+            }
+        }
+    }
+    while (count > 0)
+    {
+        vPortFree(chunks[--count]);
+    }
+}
+
+/* Reads every cache line of the heap before a timed call */
+static void heap_touch(void)
+{
+    volatile uint8_t touch;
+
+    for (const uint8_t * p = m_heap_start; p < m_heap_end; p += 64)
+    {
+        touch = *p;
+    }
+    (void)touch;
+}
+
+/* Runs in the child, the heap starts empty */
+static void run_pass(pass_t * p_pass)
+{
+    volatile size_t touch = 0;
+
+    // Fault in the trace and the result pages of this child before timing anything
+    for (uint32_t i = 0; i < m_op_count; i++)
+    {
+        touch += m_ops[i].size;
+        p_pass->ns[i] = UINT32_MAX;
+    }
+    memset(m_live, 0, sizeof(m_live));
+
+    warm_up();
+    p_pass->min_ever_free = xPortGetFreeHeapSize();
+
+    for (uint32_t i = 0; i < m_op_count; i++)
+    {
+        const op_t * p_op = &m_ops[i];
+        uint64_t     start;
+
+        if (p_op->type == 'm')
+        {
+            void * ptr;
+
+            if (m_live_count == MAX_LIVE)
+            {
+                fprintf(stderr, "heap_replay: more than %d live allocations\n", MAX_LIVE);
+                exit(1);
+            }
+
+            heap_touch();
+            start = ep_host_now_ns();
+            ptr = pvPortMalloc(p_op->size);
+            p_pass->ns[i] = (uint32_t)(ep_host_now_ns() - start);
+
+            if (ptr == NULL)
+            {
+                p_pass->failed++;
+                continue;
+            }
+            m_live[m_live_count].id  = p_op->id;
+            m_live[m_live_count].ptr = ptr;
+            m_live_count++;
+        }
+        else
+        {
+            int index = live_find(p_op->id);
+
+            if (index < 0)
+            {
+                // Allocation that failed, or was made before the trace started
+                continue;
+            }
+
+            heap_touch();
+            start = ep_host_now_ns();
+            vPortFree(m_live[index].ptr);
+            p_pass->ns[i] = (uint32_t)(ep_host_now_ns() - start);
+
+            m_live[index] = m_live[--m_live_count];
+        }
+
+        if (xPortGetFreeHeapSize() < p_pass->min_ever_free)
+        {
+            p_pass->min_ever_free = xPortGetFreeHeapSize();
+        }
+        sample_fragmentation(p_pass);
+    }
+}
+
+static int compare_u32(const void * a, const void * b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void report(const char * what, char type, const uint32_t * best)
+{
+    static uint32_t samples[MAX_OPS];
+    uint32_t        count = 0;
+
+    for (uint32_t i = 0; i < m_op_count; i++)
+    {
+        if ((m_ops[i].type == type) && (best[i] != UINT32_MAX))
+        {
+            samples[count++] = best[i];
+        }
+    }
+
+    if (count == 0)
+    {
+        printf("  %-12s no calls\n", what);
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), compare_u32);
+    printf("  %-12s %7lu calls, median %4lu ns, p99.9 %5lu ns, max %5lu ns\n", what, (unsigned long)count,
+           (unsigned long)samples[count / 2], (unsigned long)samples[(uint64_t)count * 999 / 1000],
+           (unsigned long)samples[count - 1]);
+}
+
+int main(int argc, char * argv[])
+{
+    size_t     pass_size;
+    uint8_t *  p_shared;
+    pass_t *   p_first;
+    uint32_t * p_best;
+
+    if (argc > 1)
+    {
+        if (load_file(argv[1]) != 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        load_synthetic();
+    }
+
+    pass_size = sizeof(pass_t) + m_op_count * sizeof(uint32_t);
+    p_shared  = mmap(NULL, pass_size * BENCH_PASSES, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p_shared == MAP_FAILED)
+    {
+        perror("mmap");
+        return 1;
+    }
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        int   status;
+        pid_t pid = fork();
+
+        if (pid == 0)
+        {
+            run_pass((pass_t *)(p_shared + pass * pass_size));
+            _exit(0);
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            fprintf(stderr, "heap_replay: pass %lu failed\n", (unsigned long)pass);
+            return 1;
+        }
+    }
+
+    // Fastest time of every call over the passes, the heap state is identical in each pass
+    p_first = (pass_t *)p_shared;
+    p_best  = p_first->ns;
+    for (uint32_t pass = 1; pass < BENCH_PASSES; pass++)
+    {
+        const pass_t * p_pass = (const pass_t *)(p_shared + pass * pass_size);
+
+        for (uint32_t i = 0; i < m_op_count; i++)
+        {
+            if (p_pass->ns[i] < p_best[i])
+            {
+                p_best[i] = p_pass->ns[i];
+            }
+        }
+    }
+
+    printf("%s (%s, %lu entries, %u byte heap)\n", HEAP_NAME, (argc > 1) ? argv[1] : "synthetic trace",
+           (unsigned long)m_op_count, (unsigned)configTOTAL_HEAP_SIZE);
+    report("pvPortMalloc", 'm', p_best);
+    report("vPortFree", 'f', p_best);
+    printf("  failed allocations %lu, minimum free %lu bytes\n", (unsigned long)p_first->failed,
+           (unsigned long)p_first->min_ever_free);
+    printf("  peak fragmentation %.1f %%, peak free blocks %lu\n", p_first->peak_fragmentation * 100.0,
+           (unsigned long)p_first->peak_free_blocks);
+
+    return 0;
+}
@@ -0,0 +1,273 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    log_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Log calls per second of the deferred nrf_log frontend with several
+ * producer threads.
+ *
+ * Built once per frontend mode, see the log_bench target of HOST/Makefile:
+ * - critical: the frontend of the SDK. It only reserves the space of an entry
+ *   in a critical region, and skips entries still in progress when the
+ *   consumer runs in between. A producer that can be preempted by the
+ *   consumer has to make the whole log call in a critical region, so the
+ *   producers and the consumer below do.
+ * - lockfree: NRF_LOG_LOCK_FREE. Producers log without a critical region.
+ *
+ * 1, 2 and 4 producer threads share LOG_BENCH_CALLS calls to NRF_LOG_INFO
+ * with their id and a sequence number, in bursts of BURST_CALLS, while a
+ * consumer thread runs NRF_LOG_PROCESS() into a backend that checks each
+ * producer's sequence. Producers yield between bursts, so the consumer keeps
+ * up. The report gives the time spent in log calls per call, which includes
+ * being preempted by the other producers, and the calls per second of
+ * producer time. The critical region is the mutex of sim/critical_region_host.c.
+ * Calls made while the buffer is full are dropped: the logs the backend misses
+ * must match the dropped count reported by the frontend.
+ *
+ * Built for the POSIX host target only, see the log_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "sdk_common.h"
+#include "app_util_platform.h"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_internal.h"
+#include "nrf_log_backend_interface.h"
+#include "nrf_memobj.h"
+#include "ep_host.h"
+
+#define LOG_BENCH_CALLS     2000000     // Log calls per run, shared by the producers
+#define BURST_CALLS         16          // Calls between two yields of a producer
+#define MAX_PRODUCERS       4
+#define END_MARKER          0xFFFFu     // Producer id of the log closing a run
+
+#if NRF_LOG_LOCK_FREE
+#define MODE_NAME           "lockfree"
+#define BENCH_LOG(id, seq)  NRF_LOG_INFO("producer %u: %u", (id), (seq))
+#else
+#define MODE_NAME           "critical"
+#define BENCH_LOG(id, seq)                                  \
+    do {                                                    \
+        CRITICAL_REGION_ENTER();                            \
+        NRF_LOG_INFO("producer %u: %u", (id), (seq));       \
+        CRITICAL_REGION_EXIT();                             \
+    } while (0)
+#endif
+
+/* Written by the consumer thread only, read once it stopped */
+static uint32_t m_next_seq[MAX_PRODUCERS];
+static uint32_t m_delivered;
+static uint32_t m_reported_dropped;
+static bool     m_dropped_saturated;
+static uint32_t m_errors;
+static bool     m_end_seen;
+
+static volatile bool m_stop;
+static uint32_t      m_calls_per_producer;
+static double        m_call_time[MAX_PRODUCERS];  // Seconds spent in log calls, per producer
+
+static void check_put(nrf_log_backend_t const * p_backend, nrf_log_entry_t * p_msg)
+{
+    nrf_log_header_t header;
+    uint32_t         args[2];
+
+    (void)p_backend;
+    nrf_memobj_read(p_msg, &header, HEADER_SIZE * sizeof(uint32_t), 0);
+
+    m_reported_dropped  += header.dropped;
+    m_dropped_saturated |= (header.dropped == UINT16_MAX);
+
+    if ((header.base.generic.type != HEADER_TYPE_STD) || (header.base.std.nargs != 2))
+    {
+        m_errors++;
+        return;
+    }
+    nrf_memobj_read(p_msg, args, sizeof(args), HEADER_SIZE * sizeof(uint32_t));
+
+    if (args[0] == END_MARKER)
+    {
+        m_end_seen = true;
+    }
+    else if ((args[0] >= MAX_PRODUCERS) || (args[1] < m_next_seq[args[0]]))
+    {
+        // Unknown producer, or a log delivered twice or out of order
+        m_errors++;
+    }
+    else
+    {
+        m_next_seq[args[0]] = args[1] + 1;
+        m_delivered++;
+    }
+}
+
+static void check_flush(nrf_log_backend_t const * p_backend)
+{
+    (void)p_backend;
+}
+
+static void check_panic_set(nrf_log_backend_t const * p_backend)
+{
+    (void)p_backend;
+}
+
+static const nrf_log_backend_api_t m_check_api = {
+    .put       = check_put,
+    .flush     = check_flush,
+    .panic_set = check_panic_set,
+};
+
+NRF_LOG_BACKEND_DEF(m_check_backend, m_check_api, NULL);
+
+static bool process(void)
+{
+    bool more;
+
+#if NRF_LOG_LOCK_FREE
+    more = NRF_LOG_PROCESS();
+#else
+    CRITICAL_REGION_ENTER();
+    more = NRF_LOG_PROCESS();
+    CRITICAL_REGION_EXIT();
+#endif
+    return more;
+}
+
+static void * consumer(void * p_arg)
+{
+    (void)p_arg;
+    while (!m_stop)
+    {
+        if (!process())
+        {
+            sched_yield();
+        }
+    }
+    while (process())
+    {
+    }
+    return NULL;
+}
+
+static void * producer(void * p_arg)
+{
+    uint32_t id   = (uint32_t)(uintptr_t)p_arg;
+    double   time = 0;
+
+    for (uint32_t seq = 0; seq < m_calls_per_producer; )
+    {
+        uint32_t end   = MIN(seq + BURST_CALLS, m_calls_per_producer);
+        uint64_t start = ep_host_now_ns();
+
+        for (; seq < end; seq++)
+        {
+            BENCH_LOG(id, seq);
+        }
+        time += (ep_host_now_ns() - start) * 1e-9;
+        sched_yield();
+    }
+    m_call_time[id] = time;
+    return NULL;
+}
+
+static bool run(uint32_t producers)
+{
+    pthread_t consumer_thread;
+    pthread_t producer_threads[MAX_PRODUCERS];
+    uint32_t  issued;
+    uint32_t  missed;
+    double    call_time = 0;
+    bool      ok;
+
+    memset(m_next_seq, 0, sizeof(m_next_seq));
+    m_delivered          = 0;
+    m_reported_dropped   = 0;
+    m_dropped_saturated  = false;
+    m_errors             = 0;
+    m_end_seen           = false;
+    m_stop               = false;
+    m_calls_per_producer = LOG_BENCH_CALLS / producers;
+    issued               = m_calls_per_producer * producers;
+
+    pthread_create(&consumer_thread, NULL, consumer, NULL);
+
+    for (uint32_t i = 0; i < producers; i++)
+    {
+        pthread_create(&producer_threads[i], NULL, producer, (void *)(uintptr_t)i);
+    }
+    for (uint32_t i = 0; i < producers; i++)
+    {
+        pthread_join(producer_threads[i], NULL);
+        call_time += m_call_time[i];
+    }
+
+    m_stop = true;
+    pthread_join(consumer_thread, NULL);
+
+    // The buffer is empty: this log carries the drops not reported yet
+    BENCH_LOG(END_MARKER, 0);
+    while (process())
+    {
+    }
+
+    missed = issued - m_delivered;
+    ok = m_end_seen && (m_errors == 0) && (m_reported_dropped <= missed) &&
+         (m_dropped_saturated || (m_reported_dropped == missed));
+
+    printf("%-10s %9u %9.1f %10.2f %8.2f%% %9u %s\n", MODE_NAME, producers,
+           call_time / issued * 1e9, issued / call_time / 1e6, 100.0 * missed / issued,
+           m_reported_dropped, ok ? "" : "FAIL");
+    return ok;
+}
+
+int main(void)
+{
+    static const uint32_t producers[] = {1, 2, 4};
+    uint32_t failures = 0;
+
+    if (NRF_LOG_INIT(NULL) != NRF_SUCCESS)
+    {
+        printf("FAIL nrf_log_init\n");
+        return 1;
+    }
+    if (nrf_log_backend_add(&m_check_backend, NRF_LOG_SEVERITY_DEBUG) < 0)
+    {
+        printf("FAIL nrf_log_backend_add\n");
+        return 1;
+    }
+    nrf_log_backend_enable(&m_check_backend);
+
+    printf("nrf_log deferred frontend, %d byte buffer, %d calls of 2 arguments per run\n",
+           NRF_LOG_BUFSIZE, LOG_BENCH_CALLS);
+    printf("%-10s %9s %9s %10s %9s %9s\n", "mode", "producers", "ns/call", "M calls/s",
+           "dropped", "reported");
+    for (uint32_t i = 0; i < ARRAY_SIZE(producers); i++)
+    {
+        failures += run(producers[i]) ? 0 : 1;
+    }
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    memobj_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Cost of building nrf_memobj objects from nrf_balloc chunks.
+ *
+ * For each chunk size an object of OBJECT_SIZE bytes is allocated and freed
+ * BENCH_ROUNDS times, once with one nrf_balloc_alloc()/nrf_balloc_free() per
+ * chunk (the chunk loop nrf_memobj used before nrf_balloc_alloc_n) and once
+ * with nrf_memobj_alloc()/nrf_memobj_free(). The report gives the CPU cycles
+ * per allocated byte (time stamp counter on x86, nanoseconds elsewhere) and
+ * the critical regions entered per object.
+ *
+ * The critical region stand-in below issues a full barrier, roughly the
+ * price of masking interrupts on the target, and counts the entries.
+ *
+ * Built for the POSIX host target only, see the memobj_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "nrf_balloc.h"
+#include "nrf_memobj.h"
+#include "nrf_atomic.h"
+#include "ep_host.h"
+
+#define BENCH_ROUNDS    20000
+#define BENCH_PASSES    5           // Fastest pass is reported
+#define OBJECT_SIZE     1024
+#define POOL_CHUNKS     255
+
+NRF_MEMOBJ_POOL_DEF(m_pool_8, 8, POOL_CHUNKS);
+NRF_MEMOBJ_POOL_DEF(m_pool_16, 16, POOL_CHUNKS);
+NRF_MEMOBJ_POOL_DEF(m_pool_32, 32, POOL_CHUNKS);
+NRF_MEMOBJ_POOL_DEF(m_pool_64, 64, POOL_CHUNKS);
+NRF_MEMOBJ_POOL_DEF(m_pool_128, 128, POOL_CHUNKS);
+
+static const struct {
+    nrf_memobj_pool_t const * p_pool;
+    uint32_t                  chunk_size;
+} m_pools[] = {
+    { &m_pool_8,   8   },
+    { &m_pool_16,  16  },
+    { &m_pool_32,  32  },
+    { &m_pool_64,  64  },
+    { &m_pool_128, 128 },
+};
+
+/* nrf_atomic.c is Cortex-M assembly, nrf_memobj only needs these two */
+uint32_t nrf_atomic_u32_add(nrf_atomic_u32_t * p_data, uint32_t value)
+{
+    return __atomic_add_fetch(p_data, value, __ATOMIC_SEQ_CST);
+}
+
+uint32_t nrf_atomic_u32_sub(nrf_atomic_u32_t * p_data, uint32_t value)
+{
+    return __atomic_sub_fetch(p_data, value, __ATOMIC_SEQ_CST);
+}
+
+static uint64_t now_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();   // x86intrin.h clashes with the CMSIS __I/__O macros
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* One nrf_balloc call per chunk, as nrf_memobj did before the batch API */
+static int per_chunk_round(nrf_balloc_t const * p_pool, uint32_t chunks)
+{
+    void * p_chunks[POOL_CHUNKS];
+
+    for (uint32_t i = 0; i < chunks; i++)
+    {
+        p_chunks[i] = nrf_balloc_alloc(p_pool);
+        if (p_chunks[i] == NULL)
+        {
+            return -1;
+        }
+    }
+    for (uint32_t i = 0; i < chunks; i++)
+    {
+        nrf_balloc_free(p_pool, p_chunks[i]);
+    }
+    return 0;
+}
+
+static int memobj_round(nrf_memobj_pool_t const * p_pool)
+{
+    nrf_memobj_t * p_obj = nrf_memobj_alloc(p_pool, OBJECT_SIZE);
+
+    if (p_obj == NULL)
+    {
+        return -1;
+    }
+    nrf_memobj_free(p_obj);
+    return 0;
+}
+
+static double run(nrf_memobj_pool_t const * p_pool, uint32_t chunks, int batched, double * p_regions)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (int pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        uint64_t regions = ep_host_critical_regions_get();
+        uint64_t start   = now_cycles();
+
+        for (int round = 0; round < BENCH_ROUNDS; round++)
+        {
+            int err = batched ? memobj_round(p_pool) : per_chunk_round(p_pool, chunks);
+
+            if (err != 0)
+            {
+                fprintf(stderr, "memobj_bench: pool exhausted\n");
+                return -1.0;
+            }
+        }
+
+        uint64_t cycles = now_cycles() - start;
+
+        if (cycles < best)
+        {
+            best = cycles;
+        }
+        *p_regions = (double)(ep_host_critical_regions_get() - regions) / BENCH_ROUNDS;
+    }
+
+    return (double)best / ((double)BENCH_ROUNDS * OBJECT_SIZE);
+}
+
+int main(void)
+{
+    printf("nrf_memobj alloc+free of %d byte objects, %s per byte\n", OBJECT_SIZE,
+#if defined(__x86_64__) || defined(__i386__)
+           "TSC cycles"
+#else
+           "ns"
+#endif
+           );
+    printf("%6s %7s | %12s %9s | %12s %9s | %7s\n", "chunk", "chunks",
+           "per chunk", "regions", "batched", "regions", "speedup");
+
+    for (size_t i = 0; i < sizeof(m_pools) / sizeof(m_pools[0]); i++)
+    {
+        nrf_memobj_pool_t const * p_pool = m_pools[i].p_pool;
+        uint32_t chunk_size = m_pools[i].chunk_size;
+        // The head chunk also holds the 4 byte object header
+        uint32_t chunks     = (OBJECT_SIZE + 4 + chunk_size - 1) / chunk_size;
+        double   regions_chunk;
+        double   regions_batch;
+
+        if (nrf_memobj_pool_init(p_pool) != NRF_SUCCESS)
+        {
+            return 1;
+        }
+
+        double per_chunk = run(p_pool, chunks, 0, &regions_chunk);
+        double batched   = run(p_pool, chunks, 1, &regions_batch);
+
+        if ((per_chunk < 0) || (batched < 0))
+        {
+            return 1;
+        }
+
+        printf("%6u %7u | %12.3f %9.0f | %12.3f %9.0f | %6.2fx\n", chunk_size, chunks,
+               per_chunk, regions_chunk, batched, regions_batch, per_chunk / batched);
+    }
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    queue_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Producer/consumer stress test and throughput of nrf_queue, in
+ * NRF_QUEUE_MODE_SPSC and in the critical region mode NRF_QUEUE_MODE_NO_OVERFLOW.
+ *
+ * A producer thread and a consumer thread move QUEUE_BENCH_ELEMENTS elements
+ * through a queue of QUEUE_SIZE elements, an odd size so that the indexes
+ * wrap at every offset. Each element holds a sequence number and a check word
+ * derived from it, so that a lost, repeated, reordered or torn element fails
+ * the run. Two patterns are run per mode:
+ * - single: nrf_queue_push() and nrf_queue_pop(),
+ * - bulk: nrf_queue_push(), nrf_queue_write() and nrf_queue_in() against
+ *   nrf_queue_peek(), nrf_queue_pop(), nrf_queue_read() and nrf_queue_out(),
+ *   with random counts of up to BULK_MAX elements.
+ * A thread that finds the queue full or empty yields. The critical region
+ * is the mutex of sim/critical_region_host.c. On a single core host the threads
+ * interleave where the scheduler preempts them, on more cores they run in
+ * parallel. The report gives the elements per second of each run and the
+ * maximum utilization the queue recorded, and the time of a push and pop pair
+ * in one thread, where the cost of the critical region is not hidden by the
+ * thread switches.
+ *
+ * Built for the POSIX host target only, see the queue_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "sdk_common.h"
+#include "app_util_platform.h"
+#include "nrf_queue.h"
+#include "ep_host.h"
+
+#define QUEUE_BENCH_ELEMENTS    4000000     // Elements per run
+#define QUEUE_SIZE              37
+#define BULK_MAX                8
+#define OP_ROUNDS               2000000     // Push and pop pairs of the one thread timing
+#define OP_PASSES               5           // Fastest pass is reported
+
+typedef struct {
+    uint32_t seq;
+    uint32_t check;
+} element_t;
+
+NRF_QUEUE_DEF(element_t, m_queue_spsc, QUEUE_SIZE, NRF_QUEUE_MODE_SPSC);
+NRF_QUEUE_DEF(element_t, m_queue_critical, QUEUE_SIZE, NRF_QUEUE_MODE_NO_OVERFLOW);
+
+typedef struct {
+    nrf_queue_t const * p_queue;
+    bool                bulk;
+    volatile uint32_t   failures;       // Set by the consumer, stops both threads
+} run_t;
+
+static uint32_t check_word(uint32_t seq)
+{
+    return (seq * 2654435761u) ^ 0xA5A5A5A5u;
+}
+
+static uint32_t rand32(uint32_t * p_seed)
+{
+    // xorshift32, the same sequence on every run
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 17;
+    *p_seed ^= *p_seed << 5;
+    return *p_seed;
+}
+
+static void * producer(void * p_context)
+{
+    run_t const * p_run = p_context;
+    element_t     elements[BULK_MAX];
+    uint32_t      seed  = 1;
+    uint32_t      seq   = 0;
+
+    while ((seq < QUEUE_BENCH_ELEMENTS) && (p_run->failures == 0))
+    {
+        uint32_t op    = p_run->bulk ? rand32(&seed) % 3 : 0;
+        uint32_t count = (op == 0) ? 1 : 1 + rand32(&seed) % BULK_MAX;
+        size_t   done  = 0;
+
+        count = MIN(count, QUEUE_BENCH_ELEMENTS - seq);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            elements[i].seq   = seq + i;
+            elements[i].check = check_word(seq + i);
+        }
+
+        switch (op)
+        {
+            case 0:
+                done = (nrf_queue_push(p_run->p_queue, &elements[0]) == NRF_SUCCESS) ? 1 : 0;
+                break;
+            case 1:
+                done = (nrf_queue_write(p_run->p_queue, elements, count) == NRF_SUCCESS) ? count : 0;
+                break;
+            default:
+                done = nrf_queue_in(p_run->p_queue, elements, count);
+                break;
+        }
+
+        seq += done;
+        if (done == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void * consumer(void * p_context)
+{
+    run_t *   p_run = p_context;
+    element_t elements[BULK_MAX];
+    uint32_t  seed  = 2;
+    uint32_t  seq   = 0;
+
+    while ((seq < QUEUE_BENCH_ELEMENTS) && (p_run->failures == 0))
+    {
+        uint32_t op    = p_run->bulk ? rand32(&seed) % 4 : 0;
+        uint32_t count = (op < 2) ? 1 : 1 + rand32(&seed) % BULK_MAX;
+        size_t   done  = 0;
+
+        switch (op)
+        {
+            case 0:
+                done = (nrf_queue_pop(p_run->p_queue, &elements[0]) == NRF_SUCCESS) ? 1 : 0;
+                break;
+            case 1:
+                // The peeked element must be the one popped next
+                if (nrf_queue_peek(p_run->p_queue, &elements[1]) == NRF_SUCCESS)
+                {
+                    done = (nrf_queue_pop(p_run->p_queue, &elements[0]) == NRF_SUCCESS) ? 1 : 0;
+                    if ((done == 0) || (memcmp(&elements[0], &elements[1], sizeof(element_t)) != 0))
+                    {
+                        printf("FAIL peeked %u, popped %u\n", elements[1].seq, elements[0].seq);
+                        p_run->failures++;
+                    }
+                }
+                break;
+            case 2:
+                done = (nrf_queue_read(p_run->p_queue, elements, count) == NRF_SUCCESS) ? count : 0;
+                break;
+            default:
+                done = nrf_queue_out(p_run->p_queue, elements, count);
+                break;
+        }
+
+        for (uint32_t i = 0; (i < done) && (p_run->failures == 0); i++)
+        {
+            if ((elements[i].seq != seq) || (elements[i].check != check_word(seq)))
+            {
+                printf("FAIL element %u: sequence %u, check %08x\n", seq, elements[i].seq, elements[i].check);
+                p_run->failures++;
+            }
+            seq++;
+        }
+        if (done == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @return double Elements per second
+ */
+static double run(run_t * p_run)
+{
+    pthread_t threads[2];
+    uint64_t  start = ep_host_now_ns();
+
+    nrf_queue_reset(p_run->p_queue);
+    pthread_create(&threads[0], NULL, consumer, p_run);
+    pthread_create(&threads[1], NULL, producer, p_run);
+    pthread_join(threads[1], NULL);
+    pthread_join(threads[0], NULL);
+
+    if ((p_run->failures == 0) && !nrf_queue_is_empty(p_run->p_queue))
+    {
+        printf("FAIL %u elements left in the queue\n", (unsigned)nrf_queue_utilization_get(p_run->p_queue));
+        p_run->failures++;
+    }
+    if (nrf_queue_max_utilization_get(p_run->p_queue) > QUEUE_SIZE)
+    {
+        printf("FAIL maximum utilization %u\n", (unsigned)nrf_queue_max_utilization_get(p_run->p_queue));
+        p_run->failures++;
+    }
+
+    return QUEUE_BENCH_ELEMENTS / ((ep_host_now_ns() - start) * 1e-9);
+}
+
+/**
+ * @return double Time of one nrf_queue_push() and nrf_queue_pop() pair in one thread, in seconds
+ */
+static double op_time(nrf_queue_t const * p_queue)
+{
+    element_t element = {0};
+    double    best    = 0;
+
+    nrf_queue_reset(p_queue);
+    for (uint32_t pass = 0; pass < OP_PASSES; pass++)
+    {
+        uint64_t start = ep_host_now_ns();
+        double time;
+
+        for (uint32_t i = 0; i < OP_ROUNDS; i++)
+        {
+            (void)nrf_queue_push(p_queue, &element);
+            (void)nrf_queue_pop(p_queue, &element);
+        }
+        time = (ep_host_now_ns() - start) * 1e-9 / OP_ROUNDS;
+        best = ((pass == 0) || (time < best)) ? time : best;
+    }
+    return best;
+}
+
+int main(void)
+{
+    static const struct {
+        const char *        name;
+        nrf_queue_t const * p_queue;
+    } modes[] = {
+        {"critical", &m_queue_critical},
+        {"spsc",     &m_queue_spsc},
+    };
+    uint32_t failures = 0;
+
+    printf("nrf_queue, %d elements per run, queue of %d\n", QUEUE_BENCH_ELEMENTS, QUEUE_SIZE);
+    printf("%-10s %-8s %12s %9s\n", "mode", "pattern", "Melem/s", "max util");
+    for (uint32_t bulk = 0; bulk < 2; bulk++)
+    {
+        for (size_t i = 0; i < ARRAY_SIZE(modes); i++)
+        {
+            run_t  run_ctx = {.p_queue = modes[i].p_queue, .bulk = bulk};
+            double rate;
+
+            nrf_queue_max_utilization_reset(modes[i].p_queue);
+            rate = run(&run_ctx);
+            printf("%-10s %-8s %12.2f %9u\n", modes[i].name, bulk ? "bulk" : "single", rate / 1e6,
+                   (unsigned)nrf_queue_max_utilization_get(modes[i].p_queue));
+            failures += run_ctx.failures;
+        }
+    }
+    printf("%-10s %18s\n", "mode", "ns/push+pop");
+    for (size_t i = 0; i < ARRAY_SIZE(modes); i++)
+    {
+        printf("%-10s %18.1f\n", modes[i].name, op_time(modes[i].p_queue) * 1e9);
+    }
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
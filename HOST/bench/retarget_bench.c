@@ -0,0 +1,343 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    retarget_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Transfers, interrupts and CPU time per log line of the retarget _write.
+ *
+ * The real retarget.c writes log lines to a fake libuarte instance, with
+ * the scheduler considered running. nrf_libuarte_async_tx() and
+ * nrf_libuarte_async_txv() start a transfer on a virtual line at 1 Mbaud,
+ * 10 bits per byte, and its TX_DONE interrupt is handled a configurable
+ * latency after the last byte. The handler gives txSemaphore and sets
+ * txDone, as the one of uart_helper does. The FreeRTOS semaphores are
+ * fakes as well: a take that would block runs the pending interrupt, the
+ * time the task would sleep.
+ *
+ * The bytes of a transfer are read when it ends, as the DMA does, so a
+ * buffer written while it is sent shows up as corrupted output. Every byte
+ * on the line is checked against the lines written. The lines are written
+ * with _write, as printf does, and as the three segments of the deferred
+ * logger with retarget_writev().
+ *
+ * Reported per log line: transfers, which are the TX_DONE interrupts of
+ * libuarte, bytes per interrupt, line busy time, and host CPU time in
+ * retarget.c and the fake. The bench is built with
+ * RETARGET_TX_BATCH_ENABLED off and on, see the retarget_bench target of
+ * HOST/Makefile.
+ *
+ * Built for the POSIX host target only, see the retarget_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "sdk_common.h"
+#include "nrf_libuarte_async.h"
+#include "retarget.h"
+#include "ep_host.h"
+
+/* Newlib system call of retarget.c, not declared by retarget.h */
+int _write(int file, const char * p_char, int len);
+
+#define BENCH_LINES         2000
+#define BENCH_PASSES        5           // Fastest pass is reported for the CPU time
+#define LINE_RATE           100000.0    // Bytes per second at 1 Mbaud
+#define LINE_MAX            300
+#define OUTPUT_SIZE         (BENCH_LINES * (LINE_MAX + 16))
+
+#define BENCH_CHECK(_cond)                                  \
+    do {                                                    \
+        if (!(_cond))                                       \
+        {                                                   \
+            printf("%s FAILED\n", #_cond);                  \
+            exit(1);                                        \
+        }                                                   \
+    } while (0)
+
+typedef enum {
+    WRITE_PRINTF,       ///< _write of the whole line
+    WRITE_SEGMENTS,     ///< retarget_writev of prefix, text and suffix
+} write_t;
+
+static const double m_latencies_us[] = {2.0, 10.0};
+
+/* Fake semaphores, a count only */
+typedef struct {
+    UBaseType_t count;
+} fake_semaphore_t;
+
+static fake_semaphore_t m_tx_sem      = {1};
+static fake_semaphore_t m_tx_lock_sem = {1};
+static volatile bool     m_tx_done     = true;
+
+/* Fake libuarte: the transfer on the line, read when it ends */
+static nrf_libuarte_async_ctrl_blk_t m_ctrl_blk;
+static const nrf_libuarte_async_t    m_libuarte = {
+    .p_ctrl_blk = &m_ctrl_blk,
+};
+
+static nrf_libuarte_async_data_t const * m_segments;
+static size_t                            m_segment_cnt;
+static nrf_libuarte_async_data_t         m_single;
+static bool                              m_busy;
+static double                            m_done_at;     // Virtual time of the TX_DONE interrupt
+static double                            m_now;
+static double                            m_line_busy;
+static double                            m_latency_us;
+static uint32_t                          m_transfers;
+static uint32_t                          m_errors;
+
+static uint8_t  m_output[OUTPUT_SIZE];
+static size_t   m_output_len;
+static uint8_t  m_expected[OUTPUT_SIZE];
+static size_t   m_expected_len;
+
+/* Deferred logger segments, in RAM */
+static char     m_prefix[] = "\x1B[0m[INF]";
+static char     m_suffix[] = "\x1B[0m\r\n";
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+    return taskSCHEDULER_RUNNING;
+}
+
+/**
+ * @brief The TX_DONE interrupt: the DMA has read the buffers, uart_helper releases the writer.
+ */
+static void tx_done_isr(void)
+{
+    BENCH_CHECK(m_busy);
+    for (size_t i = 0; i < m_segment_cnt; i++)
+    {
+        size_t n = MIN(m_segments[i].length, OUTPUT_SIZE - m_output_len);
+
+        memcpy(&m_output[m_output_len], m_segments[i].p_data, n);
+        m_output_len += n;
+    }
+    m_now  = MAX(m_now, m_done_at);
+    m_busy = false;
+    m_tx_sem.count++;
+    m_tx_done = true;
+}
+
+BaseType_t xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait)
+{
+    fake_semaphore_t * p_sem = xQueue;
+
+    while (p_sem->count == 0)
+    {
+        // The task would sleep until the interrupt gives the semaphore
+        BENCH_CHECK(m_busy);
+        tx_done_isr();
+    }
+    p_sem->count--;
+    return pdTRUE;
+}
+
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void * const pvItemToQueue,
+                             TickType_t xTicksToWait, const BaseType_t xCopyPosition)
+{
+    ((fake_semaphore_t *)xQueue)->count++;
+    return pdTRUE;
+}
+
+static ret_code_t transfer_start(nrf_libuarte_async_data_t const * p_segments, size_t count)
+{
+    size_t length = 0;
+
+    if (m_busy)
+    {
+        m_errors++;
+        return NRF_ERROR_BUSY;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        length += p_segments[i].length;
+    }
+    m_segments      = p_segments;
+    m_segment_cnt   = count;
+    m_busy          = true;
+    m_done_at       = m_now + length / LINE_RATE * 1e6 + m_latency_us;
+    m_line_busy    += length / LINE_RATE * 1e6;
+    m_transfers++;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
+                                 uint8_t * p_data, size_t length)
+{
+    m_single = (nrf_libuarte_async_data_t){ p_data, length };
+    return transfer_start(&m_single, 1);
+}
+
+ret_code_t nrf_libuarte_async_txv(const nrf_libuarte_async_t * const p_libuarte,
+                                  nrf_libuarte_async_data_t const *  p_segments,
+                                  size_t                             count)
+{
+    return transfer_start(p_segments, count);
+}
+
+/* The text of a log line, up to LINE_MAX bytes, some lines longer than a batch */
+static int line_format(char * p_text, size_t size, uint32_t line)
+{
+    return snprintf(p_text, size, "[%08lu][SensorTask:%lu]: sample %lu, %.*s\r\n",
+                    (unsigned long)line * 7, (unsigned long)(100 + line % 50),
+                    (unsigned long)line * 2654435761u,
+                    (int)((line * 37) % 220),
+                    "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+                    "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"
+                    "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz");
+}
+
+static char m_text[BENCH_LINES][LINE_MAX];
+
+static void run_reset(double latency_us)
+{
+    m_tx_sem.count      = 1;
+    m_tx_lock_sem.count = 1;
+    m_tx_done           = true;
+    m_busy              = false;
+    m_now               = 0;
+    m_line_busy         = 0;
+    m_latency_us        = latency_us;
+    m_transfers         = 0;
+    m_errors            = 0;
+    m_output_len        = 0;
+}
+
+static void expected_add(void const * p_data, size_t length)
+{
+    memcpy(&m_expected[m_expected_len], p_data, length);
+    m_expected_len += length;
+}
+
+static void expected_build(write_t write)
+{
+    m_expected_len = 0;
+    for (uint32_t line = 0; line < BENCH_LINES; line++)
+    {
+        if (write == WRITE_SEGMENTS)
+        {
+            expected_add(m_prefix, sizeof(m_prefix) - 1);
+        }
+        expected_add(m_text[line], strlen(m_text[line]));
+        if (write == WRITE_SEGMENTS)
+        {
+            expected_add(m_suffix, sizeof(m_suffix) - 1);
+        }
+    }
+}
+
+/**
+ * @brief Writes the log lines, and waits for the last transfer as the next write would.
+ * @return double Host nanoseconds for the lines
+ */
+static double lines_write(write_t write)
+{
+    uint64_t start = ep_host_now_ns();
+
+    for (uint32_t line = 0; line < BENCH_LINES; line++)
+    {
+        size_t len = strlen(m_text[line]);
+
+        if (write == WRITE_PRINTF)
+        {
+            BENCH_CHECK(_write(1, m_text[line], (int)len) == (int)len);
+        }
+        else
+        {
+            nrf_libuarte_async_data_t segments[3] = {
+                { (uint8_t *)m_prefix, sizeof(m_prefix) - 1 },
+                { (uint8_t *)m_text[line], len },
+                { (uint8_t *)m_suffix, sizeof(m_suffix) - 1 },
+            };
+
+            BENCH_CHECK(retarget_writev(segments, ARRAY_SIZE(segments)) ==
+                        (int)(len + sizeof(m_prefix) - 1 + sizeof(m_suffix) - 1));
+        }
+    }
+    if (m_busy)
+    {
+        tx_done_isr();
+    }
+    return ep_host_now_ns() - start;
+}
+
+static bool run(write_t write, double latency_us)
+{
+    double   best_ns;
+    double   busy;
+    uint32_t transfers;
+    bool     ok;
+
+    // The first pass is checked, the others only timed
+    run_reset(latency_us);
+    expected_build(write);
+    best_ns   = lines_write(write);
+    transfers = m_transfers;
+    busy      = m_line_busy / m_now * 100;
+    ok = (m_errors == 0) && (m_output_len == m_expected_len) &&
+         (memcmp(m_output, m_expected, m_expected_len) == 0);
+
+    for (uint32_t pass = 1; pass < BENCH_PASSES; pass++)
+    {
+        run_reset(latency_us);
+        best_ns = MIN(best_ns, lines_write(write));
+    }
+
+    printf("%-9s %8.1f %10.2f %10.1f %8.1f %10.1f\n",
+           (write == WRITE_PRINTF) ? "_write" : "writev", latency_us,
+           (double)transfers / BENCH_LINES, (double)m_expected_len / transfers, busy,
+           best_ns / BENCH_LINES);
+    if (!ok)
+    {
+        printf("output FAILED\n");
+    }
+    return ok;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+
+    for (uint32_t line = 0; line < BENCH_LINES; line++)
+    {
+        line_format(m_text[line], LINE_MAX, line);
+    }
+    retarget_init(&m_libuarte, &m_tx_sem, &m_tx_lock_sem, &m_tx_done);
+    printf("retarget, RETARGET_TX_BATCH_ENABLED %d, %d log lines at 1 Mbaud\n",
+           RETARGET_TX_BATCH_ENABLED, BENCH_LINES);
+    printf("%-9s %8s %10s %10s %8s %10s\n", "write", "irq us", "irqs/line", "bytes/irq", "busy %", "ns/line");
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_latencies_us); i++)
+    {
+        failures += run(WRITE_PRINTF, m_latencies_us[i]) ? 0 : 1;
+        failures += run(WRITE_SEGMENTS, m_latencies_us[i]) ? 0 : 1;
+    }
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
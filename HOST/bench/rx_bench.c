@@ -0,0 +1,536 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    rx_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief CPU time per received kilobyte of the debug UART RX path.
+ *
+ * The same traffic is received two ways:
+ * - byte: as uart_helper does, the RX interrupt sends every byte to
+ *   xDebugUartRxQueue and frees the RX buffer, the consumer task receives
+ *   the bytes one xQueueReceive at a time.
+ * - span: uart_rx_spans.c. The interrupt queues a span of the RX buffer, the
+ *   consumer gets it with uart_rx_span_get() and releases it.
+ *
+ * libuarte is simulated: the traffic is copied to a pool of RX buffers, as
+ * the DMA would, and an RX_DATA event is sent when a buffer is full and when
+ * the line goes idle. nrf_libuarte_async_rx_free() counts the released bytes
+ * as libuarte does, and checks that they are released in order. The queues
+ * and the semaphore are the FreeRTOS ones, used before the scheduler starts:
+ * the interrupt handler runs first, then the consumer empties the queue.
+ *
+ * The traffic is synthetic, replayed from a script of three workloads:
+ * - typed: CLI commands typed one key at a time, one event per byte.
+ * - lines: command lines pasted or sent by a host script, an idle gap after
+ *   each line.
+ * - bulk: 4 KB bursts, back to back within a burst.
+ *
+ * Only the interrupt handler and the consumer are timed, the cost of the
+ * clock is subtracted. Every byte delivered is checked against the traffic.
+ * The CPU load is the host time per kilobyte at the 10 bits per byte of
+ * 1 Mbaud, 100000 bytes per second.
+ *
+ * Built for the POSIX host target only, see the rx_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "sdk_common.h"
+#include "nrf_libuarte_async.h"
+#include "uart_rx_spans.h"
+#include "ep_host.h"
+
+#define BENCH_PASSES        5           // Fastest pass is reported
+#define LINE_RATE           100000      // Bytes per second at 1 Mbaud
+
+#define RX_BUF_SIZE         255         // As the libuarte instance of uart_helper
+#define RX_BUF_CNT          3
+#define RX_QUEUE_SIZE       256         // xDebugUartRxQueue of uart_helper
+
+#define TRAFFIC_SIZE        (1024 * 1024)
+#define TYPED_SIZE          (16 * 1024)
+#define BULK_BURST          4096
+#define MAX_CHUNKS          (TRAFFIC_SIZE / 8)
+
+typedef enum
+{
+    MODE_BYTE,  ///< Every byte through xDebugUartRxQueue
+    MODE_SPAN,  ///< uart_rx_spans.c
+} mode_t;
+
+typedef enum
+{
+    WORKLOAD_TYPED,
+    WORKLOAD_LINES,
+    WORKLOAD_BULK,
+} workload_t;
+
+static char const * m_workload_names[] = {"typed", "lines", "bulk"};
+
+static char const * m_commands[] = {
+    "help",
+    "log enable info app",
+    "log status",
+    "fds write 0x1111 0x2222 sensor-calibration",
+    "stats",
+    "history",
+    "gpio set 13 1",
+    "i2c read 0x76 0xd0 1",
+    "spi xfer 0 9f 00 00 00",
+    "flash erase 0x000f4000 4096",
+};
+
+/* Traffic script: chunks received back to back, each followed by an idle line */
+static uint8_t      m_traffic[TRAFFIC_SIZE];
+static size_t       m_traffic_len;
+static size_t       m_chunks[MAX_CHUNKS];
+static uint32_t     m_chunk_cnt;
+
+/* Simulated libuarte instance */
+static uint8_t      m_pool[RX_BUF_CNT][RX_BUF_SIZE];
+static uint8_t    * m_free_bufs[RX_BUF_CNT];    // LIFO, as nrf_balloc
+static uint32_t     m_free_cnt;
+static nrf_libuarte_async_ctrl_blk_t m_ctrl_blk;
+static uint8_t      m_pool_stack[RX_BUF_CNT];   // Only its size is used, by uart_rx_spans_init()
+static const nrf_balloc_t m_rx_pool = {
+    .p_stack_base  = m_pool_stack,
+    .p_stack_limit = m_pool_stack + RX_BUF_CNT,
+};
+static nrf_libuarte_async_t m_libuarte = {
+    .p_ctrl_blk  = &m_ctrl_blk,
+    .p_rx_pool   = &m_rx_pool,
+    .rx_buf_size = RX_BUF_SIZE,
+};
+static nrf_libuarte_async_evt_handler_t m_rx_handler;
+static void       * m_rx_context;
+
+static uint8_t    * m_dma_buf;          // Buffer the DMA writes to
+static uint8_t    * m_dma_next;         // Buffer scheduled next, NULL when halted
+static size_t       m_dma_pos;
+static size_t       m_dma_reported;
+static uint8_t    * m_dma_order[RX_BUF_CNT];    // Buffers not freed yet, in the order they were written
+static uint32_t     m_dma_order_head;
+static uint32_t     m_dma_order_cnt;
+
+/* Set by uart_helper through retarget_init() */
+nrf_libuarte_async_t * debug_uart = &m_libuarte;
+
+QueueHandle_t xDebugUartRxQueue;
+
+/* Results of a run */
+static size_t       m_rx_pos;           // Bytes delivered to the consumer
+static uint32_t     m_errors;
+static uint32_t     m_events;
+static uint32_t     m_isr_ops;          // FreeRTOS calls in the interrupt
+static uint32_t     m_task_ops;         // FreeRTOS calls of the consumer
+static uint32_t     m_spans;
+static double       m_isr_ns;
+static double       m_task_ns;
+static double       m_clock_ns;         // Cost of a timed call with nothing in it
+static uint32_t     m_consumer_period;  // Events between two runs of the consumer
+
+static mode_t       m_mode;
+
+static uint8_t * buf_alloc(void)
+{
+    if (m_free_cnt == 0)
+    {
+        return NULL;
+    }
+    m_ctrl_blk.alloc_cnt++;
+    return m_free_bufs[--m_free_cnt];
+}
+
+void nrf_libuarte_async_rx_handler_set(const nrf_libuarte_async_t * const p_libuarte,
+                                       nrf_libuarte_async_evt_handler_t   rx_handler,
+                                       void *                             context)
+{
+    (void)p_libuarte;
+    m_rx_handler = rx_handler;
+    m_rx_context = context;
+}
+
+/**
+ * @brief Counts the released bytes as libuarte does, and frees a buffer once all of it is.
+ */
+void nrf_libuarte_async_rx_free(const nrf_libuarte_async_t * const p_libuarte, uint8_t * p_data, size_t length)
+{
+    if ((m_dma_order_cnt == 0) ||
+        (p_data != &m_dma_order[m_dma_order_head][p_libuarte->p_ctrl_blk->rx_free_cnt]))
+    {
+        m_errors++;
+        return;
+    }
+
+    p_libuarte->p_ctrl_blk->rx_free_cnt += length;
+    if (p_libuarte->p_ctrl_blk->rx_free_cnt >= p_libuarte->rx_buf_size)
+    {
+        p_data -= (p_libuarte->p_ctrl_blk->rx_free_cnt - length);
+        if (p_libuarte->p_ctrl_blk->rx_free_cnt > p_libuarte->rx_buf_size)
+        {
+            m_errors++;
+        }
+        m_dma_order_head = (m_dma_order_head + 1) % RX_BUF_CNT;
+        m_dma_order_cnt--;
+        p_libuarte->p_ctrl_blk->rx_free_cnt = 0;
+        p_libuarte->p_ctrl_blk->alloc_cnt--;
+        m_free_bufs[m_free_cnt++] = p_data;
+
+        if (m_dma_next == NULL)
+        {
+            // Halted, the buffer is scheduled right away
+            m_dma_next = buf_alloc();
+        }
+    }
+}
+
+/**
+ * @brief The RX_DATA handler of uart_helper: every byte to xDebugUartRxQueue.
+ */
+static void dma_buf_start(uint8_t * p_buf)
+{
+    m_dma_buf      = p_buf;
+    m_dma_pos      = 0;
+    m_dma_reported = 0;
+    m_dma_order[(m_dma_order_head + m_dma_order_cnt++) % RX_BUF_CNT] = p_buf;
+}
+
+static void byte_rx_handler(void * context, nrf_libuarte_async_evt_t * p_evt)
+{
+    BaseType_t woken = pdFALSE;
+
+    for (size_t i = 0; i < p_evt->data.rxtx.length; i++)
+    {
+        if (xQueueSendFromISR(xDebugUartRxQueue, &p_evt->data.rxtx.p_data[i], &woken) != pdTRUE)
+        {
+            m_errors++;
+        }
+    }
+    m_isr_ops += p_evt->data.rxtx.length;
+    nrf_libuarte_async_rx_free(debug_uart, p_evt->data.rxtx.p_data, p_evt->data.rxtx.length);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void byte_consume(void)
+{
+    char c;
+
+    for (;;)
+    {
+        m_task_ops++;
+        if (xQueueReceive(xDebugUartRxQueue, &c, 0) != pdTRUE)
+        {
+            break;
+        }
+        if ((m_rx_pos >= m_traffic_len) || ((uint8_t)c != m_traffic[m_rx_pos]))
+        {
+            m_errors++;
+        }
+        m_rx_pos++;
+    }
+}
+
+static void span_consume(void)
+{
+    uart_rx_span_t span;
+
+    for (;;)
+    {
+        m_task_ops++;
+        if (!uart_rx_span_get(&span, 0))
+        {
+            break;
+        }
+        if ((m_rx_pos + span.length > m_traffic_len) ||
+            (memcmp(span.p_data, &m_traffic[m_rx_pos], span.length) != 0))
+        {
+            m_errors++;
+        }
+        m_rx_pos += span.length;
+        m_spans++;
+        uart_rx_span_release(&span);
+    }
+}
+
+static void consumer_run(void)
+{
+    uint64_t start = ep_host_now_ns();
+
+    if (m_mode == MODE_BYTE)
+    {
+        byte_consume();
+    }
+    else
+    {
+        span_consume();
+    }
+    m_task_ns += ep_host_now_ns() - start - m_clock_ns;
+}
+
+/**
+ * @brief Sends the bytes received since the last event, from the RX interrupt.
+ */
+static void rx_event_send(void)
+{
+    nrf_libuarte_async_evt_t evt = {
+        .type = NRF_LIBUARTE_ASYNC_EVT_RX_DATA,
+        .data.rxtx = {
+            .p_data = &m_dma_buf[m_dma_reported],
+            .length = m_dma_pos - m_dma_reported,
+        },
+    };
+    uint64_t start;
+
+    m_dma_reported = m_dma_pos;
+    m_events++;
+    if (m_mode == MODE_SPAN)
+    {
+        m_isr_ops++;    // xSemaphoreGiveFromISR
+    }
+
+    start = ep_host_now_ns();
+    m_rx_handler(m_rx_context, &evt);
+    m_isr_ns += ep_host_now_ns() - start - m_clock_ns;
+
+    if (m_events % m_consumer_period == 0)
+    {
+        consumer_run();
+    }
+}
+
+/**
+ * @brief Receives a chunk of traffic, then the line goes idle.
+ */
+static void dma_receive(uint8_t const * p_data, size_t length)
+{
+    while (length > 0)
+    {
+        size_t n = MIN(length, RX_BUF_SIZE - m_dma_pos);
+
+        memcpy(&m_dma_buf[m_dma_pos], p_data, n);
+        m_dma_pos += n;
+        p_data    += n;
+        length    -= n;
+
+        if (m_dma_pos == RX_BUF_SIZE)
+        {
+            rx_event_send();
+            if (m_dma_next == NULL)
+            {
+                // Overrun, no buffer to receive the next byte
+                m_errors++;
+                return;
+            }
+            dma_buf_start(m_dma_next);
+            m_dma_next = buf_alloc();
+        }
+    }
+    if (m_dma_pos > m_dma_reported)
+    {
+        rx_event_send();
+    }
+}
+
+static void rx_init(void)
+{
+    memset(&m_ctrl_blk, 0, sizeof(m_ctrl_blk));
+    for (m_free_cnt = 0; m_free_cnt < RX_BUF_CNT; m_free_cnt++)
+    {
+        // The first buffers taken follow each other in memory
+        m_free_bufs[m_free_cnt] = m_pool[RX_BUF_CNT - 1 - m_free_cnt];
+    }
+    m_dma_order_head = 0;
+    m_dma_order_cnt  = 0;
+    dma_buf_start(buf_alloc());
+    m_dma_next       = buf_alloc();
+    xQueueReset(xDebugUartRxQueue);
+}
+
+static void traffic_add(char const * p_data, size_t length)
+{
+    memcpy(&m_traffic[m_traffic_len], p_data, length);
+    m_traffic_len += length;
+    m_chunks[m_chunk_cnt++] = length;
+}
+
+static void traffic_generate(workload_t workload)
+{
+    char     line[128];
+    uint32_t i = 0;
+
+    m_traffic_len = 0;
+    m_chunk_cnt   = 0;
+
+    switch (workload)
+    {
+        case WORKLOAD_TYPED:
+            while (m_traffic_len + sizeof(line) < TYPED_SIZE)
+            {
+                int n = snprintf(line, sizeof(line), "%s\r", m_commands[i++ % ARRAY_SIZE(m_commands)]);
+
+                for (int k = 0; k < n; k++)
+                {
+                    traffic_add(&line[k], 1);
+                }
+            }
+            break;
+
+        case WORKLOAD_LINES:
+            while (m_traffic_len + sizeof(line) < TRAFFIC_SIZE)
+            {
+                int n = snprintf(line, sizeof(line), "%s %u\r\n", m_commands[i % ARRAY_SIZE(m_commands)],
+                                 i * 2654435761u);
+
+                traffic_add(line, n);
+                i++;
+            }
+            break;
+
+        default:
+            while (m_traffic_len + BULK_BURST <= TRAFFIC_SIZE)
+            {
+                for (size_t k = 0; k < BULK_BURST; k++)
+                {
+                    m_traffic[m_traffic_len + k] = (uint8_t)((i * 2654435761u) >> 24);
+                    i++;
+                }
+                m_traffic_len += BULK_BURST;
+                m_chunks[m_chunk_cnt++] = BULK_BURST;
+            }
+            break;
+    }
+}
+
+static void replay(mode_t mode, uint32_t consumer_period)
+{
+    size_t offset = 0;
+
+    m_mode            = mode;
+    m_consumer_period = consumer_period;
+    m_rx_handler      = byte_rx_handler;
+    m_rx_context      = NULL;
+    m_rx_pos          = 0;
+    m_errors          = 0;
+    m_events          = 0;
+    m_isr_ops         = 0;
+    m_task_ops        = 0;
+    m_spans           = 0;
+    m_isr_ns          = 0;
+    m_task_ns         = 0;
+
+    rx_init();
+    if ((mode == MODE_SPAN) && !uart_rx_spans_init())
+    {
+        m_errors++;
+        return;
+    }
+
+    for (uint32_t i = 0; (i < m_chunk_cnt) && (m_errors == 0); i++)
+    {
+        dma_receive(&m_traffic[offset], m_chunks[i]);
+        offset += m_chunks[i];
+    }
+    consumer_run();
+
+    if (m_rx_pos != m_traffic_len)
+    {
+        m_errors++;
+    }
+}
+
+static bool run(workload_t workload, mode_t mode)
+{
+    double   best_isr  = 0;
+    double   best_task = 0;
+    double   kib;
+    double   ns_per_kib;
+    bool     ok        = true;
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        replay(mode, 1);
+        ok = ok && (m_errors == 0);
+        if ((pass == 0) || (m_isr_ns + m_task_ns < best_isr + best_task))
+        {
+            best_isr  = m_isr_ns;
+            best_task = m_task_ns;
+        }
+    }
+
+    kib        = m_traffic_len / 1024.0;
+    ns_per_kib = (best_isr + best_task) / kib;
+    printf("%-6s %-5s %9.1f %9.1f %9.1f %9.0f %9.0f %9.0f %7.2f %s\n", m_workload_names[workload],
+           (mode == MODE_BYTE) ? "byte" : "span", m_events / kib, m_isr_ops / kib, m_task_ops / kib,
+           best_isr / kib, best_task / kib, ns_per_kib, ns_per_kib * LINE_RATE / 1024 / 1e9 * 100,
+           ok ? "" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief Lets the consumer run every few events only: the spans queued meanwhile are merged,
+ * also across two RX buffers that follow each other in memory.
+ */
+static bool coalesce_check(void)
+{
+    bool ok;
+
+    traffic_generate(WORKLOAD_LINES);
+    replay(MODE_SPAN, 3);
+    ok = (m_errors == 0) && (m_spans < m_events);
+    printf("span consumer every 3 events: %u events, %u spans %s\n", (unsigned)m_events,
+           (unsigned)m_spans, ok ? "" : "FAIL");
+    return ok;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+
+    xDebugUartRxQueue = xQueueCreate(RX_QUEUE_SIZE, sizeof(char));
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        uint64_t start = ep_host_now_ns();
+        m_clock_ns  += ep_host_now_ns() - start;
+    }
+    m_clock_ns /= 1000;
+
+    printf("debug UART RX, %u buffers of %u bytes, per KiB received, synthetic traffic\n",
+           RX_BUF_CNT, RX_BUF_SIZE);
+    printf("%-6s %-5s %9s %9s %9s %9s %9s %9s %7s\n", "load", "mode", "events", "isr ops",
+           "task ops", "isr ns", "task ns", "total ns", "%1Mbd");
+    for (workload_t workload = WORKLOAD_TYPED; workload <= WORKLOAD_BULK; workload++)
+    {
+        traffic_generate(workload);
+        failures += run(workload, MODE_BYTE) ? 0 : 1;
+        failures += run(workload, MODE_SPAN) ? 0 : 1;
+    }
+    failures += coalesce_check() ? 0 : 1;
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
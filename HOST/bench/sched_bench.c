@@ -0,0 +1,271 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    sched_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Events per second and high-priority dispatch latency of app_scheduler.
+ *
+ * Built once per scheduler mode, see the sched_bench target of HOST/Makefile:
+ * the FIFO of the SDK and APP_SCHEDULER_WITH_PRIORITIES.
+ *
+ * - capacity: events of 4 to 32 bytes queued before NO_MEM, at all priority
+ *   levels, per KB of buffer.
+ * - throughput: events put and executed per second, in bursts of 32.
+ * - latency: a backlog of low-priority events, each taking about WORK_NS to
+ *   handle, keeps the queue full. Every 16th low-priority handler puts an
+ *   urgent event, as an interrupt would, timed until its handler runs. In
+ *   the FIFO it waits behind the backlog.
+ * - drain (priorities only): events of one handler executed one by one with
+ *   app_sched_execute() and in bulk with app_sched_drain(). The handler has
+ *   a fixed cost of CALL_NS per call, e.g. for starting a transfer.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "app_scheduler.h"
+#include "ep_host.h"
+
+#define EVENT_SIZE      32
+#define QUEUE_SIZE      64
+#define BENCH_EVENTS    200000
+#define LATENCY_EVENTS  20000
+#define URGENT_EVERY    16
+#define WORK_NS         200
+#define CALL_NS         100
+
+#if APP_SCHEDULER_WITH_PRIORITIES
+#define MODE_NAME       "priorities"
+#define PUT_URGENT(p_data, size, handler) \
+    app_sched_event_put_prio((p_data), (size), (handler), APP_SCHED_PRIORITY_HIGHEST)
+#else
+#define MODE_NAME       "fifo"
+#define PUT_URGENT(p_data, size, handler) \
+    app_sched_event_put((p_data), (size), (handler))
+#endif
+
+static uint64_t m_buffer[CEIL_DIV(APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE), sizeof(uint64_t))];
+static uint32_t m_executed;
+static uint32_t m_low_left;
+static uint32_t m_urgent_count;
+static uint64_t m_urgent_total;
+static uint64_t m_urgent_max;
+
+static void work(uint64_t ns)
+{
+    uint64_t end = ep_host_now_ns() + ns;
+
+    while (ep_host_now_ns() < end)
+    {
+    }
+}
+
+static void init(void)
+{
+    if (app_sched_init(EVENT_SIZE, QUEUE_SIZE, m_buffer) != NRF_SUCCESS)
+    {
+        fprintf(stderr, "sched_bench: app_sched_init failed\n");
+    }
+}
+
+static uint16_t event_size(uint32_t i)
+{
+    return 4 + (uint16_t)((i * 7) % (EVENT_SIZE - 3));
+}
+
+static void count_handler(void * p_event_data, uint16_t event_size)
+{
+    (void)p_event_data;
+    (void)event_size;
+    m_executed++;
+}
+
+static uint32_t capacity(void)
+{
+    uint8_t  data[EVENT_SIZE] = { 0 };
+    uint32_t count = 0;
+
+    init();
+#if APP_SCHEDULER_WITH_PRIORITIES
+    for (uint8_t priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        while (app_sched_event_put_prio(data, event_size(count), count_handler, priority) ==
+               NRF_SUCCESS)
+        {
+            count++;
+        }
+    }
+#else
+    while (app_sched_event_put(data, event_size(count), count_handler) == NRF_SUCCESS)
+    {
+        count++;
+    }
+#endif
+    app_sched_execute();
+
+    return count;
+}
+
+static double throughput(void)
+{
+    uint8_t  data[EVENT_SIZE] = { 0 };
+    uint64_t start;
+
+    init();
+    m_executed = 0;
+    start      = ep_host_now_ns();
+    for (uint32_t i = 0; i < BENCH_EVENTS; i += 32)
+    {
+        for (uint32_t j = 0; j < 32; j++)
+        {
+            data[0] = (uint8_t)j;
+            (void)app_sched_event_put(data, event_size(i + j), count_handler);
+        }
+        app_sched_execute();
+    }
+
+    return (double)m_executed * 1e9 / (double)(ep_host_now_ns() - start);
+}
+
+static void urgent_handler(void * p_event_data, uint16_t event_size)
+{
+    uint64_t put_time;
+    uint64_t latency;
+
+    (void)event_size;
+    memcpy(&put_time, p_event_data, sizeof(put_time));
+    latency = ep_host_now_ns() - put_time;
+
+    m_urgent_count++;
+    m_urgent_total += latency;
+    if (latency > m_urgent_max)
+    {
+        m_urgent_max = latency;
+    }
+}
+
+static void low_handler(void * p_event_data, uint16_t event_size)
+{
+    uint8_t data[EVENT_SIZE];
+
+    memcpy(data, p_event_data, event_size);
+    work(WORK_NS);
+    m_executed++;
+
+    if ((m_executed % URGENT_EVERY) == 0)
+    {
+        uint64_t put_time = ep_host_now_ns();
+
+        (void)PUT_URGENT(&put_time, sizeof(put_time), urgent_handler);
+    }
+
+    // Keep the backlog, leaving room for the urgent events
+    if ((m_low_left > 0) && (app_sched_queue_space_get() > 2))
+    {
+        m_low_left--;
+        (void)app_sched_event_put(data, event_size, low_handler);
+    }
+}
+
+static void latency(void)
+{
+    uint8_t data[EVENT_SIZE] = { 0 };
+
+    init();
+    m_executed     = 0;
+    m_urgent_count = 0;
+    m_urgent_total = 0;
+    m_urgent_max   = 0;
+    m_low_left     = LATENCY_EVENTS;
+
+    while ((m_low_left > 0) && (app_sched_queue_space_get() > 2))
+    {
+        m_low_left--;
+        (void)app_sched_event_put(data, event_size(m_low_left), low_handler);
+    }
+    app_sched_execute();
+
+    printf("%-14s %8u events, mean %8.1f us, worst %8.1f us\n", "urgent latency", m_urgent_count,
+           m_urgent_count ? (double)m_urgent_total / m_urgent_count / 1e3 : 0.0,
+           (double)m_urgent_max / 1e3);
+}
+
+#if APP_SCHEDULER_WITH_PRIORITIES
+static void call_handler(void * p_event_data, uint16_t event_size)
+{
+    (void)p_event_data;
+    (void)event_size;
+    work(CALL_NS);
+    m_executed++;
+}
+
+static void bulk_handler(app_sched_event_t const * p_events, uint16_t count)
+{
+    (void)p_events;
+    work(CALL_NS);
+    m_executed += count;
+}
+
+static double drain(int bulk)
+{
+    uint8_t  data[EVENT_SIZE] = { 0 };
+    uint64_t start;
+
+    init();
+    m_executed = 0;
+    start      = ep_host_now_ns();
+    for (uint32_t i = 0; i < BENCH_EVENTS; i += QUEUE_SIZE)
+    {
+        for (uint32_t j = 0; j < QUEUE_SIZE; j++)
+        {
+            (void)app_sched_event_put(data, 8, call_handler);
+        }
+        if (bulk)
+        {
+            (void)app_sched_drain(call_handler, bulk_handler);
+        }
+        else
+        {
+            app_sched_execute();
+        }
+    }
+
+    return (double)m_executed * 1e9 / (double)(ep_host_now_ns() - start);
+}
+#endif
+
+int main(void)
+{
+    uint32_t events = capacity();
+
+    printf("app_scheduler %s, %u byte buffer for %d events of up to %d bytes\n", MODE_NAME,
+           (unsigned)sizeof(m_buffer), QUEUE_SIZE, EVENT_SIZE);
+    printf("%-14s %8u events of 4-%d bytes, %.1f per KB\n", "capacity", events, EVENT_SIZE,
+           events * 1024.0 / sizeof(m_buffer));
+    printf("%-14s %8.2f M events/s\n", "throughput", throughput() / 1e6);
+    latency();
+#if APP_SCHEDULER_WITH_PRIORITIES
+    printf("%-14s %8.2f M events/s one by one, %.2f M events/s with app_sched_drain\n",
+           "drain", drain(0) / 1e6, drain(1) / 1e6);
+#endif
+    printf("\n");
+
+    return 0;
+}
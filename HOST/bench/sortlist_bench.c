@@ -0,0 +1,342 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    sortlist_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief nrf_sortlist pairing heap checked against the linked list, and their scaling.
+ *
+ * This file is built with NRF_SORTLIST_CONFIG_HEAP=1 and linked with both builds
+ * of nrf_sortlist.c. The linked list build has its functions renamed with a
+ * list_ prefix, see the sortlist_bench target of HOST/Makefile. It only uses
+ * p_next, the first member of the item in both builds.
+ *
+ * - random test: random adds, pops and removes, with many equal keys, applied
+ *   to both. The heads must have the same key after every step. Equal keys
+ *   may pop in a different order, so the item popped from the heap is removed
+ *   from the list. Removing an entry from a third list it is not in must
+ *   fail and leave both lists as they are.
+ * - scaling: n deadlines, then pops of the earliest deadline, each followed by
+ *   an add of a later one, as app_timer does for repeating timers. Then n
+ *   deadlines added in increasing order, and removes of a random one, each
+ *   followed by an add after all others, as app_timer_stop() and
+ *   app_timer_start() do. Reported in nanoseconds per pair of operations.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sdk_common.h"
+#include "nrf_sortlist.h"
+#include "ep_host.h"
+
+#define TEST_STEPS      200000
+#define TEST_ITEMS      512
+#define TEST_KEYS       64          // Few distinct keys, so there are many ties
+#define SCALE_MAX       10000
+
+void                        list_nrf_sortlist_add(nrf_sortlist_t const * p_list, nrf_sortlist_item_t * p_item);
+nrf_sortlist_item_t       * list_nrf_sortlist_pop(nrf_sortlist_t const * p_list);
+nrf_sortlist_item_t const * list_nrf_sortlist_peek(nrf_sortlist_t const * p_list);
+nrf_sortlist_item_t const * list_nrf_sortlist_next(nrf_sortlist_item_t const * p_item);
+bool                        list_nrf_sortlist_remove(nrf_sortlist_t const * p_list, nrf_sortlist_item_t * p_item);
+
+typedef struct {
+    uint32_t            key;
+    bool                queued;
+    nrf_sortlist_item_t heap_item;
+    nrf_sortlist_item_t list_item;
+} entry_t;
+
+static bool heap_compare(nrf_sortlist_item_t * p_item0, nrf_sortlist_item_t * p_item1)
+{
+    return (CONTAINER_OF(p_item0, entry_t, heap_item))->key <=
+           (CONTAINER_OF(p_item1, entry_t, heap_item))->key;
+}
+
+static bool list_compare(nrf_sortlist_item_t * p_item0, nrf_sortlist_item_t * p_item1)
+{
+    return (CONTAINER_OF(p_item0, entry_t, list_item))->key <=
+           (CONTAINER_OF(p_item1, entry_t, list_item))->key;
+}
+
+NRF_SORTLIST_DEF(m_heap, heap_compare);
+NRF_SORTLIST_DEF(m_list, list_compare);
+NRF_SORTLIST_DEF(m_other, heap_compare);
+
+static entry_t  m_entries[SCALE_MAX];
+static entry_t  m_other_entries[8];
+static uint32_t m_seed = 1;
+static int      m_failures;
+
+static uint32_t rand32(void)
+{
+    // xorshift32, the same sequence on every run
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return m_seed;
+}
+
+static void fail(uint32_t step, const char * p_what)
+{
+    if (m_failures++ < 10)
+    {
+        printf("FAIL step %u: %s\n", step, p_what);
+    }
+}
+
+static uint32_t head_key(nrf_sortlist_item_t const * p_item, int heap)
+{
+    return heap ? (CONTAINER_OF(p_item, entry_t, heap_item))->key :
+                  (CONTAINER_OF(p_item, entry_t, list_item))->key;
+}
+
+static void check_heads(uint32_t step, uint32_t queued)
+{
+    nrf_sortlist_item_t const * p_heap = nrf_sortlist_peek(&m_heap);
+    nrf_sortlist_item_t const * p_list = list_nrf_sortlist_peek(&m_list);
+    uint32_t                    count  = 0;
+
+    if ((p_heap == NULL) != (p_list == NULL))
+    {
+        fail(step, "one of the heads is NULL");
+        return;
+    }
+    if ((p_heap != NULL) && (head_key(p_heap, 1) != head_key(p_list, 0)))
+    {
+        fail(step, "head keys differ");
+    }
+
+    // Every 64 steps, every item must be visited once and none comes before the head
+    if ((step % 64) == 0)
+    {
+        for (nrf_sortlist_item_t const * p_item = p_heap;
+             p_item != NULL;
+             p_item = nrf_sortlist_next(p_item))
+        {
+            if (head_key(p_item, 1) < head_key(p_heap, 1))
+            {
+                fail(step, "item before the head");
+            }
+            count++;
+        }
+        if (count != queued)
+        {
+            fail(step, "nrf_sortlist_next does not visit every item");
+        }
+    }
+}
+
+static void random_test(void)
+{
+    uint32_t queued = 0;
+    uint32_t other  = 0;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_other_entries); i++)
+    {
+        m_other_entries[i].key = rand32() % TEST_KEYS;
+        nrf_sortlist_add(&m_other, &m_other_entries[i].heap_item);
+    }
+
+    for (uint32_t step = 0; step < TEST_STEPS; step++)
+    {
+        uint32_t op      = rand32() % 8;
+        entry_t * p_entry = &m_entries[rand32() % TEST_ITEMS];
+
+        if (op < 4)
+        {
+            // Add, or move a queued entry to a new key like a restarted timer
+            if (p_entry->queued)
+            {
+                bool in_heap = nrf_sortlist_remove(&m_heap, &p_entry->heap_item);
+                bool in_list = list_nrf_sortlist_remove(&m_list, &p_entry->list_item);
+
+                if (!in_heap || !in_list)
+                {
+                    fail(step, "queued entry not found");
+                }
+                queued--;
+            }
+            p_entry->key    = rand32() % TEST_KEYS;
+            p_entry->queued = true;
+            nrf_sortlist_add(&m_heap, &p_entry->heap_item);
+            list_nrf_sortlist_add(&m_list, &p_entry->list_item);
+            queued++;
+        }
+        else if (op < 6)
+        {
+            nrf_sortlist_item_t const * p_list_head = list_nrf_sortlist_peek(&m_list);
+            nrf_sortlist_item_t       * p_popped    = nrf_sortlist_pop(&m_heap);
+
+            if (p_popped == NULL)
+            {
+                if (p_list_head != NULL)
+                {
+                    fail(step, "heap empty, list not");
+                }
+                continue;
+            }
+
+            entry_t * p_popped_entry = CONTAINER_OF(p_popped, entry_t, heap_item);
+
+            if ((p_list_head == NULL) || (head_key(p_list_head, 0) != p_popped_entry->key))
+            {
+                fail(step, "popped key is not the list head key");
+            }
+            if (!list_nrf_sortlist_remove(&m_list, &p_popped_entry->list_item))
+            {
+                fail(step, "popped entry not in the list");
+            }
+            p_popped_entry->queued = false;
+            queued--;
+        }
+        else
+        {
+            // Remove, also of entries that are not queued, after a try on the wrong list
+            if (nrf_sortlist_remove(&m_other, &p_entry->heap_item))
+            {
+                fail(step, "removed from a list it is not in");
+            }
+
+            bool in_heap = nrf_sortlist_remove(&m_heap, &p_entry->heap_item);
+            bool in_list = list_nrf_sortlist_remove(&m_list, &p_entry->list_item);
+
+            if ((in_heap != in_list) || (in_heap != p_entry->queued))
+            {
+                fail(step, "remove results differ");
+            }
+            if (p_entry->queued)
+            {
+                p_entry->queued = false;
+                queued--;
+            }
+        }
+
+        check_heads(step, queued);
+    }
+
+    for (nrf_sortlist_item_t const * p_item = nrf_sortlist_peek(&m_other);
+         p_item != NULL;
+         p_item = nrf_sortlist_next(p_item))
+    {
+        other++;
+    }
+    if (other != ARRAY_SIZE(m_other_entries))
+    {
+        fail(TEST_STEPS, "the wrong list lost items");
+    }
+
+    printf("random test, %d steps: %s\n", TEST_STEPS, m_failures ? "FAILED" : "passed");
+}
+
+static void scale_add(entry_t * p_entry, int heap)
+{
+    if (heap)
+    {
+        nrf_sortlist_add(&m_heap, &p_entry->heap_item);
+    }
+    else
+    {
+        list_nrf_sortlist_add(&m_list, &p_entry->list_item);
+    }
+}
+
+/**
+ * @brief Times n deadlines in one list.
+ *
+ * @param n      Deadlines in the list.
+ * @param heap   1 for the pairing heap, 0 for the linked list.
+ * @param stop   0: pop of the earliest deadline and add of a later one, random deadlines.
+ *               1: remove of a random entry and add of a deadline after all others, deadlines
+ *               added in increasing order. app_timer_stop() and app_timer_start() on timers
+ *               started one after the other, which leaves one heap root with n children.
+ *
+ * @return double Nanoseconds per pair of operations
+ */
+static double scale(uint32_t n, int heap, int stop)
+{
+    nrf_sortlist_t const * p_list = heap ? &m_heap : &m_list;
+    uint32_t               ops    = 20000;
+    uint32_t               key    = 0;
+    uint64_t               start;
+
+    while ((heap ? nrf_sortlist_pop(p_list) : list_nrf_sortlist_pop(p_list)) != NULL)
+    {
+    }
+    for (uint32_t i = 0; i < SCALE_MAX; i++)
+    {
+        m_entries[i] = (entry_t){ 0 };
+    }
+
+    m_seed = 1;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        m_entries[i].key = stop ? key++ : rand32() % 1000000;
+        scale_add(&m_entries[i], heap);
+    }
+
+    start = ep_host_now_ns();
+    for (uint32_t i = 0; i < ops; i++)
+    {
+        entry_t * p_entry;
+
+        if (stop)
+        {
+            p_entry = &m_entries[rand32() % n];
+            if (!(heap ? nrf_sortlist_remove(p_list, &p_entry->heap_item)
+                       : list_nrf_sortlist_remove(p_list, &p_entry->list_item)))
+            {
+                fail(i, "queued entry not removed");
+            }
+            p_entry->key = key++;
+        }
+        else
+        {
+            p_entry = heap ? CONTAINER_OF(nrf_sortlist_pop(p_list), entry_t, heap_item)
+                           : CONTAINER_OF(list_nrf_sortlist_pop(p_list), entry_t, list_item);
+            p_entry->key += 1 + rand32() % 1000000;
+        }
+        scale_add(p_entry, heap);
+    }
+
+    return (double)(ep_host_now_ns() - start) / ops;
+}
+
+int main(void)
+{
+    random_test();
+
+    printf("nrf_sortlist with n deadlines, ns per pop and add, and per remove and add\n");
+    printf("%7s %12s %12s %9s %12s %12s %9s\n", "n", "list pop", "heap pop", "speedup",
+           "list remove", "heap remove", "speedup");
+    for (uint32_t n = 10; n <= SCALE_MAX; n *= 10)
+    {
+        double list_pop    = scale(n, 0, 0);
+        double heap_pop    = scale(n, 1, 0);
+        double list_remove = scale(n, 0, 1);
+        double heap_remove = scale(n, 1, 1);
+
+        printf("%7u %12.1f %12.1f %8.1fx %12.1f %12.1f %8.1fx\n", n, list_pop, heap_pop, list_pop / heap_pop,
+               list_remove, heap_remove, list_remove / heap_remove);
+    }
+    printf("%s\n\n", m_failures ? "FAILED" : "passed");
+
+    return m_failures ? 1 : 0;
+}
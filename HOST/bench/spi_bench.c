@@ -0,0 +1,476 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    spi_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Bandwidth and bus idle time of nrf_spi_mngr on a mock SPIM driver.
+ *
+ * The real nrf_spi_mngr runs on a mock of the SPIM driver that keeps a
+ * virtual clock: a transfer takes 8 bits per byte at BUS_MHZ, its interrupt
+ * is handled a configurable latency after it ends, and the callbacks of the
+ * bench take their own time. The bus is idle from the end of a transfer to
+ * the start of the next one.
+ *
+ * - stream: an ADC is read in frames, one transaction per frame with the
+ *   chip select of the driver. The end callback processes the frame and
+ *   schedules a new one, keeping 1 to 4 transactions in the queue.
+ * - flash: a region of a serial flash is read with chip select in the
+ *   begin and end callbacks, as one transaction per chunk with its own read
+ *   command and as one nrf_spi_mngr_bulk_read().
+ *
+ * The data read is checked against the devices. The bench is built with
+ * NRF_SPI_MNGR_STREAMING_ENABLED off and on, see the spi_bench target of
+ * HOST/Makefile.
+ *
+ * Built for the POSIX host target only, see the spi_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdk_common.h"
+#include "nrf_drv_spi.h"
+#include "nrf_spi_mngr.h"
+
+#define BUS_MHZ             8
+#define STREAM_FRAMES       2000
+#define STREAM_FRAME_SIZE   32          // Bytes of a frame, after the command byte
+#define STREAM_MAX_DEPTH    4
+#define STREAM_CALLBACK_US  15.0        // Processing of a frame in the end callback
+#define CS_CALLBACK_US      0.5         // Chip select in the begin and end callbacks
+#define FLASH_SIZE          65536
+#define FLASH_READ_SIZE     65536
+#define FLASH_CHUNK_SIZE    255
+#define FLASH_CMD_READ      0x03
+#define FLASH_DEPTH         4           // Chunk transactions kept in the queue
+
+#define SS_PIN              4
+
+#define BENCH_CHECK(_call)                                  \
+    do {                                                    \
+        if ((_call) != NRF_SUCCESS)                         \
+        {                                                   \
+            printf("%s FAILED\n", #_call);                  \
+            exit(1);                                        \
+        }                                                   \
+    } while (0)
+
+static const double m_latencies_us[] = {2.0, 10.0};
+
+NRF_SPI_MNGR_DEF(m_spi_mngr, STREAM_MAX_DEPTH, 0);
+
+/**
+ * @brief Mock SPIM driver, on a virtual clock in microseconds
+ */
+typedef struct {
+    double   first_start;
+    double   last_end;
+    double   busy;
+    uint32_t irqs;
+    uint32_t bytes;
+} bus_stats_t;
+
+typedef struct {
+    void    (* select)(void);
+    uint8_t (* exchange)(uint8_t mosi);
+} device_t;
+
+static nrf_drv_spi_evt_handler_t m_spi_handler;
+static void *                    m_spi_context;
+static bool                      m_driver_cs;
+static bool                      m_spi_pending;
+static double                    m_now;
+static double                    m_done_at;
+static double                    m_latency_us;
+static bus_stats_t               m_bus;
+static device_t const *          m_device;
+
+static uint8_t                   m_flash[FLASH_SIZE];
+static uint32_t                  m_flash_addr;
+static uint32_t                  m_flash_cmd_bytes;
+static uint8_t                   m_flash_read[FLASH_READ_SIZE];
+static uint8_t                   m_adc_sample;
+static uint32_t                  m_adc_cmd_bytes;
+
+static void flash_select(void)
+{
+    m_flash_cmd_bytes = 0;
+}
+
+/**
+ * @brief Serial flash: a read command with a 24 bit address, then data until chip select ends.
+ */
+static uint8_t flash_exchange(uint8_t mosi)
+{
+    if (m_flash_cmd_bytes < 4)
+    {
+        m_flash_addr = (m_flash_cmd_bytes == 0) ? 0 : (m_flash_addr << 8) | mosi;
+        m_flash_cmd_bytes += (m_flash_cmd_bytes > 0) || (mosi == FLASH_CMD_READ) ? 1 : 0;
+        return 0xFF;
+    }
+    return m_flash[m_flash_addr++ % FLASH_SIZE];
+}
+
+static void adc_select(void)
+{
+    m_adc_cmd_bytes = 0;
+}
+
+/**
+ * @brief ADC: a command byte, then the next samples.
+ */
+static uint8_t adc_exchange(uint8_t mosi)
+{
+    (void)mosi;
+    return (m_adc_cmd_bytes++ == 0) ? 0xFF : m_adc_sample++;
+}
+
+static const device_t m_flash_device = {flash_select, flash_exchange};
+static const device_t m_adc_device   = {adc_select, adc_exchange};
+
+ret_code_t nrf_drv_spi_init(nrf_drv_spi_t const * const p_instance,
+                            nrf_drv_spi_config_t const * p_config,
+                            nrf_drv_spi_evt_handler_t    handler,
+                            void *                       p_context)
+{
+    m_spi_handler = handler;
+    m_spi_context = p_context;
+    m_driver_cs   = (p_config->ss_pin != NRF_DRV_SPI_PIN_NOT_USED);
+    return NRF_SUCCESS;
+}
+
+void nrfx_spim_uninit(nrfx_spim_t const * p_instance)
+{
+}
+
+nrfx_err_t nrfx_spim_xfer(nrfx_spim_t const *           p_instance,
+                          nrfx_spim_xfer_desc_t const * p_xfer_desc,
+                          uint32_t                      flags)
+{
+    uint32_t length = MAX(p_xfer_desc->tx_length, p_xfer_desc->rx_length);
+
+    if (m_spi_pending)
+    {
+        return NRFX_ERROR_BUSY;
+    }
+    if (m_driver_cs)
+    {
+        m_device->select();
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint8_t miso = m_device->exchange((i < p_xfer_desc->tx_length) ? p_xfer_desc->p_tx_buffer[i] : 0xFF);
+
+        if (i < p_xfer_desc->rx_length)
+        {
+            p_xfer_desc->p_rx_buffer[i] = miso;
+        }
+    }
+
+    if (m_bus.bytes == 0)
+    {
+        m_bus.first_start = m_now;
+    }
+    m_bus.bytes  += length;
+    m_bus.busy   += length * 8.0 / BUS_MHZ;
+    m_done_at     = m_now + length * 8.0 / BUS_MHZ;
+    m_spi_pending = true;
+    return NRFX_SUCCESS;
+}
+
+/**
+ * @brief Runs the SPI interrupt until the bus is idle.
+ */
+static void bus_run(void)
+{
+    static nrf_drv_spi_evt_t const event = {.type = NRF_DRV_SPI_EVENT_DONE};
+
+    while (m_spi_pending)
+    {
+        m_bus.last_end = m_done_at;
+        m_now          = MAX(m_now, m_done_at) + m_latency_us;
+        m_spi_pending  = false;
+        m_bus.irqs++;
+        m_spi_handler(&event, m_spi_context);
+    }
+}
+
+static void bus_reset(nrf_drv_spi_config_t const * p_config, device_t const * p_device, double latency_us)
+{
+    nrf_spi_mngr_uninit(&m_spi_mngr);
+    BENCH_CHECK(nrf_spi_mngr_init(&m_spi_mngr, p_config));
+    memset(&m_bus, 0, sizeof(m_bus));
+    m_now        = 0;
+    m_device     = p_device;
+    m_latency_us = latency_us;
+}
+
+static void bus_print(char const * p_name, double latency_us, uint32_t depth, uint32_t payload)
+{
+    double total = m_bus.last_end - m_bus.first_start;
+
+    printf("%-8s %8.1f %6u %10.1f %8.1f %8u\n", p_name, latency_us, depth,
+           payload / total * 1e6 / 1024, (total - m_bus.busy) / total * 100, m_bus.irqs);
+}
+
+/**
+ * @brief ADC stream
+ */
+typedef struct {
+    nrf_spi_mngr_transaction_t transaction;
+    nrf_spi_mngr_transfer_t    transfer;
+    uint8_t                    rx[1 + STREAM_FRAME_SIZE];
+    uint32_t                   frame;
+} stream_slot_t;
+
+static stream_slot_t m_slots[STREAM_MAX_DEPTH];
+static uint8_t const m_adc_cmd = 0x40;
+static uint32_t      m_frames_scheduled;
+static uint32_t      m_frames_done;
+static uint32_t      m_frame_errors;
+
+static void stream_schedule(stream_slot_t * p_slot)
+{
+    p_slot->frame = m_frames_scheduled++;
+    BENCH_CHECK(nrf_spi_mngr_schedule(&m_spi_mngr, &p_slot->transaction));
+}
+
+static void stream_frame_done(ret_code_t result, void * p_user_data)
+{
+    stream_slot_t * p_slot = (stream_slot_t *)p_user_data;
+
+    for (uint32_t i = 0; i < STREAM_FRAME_SIZE; i++)
+    {
+        if ((result != NRF_SUCCESS) || (p_slot->rx[1 + i] != (uint8_t)(p_slot->frame * STREAM_FRAME_SIZE + i)))
+        {
+            m_frame_errors++;
+            break;
+        }
+    }
+    m_frames_done++;
+    m_now += STREAM_CALLBACK_US;
+
+    if (m_frames_scheduled < STREAM_FRAMES)
+    {
+        stream_schedule(p_slot);
+    }
+}
+
+static bool stream_run(double latency_us, uint32_t depth, double * p_idle)
+{
+    nrf_drv_spi_config_t config = NRF_DRV_SPI_DEFAULT_CONFIG;
+
+    config.ss_pin = SS_PIN;
+    bus_reset(&config, &m_adc_device, latency_us);
+    m_adc_sample       = 0;
+    m_frames_scheduled = 0;
+    m_frames_done      = 0;
+    m_frame_errors     = 0;
+
+    for (uint32_t i = 0; i < depth; i++)
+    {
+        m_slots[i].transfer    = (nrf_spi_mngr_transfer_t)
+            NRF_SPI_MNGR_TRANSFER(&m_adc_cmd, 1, m_slots[i].rx, sizeof(m_slots[i].rx));
+        m_slots[i].transaction = (nrf_spi_mngr_transaction_t) {
+            .end_callback        = stream_frame_done,
+            .p_user_data         = &m_slots[i],
+            .p_transfers         = &m_slots[i].transfer,
+            .number_of_transfers = 1,
+        };
+        stream_schedule(&m_slots[i]);
+    }
+    bus_run();
+
+    bus_print("stream", latency_us, depth, STREAM_FRAMES * STREAM_FRAME_SIZE);
+    *p_idle = m_bus.last_end - m_bus.first_start - m_bus.busy;
+    return (m_frames_done == STREAM_FRAMES) && (m_frame_errors == 0);
+}
+
+/**
+ * @brief Flash reads
+ */
+typedef struct {
+    nrf_spi_mngr_transaction_t transaction;
+    nrf_spi_mngr_transfer_t    transfers[2];
+    uint8_t                    cmd[4];
+} chunk_slot_t;
+
+static chunk_slot_t m_chunks[FLASH_DEPTH];
+static uint32_t     m_flash_offset;
+static bool         m_flash_done;
+static ret_code_t   m_flash_result;
+
+static void flash_cs_begin(void * p_user_data)
+{
+    m_now += CS_CALLBACK_US;
+    flash_select();
+}
+
+static void chunk_schedule(chunk_slot_t * p_chunk)
+{
+    uint32_t length = MIN(FLASH_CHUNK_SIZE, FLASH_READ_SIZE - m_flash_offset);
+
+    p_chunk->cmd[0] = FLASH_CMD_READ;
+    p_chunk->cmd[1] = (uint8_t)(m_flash_offset >> 16);
+    p_chunk->cmd[2] = (uint8_t)(m_flash_offset >> 8);
+    p_chunk->cmd[3] = (uint8_t)m_flash_offset;
+    p_chunk->transfers[0] = (nrf_spi_mngr_transfer_t)NRF_SPI_MNGR_TRANSFER(p_chunk->cmd, 4, NULL, 0);
+    p_chunk->transfers[1] = (nrf_spi_mngr_transfer_t)
+        NRF_SPI_MNGR_TRANSFER(NULL, 0, &m_flash_read[m_flash_offset], length);
+    m_flash_offset += length;
+    BENCH_CHECK(nrf_spi_mngr_schedule(&m_spi_mngr, &p_chunk->transaction));
+}
+
+static void chunk_done(ret_code_t result, void * p_user_data)
+{
+    m_now += CS_CALLBACK_US;
+    m_flash_result = (m_flash_result == NRF_SUCCESS) ? result : m_flash_result;
+    if (m_flash_offset < FLASH_READ_SIZE)
+    {
+        chunk_schedule((chunk_slot_t *)p_user_data);
+    }
+}
+
+static void bulk_done(ret_code_t result, void * p_user_data)
+{
+    m_now += CS_CALLBACK_US;
+    m_flash_result = result;
+    m_flash_done   = true;
+}
+
+static bool flash_run(double latency_us, bool bulk)
+{
+    static nrf_spi_mngr_bulk_t bulk_read;
+    static uint8_t const       cmd[4] = {FLASH_CMD_READ, 0, 0, 0};
+    nrf_drv_spi_config_t const config = NRF_DRV_SPI_DEFAULT_CONFIG;
+    bool                       ok;
+
+    bus_reset(&config, &m_flash_device, latency_us);
+    memset(m_flash_read, 0, sizeof(m_flash_read));
+    m_flash_offset = 0;
+    m_flash_done   = false;
+    m_flash_result = NRF_SUCCESS;
+
+    if (bulk)
+    {
+        bulk_read = (nrf_spi_mngr_bulk_t) {
+            .begin_callback = flash_cs_begin,
+            .end_callback   = bulk_done,
+            .p_cmd          = cmd,
+            .cmd_length     = sizeof(cmd),
+            .p_data         = m_flash_read,
+            .length         = FLASH_READ_SIZE,
+            .chunk_size     = FLASH_CHUNK_SIZE,
+        };
+        BENCH_CHECK(nrf_spi_mngr_bulk_read(&m_spi_mngr, &bulk_read));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < FLASH_DEPTH; i++)
+        {
+            m_chunks[i].transaction = (nrf_spi_mngr_transaction_t) {
+                .begin_callback      = flash_cs_begin,
+                .end_callback        = chunk_done,
+                .p_user_data         = &m_chunks[i],
+                .p_transfers         = m_chunks[i].transfers,
+                .number_of_transfers = 2,
+            };
+            chunk_schedule(&m_chunks[i]);
+        }
+        m_flash_done = true;
+    }
+    bus_run();
+
+    bus_print(bulk ? "bulk" : "chunks", latency_us, bulk ? 1 : FLASH_DEPTH, FLASH_READ_SIZE);
+    ok = m_flash_done && (m_flash_result == NRF_SUCCESS) &&
+         (memcmp(m_flash_read, m_flash, FLASH_READ_SIZE) == 0);
+    if (!ok)
+    {
+        printf("flash data FAILED\n");
+    }
+    return ok;
+}
+
+/**
+ * @brief Bulk reads that cannot be made are refused.
+ */
+static bool bulk_check(void)
+{
+    static uint8_t const cmd[4] = {FLASH_CMD_READ, 0, 0, 0};
+    nrf_spi_mngr_bulk_t  bulk_read = {
+        .p_cmd      = cmd,
+        .cmd_length = sizeof(cmd),
+        .p_data     = m_flash_read,
+        .length     = FLASH_READ_SIZE,
+        .chunk_size = 0,
+    };
+    bool ok = true;
+
+    ok &= nrf_spi_mngr_bulk_read(&m_spi_mngr, &bulk_read) == NRF_ERROR_INVALID_LENGTH;
+    bulk_read.chunk_size = 1;
+    bulk_read.length     = UINT16_MAX;
+    ok &= nrf_spi_mngr_bulk_read(&m_spi_mngr, &bulk_read) == NRF_ERROR_INVALID_LENGTH;
+    bulk_read.length     = 0;
+    ok &= nrf_spi_mngr_bulk_read(&m_spi_mngr, &bulk_read) == NRF_ERROR_INVALID_LENGTH;
+    bulk_read.length     = 16;
+    bulk_read.cmd_length = 0;
+    ok &= nrf_spi_mngr_bulk_read(&m_spi_mngr, &bulk_read) == NRF_ERROR_INVALID_LENGTH;
+
+    printf("invalid bulk reads refused %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main(void)
+{
+    nrf_drv_spi_config_t const config = NRF_DRV_SPI_DEFAULT_CONFIG;
+    uint32_t                   failures = 0;
+
+    printf("nrf_spi_mngr, streaming %s, bus at %d MHz, callbacks %.1f us per frame, %.1f us per chip select\n",
+           NRF_SPI_MNGR_STREAMING_ENABLED ? "on" : "off", BUS_MHZ, STREAM_CALLBACK_US, CS_CALLBACK_US);
+
+    for (uint32_t i = 0; i < FLASH_SIZE; i++)
+    {
+        m_flash[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+    BENCH_CHECK(nrf_spi_mngr_init(&m_spi_mngr, &config));
+    failures += bulk_check() ? 0 : 1;
+
+    printf("%-8s %8s %6s %10s %8s %8s\n", "read", "irq us", "depth", "KiB/s", "idle %", "irqs");
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_latencies_us); i++)
+    {
+        double idle[STREAM_MAX_DEPTH + 1];
+
+        for (uint32_t depth = 1; depth <= STREAM_MAX_DEPTH; depth *= 2)
+        {
+            failures += stream_run(m_latencies_us[i], depth, &idle[depth]) ? 0 : 1;
+        }
+#if NRF_SPI_MNGR_STREAMING_ENABLED
+        // Chaining needs a queued transaction: it hides the callback from depth 2 on
+        failures += (idle[2] < idle[1]) ? 0 : 1;
+#endif
+        failures += flash_run(m_latencies_us[i], false) ? 0 : 1;
+        failures += flash_run(m_latencies_us[i], true) ? 0 : 1;
+    }
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
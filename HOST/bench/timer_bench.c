@@ -0,0 +1,440 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    timer_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Firing window, cancellation and cost of app_timer on the FreeRTOS
+ * virtual tick.
+ *
+ * Built once per backend, see the timer_bench target of HOST/Makefile:
+ * - freertos: app_timer_freertos.c, one FreeRTOS software timer per app timer.
+ * - wheel: APP_TIMER_CONFIG_FREERTOS_WHEEL, app_timer_freertos_wheel.c. The
+ *   RTC is modelled by a task of the highest priority: its counter is the
+ *   tick count, and the task sleeps until the tick of the compare value and
+ *   then calls the compare handler, as the interrupt would.
+ *
+ * The scheduler runs on the host port, whose tick is virtual: time only moves
+ * while every task is blocked. The bench task checks, with SINGLE_COUNT
+ * single shot and REPEATED_COUNT repeated timers:
+ * - window: each single shot timer fires once, not before its timeout and at
+ *   most LATE_MAX ticks after it,
+ * - cancel: timers stopped right after their start, while running, or from
+ *   the handler of another timer due at the same or an earlier tick, never
+ *   fire, and the others still fire in their window,
+ * - repeated: the n-th expiry of a repeated timer comes n periods after its
+ *   start, within the same window, and none comes after it is stopped, also
+ *   from its own handler.
+ * Then LOAD_COUNT repeated timers of 1 to 60 s run for LOAD_SECONDS of
+ * virtual time. The report gives the host time of an app_timer_start() or
+ * app_timer_stop() call with those timers running, the expiries per second,
+ * and the wakeups per second, the returns from the idle task: an RTC interrupt
+ * on the target, which the timer task then serves.
+ *
+ * Built for the POSIX host target only, see the timer_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "ep_host.h"
+
+#if APP_TIMER_CONFIG_FREERTOS_WHEEL
+#include "nrfx_rtc.h"
+#define MODE_NAME       "wheel"
+#else
+#define MODE_NAME       "freertos"
+#endif
+
+#define SINGLE_COUNT    2000        // Single shot timers of the window and cancel tests
+#define REPEATED_COUNT  200
+#define LOAD_COUNT      4000        // Repeated timers running during the benchmark
+#define LOAD_SECONDS    120
+#define OP_COUNT        20000       // Start and stop pairs timed with the load running
+#define TIMEOUT_MAX     3000        // Ticks, single shot timeouts are 5 to TIMEOUT_MAX
+#define PERIOD_MAX      500         // Ticks, repeated timer periods are 5 to PERIOD_MAX
+#define REPEATED_TICKS  5000        // Run time of the repeated test
+#define LATE_MAX        2           // Ticks an expiry may come after its due tick
+
+typedef struct {
+    app_timer_t data;               // Storage of the timer, as APP_TIMER_DEF
+    TickType_t  start;              // Tick of the app_timer_start() call
+    uint32_t    timeout;
+    uint32_t    fires;
+    uint32_t    fires_max;          // Stops itself from the handler after this many expiries, 0 for never
+    uint32_t    partner;            // Index of the timer this one stops from its handler, or SINGLE_COUNT
+    bool        stopped;            // Stopped before its expiry, must not fire
+} timer_rec_t;
+
+static timer_rec_t m_timers[SINGLE_COUNT];
+static timer_rec_t m_repeated[REPEATED_COUNT];
+static timer_rec_t m_load[LOAD_COUNT];
+
+static uint32_t m_failures;
+static uint32_t m_late_max;
+static uint64_t m_expiries;
+static uint64_t m_wakeups;
+static uint32_t m_seed = 1;
+
+static uint32_t rand32(void)
+{
+    // xorshift32, the same sequence on every run
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return m_seed;
+}
+
+/* Counts the wakeups, the switches out of the idle task, see the timer_bench target of HOST/Makefile */
+void timer_bench_task_switched_in(void)
+{
+    static bool idle;
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        return;
+    }
+    if (xTaskGetCurrentTaskHandle() == xTaskGetIdleTaskHandle())
+    {
+        idle = true;
+    }
+    else if (idle)
+    {
+        idle = false;
+        m_wakeups++;
+    }
+}
+
+#if APP_TIMER_CONFIG_FREERTOS_WHEEL
+/* RTC model: the counter is the tick count, the compare event is sent by m_rtc_task */
+static nrfx_rtc_handler_t m_rtc_handler;
+static TaskHandle_t       m_rtc_task;
+static uint32_t           m_rtc_cc;
+static bool               m_rtc_cc_enabled;
+
+uint32_t ep_host_rtc_counter_get(NRF_RTC_Type * p_reg)
+{
+    (void)p_reg;
+    return xTaskGetTickCount() & RTC_COUNTER_COUNTER_Msk;
+}
+
+static void rtc_task(void * pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;)
+    {
+        TickType_t wait = portMAX_DELAY;
+        bool       fire = false;
+
+        taskENTER_CRITICAL();
+        if (m_rtc_cc_enabled)
+        {
+            wait = (m_rtc_cc - ep_host_rtc_counter_get(NULL)) & RTC_COUNTER_COUNTER_Msk;
+            // The next match of the compare value is 2^24 ticks later, the wheel rearms before
+            fire = (wait == 0);
+            m_rtc_cc_enabled = !fire;
+        }
+        taskEXIT_CRITICAL();
+
+        if (fire)
+        {
+            m_rtc_handler(NRFX_RTC_INT_COMPARE0);
+        }
+        else
+        {
+            (void)ulTaskNotifyTake(pdTRUE, wait);
+        }
+    }
+}
+
+nrfx_err_t nrfx_rtc_init(nrfx_rtc_t const * const  p_instance,
+                         nrfx_rtc_config_t const * p_config,
+                         nrfx_rtc_handler_t        handler)
+{
+    (void)p_instance;
+    (void)p_config;
+    m_rtc_handler = handler;
+    xTaskCreate(rtc_task, "RTC", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &m_rtc_task);
+    return NRFX_SUCCESS;
+}
+
+void nrfx_rtc_enable(nrfx_rtc_t const * const p_instance)
+{
+    (void)p_instance;
+}
+
+nrfx_err_t nrfx_rtc_cc_set(nrfx_rtc_t const * const p_instance, uint32_t channel, uint32_t val, bool enable_irq)
+{
+    (void)p_instance;
+    (void)channel;
+    (void)enable_irq;
+    m_rtc_cc         = val & RTC_COUNTER_COUNTER_Msk;
+    m_rtc_cc_enabled = true;
+    xTaskNotifyGive(m_rtc_task);
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_rtc_cc_disable(nrfx_rtc_t const * const p_instance, uint32_t channel)
+{
+    (void)p_instance;
+    (void)channel;
+    m_rtc_cc_enabled = false;
+    return NRFX_SUCCESS;
+}
+#endif // APP_TIMER_CONFIG_FREERTOS_WHEEL
+
+static void timeout_handler(void * p_context)
+{
+    timer_rec_t * p_rec   = p_context;
+    TickType_t    elapsed = xTaskGetTickCount() - p_rec->start;
+    uint32_t      due     = p_rec->timeout * (p_rec->fires + 1);
+
+    m_expiries++;
+    p_rec->fires++;
+    if (p_rec->stopped || (elapsed < due) || (elapsed > due + LATE_MAX) ||
+        ((p_rec->fires_max != 0) && (p_rec->fires > p_rec->fires_max)))
+    {
+        printf("FAIL timer %p: expiry %u after %u ticks, timeout %u%s\n", (void *)p_rec, (unsigned)p_rec->fires,
+               (unsigned)elapsed, (unsigned)p_rec->timeout, p_rec->stopped ? ", stopped" : "");
+        m_failures++;
+    }
+    m_late_max = MAX(m_late_max, (elapsed >= due) ? elapsed - due : 0);
+
+    if (p_rec->fires == p_rec->fires_max)
+    {
+        p_rec->stopped = true;
+        (void)app_timer_stop(&p_rec->data);
+    }
+    if ((p_rec >= m_timers) && (p_rec < &m_timers[SINGLE_COUNT]) && (p_rec->partner < SINGLE_COUNT) &&
+        (m_timers[p_rec->partner].fires == 0))
+    {
+        m_timers[p_rec->partner].stopped = true;
+        (void)app_timer_stop(&m_timers[p_rec->partner].data);
+    }
+}
+
+static void load_handler(void * p_context)
+{
+    (void)p_context;
+    m_expiries++;
+}
+
+static void timer_start(timer_rec_t * p_rec, uint32_t timeout)
+{
+    p_rec->start   = xTaskGetTickCount();
+    p_rec->timeout = timeout;
+    p_rec->fires   = 0;
+    p_rec->stopped = false;
+    if (app_timer_start(&p_rec->data, timeout, p_rec) != NRF_SUCCESS)
+    {
+        printf("FAIL app_timer_start\n");
+        m_failures++;
+    }
+}
+
+static void timer_stop(timer_rec_t * p_rec)
+{
+    p_rec->stopped = true;
+    (void)app_timer_stop(&p_rec->data);
+}
+
+/**
+ * @brief Checks that every single shot timer not stopped fired once.
+ */
+static void fires_check(const char * p_test)
+{
+    for (uint32_t i = 0; i < SINGLE_COUNT; i++)
+    {
+        if (!m_timers[i].stopped && (m_timers[i].fires != 1))
+        {
+            printf("FAIL %s: timer %u fired %u times\n", p_test, i, m_timers[i].fires);
+            m_failures++;
+        }
+    }
+}
+
+static void window_test(void)
+{
+    for (uint32_t i = 0; i < SINGLE_COUNT; i++)
+    {
+        m_timers[i].partner = SINGLE_COUNT;
+        timer_start(&m_timers[i], 5 + rand32() % (TIMEOUT_MAX - 4));
+    }
+    vTaskDelay(TIMEOUT_MAX + LATE_MAX + 1);
+    fires_check("window");
+}
+
+static void cancel_test(void)
+{
+    uint32_t timeout = 0;
+
+    for (uint32_t i = 0; i < SINGLE_COUNT; i++)
+    {
+        // Pairs of timers stopping each other, due at the same tick or one tick apart
+        m_timers[i].partner = SINGLE_COUNT;
+        if ((i % 10) == 2)
+        {
+            m_timers[i].partner = i + 1;
+        }
+        else if ((i % 10) == 3)
+        {
+            m_timers[i].partner = i - 1;
+        }
+        timeout = ((i % 10) == 3) ? timeout + (i % 20) / 10 : 5 + rand32() % (TIMEOUT_MAX - 4);
+        timer_start(&m_timers[i], timeout);
+    }
+    for (uint32_t i = 0; i < SINGLE_COUNT; i += 10)
+    {
+        timer_stop(&m_timers[i]);
+    }
+
+    // Stop the timers due after the delay, some of them in the same wheel slot as timers that fire
+    vTaskDelay(TIMEOUT_MAX / 2);
+    for (uint32_t i = 1; i < SINGLE_COUNT; i += 10)
+    {
+        if (m_timers[i].timeout > TIMEOUT_MAX / 2 + LATE_MAX)
+        {
+            timer_stop(&m_timers[i]);
+        }
+    }
+    vTaskDelay(TIMEOUT_MAX / 2 + LATE_MAX + 1);
+    fires_check("cancel");
+
+    for (uint32_t i = 2; i < SINGLE_COUNT; i += 10)
+    {
+        if (m_timers[i].fires + m_timers[i + 1].fires != 1)
+        {
+            printf("FAIL cancel: timers %u and %u fired %u and %u times\n", i, i + 1, m_timers[i].fires,
+                   m_timers[i + 1].fires);
+            m_failures++;
+        }
+    }
+}
+
+static void repeated_test(void)
+{
+    for (uint32_t i = 0; i < REPEATED_COUNT; i++)
+    {
+        // One in four stops itself from its handler after a few expiries
+        m_repeated[i].partner   = SINGLE_COUNT;
+        m_repeated[i].fires_max = ((i % 4) == 0) ? 1 + i % 7 : 0;
+        timer_start(&m_repeated[i], 5 + rand32() % (PERIOD_MAX - 4));
+    }
+    vTaskDelay(REPEATED_TICKS);
+
+    for (uint32_t i = 0; i < REPEATED_COUNT; i++)
+    {
+        timer_rec_t * p_rec    = &m_repeated[i];
+        uint32_t      expected = (p_rec->fires_max != 0) ? p_rec->fires_max : REPEATED_TICKS / p_rec->timeout;
+
+        // The expiry due in the last LATE_MAX ticks may come after the delay
+        if ((p_rec->fires != expected) &&
+            ((p_rec->fires_max != 0) || (p_rec->fires + 1 != expected) ||
+             ((REPEATED_TICKS % p_rec->timeout) > LATE_MAX)))
+        {
+            printf("FAIL repeated timer %u, period %u: %u expiries instead of %u\n", i, p_rec->timeout,
+                   p_rec->fires, expected);
+            m_failures++;
+        }
+        timer_stop(p_rec);
+    }
+    vTaskDelay(PERIOD_MAX + LATE_MAX + 1);
+}
+
+static void bench_task(void * pvParameters)
+{
+    uint64_t ops_ns;
+    uint64_t expiries;
+    uint64_t wakeups;
+
+    (void)pvParameters;
+
+    if (app_timer_init() != NRF_SUCCESS)
+    {
+        printf("FAIL app_timer_init\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < SINGLE_COUNT; i++)
+    {
+        app_timer_id_t id = &m_timers[i].data;
+        (void)app_timer_create(&id, APP_TIMER_MODE_SINGLE_SHOT, timeout_handler);
+    }
+    for (uint32_t i = 0; i < REPEATED_COUNT; i++)
+    {
+        app_timer_id_t id = &m_repeated[i].data;
+        (void)app_timer_create(&id, APP_TIMER_MODE_REPEATED, timeout_handler);
+    }
+    for (uint32_t i = 0; i < LOAD_COUNT; i++)
+    {
+        app_timer_id_t id = &m_load[i].data;
+        (void)app_timer_create(&id, APP_TIMER_MODE_REPEATED, load_handler);
+    }
+
+    window_test();
+    cancel_test();
+    repeated_test();
+
+    // Load: repeated timers of 1 to 60 s
+    for (uint32_t i = 0; i < LOAD_COUNT; i++)
+    {
+        (void)app_timer_start(&m_load[i].data, configTICK_RATE_HZ + rand32() % (59 * configTICK_RATE_HZ), NULL);
+    }
+
+    // Calls with the load running, the single shot timers are stopped before they expire
+    ops_ns = ep_host_now_ns();
+    for (uint32_t i = 0; i < OP_COUNT; i++)
+    {
+        app_timer_id_t id = &m_timers[i % SINGLE_COUNT].data;
+
+        (void)app_timer_start(id, 5 + rand32() % (TIMEOUT_MAX - 4), NULL);
+        (void)app_timer_stop(id);
+    }
+    ops_ns = ep_host_now_ns() - ops_ns;
+
+    expiries = m_expiries;
+    wakeups  = m_wakeups;
+    vTaskDelay(LOAD_SECONDS * configTICK_RATE_HZ);
+    expiries = m_expiries - expiries;
+    wakeups  = m_wakeups - wakeups;
+
+    printf("app_timer %s, %u timers running, %u s of virtual time\n", MODE_NAME, LOAD_COUNT, LOAD_SECONDS);
+    printf("%-10s %9s %10s %12s %11s\n", "backend", "late max", "ns/call", "expiries/s", "wakeups/s");
+    printf("%-10s %9u %10.1f %12.1f %11.1f\n", MODE_NAME, m_late_max, (double)ops_ns / (2 * OP_COUNT),
+           (double)expiries / LOAD_SECONDS, (double)wakeups / LOAD_SECONDS);
+    printf("%s\n\n", m_failures ? "FAILED" : "passed");
+    fflush(stdout);
+
+    exit(m_failures ? 1 : 0);
+}
+
+int main(void)
+{
+    xTaskCreate(bench_task, "Bench", 1024, NULL, tskIDLE_PRIORITY + 1, NULL);
+    vTaskStartScheduler();
+    return 1;
+}
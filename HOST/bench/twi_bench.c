@@ -0,0 +1,448 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    twi_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Bus cycles and CPU time of a sensor sweep, read by read and with twi_poll.
+ *
+ * The real nrf_twi_mngr and nrf_twi_sensor run on a mock bus that stands in
+ * for the TWIM driver: four sensors with register maps that change every
+ * sweep. Each transfer is counted as one interrupt and in SCL clocks: one per
+ * START, repeated START and STOP, nine per address or data byte. The bus
+ * time is given at 400 kHz.
+ *
+ * A sweep of the same register reads is made three ways:
+ * - reads: one nrf_twi_sensor_reg_read() per register read.
+ * - gap 0: a twi_poll sweep, merging reads that follow each other.
+ * - gap N: a twi_poll sweep, merging reads up to TWI_POLL_MAX_GAP apart.
+ * The frames of the sweeps must hold the same data as the reads, and with
+ * gap 0 no register that was not asked for may be read.
+ *
+ * Built for the POSIX host target only, see the twi_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sdk_common.h"
+#include "nrf_drv_twi.h"
+#include "nrf_twi_mngr.h"
+#include "nrf_twi_sensor.h"
+#include "twi_poll.h"
+#include "ep_host.h"
+
+#define BENCH_SWEEPS        100000
+#define BENCH_PASSES        5           // Fastest pass is reported
+#define CHECK_SWEEPS        1000
+#define BUS_KHZ             400
+
+#define DEV_IMU             0x6A        // Accelerometer and gyroscope
+#define DEV_BARO            0x76        // Pressure and temperature
+#define DEV_MAG             0x1E        // Magnetometer
+#define DEV_LIGHT           0x44        // Ambient light
+
+enum { MODE_READS, MODE_GAP_0, MODE_GAP_N, MODE_CNT };
+
+static char const * m_mode_names[MODE_CNT] = {"reads", "gap 0", "gap " STRINGIFY(TWI_POLL_MAX_GAP)};
+
+// As an application would poll them, device by device in no particular order
+static const twi_poll_read_t m_reads[] = {
+    TWI_POLL_READ(DEV_IMU,   0x28, 6),  // Accelerometer X, Y, Z
+    TWI_POLL_READ(DEV_IMU,   0x22, 6),  // Gyroscope X, Y, Z
+    TWI_POLL_READ(DEV_IMU,   0x20, 2),  // Temperature
+    TWI_POLL_READ(DEV_IMU,   0x1E, 1),  // Status
+    TWI_POLL_READ(DEV_BARO,  0xF3, 1),  // Status
+    TWI_POLL_READ(DEV_BARO,  0xF7, 3),  // Pressure
+    TWI_POLL_READ(DEV_BARO,  0xFA, 3),  // Temperature
+    TWI_POLL_READ(DEV_MAG,   0x68, 2),  // X
+    TWI_POLL_READ(DEV_MAG,   0x6A, 2),  // Y
+    TWI_POLL_READ(DEV_MAG,   0x6C, 2),  // Z
+    TWI_POLL_READ(DEV_MAG,   0x6E, 2),  // Temperature
+    TWI_POLL_READ(DEV_LIGHT, 0x00, 2),  // Result
+};
+
+#define READ_CNT            ARRAY_SIZE(m_reads)
+
+static const uint8_t m_devices[] = {DEV_IMU, DEV_BARO, DEV_MAG, DEV_LIGHT};
+
+#define DEV_CNT             ARRAY_SIZE(m_devices)
+
+NRF_TWI_MNGR_DEF(m_twi_mngr, READ_CNT, 0);
+NRF_TWI_SENSOR_DEF(m_twi_sensor, &m_twi_mngr, READ_CNT);
+
+/**
+ * @brief Mock bus
+ */
+typedef struct {
+    uint32_t transactions;
+    uint32_t irqs;                          // One per transfer
+    uint32_t bytes;                         // Address and data bytes
+    uint32_t clocks;                        // SCL clocks
+} bus_stats_t;
+
+static nrf_drv_twi_evt_handler_t m_twi_handler;
+static void *                    m_twi_context;
+static nrf_drv_twi_evt_t         m_twi_event;
+static bool                      m_twi_pending;
+static bus_stats_t               m_bus;
+static uint8_t                   m_regs[DEV_CNT][256];
+static bool                      m_reg_read[DEV_CNT][256];      // Read since the last clear
+static uint8_t                   m_reg_ptr[DEV_CNT];
+
+static uint8_t                   m_frames[MODE_CNT][TWI_POLL_FRAME_SIZE];
+static uint32_t                  m_reads_done;
+static bool                      m_sweep_done;
+static ret_code_t                m_sweep_result;
+
+static int32_t device_get(uint8_t address)
+{
+    for (uint32_t i = 0; i < DEV_CNT; i++)
+    {
+        if (m_devices[i] == address)
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief New readings in every register, as if the sensors sampled again.
+ */
+static void registers_update(uint32_t sweep)
+{
+    for (uint32_t dev = 0; dev < DEV_CNT; dev++)
+    {
+        for (uint32_t reg = 0; reg < 256; reg++)
+        {
+            uint32_t x = (sweep * 2654435761u) ^ (dev << 8 | reg) * 40503u;
+            m_regs[dev][reg] = (uint8_t)((x >> 16) ^ x);
+        }
+    }
+}
+
+/**
+ * @brief Moves bytes between the master and a device: a write sets the register pointer, a read
+ *        returns registers from it on, incrementing it.
+ */
+static void bus_phase(int32_t dev, bool read, uint8_t * p_data, uint8_t length)
+{
+    m_bus.clocks += 1 + 9 + 9 * length;     // START or repeated START, address, data
+    m_bus.bytes  += 1 + length;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (read)
+        {
+            m_reg_read[dev][m_reg_ptr[dev]] = true;
+            p_data[i] = m_regs[dev][m_reg_ptr[dev]++];
+        }
+        else if (i == 0)
+        {
+            m_reg_ptr[dev] = p_data[0];
+        }
+    }
+}
+
+ret_code_t nrf_drv_twi_init(nrf_drv_twi_t const *        p_instance,
+                            nrf_drv_twi_config_t const * p_config,
+                            nrf_drv_twi_evt_handler_t    event_handler,
+                            void *                       p_context)
+{
+    m_twi_handler = event_handler;
+    m_twi_context = p_context;
+    return NRF_SUCCESS;
+}
+
+void nrfx_twim_uninit(nrfx_twim_t const * p_instance)
+{
+}
+
+void nrfx_twim_enable(nrfx_twim_t const * p_instance)
+{
+}
+
+nrfx_err_t nrfx_twim_xfer(nrfx_twim_t           const * p_instance,
+                          nrfx_twim_xfer_desc_t const * p_xfer_desc,
+                          uint32_t                      flags)
+{
+    int32_t dev = device_get(p_xfer_desc->address);
+
+    if (m_twi_pending)
+    {
+        return NRFX_ERROR_BUSY;
+    }
+
+    m_twi_event.type                 = NRF_DRV_TWI_EVT_DONE;
+    m_twi_event.xfer_desc.type       = (nrf_drv_twi_xfer_type_t)p_xfer_desc->type;
+    m_twi_event.xfer_desc.address    = p_xfer_desc->address;
+    if (dev < 0)
+    {
+        m_bus.clocks += 1 + 9 + 1;
+        m_twi_event.type = NRF_DRV_TWI_EVT_ADDRESS_NACK;
+    }
+    else
+    {
+        bus_phase(dev, p_xfer_desc->type == NRFX_TWIM_XFER_RX,
+                  p_xfer_desc->p_primary_buf, p_xfer_desc->primary_length);
+        if ((p_xfer_desc->type == NRFX_TWIM_XFER_TXRX) || (p_xfer_desc->type == NRFX_TWIM_XFER_TXTX))
+        {
+            bus_phase(dev, p_xfer_desc->type == NRFX_TWIM_XFER_TXRX,
+                      p_xfer_desc->p_secondary_buf, p_xfer_desc->secondary_length);
+        }
+        if (!(flags & NRFX_TWIM_FLAG_TX_NO_STOP))
+        {
+            m_bus.clocks += 1;
+        }
+    }
+    m_twi_pending = true;
+    return NRFX_SUCCESS;
+}
+
+/**
+ * @brief Runs the TWI interrupt until the bus is idle.
+ */
+static void bus_run(void)
+{
+    while (m_twi_pending)
+    {
+        m_twi_pending = false;
+        m_bus.irqs++;
+        m_twi_handler(&m_twi_event, m_twi_context);
+    }
+}
+
+static void read_done(ret_code_t result, void * p_register_data)
+{
+    m_sweep_result = (m_sweep_result == NRF_SUCCESS) ? result : m_sweep_result;
+    m_reads_done++;
+}
+
+static void sweep_done(ret_code_t result, uint8_t const * p_frame, void * p_context)
+{
+    memcpy(p_context, p_frame, TWI_POLL_FRAME_SIZE);
+    m_sweep_result = result;
+    m_sweep_done   = true;
+}
+
+/**
+ * @brief One sweep, read by read or with a poller.
+ */
+static ret_code_t sweep_run(uint32_t mode, twi_poll_t * p_poll)
+{
+    ret_code_t err_code;
+
+    m_sweep_result = NRF_SUCCESS;
+    if (mode == MODE_READS)
+    {
+        uint32_t frame_bytes = 0;
+
+        m_reads_done = 0;
+        for (uint32_t i = 0; i < READ_CNT; i++)
+        {
+            err_code = nrf_twi_sensor_reg_read(&m_twi_sensor, m_reads[i].dev_addr, m_reads[i].reg_addr,
+                                               read_done, &m_frames[MODE_READS][frame_bytes], m_reads[i].length);
+            VERIFY_SUCCESS(err_code);
+            frame_bytes += m_reads[i].length;
+            m_bus.transactions++;
+        }
+        bus_run();
+        return (m_reads_done == READ_CNT) ? m_sweep_result : NRF_ERROR_INTERNAL;
+    }
+
+    m_sweep_done = false;
+    err_code = twi_poll_sweep(p_poll);
+    VERIFY_SUCCESS(err_code);
+    m_bus.transactions++;
+    if (twi_poll_sweep(p_poll) != NRF_ERROR_BUSY)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+    bus_run();
+    return m_sweep_done ? m_sweep_result : NRF_ERROR_INTERNAL;
+}
+
+/**
+ * @brief Invalid poller setups are refused.
+ */
+static bool init_check(void)
+{
+    static twi_poll_t        poll;
+    static twi_poll_read_t   many[TWI_POLL_MAX_READS + 1];
+    twi_poll_read_t const    empty  = TWI_POLL_READ(DEV_IMU, 0x28, 0);
+    twi_poll_read_t const    wide[] = {TWI_POLL_READ(DEV_IMU, 0x00, 60), TWI_POLL_READ(DEV_IMU, 0x80, 8)};
+    uint8_t                  frame[TWI_POLL_FRAME_SIZE];
+    bool                     ok = true;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(many); i++)
+    {
+        many[i] = (twi_poll_read_t)TWI_POLL_READ(0x10 + i, 0x00, 1);
+    }
+
+    ok &= twi_poll_init(&poll, &m_twi_mngr, m_reads, 0, 0, sweep_done, frame) == NRF_ERROR_INVALID_PARAM;
+    ok &= twi_poll_init(&poll, &m_twi_mngr, &empty, 1, 0, sweep_done, frame) == NRF_ERROR_INVALID_PARAM;
+    ok &= twi_poll_init(&poll, &m_twi_mngr, many, ARRAY_SIZE(many), 0, sweep_done, frame) == NRF_ERROR_NO_MEM;
+    ok &= twi_poll_init(&poll, &m_twi_mngr, many, TWI_POLL_MAX_BURSTS + 1, 0, sweep_done, frame) == NRF_ERROR_NO_MEM;
+    ok &= twi_poll_init(&poll, &m_twi_mngr, wide, ARRAY_SIZE(wide), 0, sweep_done, frame) == NRF_ERROR_NO_MEM;
+    ok &= twi_poll_init(&poll, &m_twi_mngr, many, TWI_POLL_MAX_BURSTS, 0, sweep_done, frame) == NRF_SUCCESS;
+
+    printf("invalid setups refused %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+/**
+ * @brief Bus cost of a sweep and checks of the frames against the reads.
+ */
+static bool bus_check(twi_poll_t * p_polls)
+{
+    bus_stats_t stats[MODE_CNT];
+    uint32_t    mismatches = 0;
+    uint32_t    stray_reads = 0;
+    uint32_t    errors = 0;
+    uint32_t    frame_bytes = 0;
+
+    for (uint32_t i = 0; i < READ_CNT; i++)
+    {
+        frame_bytes += m_reads[i].length;
+    }
+
+    memset(stats, 0, sizeof(stats));
+    for (uint32_t sweep = 0; sweep < CHECK_SWEEPS; sweep++)
+    {
+        registers_update(sweep);
+        for (uint32_t mode = 0; mode < MODE_CNT; mode++)
+        {
+            memset(m_reg_read, 0, sizeof(m_reg_read));
+            memset(&m_bus, 0, sizeof(m_bus));
+            errors += (sweep_run(mode, &p_polls[mode]) == NRF_SUCCESS) ? 0 : 1;
+            stats[mode] = m_bus;
+
+            if (mode == MODE_GAP_0)
+            {
+                uint32_t asked = 0;
+                uint32_t read  = 0;
+
+                for (uint32_t i = 0; i < READ_CNT; i++)
+                {
+                    for (uint32_t reg = 0; reg < m_reads[i].length; reg++)
+                    {
+                        int32_t dev = device_get(m_reads[i].dev_addr);
+
+                        asked += m_reg_read[dev][m_reads[i].reg_addr + reg] ? 1 : 0;
+                        m_reg_read[dev][m_reads[i].reg_addr + reg] = false;
+                    }
+                }
+                for (uint32_t dev = 0; dev < DEV_CNT; dev++)
+                {
+                    for (uint32_t reg = 0; reg < 256; reg++)
+                    {
+                        read += m_reg_read[dev][reg] ? 1 : 0;
+                    }
+                }
+                stray_reads += read + (frame_bytes - asked);
+            }
+            if ((mode != MODE_READS) && (memcmp(m_frames[mode], m_frames[MODE_READS], frame_bytes) != 0))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    printf("%-8s %8s %8s %8s %8s %10s\n", "sweep", "trans", "irqs", "bytes", "clocks", "bus us");
+    for (uint32_t mode = 0; mode < MODE_CNT; mode++)
+    {
+        printf("%-8s %8u %8u %8u %8u %10.1f\n", m_mode_names[mode], stats[mode].transactions,
+               stats[mode].irqs, stats[mode].bytes, stats[mode].clocks,
+               stats[mode].clocks * 1000.0 / BUS_KHZ);
+    }
+    printf("%u reads, %u bytes of frame, bursts: gap 0 %u, gap %u %u\n", (uint32_t)READ_CNT, frame_bytes,
+           twi_poll_burst_cnt(&p_polls[MODE_GAP_0]), TWI_POLL_MAX_GAP, twi_poll_burst_cnt(&p_polls[MODE_GAP_N]));
+    printf("%u sweeps: %u frames differ from the reads, %u stray register reads at gap 0, %u errors %s\n",
+           CHECK_SWEEPS, mismatches, stray_reads, errors,
+           (mismatches == 0) && (stray_reads == 0) && (errors == 0) ? "ok" : "FAILED");
+
+    return (mismatches == 0) && (stray_reads == 0) && (errors == 0) &&
+           (stats[MODE_GAP_N].irqs < stats[MODE_READS].irqs) &&
+           (stats[MODE_GAP_N].clocks < stats[MODE_READS].clocks);
+}
+
+/**
+ * @brief CPU time of a sweep, through nrf_twi_mngr and the mock bus.
+ */
+static void speed_run(twi_poll_t * p_polls)
+{
+    double best[MODE_CNT];
+
+    for (uint32_t mode = 0; mode < MODE_CNT; mode++)
+    {
+        best[mode] = 1e9;
+        for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+        {
+            uint64_t start = ep_host_now_ns();
+
+            for (uint32_t sweep = 0; sweep < BENCH_SWEEPS; sweep++)
+            {
+                (void)sweep_run(mode, &p_polls[mode]);
+            }
+            best[mode] = MIN(best[mode], (ep_host_now_ns() - start) * 1e-9);
+        }
+    }
+
+    printf("%-8s %12s\n", "sweep", "ns/sweep");
+    for (uint32_t mode = 0; mode < MODE_CNT; mode++)
+    {
+        printf("%-8s %12.1f\n", m_mode_names[mode], best[mode] / BENCH_SWEEPS * 1e9);
+    }
+}
+
+int main(void)
+{
+    static twi_poll_t             polls[MODE_CNT];
+    nrf_drv_twi_config_t const    config = {
+        .scl                = 27,
+        .sda                = 26,
+        .frequency          = NRF_DRV_TWI_FREQ_400K,
+        .interrupt_priority = 6,
+        .clear_bus_init     = false,
+    };
+    uint32_t                      failures = 0;
+
+    printf("twi_poll, %u devices, %u register reads per sweep, bus at %d kHz\n",
+           (uint32_t)DEV_CNT, (uint32_t)READ_CNT, BUS_KHZ);
+
+    if ((nrf_twi_mngr_init(&m_twi_mngr, &config) != NRF_SUCCESS) ||
+        (nrf_twi_sensor_init(&m_twi_sensor) != NRF_SUCCESS) ||
+        (twi_poll_init(&polls[MODE_GAP_0], &m_twi_mngr, m_reads, READ_CNT, 0,
+                       sweep_done, m_frames[MODE_GAP_0]) != NRF_SUCCESS) ||
+        (twi_poll_init(&polls[MODE_GAP_N], &m_twi_mngr, m_reads, READ_CNT, TWI_POLL_MAX_GAP,
+                       sweep_done, m_frames[MODE_GAP_N]) != NRF_SUCCESS))
+    {
+        printf("setup FAILED\n");
+        return 1;
+    }
+
+    failures += init_check() ? 0 : 1;
+    failures += bus_check(polls) ? 0 : 1;
+    speed_run(polls);
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,502 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    uarte_bench.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Segment order and line gaps of nrf_libuarte_async_txv() on a UARTE model.
+ *
+ * The real nrf_libuarte_async and nrf_libuarte_drv run on the UARTE, PPI and
+ * NVIC model of HOST/sim/nrf_uarte_host.c, with a configurable interrupt
+ * latency. Log lines are sent as the three segments of the deferred logger,
+ * colour prefix, text and suffix:
+ *
+ * - tx: one nrf_libuarte_async_tx() per segment, the next one started from
+ *   the TX_DONE event of the previous one.
+ * - txv: one nrf_libuarte_async_txv(), the segments chained over PPI.
+ *
+ * The bytes on the line are checked against the segments, and the idle
+ * time of the line between the segments of a line is measured. Segment
+ * layouts with empty segments, a segment longer than one EasyDMA transfer,
+ * refused calls and segments that cannot be started are checked as well,
+ * the latter with nrf_libuarte_drv_tx() wrapped at link time.
+ *
+ * Built for the POSIX host target only, see the uarte_bench target of
+ * HOST/Makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdk_common.h"
+#include "nrf_libuarte_async.h"
+#include "nrfx_gpiote.h"
+#include "ep_host.h"
+
+#define BENCH_LINES         500
+#define LONG_SEGMENT_SIZE   70000       // Over the 65535 bytes of one EasyDMA transfer
+#define OUTPUT_SIZE         (LONG_SEGMENT_SIZE + 64)
+
+#define BENCH_CHECK(_call)                                  \
+    do {                                                    \
+        if ((_call) != NRF_SUCCESS)                         \
+        {                                                   \
+            printf("%s FAILED\n", #_call);                  \
+            exit(1);                                        \
+        }                                                   \
+    } while (0)
+
+typedef enum {
+    MODE_TX,
+    MODE_TXV,
+} tx_mode_t;
+
+static const struct {
+    nrf_uarte_baudrate_t baudrate;
+    uint32_t             baud;
+} m_baudrates[] = {
+    { NRF_UARTE_BAUDRATE_115200,  115200  },
+    { NRF_UARTE_BAUDRATE_1000000, 1000000 },
+};
+
+static const double m_latencies_us[] = {2.0, 10.0};
+
+/* Interrupt handler of UARTE0 in nrf_libuarte_drv.c, with PRS disabled */
+void UARTE0_UART0_IRQHandler(void);
+
+NRF_LIBUARTE_ASYNC_DEFINE(m_uart, 0, 1, NRF_LIBUARTE_PERIPHERAL_NOT_USED, 2, 64, 3);
+
+/* Segments in RAM, as the deferred logger has them */
+static char m_prefix[] = "\x1B[0m[INF]";
+static char m_suffix[] = "\x1B[0m\r\n";
+static char m_text[128];
+static uint8_t m_long[LONG_SEGMENT_SIZE];
+static uint8_t m_expected[OUTPUT_SIZE];
+
+/* Events of the instance */
+static uint32_t                  m_tx_done;
+static nrf_libuarte_async_data_t m_tx_done_data;
+static uint32_t                  m_tx_errors;
+static nrf_libuarte_async_data_t m_tx_error_data;
+
+/* Segments left to send in MODE_TX */
+static nrf_libuarte_async_data_t const * m_chain;
+static size_t                            m_chain_left;
+
+/* Calls of nrf_libuarte_drv_tx(), and the one to fail */
+static uint32_t m_drv_tx_calls;
+static uint32_t m_drv_tx_fail;
+
+ret_code_t __real_nrf_libuarte_drv_tx(const nrf_libuarte_drv_t * const p_libuarte,
+                                      uint8_t * p_data, size_t len);
+
+ret_code_t __wrap_nrf_libuarte_drv_tx(const nrf_libuarte_drv_t * const p_libuarte,
+                                      uint8_t * p_data, size_t len)
+{
+    if (++m_drv_tx_calls == m_drv_tx_fail)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+    return __real_nrf_libuarte_drv_tx(p_libuarte, p_data, len);
+}
+
+void app_error_handler_bare(ret_code_t error_code)
+{
+    printf("app_error_handler_bare(%u) FAILED\n", (unsigned)error_code);
+    exit(1);
+}
+
+/* Pins set up by nrf_libuarte_drv_init(), see ep_host_nrf.h */
+NRF_GPIO_Type ep_host_gpio[2];
+
+/* The TIMER and RTC instances count RX bytes and time out RX, and GPIOTE drives RTS, which
+ * the bench does not use */
+nrfx_err_t nrfx_timer_init(nrfx_timer_t const * const  p_instance,
+                           nrfx_timer_config_t const * p_config,
+                           nrfx_timer_event_handler_t  timer_event_handler)
+{
+    return NRFX_SUCCESS;
+}
+
+void nrfx_timer_uninit(nrfx_timer_t const * const p_instance)
+{
+}
+
+void nrfx_timer_enable(nrfx_timer_t const * const p_instance)
+{
+}
+
+void nrfx_timer_disable(nrfx_timer_t const * const p_instance)
+{
+}
+
+void nrfx_timer_clear(nrfx_timer_t const * const p_instance)
+{
+}
+
+void nrfx_timer_compare(nrfx_timer_t const * const p_instance,
+                        nrf_timer_cc_channel_t     cc_channel,
+                        uint32_t                   cc_value,
+                        bool                       enable_int)
+{
+}
+
+nrfx_err_t nrfx_rtc_init(nrfx_rtc_t const * const  p_instance,
+                         nrfx_rtc_config_t const * p_config,
+                         nrfx_rtc_handler_t        handler)
+{
+    return NRFX_SUCCESS;
+}
+
+void nrfx_rtc_uninit(nrfx_rtc_t const * const p_instance)
+{
+}
+
+void nrfx_rtc_disable(nrfx_rtc_t const * const p_instance)
+{
+}
+
+nrfx_err_t nrfx_rtc_cc_set(nrfx_rtc_t const * const p_instance,
+                           uint32_t                 channel,
+                           uint32_t                 val,
+                           bool                     enable_irq)
+{
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_gpiote_init(void)
+{
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_gpiote_out_init(nrfx_gpiote_pin_t                pin,
+                                nrfx_gpiote_out_config_t const * p_config)
+{
+    return NRFX_SUCCESS;
+}
+
+void nrfx_gpiote_out_uninit(nrfx_gpiote_pin_t pin)
+{
+}
+
+void nrfx_gpiote_out_task_enable(nrfx_gpiote_pin_t pin)
+{
+}
+
+uint32_t nrfx_gpiote_set_task_addr_get(nrfx_gpiote_pin_t pin)
+{
+    return 0;
+}
+
+uint32_t nrfx_gpiote_clr_task_addr_get(nrfx_gpiote_pin_t pin)
+{
+    return 0;
+}
+
+static void uart_evt_handler(void * context, nrf_libuarte_async_evt_t * p_evt)
+{
+    switch (p_evt->type)
+    {
+        case NRF_LIBUARTE_ASYNC_EVT_TX_DONE:
+            if (m_chain_left > 0)
+            {
+                m_chain_left--;
+                BENCH_CHECK(nrf_libuarte_async_tx(&m_uart, m_chain->p_data, m_chain->length));
+                m_chain++;
+                break;
+            }
+            m_tx_done++;
+            m_tx_done_data = p_evt->data.rxtx;
+            break;
+
+        case NRF_LIBUARTE_ASYNC_EVT_TX_ERROR:
+            m_tx_errors++;
+            m_tx_error_data = p_evt->data.rxtx;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void uart_init(nrf_uarte_baudrate_t baudrate)
+{
+    nrf_libuarte_async_config_t const config = {
+        .tx_pin     = 6,
+        .rx_pin     = 8,
+        .cts_pin    = NRF_UARTE_PSEL_DISCONNECTED,
+        .rts_pin    = NRF_UARTE_PSEL_DISCONNECTED,
+        .timeout_us = 100,
+        .hwfc       = NRF_UARTE_HWFC_DISABLED,
+        .parity     = NRF_UARTE_PARITY_EXCLUDED,
+        .baudrate   = baudrate,
+        .int_prio   = 6,
+    };
+
+    BENCH_CHECK(nrf_libuarte_async_init(&m_uart, &config, uart_evt_handler, NULL));
+    ep_host_uarte_irq_handler_set(0, UARTE0_UART0_IRQHandler);
+}
+
+static void uart_run(void)
+{
+    while (ep_host_uarte_process())
+    {
+    }
+}
+
+static void events_clear(void)
+{
+    m_tx_done   = 0;
+    m_tx_errors = 0;
+    memset(&m_tx_done_data, 0, sizeof(m_tx_done_data));
+    memset(&m_tx_error_data, 0, sizeof(m_tx_error_data));
+}
+
+static size_t expected_append(size_t offset, nrf_libuarte_async_data_t const * p_segments, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        memcpy(&m_expected[offset], p_segments[i].p_data, p_segments[i].length);
+        offset += p_segments[i].length;
+    }
+    return offset;
+}
+
+static bool output_check(size_t expected_len)
+{
+    uint8_t const * p_out;
+    size_t          out_len = ep_host_uarte_output_get(0, &p_out);
+
+    return (out_len == expected_len) && (memcmp(p_out, m_expected, expected_len) == 0);
+}
+
+/**
+ * @brief Sends a segment list in a mode and runs the UARTE until it is idle.
+ * @return true if one TX_DONE event reported all bytes
+ */
+static bool segments_send(tx_mode_t mode, nrf_libuarte_async_data_t const * p_segments, size_t count)
+{
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        total += p_segments[i].length;
+    }
+    events_clear();
+    if (mode == MODE_TX)
+    {
+        m_chain      = &p_segments[1];
+        m_chain_left = count - 1;
+        BENCH_CHECK(nrf_libuarte_async_tx(&m_uart, p_segments[0].p_data, p_segments[0].length));
+    }
+    else
+    {
+        BENCH_CHECK(nrf_libuarte_async_txv(&m_uart, p_segments, count));
+    }
+    uart_run();
+
+    return (m_tx_done == 1) && (m_tx_errors == 0) &&
+           (m_tx_done_data.length == ((mode == MODE_TX) ? p_segments[count - 1].length : total));
+}
+
+/**
+ * @brief Log lines of varying length, in one mode
+ */
+static bool lines_run(uint32_t baud, double latency_us, tx_mode_t mode)
+{
+    double   start  = ep_host_uarte_now_us();
+    double   gap_us = 0;
+    uint32_t irqs   = 0;
+    bool     ok     = true;
+
+    ep_host_uarte_irq_latency_set(latency_us);
+    for (uint32_t line = 0; line < BENCH_LINES; line++)
+    {
+        nrf_libuarte_async_data_t segments[3];
+        ep_host_uarte_stats_t     stats;
+        int                       len;
+
+        len = snprintf(m_text, sizeof(m_text), "[%08lu] sensor %lu: %*lu mV",
+                       (unsigned long)line * 7, (unsigned long)(line % 5),
+                       (int)(line % 40), (unsigned long)line * 13 % 3300);
+        segments[0] = (nrf_libuarte_async_data_t){ (uint8_t *)m_prefix, sizeof(m_prefix) - 1 };
+        segments[1] = (nrf_libuarte_async_data_t){ (uint8_t *)m_text, (size_t)len };
+        segments[2] = (nrf_libuarte_async_data_t){ (uint8_t *)m_suffix, sizeof(m_suffix) - 1 };
+
+        ep_host_uarte_stats_clear(0);
+        ok &= segments_send(mode, segments, ARRAY_SIZE(segments));
+        ok &= output_check(expected_append(0, segments, ARRAY_SIZE(segments)));
+
+        stats = ep_host_uarte_stats_get(0);
+        ok &= (stats.errors == 0) && (stats.transfers == ARRAY_SIZE(segments));
+        ok &= (mode == MODE_TX) || (stats.gaps == 0);
+        gap_us += stats.gap_us;
+        irqs   += stats.irqs;
+    }
+    printf("%-5s %8lu %8.1f %10.1f %10.2f %8.2f\n", (mode == MODE_TX) ? "tx" : "txv",
+           (unsigned long)baud, latency_us, (ep_host_uarte_now_us() - start) / BENCH_LINES,
+           gap_us / BENCH_LINES, (double)irqs / BENCH_LINES);
+    if (!ok)
+    {
+        printf("log lines FAILED\n");
+    }
+    return ok;
+}
+
+/**
+ * @brief Layouts with empty segments and a segment longer than one EasyDMA transfer
+ */
+static bool layouts_check(void)
+{
+    static char a[] = "first,";
+    static char b[] = "second,";
+    static char c[] = "third";
+    nrf_libuarte_async_data_t const sparse[] = {
+        { (uint8_t *)a, 0 },
+        { (uint8_t *)a, sizeof(a) - 1 },
+        { (uint8_t *)b, 0 },
+        { (uint8_t *)b, sizeof(b) - 1 },
+        { (uint8_t *)c, sizeof(c) - 1 },
+        { (uint8_t *)c, 0 },
+    };
+    nrf_libuarte_async_data_t const single[] = {
+        { (uint8_t *)c, sizeof(c) - 1 },
+    };
+    nrf_libuarte_async_data_t const with_long[] = {
+        { (uint8_t *)a, sizeof(a) - 1 },
+        { m_long, sizeof(m_long) },
+        { (uint8_t *)c, sizeof(c) - 1 },
+    };
+    ep_host_uarte_stats_t stats;
+    bool                  ok = true;
+
+    ep_host_uarte_stats_clear(0);
+    ok &= segments_send(MODE_TXV, sparse, ARRAY_SIZE(sparse));
+    ok &= output_check(expected_append(0, sparse, ARRAY_SIZE(sparse)));
+    ok &= (m_tx_done_data.p_data == sparse[0].p_data);
+    ok &= (ep_host_uarte_stats_get(0).gaps == 0);
+
+    ep_host_uarte_stats_clear(0);
+    ok &= segments_send(MODE_TXV, single, ARRAY_SIZE(single));
+    ok &= output_check(expected_append(0, single, ARRAY_SIZE(single)));
+
+    /* The long segment is started from TX_DONE of the previous one, and the next one from its own */
+    ep_host_uarte_stats_clear(0);
+    ok &= segments_send(MODE_TXV, with_long, ARRAY_SIZE(with_long));
+    ok &= output_check(expected_append(0, with_long, ARRAY_SIZE(with_long)));
+    stats = ep_host_uarte_stats_get(0);
+    ok &= (stats.errors == 0) && (stats.gaps == 2);
+
+    printf("segment layouts %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+/**
+ * @brief Calls refused, and segments that cannot be started
+ */
+static bool errors_check(void)
+{
+    static char a[] = "first,";
+    static char c[] = "third";
+    nrf_libuarte_async_data_t const empty[] = {
+        { (uint8_t *)a, 0 },
+        { (uint8_t *)c, 0 },
+    };
+    nrf_libuarte_async_data_t const with_long[] = {
+        { (uint8_t *)a, sizeof(a) - 1 },
+        { m_long, sizeof(m_long) },
+        { (uint8_t *)c, sizeof(c) - 1 },
+    };
+    bool ok = true;
+
+    ok &= nrf_libuarte_async_txv(&m_uart, empty, ARRAY_SIZE(empty)) == NRF_ERROR_INVALID_LENGTH;
+    ok &= nrf_libuarte_async_txv(&m_uart, empty, 0) == NRF_ERROR_INVALID_LENGTH;
+
+    /* Busy until TX_DONE, for both functions */
+    events_clear();
+    ep_host_uarte_stats_clear(0);
+    ok &= nrf_libuarte_async_txv(&m_uart, with_long, 1) == NRF_SUCCESS;
+    ok &= nrf_libuarte_async_txv(&m_uart, with_long, 1) == NRF_ERROR_BUSY;
+    ok &= nrf_libuarte_async_tx(&m_uart, (uint8_t *)c, sizeof(c) - 1) == NRF_ERROR_BUSY;
+    uart_run();
+    ok &= (m_tx_done == 1) && output_check(expected_append(0, with_long, 1));
+
+    /* The first segment fails: nothing is sent and no event is generated */
+    events_clear();
+    ep_host_uarte_stats_clear(0);
+    m_drv_tx_calls = 0;
+    m_drv_tx_fail  = 1;
+    ok &= nrf_libuarte_async_txv(&m_uart, with_long, ARRAY_SIZE(with_long)) == NRF_ERROR_INTERNAL;
+    uart_run();
+    ok &= (m_tx_done == 0) && (m_tx_errors == 0) && output_check(0);
+
+    /* The long segment fails: TX_ERROR with it, then TX_DONE with the bytes sent before it */
+    events_clear();
+    ep_host_uarte_stats_clear(0);
+    m_drv_tx_calls = 0;
+    m_drv_tx_fail  = 2;
+    ok &= nrf_libuarte_async_txv(&m_uart, with_long, ARRAY_SIZE(with_long)) == NRF_SUCCESS;
+    uart_run();
+    ok &= (m_tx_errors == 1) && (m_tx_error_data.p_data == m_long) &&
+          (m_tx_error_data.length == sizeof(m_long));
+    ok &= (m_tx_done == 1) && (m_tx_done_data.length == with_long[0].length);
+    ok &= output_check(expected_append(0, with_long, 1));
+    m_drv_tx_fail = 0;
+
+    /* And the instance is usable again */
+    ep_host_uarte_stats_clear(0);
+    ok &= segments_send(MODE_TXV, with_long, ARRAY_SIZE(with_long));
+    ok &= output_check(expected_append(0, with_long, ARRAY_SIZE(with_long)));
+
+    printf("refused calls and failed segments %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+
+    printf("nrf_libuarte_async on the UARTE model, %d log lines of 3 segments\n", BENCH_LINES);
+
+    for (uint32_t i = 0; i < sizeof(m_long); i++)
+    {
+        m_long[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    printf("%-5s %8s %8s %10s %10s %8s\n", "mode", "baud", "irq us", "us/line", "gap us", "irqs");
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_baudrates); i++)
+    {
+        uart_init(m_baudrates[i].baudrate);
+        for (uint32_t j = 0; j < ARRAY_SIZE(m_latencies_us); j++)
+        {
+            failures += lines_run(m_baudrates[i].baud, m_latencies_us[j], MODE_TX) ? 0 : 1;
+            failures += lines_run(m_baudrates[i].baud, m_latencies_us[j], MODE_TXV) ? 0 : 1;
+        }
+        nrf_libuarte_async_uninit(&m_uart);
+    }
+
+    uart_init(NRF_UARTE_BAUDRATE_1000000);
+    ep_host_uarte_irq_latency_set(m_latencies_us[0]);
+    failures += layouts_check() ? 0 : 1;
+    failures += errors_check() ? 0 : 1;
+    printf("%s\n\n", failures ? "FAILED" : "passed");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    FreeRTOSConfig.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief FreeRTOS configuration of the POSIX host build.
+ *
+ * Kernel settings follow config/FreeRTOSConfig.h so the scheduler behaves
+ * like on the nRF52840. Only the Cortex-M specific parts are left out.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Possible configurations for system timer
+ */
+#define FREERTOS_USE_RTC      0 /**< Use real time clock for the system */
+#define FREERTOS_USE_SYSTICK  1 /**< Use SysTick timer for system */
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *----------------------------------------------------------*/
+
+/* The virtual clock of the host port stands in for the RTC */
+#define configTICK_SOURCE FREERTOS_USE_RTC
+
+/* Set to 1 to collect per task CPU time, stack high-water marks and context switches, see rtos_stats.h */
+#ifndef RTOS_STATS_ENABLED
+#define RTOS_STATS_ENABLED                                                        0
+#endif
+/* No DWT or TIMER on the host, the clock comes from HOST/sim/ep_bsp_host.c */
+#define RTOS_STATS_CLOCK                                                          2 /* RTOS_STATS_CLOCK_EXTERNAL */
+/* heap_3 keeps no free byte count */
+#define RTOS_STATS_HEAP_INFO                                                      0
+
+#define configUSE_PREEMPTION                                                      1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION                                   0
+#define configUSE_TICKLESS_IDLE                                                   1
+#define configCPU_CLOCK_HZ                                                        ( 64000000UL )
+#define configTICK_RATE_HZ                                                        1024
+#define configMAX_PRIORITIES                                                      ( 5 )
+#define configMINIMAL_STACK_SIZE                                                  ( 60 )
+#define configMAX_TASK_NAME_LEN                                                   ( 4 )
+#define configUSE_16_BIT_TICKS                                                    0
+#define configIDLE_SHOULD_YIELD                                                   1
+#define configUSE_MUTEXES                                                         1
+#define configUSE_RECURSIVE_MUTEXES                                               1
+#define configUSE_COUNTING_SEMAPHORES                                             1
+#define configUSE_ALTERNATIVE_API                                                 0    /* Deprecated! */
+#define configQUEUE_REGISTRY_SIZE                                                 2
+#define configUSE_QUEUE_SETS                                                      0
+#define configUSE_TIME_SLICING                                                    1
+#define configUSE_NEWLIB_REENTRANT                                                0
+#define configENABLE_BACKWARD_COMPATIBILITY                                       1
+/* Set to 1 to place the kernel tasks, LEDTask and the deferred log task in
+ * .bss. The heap then only holds the objects created by the epSDK library.
+ * The heap sizes are those of config/FreeRTOSConfig.h, see the RAM figures there. */
+#define configSUPPORT_STATIC_ALLOCATION                                           0
+#define configSUPPORT_DYNAMIC_ALLOCATION                                          1
+#if configSUPPORT_STATIC_ALLOCATION
+#define configTOTAL_HEAP_SIZE                                                     ( 28672 )
+#else
+#define configTOTAL_HEAP_SIZE                                                     ( 32768 )
+#endif
+
+/* Hook function related definitions. The idle hook drives the virtual tick. */
+#define configUSE_IDLE_HOOK                                                       1
+#define configUSE_TICK_HOOK                                                       0
+#define configCHECK_FOR_STACK_OVERFLOW                                            ( RTOS_STATS_ENABLED ? 2 : 0 )
+#define configUSE_MALLOC_FAILED_HOOK                                              0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS                                             RTOS_STATS_ENABLED
+#define configUSE_TRACE_FACILITY                                                  RTOS_STATS_ENABLED
+#define configUSE_STATS_FORMATTING_FUNCTIONS                                      0
+
+#if RTOS_STATS_ENABLED
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()                                  rtos_stats_clock_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()                                          rtos_stats_clock()
+#define traceTASK_SWITCHED_IN()                                                   rtos_stats_task_switched_in( pxCurrentTCB->uxTCBNumber )
+/* The port calls traceISR_ENTER()/traceISR_EXIT() from the tick interrupt only */
+#define traceISR_ENTER()                                                          rtos_stats_tick_isr_enter()
+#define traceISR_EXIT()                                                           rtos_stats_tick_isr_exit()
+#endif
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                                                     0
+#define configMAX_CO_ROUTINE_PRIORITIES                                           ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS                                                          ( 1 )
+#define configTIMER_TASK_PRIORITY                                                 ( 2 )
+#define configTIMER_QUEUE_LENGTH                                                  ( 32 )
+#define configTIMER_TASK_STACK_DEPTH                                              ( 1024 )
+
+/* Tickless Idle configuration. */
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP                                     2
+
+/* Define to trap errors during development. */
+#define configASSERT( x )                                                         assert( x )
+
+#if RTOS_STATS_ENABLED
+#include "rtos_stats.h"
+#endif
+
+/* Heap trace for HOST/bench/heap_replay.c, written when EP_HOST_HEAP_TRACE names a file.
+ * A freed block is traced by its address value only, the pointer is not used after free(). */
+void vPortTraceMalloc( void * pvAddress, size_t xSize );
+void vPortTraceFree( uintptr_t uxAddress );
+#define traceMALLOC( pvAddress, uiSize )                                          vPortTraceMalloc( pvAddress, uiSize )
+#define traceFREE( pvAddress, uiSize )                                            vPortTraceFree( ( uintptr_t ) ( pvAddress ) )
+
+/* Optional functions - most linkers will remove unused functions anyway. */
+#define INCLUDE_vTaskPrioritySet                                                  1
+#define INCLUDE_uxTaskPriorityGet                                                 1
+#define INCLUDE_vTaskDelete                                                       1
+#define INCLUDE_vTaskSuspend                                                      1
+#define INCLUDE_xResumeFromISR                                                    1
+#define INCLUDE_vTaskDelayUntil                                                   1
+#define INCLUDE_vTaskDelay                                                        1
+#define INCLUDE_xTaskGetSchedulerState                                            1
+#define INCLUDE_xTaskGetCurrentTaskHandle                                         1
+#define INCLUDE_uxTaskGetStackHighWaterMark                                       1
+#define INCLUDE_xTaskGetIdleTaskHandle                                            1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle                                    1
+#define INCLUDE_pcTaskGetTaskName                                                 1
+#define INCLUDE_eTaskGetState                                                     1
+#define INCLUDE_xEventGroupSetBitFromISR                                          1
+#define INCLUDE_xTimerPendFunctionCall                                            1
+
+#endif /* FREERTOS_CONFIG_H */
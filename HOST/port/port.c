@@ -0,0 +1,361 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    port.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief FreeRTOS port for the POSIX host build.
+ *
+ * Each task owns a pthread that blocks on its own semaphore until the
+ * scheduler selects the task. A context switch posts the semaphore of the
+ * next task and waits on the semaphore of the current one, so exactly one
+ * task thread runs at any time and no signals are involved.
+ *
+ * The tick is virtual. It is generated by the idle task, one tick per idle
+ * loop, and the tickless idle hook jumps straight to the next task unblock
+ * time. A simulation therefore runs as fast as the host allows and is
+ * reproducible. Tasks that never block stop the virtual clock.
+ *
+ * Environment variables:
+ *  EP_HOST_RUN_MS    Virtual run time in ms, after which the process exits. 0 runs forever.
+ *  EP_HOST_REALTIME  Set to 1 to pace the virtual clock against the wall clock.
+ *  EP_HOST_HEAP_TRACE File to record the pvPortMalloc/vPortFree calls to, for HOST/bench/heap_replay.c.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ep_host.h"
+
+/* Per task thread control block, kept at the top of the task stack */
+typedef struct {
+    pthread_t       thread;
+    sem_t           run;
+    TaskFunction_t  pxCode;
+    void *          pvParams;
+} Thread_t;
+
+static volatile UBaseType_t uxCriticalNesting;
+static volatile BaseType_t  xSwitchPending;
+
+static uint64_t m_ticks;            // Virtual ticks since the scheduler started
+static uint64_t m_end_ticks;        // Virtual tick at which the simulation ends, 0 for never
+static uint64_t m_context_switches;
+static uint64_t m_idle_jumps;
+static bool     m_realtime;
+static struct timespec m_wall_start;
+
+static Thread_t * prvGetThreadFromTask( TaskHandle_t xTask )
+{
+    StackType_t * pxTopOfStack = *( StackType_t ** ) xTask;
+
+    return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+
+static void prvWaitToRun( Thread_t * pxThread )
+{
+    while( sem_wait( &pxThread->run ) != 0 )
+    {
+        /* Interrupted, keep waiting */
+    }
+}
+
+static void * prvThreadEntry( void * pvParam )
+{
+    Thread_t * pxThread = ( Thread_t * ) pvParam;
+
+    prvWaitToRun( pxThread );
+    pxThread->pxCode( pxThread->pvParams );
+
+    /* Tasks must not return, delete the task the same way the target would fault */
+    vTaskDelete( NULL );
+    return NULL;
+}
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+    Thread_t *      pxThread;
+    pthread_attr_t  xAttr;
+    int             iError;
+
+    /* The stack itself is unused, the pthread owns a stack of its own */
+    pxThread = ( Thread_t * ) ( ( ( uintptr_t ) pxTopOfStack - sizeof( Thread_t ) ) & ~( ( uintptr_t ) portBYTE_ALIGNMENT_MASK ) );
+    memset( pxThread, 0, sizeof( Thread_t ) );
+    pxThread->pxCode   = pxCode;
+    pxThread->pvParams = pvParameters;
+    sem_init( &pxThread->run, 0, 0 );
+
+    pthread_attr_init( &xAttr );
+    pthread_attr_setdetachstate( &xAttr, PTHREAD_CREATE_JOINABLE );
+    iError = pthread_create( &pxThread->thread, &xAttr, prvThreadEntry, pxThread );
+    pthread_attr_destroy( &xAttr );
+    configASSERT( iError == 0 );
+    ( void ) iError;
+
+    return ( StackType_t * ) pxThread - 1;
+}
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+    /* The thread is blocked in sem_wait, which is a cancellation point */
+    pthread_cancel( pxThread->thread );
+    pthread_join( pxThread->thread, NULL );
+    sem_destroy( &pxThread->run );
+}
+
+static void prvSwitchContext( void )
+{
+    Thread_t * pxFrom = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    Thread_t * pxTo;
+
+    vTaskSwitchContext();
+    pxTo = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    if( pxTo != pxFrom )
+    {
+        m_context_switches++;
+        sem_post( &pxTo->run );
+        prvWaitToRun( pxFrom );
+    }
+}
+
+void vPortYield( void )
+{
+    if( uxCriticalNesting != 0 )
+    {
+        /* Same as a pended PendSV, switch when the critical section is left */
+        xSwitchPending = pdTRUE;
+        return;
+    }
+
+    xSwitchPending = pdFALSE;
+    prvSwitchContext();
+}
+
+void vPortYieldFromISR( void )
+{
+    vPortYield();
+}
+
+void vPortEnterCritical( void )
+{
+    uxCriticalNesting++;
+}
+
+void vPortExitCritical( void )
+{
+    configASSERT( uxCriticalNesting != 0 );
+    uxCriticalNesting--;
+
+    if( ( uxCriticalNesting == 0 ) && ( xSwitchPending != pdFALSE ) &&
+        ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) )
+    {
+        vPortYield();
+    }
+}
+
+static uint64_t prvWallNs( void )
+{
+    struct timespec xNow;
+
+    clock_gettime( CLOCK_MONOTONIC, &xNow );
+    return ( uint64_t ) ( xNow.tv_sec - m_wall_start.tv_sec ) * 1000000000ULL +
+           ( uint64_t ) xNow.tv_nsec - ( uint64_t ) m_wall_start.tv_nsec;
+}
+
+static void prvPace( void )
+{
+    if( !m_realtime )
+    {
+        return;
+    }
+
+    uint64_t ullVirtualNs = m_ticks * 1000000000ULL / configTICK_RATE_HZ;
+    uint64_t ullWallNs    = prvWallNs();
+
+    if( ullVirtualNs > ullWallNs )
+    {
+        struct timespec xDelay;
+
+        xDelay.tv_sec  = ( time_t ) ( ( ullVirtualNs - ullWallNs ) / 1000000000ULL );
+        xDelay.tv_nsec = ( long ) ( ( ullVirtualNs - ullWallNs ) % 1000000000ULL );
+        nanosleep( &xDelay, NULL );
+    }
+}
+
+static void prvCheckEnd( void )
+{
+    if( ( m_end_ticks != 0 ) && ( m_ticks >= m_end_ticks ) )
+    {
+        double dWallMs = ( double ) prvWallNs() / 1e6;
+
+        fflush( stdout );
+        fprintf( stderr, "\n[host] virtual time %llu ms, wall time %.1f ms, ticks %llu, idle jumps %llu, context switches %llu\n",
+                 ( unsigned long long ) ( m_ticks * 1000ULL / configTICK_RATE_HZ ), dWallMs,
+                 ( unsigned long long ) m_ticks, ( unsigned long long ) m_idle_jumps,
+                 ( unsigned long long ) m_context_switches );
+        exit( EXIT_SUCCESS );
+    }
+}
+
+/* The tick interrupt of the target */
+static void prvTick( void )
+{
+    BaseType_t xSwitchRequired;
+
+    m_ticks++;
+    prvPace();
+
+    traceISR_ENTER();
+    vPortEnterCritical();
+    xSwitchRequired = xTaskIncrementTick();
+    vPortExitCritical();
+    traceISR_EXIT();
+
+    if( xSwitchRequired != pdFALSE )
+    {
+        vPortYield();
+    }
+}
+
+void vApplicationIdleHook( void )
+{
+    prvCheckEnd();
+    prvTick();
+}
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    /* Called by the idle task with the scheduler suspended. Step to one tick
+    before the unblock time, the last tick is pended and processed by
+    xTaskResumeAll() like a tick that arrived while sleeping. */
+    TickType_t xJump = xExpectedIdleTime - 1;
+
+    if( ( m_end_ticks != 0 ) && ( m_ticks + xJump + 1 > m_end_ticks ) )
+    {
+        xJump = ( m_ticks < m_end_ticks ) ? ( TickType_t ) ( m_end_ticks - m_ticks - 1 ) : 0;
+    }
+
+    if( xJump != 0 )
+    {
+        vTaskStepTick( xJump );
+        m_ticks += xJump;
+        m_idle_jumps++;
+    }
+
+    prvTick();
+}
+
+BaseType_t xPortStartScheduler( void )
+{
+    const char * pcRunMs    = getenv( "EP_HOST_RUN_MS" );
+    const char * pcRealtime = getenv( "EP_HOST_REALTIME" );
+    sem_t        xEnd;
+
+    if( pcRunMs != NULL )
+    {
+        m_end_ticks = strtoull( pcRunMs, NULL, 0 ) * configTICK_RATE_HZ / 1000ULL;
+    }
+    m_realtime = ( pcRealtime != NULL ) && ( atoi( pcRealtime ) != 0 );
+    clock_gettime( CLOCK_MONOTONIC, &m_wall_start );
+
+    /* vTaskStartScheduler() leaves the kernel with interrupts disabled */
+    uxCriticalNesting = 0;
+    xSwitchPending    = pdFALSE;
+
+    sem_post( &prvGetThreadFromTask( xTaskGetCurrentTaskHandle() )->run );
+
+    /* The main thread is not a task, it only waits for the process to exit */
+    sem_init( &xEnd, 0, 0 );
+    for( ;; )
+    {
+        sem_wait( &xEnd );
+    }
+
+    return pdFALSE;
+}
+
+void vPortEndScheduler( void )
+{
+    fflush( stdout );
+    exit( EXIT_SUCCESS );
+}
+
+uint64_t ep_host_ticks_get( void )
+{
+    return m_ticks;
+}
+
+uint64_t ep_host_context_switches_get( void )
+{
+    return m_context_switches;
+}
+/*-----------------------------------------------------------*/
+
+/* Heap trace, one "m <address> <size>" or "f <address>" line per call. Called
+with the scheduler suspended, so the trace is in call order. */
+static FILE * prvHeapTraceFile( void )
+{
+    static bool   xOpened;
+    static FILE * pxFile;
+
+    if( !xOpened )
+    {
+        const char * pcPath = getenv( "EP_HOST_HEAP_TRACE" );
+
+        xOpened = true;
+        if( pcPath != NULL )
+        {
+            pxFile = fopen( pcPath, "w" );
+        }
+    }
+
+    return pxFile;
+}
+
+void vPortTraceMalloc( void * pvAddress, size_t xSize )
+{
+    FILE * pxFile = prvHeapTraceFile();
+
+    if( ( pxFile != NULL ) && ( pvAddress != NULL ) )
+    {
+        fprintf( pxFile, "m %p %zu\n", pvAddress, xSize );
+        fflush( pxFile );
+    }
+}
+
+void vPortTraceFree( uintptr_t uxAddress )
+{
+    FILE * pxFile = prvHeapTraceFile();
+
+    if( ( pxFile != NULL ) && ( uxAddress != 0 ) )
+    {
+        fprintf( pxFile, "f 0x%" PRIxPTR "\n", uxAddress );
+        fflush( pxFile );
+    }
+}
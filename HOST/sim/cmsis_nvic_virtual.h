@@ -0,0 +1,51 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    cmsis_nvic_virtual.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief NVIC access of CMSIS, for the POSIX host benches with peripheral models.
+ *
+ * Included by core_cm4.h when CMSIS_NVIC_VIRTUAL is defined. Enabling,
+ * disabling and pending an interrupt go to the NVIC stand-in of
+ * nrf_uarte_host.c, which delivers the interrupts of the models. The other
+ * functions are not used by the code built for the host.
+ */
+
+#ifndef EP_HOST_CMSIS_NVIC_VIRTUAL_H
+#define EP_HOST_CMSIS_NVIC_VIRTUAL_H
+
+#include <stdint.h>
+
+void     ep_host_nvic_enable(IRQn_Type irqn);
+void     ep_host_nvic_disable(IRQn_Type irqn);
+uint32_t ep_host_nvic_enabled(IRQn_Type irqn);
+void     ep_host_nvic_pending_set(IRQn_Type irqn, uint32_t pending);
+uint32_t ep_host_nvic_pending_get(IRQn_Type irqn);
+void     ep_host_nvic_priority_set(IRQn_Type irqn, uint32_t priority);
+uint32_t ep_host_nvic_priority_get(IRQn_Type irqn);
+
+#define NVIC_EnableIRQ(irqn)                ep_host_nvic_enable(irqn)
+#define NVIC_DisableIRQ(irqn)               ep_host_nvic_disable(irqn)
+#define NVIC_GetEnableIRQ(irqn)             ep_host_nvic_enabled(irqn)
+#define NVIC_SetPendingIRQ(irqn)            ep_host_nvic_pending_set((irqn), 1)
+#define NVIC_ClearPendingIRQ(irqn)          ep_host_nvic_pending_set((irqn), 0)
+#define NVIC_GetPendingIRQ(irqn)            ep_host_nvic_pending_get(irqn)
+#define NVIC_SetPriority(irqn, priority)    ep_host_nvic_priority_set((irqn), (priority))
+#define NVIC_GetPriority(irqn)              ep_host_nvic_priority_get(irqn)
+
+#endif // EP_HOST_CMSIS_NVIC_VIRTUAL_H
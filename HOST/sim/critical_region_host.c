@@ -0,0 +1,99 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    critical_region_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host stand-in for the critical region helpers of app_util_platform.
+ *
+ * On the target CRITICAL_REGION_ENTER() masks the interrupts. On the host it
+ * is one of:
+ * - the FreeRTOS critical section of the host port, when built with
+ *   EP_HOST_CRITICAL_REGION_KERNEL set to 1, for programs running on the
+ *   scheduler: a yield inside the region is held back until its end, as the
+ *   PendSV interrupt is on the target,
+ * - otherwise one mutex, taken by the outermost region of each thread, for
+ *   the benches whose interrupts and tasks are plain threads or run on the
+ *   bench thread.
+ * Both count the regions entered, see ep_host_critical_regions_get().
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "app_util_platform.h"
+#include "ep_host.h"
+
+#ifndef EP_HOST_CRITICAL_REGION_KERNEL
+#define EP_HOST_CRITICAL_REGION_KERNEL  0
+#endif
+
+#if EP_HOST_CRITICAL_REGION_KERNEL
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+static uint64_t m_regions;      // Only changed inside a region
+
+#if EP_HOST_CRITICAL_REGION_KERNEL
+
+void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    UNUSED_PARAMETER(p_nested);
+    vPortEnterCritical();
+    m_regions++;
+}
+
+void app_util_critical_region_exit(uint8_t nested)
+{
+    UNUSED_PARAMETER(nested);
+    vPortExitCritical();
+}
+
+#else
+
+static pthread_mutex_t   m_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread uint32_t m_nesting;
+
+void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    UNUSED_PARAMETER(p_nested);
+    if (m_nesting++ == 0)
+    {
+        pthread_mutex_lock(&m_mutex);
+    }
+    m_regions++;
+}
+
+void app_util_critical_region_exit(uint8_t nested)
+{
+    UNUSED_PARAMETER(nested);
+    if (--m_nesting == 0)
+    {
+        pthread_mutex_unlock(&m_mutex);
+    }
+}
+
+#endif // EP_HOST_CRITICAL_REGION_KERNEL
+
+uint64_t ep_host_critical_regions_get(void)
+{
+    return __atomic_load_n(&m_regions, __ATOMIC_RELAXED);
+}
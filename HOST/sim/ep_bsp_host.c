@@ -0,0 +1,114 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    ep_bsp_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host stand-in for ep_bsp and the app_error handlers.
+ * The critical region helpers are in critical_region_host.c.
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ep_bsp.h"
+#include "ep_host.h"
+#include "app_error.h"
+#include "app_util_platform.h"
+#include "rtos_stats.h"
+
+/* Simulated GPIO ports, see ep_host_nrf.h */
+NRF_GPIO_Type ep_host_gpio[2];
+
+nrf_drv_wdt_channel_id m_channel_id;
+
+/* Battery voltage reported by ep_bsp_read_battery_voltage */
+#define HOST_BATTERY_VOLTAGE    3.7f
+
+static uint32_t m_wdt_reload_rate;
+
+void ep_bsp_init( uint32_t reloadValue, uint32_t reloadRate )
+{
+    // The watchdog is not simulated, the values are only kept for inspection
+    watchdogReload = reloadValue;
+    m_wdt_reload_rate = reloadRate;
+    m_channel_id = 0;
+}
+
+float ep_bsp_read_battery_voltage()
+{
+    return HOST_BATTERY_VOLTAGE;
+}
+
+/*-----------------------------------------------------------*/
+
+#if RTOS_STATS_ENABLED
+/* Run-time stats clock, the wall time of the host in microseconds */
+static struct timespec m_stats_start;
+
+void rtos_stats_clock_init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &m_stats_start);
+}
+
+uint32_t rtos_stats_clock(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - m_stats_start.tv_sec) * 1000000LL +
+                      (now.tv_nsec - m_stats_start.tv_nsec) / 1000);
+}
+
+/*-----------------------------------------------------------*/
+#endif
+
+/* The SDK passes error_info_t pointers as uint32_t, which does not hold a host
+pointer. The handlers below print what they received and stop the simulation. */
+
+static void host_fault(const char * p_what, uint32_t code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    fflush(stdout);
+    fprintf(stderr, "\n[host] %s 0x%08lx at %s:%lu, tick %llu\n", p_what, (unsigned long)code,
+            p_file_name ? (const char *)p_file_name : "?", (unsigned long)line_num,
+            (unsigned long long)ep_host_ticks_get());
+    abort();
+}
+
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    UNUSED_PARAMETER(pc);
+    UNUSED_PARAMETER(info);
+    host_fault("fault id", id, 0, NULL);
+}
+
+void app_error_handler(ret_code_t error_code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    host_fault("error code", error_code, line_num, p_file_name);
+}
+
+void app_error_handler_bare(ret_code_t error_code)
+{
+    host_fault("error code", error_code, 0, NULL);
+}
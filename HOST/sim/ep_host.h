@@ -0,0 +1,224 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    ep_host.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief Simulation interface of the POSIX host build.
+ *
+ * The host build links the stand-ins in HOST/sim instead of epBlinkyLibrary.a.
+ * They keep the API of ep_bsp.h, led_helper.h, time_helper.h and uart_helper.h,
+ * with the debug UART written to stdout and the RTC driven by the virtual
+ * clock of the host FreeRTOS port.
+ */
+
+#ifndef EP_HOST_H
+#define EP_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gets the virtual clock
+ * @return uint64_t FreeRTOS ticks elapsed since the scheduler was started
+ */
+uint64_t ep_host_ticks_get(void);
+
+/**
+ * @brief Gets the number of context switches performed by the host port
+ * @return uint64_t Number of context switches since the scheduler was started
+ */
+uint64_t ep_host_context_switches_get(void);
+
+/**
+ * @brief Gets the monotonic wall clock of the host, see clock_host.c
+ * @return uint64_t Nanoseconds since an arbitrary start
+ */
+uint64_t ep_host_now_ns(void);
+
+/**
+ * @brief Gets the number of critical regions entered, see critical_region_host.c
+ * @return uint64_t Calls to app_util_critical_region_enter(), nested ones included
+ */
+uint64_t ep_host_critical_regions_get(void);
+
+/**
+ * @brief Gets the state of the simulated LEDs
+ * @return uint8_t Bit n set when LED n+1 is on
+ */
+uint8_t ep_host_led_state_get(void);
+
+/** Size of the simulated flash, at the end of the code area of NRF_FICR */
+#define EP_HOST_FLASH_SIZE          (128 * 1024)
+
+/** Exit status of a process stopped by ep_host_flash_power_cut() */
+#define EP_HOST_FLASH_POWER_CUT     99
+
+/** Flash timing of the nRF52840, in microseconds: programming a word, erasing a page */
+#define EP_HOST_FLASH_WRITE_US      41
+#define EP_HOST_FLASH_ERASE_US      85000
+
+/** Flash operations counted by the nrf_fstorage stand-in */
+typedef struct {
+    uint32_t writes;        ///< nrf_fstorage_write() calls
+    uint32_t words_written; ///< Words programmed
+    uint32_t erases;        ///< Pages erased
+    uint32_t overwrites;    ///< Words programmed more than twice between erases (nWRITE)
+    uint64_t busy_us;       ///< Time the operations take on the nRF52840
+} ep_host_flash_stats_t;
+
+/**
+ * @brief Maps the simulated flash, erased, if it is not mapped yet
+ *
+ * The mapping is shared, so a process forked afterwards writes to the same
+ * flash: a child can be powered off with ep_host_flash_power_cut() and the
+ * next one boots from what it left behind.
+ */
+void ep_host_flash_map(void);
+
+/**
+ * @brief Erases the whole simulated flash and clears the statistics
+ */
+void ep_host_flash_erase_all(void);
+
+/**
+ * @brief Powers off after a number of flash operations
+ *
+ * The process exits with EP_HOST_FLASH_POWER_CUT when the flash is about to
+ * program word @p operations + 1 or erase a page after that many operations,
+ * counting each programmed word and erased page as one operation.
+ *
+ * @param operations Operations to let through, UINT32_MAX to disarm
+ */
+void ep_host_flash_power_cut(uint32_t operations);
+
+/**
+ * @brief Selects when flash operations complete
+ *
+ * By default an operation completes, and its event is sent, before
+ * nrf_fstorage_write() or nrf_fstorage_erase() returns. When asynchronous,
+ * it is only started, and ep_host_flash_process() completes it, as the
+ * NVMC would after busy_us more microseconds. Until then, other operations
+ * are refused with NRF_ERROR_BUSY.
+ *
+ * @param async true for asynchronous operations
+ */
+void ep_host_flash_async(bool async);
+
+/**
+ * @brief Completes the operation started, if any, and sends its event
+ * @return true if an operation was completed
+ */
+bool ep_host_flash_process(void);
+
+/**
+ * @brief Gets how long the operation started takes, for virtual clocks
+ * @return uint32_t Microseconds, 0 if no operation is started
+ */
+uint32_t ep_host_flash_pending_us(void);
+
+/**
+ * @brief Gets the flash operations counted since the last erase_all
+ * @return ep_host_flash_stats_t Counters of this process
+ */
+ep_host_flash_stats_t ep_host_flash_stats_get(void);
+
+/** Bytes of the line kept by the UARTE model for each instance, see ep_host_uarte_output_get() */
+#define EP_HOST_UARTE_OUTPUT_SIZE   (128 * 1024)
+
+/** Transmit activity counted by the UARTE model, for one instance */
+typedef struct {
+    uint32_t transfers;     ///< Transfers started with STARTTX, by a task or over PPI
+    uint32_t bytes;         ///< Bytes sent on the line
+    uint32_t irqs;          ///< Calls of the interrupt handler
+    uint32_t gaps;          ///< Transfers started after the line went idle
+    double   gap_us;        ///< Line idle time between transfers
+    double   gap_max_us;    ///< Longest idle time between two transfers
+    uint32_t errors;        ///< STARTTX while a transfer is ongoing, or with no buffer
+} ep_host_uarte_stats_t;
+
+/**
+ * @brief Sets the interrupt handler of a UARTE instance
+ *
+ * The model calls it, when the interrupt is enabled in the NVIC, for the
+ * events enabled in INTEN. The handler name depends on the driver, for
+ * libuarte UARTE0_UART0_IRQHandler and UARTE1_IRQHandler.
+ *
+ * @param idx       Instance, 0 or 1
+ * @param handler   Interrupt handler
+ */
+void ep_host_uarte_irq_handler_set(uint8_t idx, void (* handler)(void));
+
+/**
+ * @brief Sets the time from an event to the start of its interrupt handler
+ * @param latency_us Interrupt latency in microseconds, 0 by default
+ */
+void ep_host_uarte_irq_latency_set(double latency_us);
+
+/**
+ * @brief Processes the next event of the UARTE instances
+ *
+ * The virtual clock advances to the end of a transfer, to a stop, or to an
+ * interrupt, which is handled from within. Tasks triggered meanwhile take
+ * effect at that time, and the PPI channels from ENDTX to STARTTX start the
+ * buffer set in TXD.PTR as soon as the transfer ends.
+ *
+ * @return true if an event was processed, false if the instances are idle
+ */
+bool ep_host_uarte_process(void);
+
+/**
+ * @brief Gets the virtual clock of the UARTE model
+ * @return double Microseconds since the start of the process
+ */
+double ep_host_uarte_now_us(void);
+
+/**
+ * @brief Gets the bytes sent on the line since the statistics were cleared
+ * @param idx       Instance, 0 or 1
+ * @param pp_data   Set to the bytes, the first EP_HOST_UARTE_OUTPUT_SIZE of them
+ * @return size_t Number of bytes sent
+ */
+size_t ep_host_uarte_output_get(uint8_t idx, uint8_t const ** pp_data);
+
+/**
+ * @brief Gets the transmit activity of an instance since its statistics were cleared
+ * @param idx Instance, 0 or 1
+ * @return ep_host_uarte_stats_t Counters of the instance
+ */
+ep_host_uarte_stats_t ep_host_uarte_stats_get(uint8_t idx);
+
+/**
+ * @brief Clears the statistics and the line output of an instance
+ *
+ * The first transfer afterwards does not count as a gap.
+ *
+ * @param idx Instance, 0 or 1
+ */
+void ep_host_uarte_stats_clear(uint8_t idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EP_HOST_H
@@ -0,0 +1,70 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    ep_host_nrf.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief Peripheral redirection of the POSIX host build.
+ *
+ * Force-included in every host translation unit (-include). The nRF register
+ * blocks used by the application are redirected to RAM, so the nrf_gpio HAL
+ * inline functions work unchanged on the host. Add a peripheral here before
+ * using it from code built for the host.
+ */
+
+#ifndef EP_HOST_NRF_H
+#define EP_HOST_NRF_H
+
+#include "nrf.h"
+
+extern NRF_GPIO_Type ep_host_gpio[2];
+
+#undef NRF_P0
+#define NRF_P0 (&ep_host_gpio[0])
+#undef NRF_P1
+#define NRF_P1 (&ep_host_gpio[1])
+
+/* Flash geometry and bootloader address, see nrf_fstorage_host.c */
+extern NRF_FICR_Type ep_host_ficr;
+extern NRF_UICR_Type ep_host_uicr;
+
+#undef NRF_FICR
+#define NRF_FICR (&ep_host_ficr)
+#undef NRF_UICR
+#define NRF_UICR (&ep_host_uicr)
+
+/* UARTE register blocks of the model, see nrf_uarte_host.c */
+extern NRF_UARTE_Type ep_host_uarte[2];
+
+#undef NRF_UARTE0
+#define NRF_UARTE0 (&ep_host_uarte[0])
+#undef NRF_UARTE1
+#define NRF_UARTE1 (&ep_host_uarte[1])
+
+/* Cortex-M barriers used by the SDK libraries, mapped to a full host barrier */
+#undef __DMB
+#define __DMB() __sync_synchronize()
+#undef __DSB
+#define __DSB() __sync_synchronize()
+#undef __ISB
+#define __ISB() __sync_synchronize()
+
+/* Host code always runs in thread mode, no exception is active */
+#undef __get_IPSR
+#define __get_IPSR() 0U
+
+#endif // EP_HOST_NRF_H
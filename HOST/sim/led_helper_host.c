@@ -0,0 +1,212 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    led_helper_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host stand-in for led_helper.
+ *
+ * A background task plays the blink patterns of led_helper.h on the board LED
+ * pins of the simulated GPIO ports. Set EP_HOST_LED_TRACE=1 to print every LED
+ * change with its virtual time.
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "boards.h"
+#include "nrf_gpio.h"
+#include "led_helper.h"
+#include "ep_host.h"
+
+#define HOST_LED_TASK_STACK_SIZE    128
+#define HOST_LED_TASK_PRIORITY      (tskIDLE_PRIORITY + 2)
+
+static const uint32_t m_led_pins[LEDS_NUMBER] = LEDS_LIST;
+
+static TaskHandle_t  m_led_task;
+static led_mode_enum m_mode = LED_OFF;
+static bool          m_latch;
+static uint8_t       m_mask;
+static bool          m_trace;
+
+#if configSUPPORT_STATIC_ALLOCATION
+static StackType_t   m_led_task_stack[HOST_LED_TASK_STACK_SIZE];
+static StaticTask_t  m_led_task_buffer;
+#endif
+
+static void leds_set(uint8_t mask, bool on)
+{
+    for (uint32_t i = 0; i < LEDS_NUMBER; i++)
+    {
+        if (mask & (1 << i))
+        {
+            nrf_gpio_pin_write(m_led_pins[i], on ? LEDS_ACTIVE_STATE : !LEDS_ACTIVE_STATE);
+        }
+    }
+
+    if (m_trace)
+    {
+        printf("[LED] 0x%02x %s @%llu\r\n", mask, on ? "on" : "off", (unsigned long long)ep_host_ticks_get());
+    }
+}
+
+/* Waits for the given time, returns true when led_mode() changed the mode meanwhile */
+static bool led_wait(TickType_t ticks)
+{
+    return ulTaskNotifyTake(pdTRUE, ticks) != 0;
+}
+
+static void pattern_get(led_mode_enum mode, uint32_t * p_pulses, TickType_t * p_length, TickType_t * p_interval)
+{
+    *p_pulses = 1;
+
+    switch (mode)
+    {
+        case LED_ALIVE_BLINK:      *p_length = LED_ALIVE_BLINK_LENGTH;      *p_interval = LED_ALIVE_BLINK_INTERVAL;      break;
+        case LED_SLOW_BLINK:       *p_length = LED_SLOW_BLINK_LENGTH;       *p_interval = LED_SLOW_BLINK_INTERVAL;       break;
+        case LED_FAST_BLINK:       *p_length = LED_FAST_BLINK_LENGTH;       *p_interval = LED_FAST_BLINK_INTERVAL;       break;
+        case LED_EXTRA_FAST_BLINK: *p_length = LED_EXTRA_FAST_BLINK_LENGTH; *p_interval = LED_EXTRA_FAST_BLINK_INTERVAL; break;
+        default:
+            *p_pulses   = (uint32_t)(mode - LED_SINGLE_BLINK) + 1;
+            *p_length   = LED_MULTI_BLINK_LENGTH;
+            *p_interval = LED_MULTI_BLINK_INTERVAL;
+            break;
+    }
+}
+
+static void led_task(void * pvParameters)
+{
+    for (;;)
+    {
+        led_mode_enum mode  = m_mode;
+        uint8_t       mask  = m_mask;
+        bool          latch = m_latch;
+
+        if (mode == LED_OFF || mode == LED_ON)
+        {
+            leds_set(mask, mode == LED_ON);
+            led_wait(portMAX_DELAY);
+            continue;
+        }
+
+        uint32_t   pulses;
+        TickType_t length;
+        TickType_t interval;
+        bool       changed = false;
+
+        pattern_get(mode, &pulses, &length, &interval);
+
+        for (uint32_t i = 0; (i < pulses) && !changed; i++)
+        {
+            leds_set(mask, true);
+            changed = led_wait(length);
+            leds_set(mask, false);
+            if (!changed && (i + 1 < pulses))
+            {
+                changed = led_wait(length);
+            }
+        }
+
+        if (!changed)
+        {
+            if (!latch)
+            {
+                m_mode = LED_OFF;
+            }
+            led_wait(interval);
+        }
+    }
+}
+
+bool led_init()
+{
+    if (m_led_task != NULL)
+    {
+        return true;
+    }
+
+    const char * p_trace = getenv("EP_HOST_LED_TRACE");
+    m_trace = (p_trace != NULL) && (atoi(p_trace) != 0);
+
+    for (uint32_t i = 0; i < LEDS_NUMBER; i++)
+    {
+        nrf_gpio_cfg_output(m_led_pins[i]);
+        nrf_gpio_pin_write(m_led_pins[i], !LEDS_ACTIVE_STATE);
+    }
+
+#if configSUPPORT_STATIC_ALLOCATION
+    m_led_task = xTaskCreateStatic(led_task, "LED", HOST_LED_TASK_STACK_SIZE, NULL, HOST_LED_TASK_PRIORITY,
+                                   m_led_task_stack, &m_led_task_buffer);
+    return m_led_task != NULL;
+#else
+    return xTaskCreate(led_task, "LED", HOST_LED_TASK_STACK_SIZE, NULL, HOST_LED_TASK_PRIORITY, &m_led_task) == pdPASS;
+#endif
+}
+
+bool led_pause()
+{
+    if (m_led_task == NULL)
+    {
+        return false;
+    }
+    vTaskSuspend(m_led_task);
+    return true;
+}
+
+bool led_resume()
+{
+    if (m_led_task == NULL)
+    {
+        return false;
+    }
+    vTaskResume(m_led_task);
+    return true;
+}
+
+void led_mode(led_mode_enum mode, bool latch, uint8_t led_mask)
+{
+    m_mode  = mode;
+    m_latch = latch;
+    m_mask  = led_mask;
+
+    if (m_led_task != NULL)
+    {
+        xTaskNotifyGive(m_led_task);
+    }
+}
+
+uint8_t ep_host_led_state_get(void)
+{
+    uint8_t state = 0;
+
+    for (uint32_t i = 0; i < LEDS_NUMBER; i++)
+    {
+        if (nrf_gpio_pin_out_read(m_led_pins[i]) == LEDS_ACTIVE_STATE)
+        {
+            state |= (1 << i);
+        }
+    }
+
+    return state;
+}
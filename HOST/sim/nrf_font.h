@@ -0,0 +1,51 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    nrf_font.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief Font descriptor types of nrf_gfx, for the POSIX host build.
+ *
+ * The nRF5 SDK has them in external/thedotfactory_fonts, which the condensed
+ * SDK does not ship. Same layout: a font is a table of glyph widths and
+ * offsets, and glyph bitmaps of height rows, MSB first, each row padded to
+ * whole bytes.
+ */
+
+#ifndef NRF_FONT_H__
+#define NRF_FONT_H__
+
+#include <stdint.h>
+
+typedef struct
+{
+    const uint8_t widthBits;            /** < Width of the glyph in pixels */
+    const uint16_t offset;              /** < First byte of the glyph in data */
+} FONT_CHAR_INFO;
+
+typedef struct
+{
+    const uint8_t height;               /** < Rows of every glyph */
+    const uint8_t startChar;            /** < First character of charInfo */
+    const uint8_t endChar;              /** < Last character of charInfo */
+    const uint8_t spacePixels;          /** < Pixels between two glyphs */
+    const FONT_CHAR_INFO * charInfo;
+    const uint8_t * data;
+} FONT_INFO;
+
+#endif
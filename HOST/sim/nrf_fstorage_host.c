@@ -0,0 +1,364 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    nrf_fstorage_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host stand-in for the nrf_fstorage_nvmc backend, on simulated flash.
+ *
+ * Modules that read flash through plain pointers, as fds does, need the flash
+ * at its device address. The last EP_HOST_FLASH_SIZE bytes of the code area
+ * given by NRF_FICR (1 MB, as on the nRF52840) are mapped there. Writes AND
+ * into the flash like NOR programming and erases set pages back to 0xFF.
+ * Like the NVMC backend, operations complete before nrf_fstorage_write()
+ * and nrf_fstorage_erase() return, and the event is sent from within them.
+ * With ep_host_flash_async(), they complete in ep_host_flash_process()
+ * instead, one at a time, as with the SoftDevice backend.
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "sdk_common.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_nvmc.h"
+#include "ep_host.h"
+
+#define FLASH_PAGE_SIZE     4096
+#define FLASH_END           (256 * FLASH_PAGE_SIZE)
+#define FLASH_START         (FLASH_END - EP_HOST_FLASH_SIZE)
+#define FLASH_WORDS         (EP_HOST_FLASH_SIZE / sizeof(uint32_t))
+#define NWRITE              2       // Writes allowed to a word between erases
+
+/* Flash geometry read by fds, see ep_host_nrf.h. No bootloader. */
+NRF_FICR_Type ep_host_ficr = {
+    .CODEPAGESIZE = FLASH_PAGE_SIZE,
+    .CODESIZE     = FLASH_END / FLASH_PAGE_SIZE,
+};
+NRF_UICR_Type ep_host_uicr = {
+    .NRFFW = { 0xFFFFFFFF, 0xFFFFFFFF },
+};
+
+static nrf_fstorage_info_t m_flash_info =
+{
+    .erase_unit   = FLASH_PAGE_SIZE,
+    .program_unit = 4,
+    .rmap         = true,
+    .wmap         = false,
+};
+
+static uint32_t            * m_flash;           // At FLASH_START, shared with forked processes
+static uint8_t             * m_word_writes;     // Writes to each word since its erase, shared
+static uint32_t              m_power_left = UINT32_MAX;
+static ep_host_flash_stats_t m_stats;
+static bool                  m_async;
+
+/* The operation started in asynchronous mode */
+static struct {
+    bool                   pending;
+    nrf_fstorage_evt_id_t  id;
+    nrf_fstorage_t const * p_fs;
+    void const           * p_src;
+    uint32_t               addr;
+    uint32_t               len;
+    void                 * p_param;
+} m_op;
+
+void ep_host_flash_map(void)
+{
+    if (m_flash != NULL)
+    {
+        return;
+    }
+
+    m_flash = mmap((void *)(uintptr_t)FLASH_START, EP_HOST_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    m_word_writes = mmap(NULL, FLASH_WORDS, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if ((m_flash != (void *)(uintptr_t)FLASH_START) || (m_word_writes == MAP_FAILED))
+    {
+        fprintf(stderr, "[host] cannot map the simulated flash at 0x%x\n", FLASH_START);
+        exit(1);
+    }
+
+    ep_host_flash_erase_all();
+}
+
+void ep_host_flash_erase_all(void)
+{
+    ep_host_flash_map();
+    memset(m_flash, 0xFF, EP_HOST_FLASH_SIZE);
+    memset(m_word_writes, 0, FLASH_WORDS);
+    memset(&m_stats, 0, sizeof(m_stats));
+    memset(&m_op, 0, sizeof(m_op));
+}
+
+void ep_host_flash_power_cut(uint32_t operations)
+{
+    m_power_left = operations;
+}
+
+ep_host_flash_stats_t ep_host_flash_stats_get(void)
+{
+    return m_stats;
+}
+
+void ep_host_flash_async(bool async)
+{
+    m_async = async;
+}
+
+static void power_use(void)
+{
+    if (m_power_left == UINT32_MAX)
+    {
+        return;
+    }
+    if (m_power_left == 0)
+    {
+        _Exit(EP_HOST_FLASH_POWER_CUT);
+    }
+    m_power_left--;
+}
+
+static bool range_is_valid(uint32_t addr, uint32_t len)
+{
+    return (m_flash != NULL) && (addr >= FLASH_START) && (len <= FLASH_END - addr);
+}
+
+static void event_send(nrf_fstorage_t        const * p_fs,
+                       nrf_fstorage_evt_id_t         evt_id,
+                       void const *                  p_src,
+                       uint32_t                      addr,
+                       uint32_t                      len,
+                       void                        * p_param)
+{
+    if (p_fs->evt_handler == NULL)
+    {
+        return;
+    }
+
+    nrf_fstorage_evt_t evt =
+    {
+        .result  = NRF_SUCCESS,
+        .id      = evt_id,
+        .addr    = addr,
+        .p_src   = p_src,
+        .len     = len,
+        .p_param = p_param,
+    };
+
+    p_fs->evt_handler(&evt);
+}
+
+static ret_code_t init(nrf_fstorage_t * p_fs, void * p_param)
+{
+    UNUSED_PARAMETER(p_param);
+
+    ep_host_flash_map();
+    p_fs->p_flash_info = &m_flash_info;
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t uninit(nrf_fstorage_t * p_fs, void * p_param)
+{
+    UNUSED_PARAMETER(p_fs);
+    UNUSED_PARAMETER(p_param);
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t read(nrf_fstorage_t const * p_fs, uint32_t src, void * p_dest, uint32_t len)
+{
+    UNUSED_PARAMETER(p_fs);
+
+    memcpy(p_dest, (uint32_t *)(uintptr_t)src, len);
+
+    return NRF_SUCCESS;
+}
+
+static void write_apply(uint32_t dest, void const * p_src, uint32_t len)
+{
+    uint32_t const first = (dest - FLASH_START) / sizeof(uint32_t);
+
+    m_stats.writes++;
+    for (uint32_t i = 0; i < len / sizeof(uint32_t); i++)
+    {
+        uint32_t word;
+
+        // The source is only guaranteed to be word aligned on the target
+        memcpy(&word, (uint8_t const *)p_src + i * sizeof(uint32_t), sizeof(word));
+
+        power_use();
+        m_flash[first + i] &= word;
+        m_stats.words_written++;
+        m_stats.busy_us += EP_HOST_FLASH_WRITE_US;
+        if (++m_word_writes[first + i] > NWRITE)
+        {
+            m_stats.overwrites++;
+        }
+    }
+}
+
+static void erase_apply(uint32_t page_addr, uint32_t len)
+{
+    for (uint32_t page = 0; page < len; page++)
+    {
+        uint32_t const first = (page_addr - FLASH_START) / sizeof(uint32_t) +
+                               page * (FLASH_PAGE_SIZE / sizeof(uint32_t));
+
+        power_use();
+        memset(&m_flash[first], 0xFF, FLASH_PAGE_SIZE);
+        memset(&m_word_writes[first], 0, FLASH_PAGE_SIZE / sizeof(uint32_t));
+        m_stats.erases++;
+        m_stats.busy_us += EP_HOST_FLASH_ERASE_US;
+    }
+}
+
+/* Completes the operation now, or leaves it to ep_host_flash_process() */
+static ret_code_t operation_start(nrf_fstorage_t const * p_fs,
+                                  nrf_fstorage_evt_id_t  id,
+                                  void           const * p_src,
+                                  uint32_t               addr,
+                                  uint32_t               len,
+                                  void                 * p_param)
+{
+    if (m_op.pending)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    m_op.id      = id;
+    m_op.p_fs    = p_fs;
+    m_op.p_src   = p_src;
+    m_op.addr    = addr;
+    m_op.len     = len;
+    m_op.p_param = p_param;
+    m_op.pending = true;
+
+    if (!m_async)
+    {
+        (void)ep_host_flash_process();
+    }
+
+    return NRF_SUCCESS;
+}
+
+bool ep_host_flash_process(void)
+{
+    if (!m_op.pending)
+    {
+        return false;
+    }
+
+    // The event handler may start the next operation
+    m_op.pending = false;
+    if (m_op.id == NRF_FSTORAGE_EVT_WRITE_RESULT)
+    {
+        write_apply(m_op.addr, m_op.p_src, m_op.len);
+    }
+    else
+    {
+        erase_apply(m_op.addr, m_op.len);
+    }
+    event_send(m_op.p_fs, m_op.id, m_op.p_src, m_op.addr, m_op.len, m_op.p_param);
+
+    return true;
+}
+
+uint32_t ep_host_flash_pending_us(void)
+{
+    if (!m_op.pending)
+    {
+        return 0;
+    }
+    if (m_op.id == NRF_FSTORAGE_EVT_WRITE_RESULT)
+    {
+        return (m_op.len / sizeof(uint32_t)) * EP_HOST_FLASH_WRITE_US;
+    }
+    return m_op.len * EP_HOST_FLASH_ERASE_US;
+}
+
+static ret_code_t write(nrf_fstorage_t const * p_fs,
+                        uint32_t               dest,
+                        void           const * p_src,
+                        uint32_t               len,
+                        void                 * p_param)
+{
+    if (!range_is_valid(dest, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    return operation_start(p_fs, NRF_FSTORAGE_EVT_WRITE_RESULT, p_src, dest, len, p_param);
+}
+
+static ret_code_t erase(nrf_fstorage_t const * p_fs,
+                        uint32_t               page_addr,
+                        uint32_t               len,
+                        void                 * p_param)
+{
+    if (!range_is_valid(page_addr, len * FLASH_PAGE_SIZE))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    return operation_start(p_fs, NRF_FSTORAGE_EVT_ERASE_RESULT, NULL, page_addr, len, p_param);
+}
+
+static uint8_t const * rmap(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    UNUSED_PARAMETER(p_fs);
+
+    return (uint8_t *)(uintptr_t)addr;
+}
+
+static uint8_t * wmap(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    UNUSED_PARAMETER(p_fs);
+    UNUSED_PARAMETER(addr);
+
+    // Not supported, as on the target.
+    return NULL;
+}
+
+static bool is_busy(nrf_fstorage_t const * p_fs)
+{
+    UNUSED_PARAMETER(p_fs);
+
+    return m_op.pending;
+}
+
+/* Same name as the NVMC backend, so that fds uses it with FDS_BACKEND NRF_FSTORAGE_NVMC */
+nrf_fstorage_api_t nrf_fstorage_nvmc =
+{
+    .init    = init,
+    .uninit  = uninit,
+    .read    = read,
+    .write   = write,
+    .erase   = erase,
+    .rmap    = rmap,
+    .wmap    = wmap,
+    .is_busy = is_busy,
+};
@@ -0,0 +1,44 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    nrf_rtc.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief RTC HAL of the nRF5 SDK, for the POSIX host build.
+ *
+ * The COUNTER register of a register block in RAM does not count. Reading
+ * it is routed to ep_host_rtc_counter_get(), provided by the program that
+ * models the RTC, see bench/timer_bench.c. The rest is the SDK header.
+ *
+ * nrfx_rtc.h includes the SDK header as <hal/nrf_rtc.h>, past this one, so a
+ * program using the driver includes this header first, with -include.
+ */
+
+#ifndef EP_HOST_NRF_RTC_H
+#define EP_HOST_NRF_RTC_H
+
+#define nrf_rtc_counter_get nrf_rtc_counter_get_hw
+
+#include_next "nrf_rtc.h"
+
+#undef nrf_rtc_counter_get
+
+uint32_t ep_host_rtc_counter_get(NRF_RTC_Type * p_reg);
+
+#define nrf_rtc_counter_get     ep_host_rtc_counter_get
+
+#endif // EP_HOST_NRF_RTC_H
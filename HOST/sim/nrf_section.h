@@ -0,0 +1,40 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    nrf_section.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief Section variables of the nRF5 SDK, for the POSIX host build.
+ *
+ * The SDK declares the start of a section as a single pointer, and reads the
+ * section items past it. GCC on the host sees an 8 byte object indexed out of
+ * bounds. Here the start is an array of the item type with no bound, the
+ * layout the linker actually provides. The rest is the SDK header.
+ */
+
+#ifndef EP_HOST_NRF_SECTION_H
+#define EP_HOST_NRF_SECTION_H
+
+#include_next "nrf_section.h"
+
+#undef NRF_SECTION_DEF
+#define NRF_SECTION_DEF(section_name, data_type)                \
+    extern data_type   CONCAT_2(__start_, section_name)[];      \
+    extern void      * CONCAT_2(__stop_,  section_name)
+
+#endif // EP_HOST_NRF_SECTION_H
@@ -0,0 +1,55 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    nrf_uarte.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ * @brief UARTE HAL of the nRF5 SDK, for the POSIX host build.
+ *
+ * Triggering a task and enabling or disabling interrupts act on the
+ * peripheral, which a register block in RAM does not, and TXD.PTR cannot
+ * hold a host pointer. These HAL functions are routed to the UARTE model of
+ * nrf_uarte_host.c. The rest is the SDK header, working on the registers of
+ * ep_host_uarte.
+ */
+
+#ifndef EP_HOST_NRF_UARTE_H
+#define EP_HOST_NRF_UARTE_H
+
+#define nrf_uarte_task_trigger  nrf_uarte_task_trigger_hw
+#define nrf_uarte_int_enable    nrf_uarte_int_enable_hw
+#define nrf_uarte_int_disable   nrf_uarte_int_disable_hw
+#define nrf_uarte_tx_buffer_set nrf_uarte_tx_buffer_set_hw
+
+#include_next "nrf_uarte.h"
+
+#undef nrf_uarte_task_trigger
+#undef nrf_uarte_int_enable
+#undef nrf_uarte_int_disable
+#undef nrf_uarte_tx_buffer_set
+
+void ep_host_uarte_task_trigger(NRF_UARTE_Type * p_reg, nrf_uarte_task_t task);
+void ep_host_uarte_int_enable(NRF_UARTE_Type * p_reg, uint32_t mask);
+void ep_host_uarte_int_disable(NRF_UARTE_Type * p_reg, uint32_t mask);
+void ep_host_uarte_tx_buffer_set(NRF_UARTE_Type * p_reg, uint8_t const * p_buffer, size_t length);
+
+#define nrf_uarte_task_trigger  ep_host_uarte_task_trigger
+#define nrf_uarte_int_enable    ep_host_uarte_int_enable
+#define nrf_uarte_int_disable   ep_host_uarte_int_disable
+#define nrf_uarte_tx_buffer_set ep_host_uarte_tx_buffer_set
+
+#endif // EP_HOST_NRF_UARTE_H
@@ -0,0 +1,487 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    nrf_uarte_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host model of the UARTE transmitter, with the PPI and NVIC it uses.
+ *
+ * The registers of the instances are ep_host_uarte, see ep_host_nrf.h, and
+ * the HAL functions with side effects come here through sim/nrf_uarte.h.
+ * A transfer started with STARTTX reads TXD.PTR and TXD.MAXCNT, the buffer
+ * pointer being kept in full beside the 32 bit register, sets
+ * TXSTARTED at once, and ends with ENDTX after 10 bits per byte at the
+ * baud rate of the BAUDRATE register, the bytes being appended to the line
+ * output then. TXD.PTR can be changed for the next transfer meanwhile, as
+ * on the device. STOPTX sets TXSTOPPED once no transfer is ongoing. The
+ * PPI stand-in follows the enabled channels whose event is ENDTX to their
+ * task and fork, so that a chained STARTTX costs no line time.
+ *
+ * Events enabled in INTEN call the interrupt handler of the instance the
+ * interrupt latency later, on the virtual clock of ep_host_uarte_process().
+ * The receiver is not modelled: RX tasks are ignored.
+ *
+ * Built for the POSIX host target only, for benches defining
+ * CMSIS_NVIC_VIRTUAL.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nrf.h"
+#include <nrf_uarte.h>             // sim/nrf_uarte.h, through the include path
+#include "nrfx_ppi.h"
+#include "ep_host.h"
+
+#define UARTE_COUNT         2
+#define PPI_CHANNELS           PPI_CH_NUM
+#define BITS_PER_BYTE       10          // Start, 8 data and stop bits
+#define BAUDRATE_CLOCK_HZ   16000000.0  // BAUDRATE is the rate in 2^-32 of this clock
+#define NVIC_IRQ_COUNT      256
+
+NRF_UARTE_Type ep_host_uarte[UARTE_COUNT];
+
+/* Events of the UARTE and their INTEN bits, checked for the interrupt line */
+static const struct {
+    nrf_uarte_event_t event;
+    uint32_t          mask;
+} m_uarte_irq_events[] = {
+    { NRF_UARTE_EVENT_CTS,       NRF_UARTE_INT_CTS_MASK       },
+    { NRF_UARTE_EVENT_NCTS,      NRF_UARTE_INT_NCTS_MASK      },
+    { NRF_UARTE_EVENT_RXDRDY,    NRF_UARTE_INT_RXDRDY_MASK    },
+    { NRF_UARTE_EVENT_ENDRX,     NRF_UARTE_INT_ENDRX_MASK     },
+    { NRF_UARTE_EVENT_TXDRDY,    NRF_UARTE_INT_TXDRDY_MASK    },
+    { NRF_UARTE_EVENT_ENDTX,     NRF_UARTE_INT_ENDTX_MASK     },
+    { NRF_UARTE_EVENT_ERROR,     NRF_UARTE_INT_ERROR_MASK     },
+    { NRF_UARTE_EVENT_RXTO,      NRF_UARTE_INT_RXTO_MASK      },
+    { NRF_UARTE_EVENT_RXSTARTED, NRF_UARTE_INT_RXSTARTED_MASK },
+    { NRF_UARTE_EVENT_TXSTARTED, NRF_UARTE_INT_TXSTARTED_MASK },
+    { NRF_UARTE_EVENT_TXSTOPPED, NRF_UARTE_INT_TXSTOPPED_MASK },
+};
+
+typedef struct {
+    void               (* irq_handler)(void);
+    bool                  irq_pending;
+    double                irq_at;
+    uint8_t const       * p_txd_ptr;    // Host pointer written to TXD.PTR
+    bool                  tx_busy;
+    uint8_t const       * p_tx;
+    uint32_t              tx_len;
+    double                tx_end;
+    bool                  stop_pending;
+    bool                  line_used;    // A transfer ended since the statistics were cleared
+    double                line_free;    // End of the last transfer
+    ep_host_uarte_stats_t stats;
+    size_t                out_len;
+    uint8_t               out[EP_HOST_UARTE_OUTPUT_SIZE];
+} uarte_model_t;
+
+typedef struct {
+    bool     allocated;
+    bool     enabled;
+    uint32_t eep;
+    uint32_t tep;
+    uint32_t fork_tep;
+} ppi_channel_model_t;
+
+static uarte_model_t       m_uarte[UARTE_COUNT];
+static ppi_channel_model_t m_ppi[PPI_CHANNELS];
+static uint32_t            m_ppi_groups;
+static bool                m_nvic_enabled[NVIC_IRQ_COUNT];
+static double              m_now;
+static double              m_latency_us;
+
+static uint8_t uarte_idx(NRF_UARTE_Type const * p_reg)
+{
+    return (p_reg == &ep_host_uarte[0]) ? 0 : 1;
+}
+
+static uint32_t reg_addr(void volatile const * p_reg)
+{
+    /* Addresses on the PPI are truncated to 32 bits, as nrf_uarte_event_address_get() does */
+    return (uint32_t)(uintptr_t)p_reg;
+}
+
+static bool irq_line(uint8_t idx)
+{
+    NRF_UARTE_Type * p_reg = &ep_host_uarte[idx];
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_uarte_irq_events); i++)
+    {
+        if ((p_reg->INTEN & m_uarte_irq_events[i].mask) &&
+            nrf_uarte_event_check(p_reg, m_uarte_irq_events[i].event))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void irq_update(uint8_t idx)
+{
+    if (!m_uarte[idx].irq_pending && irq_line(idx))
+    {
+        m_uarte[idx].irq_pending = true;
+        m_uarte[idx].irq_at      = m_now + m_latency_us;
+    }
+}
+
+static void event_raise(uint8_t idx, nrf_uarte_event_t event)
+{
+    *(volatile uint32_t *)((uint8_t *)&ep_host_uarte[idx] + (uint32_t)event) = 1;
+    irq_update(idx);
+}
+
+static double byte_us(uint8_t idx)
+{
+    double baud = ep_host_uarte[idx].BAUDRATE * BAUDRATE_CLOCK_HZ / 4294967296.0;
+
+    return (baud > 0) ? (BITS_PER_BYTE * 1e6 / baud) : 0;
+}
+
+static void tx_start(uint8_t idx)
+{
+    uarte_model_t  * p_model = &m_uarte[idx];
+    NRF_UARTE_Type * p_reg   = &ep_host_uarte[idx];
+
+    if (p_model->tx_busy || (p_model->p_txd_ptr == NULL))
+    {
+        p_model->stats.errors++;
+        return;
+    }
+    p_model->p_tx    = p_model->p_txd_ptr;
+    p_model->tx_len  = p_reg->TXD.MAXCNT;
+    p_model->tx_busy = true;
+    p_model->tx_end  = m_now + p_model->tx_len * byte_us(idx);
+    p_model->stats.transfers++;
+    if (p_model->line_used && (m_now > p_model->line_free))
+    {
+        double gap = m_now - p_model->line_free;
+
+        p_model->stats.gaps++;
+        p_model->stats.gap_us += gap;
+        p_model->stats.gap_max_us = MAX(p_model->stats.gap_max_us, gap);
+    }
+    event_raise(idx, NRF_UARTE_EVENT_TXSTARTED);
+}
+
+static void task_apply(uint32_t tep)
+{
+    for (uint8_t idx = 0; idx < UARTE_COUNT; idx++)
+    {
+        if (tep == reg_addr(&ep_host_uarte[idx].TASKS_STARTTX))
+        {
+            tx_start(idx);
+        }
+        else if (tep == reg_addr(&ep_host_uarte[idx].TASKS_STOPTX))
+        {
+            ep_host_uarte_task_trigger(&ep_host_uarte[idx], NRF_UARTE_TASK_STOPTX);
+        }
+    }
+}
+
+static void ppi_follow(uint32_t eep)
+{
+    for (size_t ch = 0; ch < PPI_CHANNELS; ch++)
+    {
+        if (m_ppi[ch].enabled && (m_ppi[ch].eep == eep))
+        {
+            task_apply(m_ppi[ch].tep);
+            if (m_ppi[ch].fork_tep)
+            {
+                task_apply(m_ppi[ch].fork_tep);
+            }
+        }
+    }
+}
+
+static void tx_end(uint8_t idx)
+{
+    uarte_model_t  * p_model = &m_uarte[idx];
+    NRF_UARTE_Type * p_reg   = &ep_host_uarte[idx];
+    size_t           copy;
+
+    m_now = p_model->tx_end;
+    copy  = MIN(p_model->tx_len, EP_HOST_UARTE_OUTPUT_SIZE - MIN(p_model->out_len,
+                                                                   EP_HOST_UARTE_OUTPUT_SIZE));
+    memcpy(&p_model->out[p_model->out_len], p_model->p_tx, copy);
+    p_model->out_len        += p_model->tx_len;
+    p_model->stats.bytes    += p_model->tx_len;
+    p_model->tx_busy         = false;
+    p_model->line_used       = true;
+    p_model->line_free       = m_now;
+    *(volatile uint32_t *)&p_reg->TXD.AMOUNT = p_model->tx_len;
+    event_raise(idx, NRF_UARTE_EVENT_ENDTX);
+    ppi_follow(reg_addr(&p_reg->EVENTS_ENDTX));
+    if (p_model->stop_pending && !p_model->tx_busy)
+    {
+        p_model->stop_pending = false;
+        event_raise(idx, NRF_UARTE_EVENT_TXSTOPPED);
+    }
+}
+
+void ep_host_uarte_task_trigger(NRF_UARTE_Type * p_reg, nrf_uarte_task_t task)
+{
+    uint8_t idx = uarte_idx(p_reg);
+
+    switch (task)
+    {
+        case NRF_UARTE_TASK_STARTTX:
+            tx_start(idx);
+            break;
+
+        case NRF_UARTE_TASK_STOPTX:
+            /* A transfer is not cut short, the stop is processed at its end */
+            if (m_uarte[idx].tx_busy)
+            {
+                m_uarte[idx].stop_pending = true;
+            }
+            else
+            {
+                event_raise(idx, NRF_UARTE_EVENT_TXSTOPPED);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ep_host_uarte_int_enable(NRF_UARTE_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN |= mask;
+    irq_update(uarte_idx(p_reg));
+}
+
+void ep_host_uarte_int_disable(NRF_UARTE_Type * p_reg, uint32_t mask)
+{
+    p_reg->INTEN &= ~mask;
+}
+
+void ep_host_uarte_tx_buffer_set(NRF_UARTE_Type * p_reg, uint8_t const * p_buffer, size_t length)
+{
+    m_uarte[uarte_idx(p_reg)].p_txd_ptr = p_buffer;
+    p_reg->TXD.PTR    = reg_addr(p_buffer);
+    p_reg->TXD.MAXCNT = length;
+}
+
+void ep_host_uarte_irq_handler_set(uint8_t idx, void (* handler)(void))
+{
+    m_uarte[idx].irq_handler = handler;
+}
+
+void ep_host_uarte_irq_latency_set(double latency_us)
+{
+    m_latency_us = latency_us;
+}
+
+double ep_host_uarte_now_us(void)
+{
+    return m_now;
+}
+
+static bool irq_deliverable(uint8_t idx)
+{
+    return m_uarte[idx].irq_pending && (m_uarte[idx].irq_handler != NULL) &&
+           m_nvic_enabled[(uint8_t)nrfx_get_irq_number(&ep_host_uarte[idx])];
+}
+
+bool ep_host_uarte_process(void)
+{
+    int    next_idx = -1;
+    bool   next_irq = false;
+    double next_at  = 0;
+
+    /* Ends of transfers first, so that their events are seen by an interrupt at the same time */
+    for (uint8_t idx = 0; idx < UARTE_COUNT; idx++)
+    {
+        if (m_uarte[idx].tx_busy && ((next_idx < 0) || (m_uarte[idx].tx_end < next_at)))
+        {
+            next_idx = idx;
+            next_irq = false;
+            next_at  = m_uarte[idx].tx_end;
+        }
+    }
+    for (uint8_t idx = 0; idx < UARTE_COUNT; idx++)
+    {
+        if (irq_deliverable(idx) && ((next_idx < 0) || (m_uarte[idx].irq_at < next_at)))
+        {
+            next_idx = idx;
+            next_irq = true;
+            next_at  = m_uarte[idx].irq_at;
+        }
+    }
+    if (next_idx < 0)
+    {
+        return false;
+    }
+
+    if (!next_irq)
+    {
+        tx_end((uint8_t)next_idx);
+        return true;
+    }
+
+    m_now = MAX(m_now, next_at);
+    m_uarte[next_idx].irq_pending = false;
+    m_uarte[next_idx].stats.irqs++;
+    m_uarte[next_idx].irq_handler();
+    /* Events left set, or set meanwhile, raise the interrupt again */
+    irq_update((uint8_t)next_idx);
+    return true;
+}
+
+size_t ep_host_uarte_output_get(uint8_t idx, uint8_t const ** pp_data)
+{
+    *pp_data = m_uarte[idx].out;
+    return m_uarte[idx].out_len;
+}
+
+ep_host_uarte_stats_t ep_host_uarte_stats_get(uint8_t idx)
+{
+    return m_uarte[idx].stats;
+}
+
+void ep_host_uarte_stats_clear(uint8_t idx)
+{
+    memset(&m_uarte[idx].stats, 0, sizeof(m_uarte[idx].stats));
+    m_uarte[idx].out_len   = 0;
+    m_uarte[idx].line_used = false;
+}
+
+/* PPI stand-in, channels and groups are only allocated and connected */
+nrfx_err_t nrfx_ppi_channel_alloc(nrf_ppi_channel_t * p_channel)
+{
+    for (size_t ch = 0; ch < PPI_CHANNELS; ch++)
+    {
+        if (!m_ppi[ch].allocated)
+        {
+            memset(&m_ppi[ch], 0, sizeof(m_ppi[ch]));
+            m_ppi[ch].allocated = true;
+            *p_channel = (nrf_ppi_channel_t)ch;
+            return NRFX_SUCCESS;
+        }
+    }
+    return NRFX_ERROR_NO_MEM;
+}
+
+nrfx_err_t nrfx_ppi_channel_free(nrf_ppi_channel_t channel)
+{
+    m_ppi[channel].allocated = false;
+    m_ppi[channel].enabled   = false;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_assign(nrf_ppi_channel_t channel, uint32_t eep, uint32_t tep)
+{
+    m_ppi[channel].eep = eep;
+    m_ppi[channel].tep = tep;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_fork_assign(nrf_ppi_channel_t channel, uint32_t fork_tep)
+{
+    m_ppi[channel].fork_tep = fork_tep;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_enable(nrf_ppi_channel_t channel)
+{
+    m_ppi[channel].enabled = true;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channel_disable(nrf_ppi_channel_t channel)
+{
+    m_ppi[channel].enabled = false;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_group_alloc(nrf_ppi_channel_group_t * p_group)
+{
+    for (uint32_t group = 0; group < PPI_GROUP_NUM; group++)
+    {
+        if (!(m_ppi_groups & (1UL << group)))
+        {
+            m_ppi_groups |= 1UL << group;
+            *p_group = (nrf_ppi_channel_group_t)group;
+            return NRFX_SUCCESS;
+        }
+    }
+    return NRFX_ERROR_NO_MEM;
+}
+
+nrfx_err_t nrfx_ppi_group_free(nrf_ppi_channel_group_t group)
+{
+    m_ppi_groups &= ~(1UL << group);
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_channels_include_in_group(uint32_t channel_mask,
+                                              nrf_ppi_channel_group_t group)
+{
+    (void)channel_mask;
+    (void)group;
+    return NRFX_SUCCESS;
+}
+
+nrfx_err_t nrfx_ppi_group_enable(nrf_ppi_channel_group_t group)
+{
+    (void)group;
+    return NRFX_SUCCESS;
+}
+
+/* NVIC stand-in, see cmsis_nvic_virtual.h */
+void ep_host_nvic_enable(IRQn_Type irqn)
+{
+    m_nvic_enabled[(uint8_t)irqn] = true;
+}
+
+void ep_host_nvic_disable(IRQn_Type irqn)
+{
+    m_nvic_enabled[(uint8_t)irqn] = false;
+}
+
+uint32_t ep_host_nvic_enabled(IRQn_Type irqn)
+{
+    return m_nvic_enabled[(uint8_t)irqn];
+}
+
+void ep_host_nvic_pending_set(IRQn_Type irqn, uint32_t pending)
+{
+    (void)irqn;
+    (void)pending;
+}
+
+uint32_t ep_host_nvic_pending_get(IRQn_Type irqn)
+{
+    (void)irqn;
+    return 0;
+}
+
+void ep_host_nvic_priority_set(IRQn_Type irqn, uint32_t priority)
+{
+    (void)irqn;
+    (void)priority;
+}
+
+uint32_t ep_host_nvic_priority_get(IRQn_Type irqn)
+{
+    (void)irqn;
+    return 0;
+}
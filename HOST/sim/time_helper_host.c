@@ -0,0 +1,61 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    time_helper_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host stand-in for time_helper.
+ *
+ * The RTC2 based clock of the target is replaced by the virtual clock of the
+ * host FreeRTOS port, so the time only advances with the simulation.
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time_helper.h"
+#include "ep_host.h"
+
+static uint64_t m_sync_ms;      // Epoch time in ms at the last set_time
+static uint64_t m_sync_ticks;   // Virtual clock at the last set_time
+
+void set_time(uint32_t seconds)
+{
+    taskENTER_CRITICAL();
+    m_sync_ms    = (uint64_t)seconds * 1000ULL;
+    m_sync_ticks = ep_host_ticks_get();
+    taskEXIT_CRITICAL();
+}
+
+uint64_t get_time_ms()
+{
+    uint64_t time_ms;
+
+    taskENTER_CRITICAL();
+    time_ms = m_sync_ms + (ep_host_ticks_get() - m_sync_ticks) * 1000ULL / configTICK_RATE_HZ;
+    taskEXIT_CRITICAL();
+
+    return time_ms;
+}
+
+uint32_t get_time_s()
+{
+    return (uint32_t)(get_time_ms() / 1000ULL);
+}
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    uart_helper_host.c
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Host stand-in for uart_helper.
+ *
+ * Keeps the queue and task structure of the target: tx_enqueue formats the
+ * message into a DEBUG_UART_TX_QUEUE_ITEM_SIZE item of xDebugUartTxQueue and
+ * a TX task writes the items to stdout instead of LibUARTE. Messages are
+ * dropped while no task has the UART initialized, as on the target.
+ * retarget_writev of retarget.c joins its segments into one item of the
+ * same queue.
+ *
+ * Built for the POSIX host target only.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "retarget.h"
+#include "uart_helper.h"
+
+#define HOST_UART_TX_TASK_STACK_SIZE    256
+#define HOST_UART_TX_TASK_PRIORITY      (tskIDLE_PRIORITY + 1)
+
+QueueHandle_t xDebugUartRxQueue;
+QueueHandle_t xDebugUartTxQueue;
+SemaphoreHandle_t xDebugUartTxSemaphore;
+SemaphoreHandle_t xDebugUartTxLockoutSemaphore;
+
+volatile UART_HELPER_STRUCT uart_helper = {
+    .dbg_header_style = DEBUG_HEADER_COMPACT,
+    .dbgi = false,
+    .dbgw = true,
+    .dbge = true,
+};
+
+static TaskHandle_t      m_tx_task;
+static SemaphoreHandle_t m_tx_buff_semaphore;
+static char              m_tx_buff[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+static uint8_t           m_active_tasks;     // Bit n set while task n has the UART initialized
+
+#if configSUPPORT_STATIC_ALLOCATION
+static StaticQueue_t     m_rx_queue_buffer;
+static uint8_t           m_rx_queue_storage[DEBUG_UART_RX_QUEUE_SIZE];
+static StaticQueue_t     m_tx_queue_buffer;
+static uint8_t           m_tx_queue_storage[DEBUG_UART_TX_QUEUE_SIZE * DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+static StaticSemaphore_t m_tx_semaphore_buffer;
+static StaticSemaphore_t m_tx_lockout_semaphore_buffer;
+static StaticSemaphore_t m_tx_buff_semaphore_buffer;
+static StackType_t       m_tx_task_stack[HOST_UART_TX_TASK_STACK_SIZE];
+static StaticTask_t      m_tx_task_buffer;
+#endif
+
+static void debug_uart_tx_task(void * pvParameters)
+{
+    static char item[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+
+    for (;;)
+    {
+        if (xQueueReceive(xDebugUartTxQueue, item, portMAX_DELAY) == pdPASS)
+        {
+            xSemaphoreTake(xDebugUartTxLockoutSemaphore, portMAX_DELAY);
+            fputs(item, stdout);
+            fflush(stdout);
+            xSemaphoreGive(xDebugUartTxLockoutSemaphore);
+        }
+    }
+}
+
+static bool uart_helper_resources_init(void)
+{
+    if (xDebugUartTxQueue != NULL)
+    {
+        return true;
+    }
+
+#if configSUPPORT_STATIC_ALLOCATION
+    xDebugUartRxQueue            = xQueueCreateStatic(DEBUG_UART_RX_QUEUE_SIZE, sizeof(char),
+                                                      m_rx_queue_storage, &m_rx_queue_buffer);
+    xDebugUartTxQueue            = xQueueCreateStatic(DEBUG_UART_TX_QUEUE_SIZE, DEBUG_UART_TX_QUEUE_ITEM_SIZE,
+                                                      m_tx_queue_storage, &m_tx_queue_buffer);
+    xDebugUartTxSemaphore        = xSemaphoreCreateBinaryStatic(&m_tx_semaphore_buffer);
+    xDebugUartTxLockoutSemaphore = xSemaphoreCreateMutexStatic(&m_tx_lockout_semaphore_buffer);
+    m_tx_buff_semaphore          = xSemaphoreCreateMutexStatic(&m_tx_buff_semaphore_buffer);
+#else
+    xDebugUartRxQueue            = xQueueCreate(DEBUG_UART_RX_QUEUE_SIZE, sizeof(char));
+    xDebugUartTxQueue            = xQueueCreate(DEBUG_UART_TX_QUEUE_SIZE, DEBUG_UART_TX_QUEUE_ITEM_SIZE);
+    xDebugUartTxSemaphore        = xSemaphoreCreateBinary();
+    xDebugUartTxLockoutSemaphore = xSemaphoreCreateMutex();
+    m_tx_buff_semaphore          = xSemaphoreCreateMutex();
+#endif
+
+    if ((xDebugUartRxQueue == NULL) || (xDebugUartTxQueue == NULL) || (xDebugUartTxSemaphore == NULL) ||
+        (xDebugUartTxLockoutSemaphore == NULL) || (m_tx_buff_semaphore == NULL))
+    {
+        return false;
+    }
+
+#if configSUPPORT_STATIC_ALLOCATION
+    m_tx_task = xTaskCreateStatic(debug_uart_tx_task, "UTX", HOST_UART_TX_TASK_STACK_SIZE, NULL,
+                                  HOST_UART_TX_TASK_PRIORITY, m_tx_task_stack, &m_tx_task_buffer);
+    return m_tx_task != NULL;
+#else
+    return xTaskCreate(debug_uart_tx_task, "UTX", HOST_UART_TX_TASK_STACK_SIZE, NULL,
+                       HOST_UART_TX_TASK_PRIORITY, &m_tx_task) == pdPASS;
+#endif
+}
+
+int init_uart(uint8_t task)
+{
+    if (task >= NUM_OF_TASKS)
+    {
+        return -1;
+    }
+    if (!uart_helper_resources_init())
+    {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    m_active_tasks |= (1 << task);
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+void uninit_uart(uint8_t task)
+{
+    if (task >= NUM_OF_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    m_active_tasks &= ~(1 << task);
+    taskEXIT_CRITICAL();
+}
+
+int init_swo(void)
+{
+    // No SWO on the host, everything goes to stdout
+    return 0;
+}
+
+void tx_enqueue(const char* ansi_color, const char* msg_type, const char* func, int line, const char* format, ...)
+{
+    va_list args;
+    size_t  n = 0;
+
+    if ((m_active_tasks == 0) || (xDebugUartTxQueue == NULL))
+    {
+        return;
+    }
+
+    xSemaphoreTake(m_tx_buff_semaphore, portMAX_DELAY);
+
+    if (uart_helper.dbg_header_style == DEBUG_HEADER_FULL)
+    {
+        n += snprintf(&m_tx_buff[n], sizeof(m_tx_buff) - n, "%s%s[%s:%d @%lu]: ", ansi_color, msg_type,
+                      func, line, (unsigned long)xTaskGetTickCount());
+    }
+    else if (uart_helper.dbg_header_style == DEBUG_HEADER_COMPACT)
+    {
+        n += snprintf(&m_tx_buff[n], sizeof(m_tx_buff) - n, "%s%s[%s:%d]: ", ansi_color, msg_type, func, line);
+    }
+    else
+    {
+        n += snprintf(&m_tx_buff[n], sizeof(m_tx_buff) - n, "%s%s: ", ansi_color, msg_type);
+    }
+
+    if (n < sizeof(m_tx_buff))
+    {
+        va_start(args, format);
+        n += vsnprintf(&m_tx_buff[n], sizeof(m_tx_buff) - n, format, args);
+        va_end(args);
+    }
+    if (n < sizeof(m_tx_buff))
+    {
+        snprintf(&m_tx_buff[n], sizeof(m_tx_buff) - n, "%s\r\n", ANSI_COLOR_RST);
+    }
+
+    xQueueSend(xDebugUartTxQueue, m_tx_buff, portMAX_DELAY);
+
+    xSemaphoreGive(m_tx_buff_semaphore);
+}
+
+int retarget_writev(nrf_libuarte_async_data_t const * p_segments, size_t count)
+{
+    size_t len = 0;
+
+    if ((m_active_tasks == 0) || (xDebugUartTxQueue == NULL))
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(m_tx_buff_semaphore, portMAX_DELAY);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t n = MIN(p_segments[i].length, sizeof(m_tx_buff) - 1 - len);
+
+        memcpy(&m_tx_buff[len], p_segments[i].p_data, n);
+        len += n;
+    }
+    m_tx_buff[len] = '\0';
+    xQueueSend(xDebugUartTxQueue, m_tx_buff, portMAX_DELAY);
+
+    xSemaphoreGive(m_tx_buff_semaphore);
+
+    return (int)len;
+}
@@ -52,6 +52,11 @@
 
 #define configTICK_SOURCE FREERTOS_USE_RTC
 
+/* Set to 1 to collect per task CPU time, stack high-water marks and context switches, see rtos_stats.h */
+#ifndef RTOS_STATS_ENABLED
+#define RTOS_STATS_ENABLED                                                        0
+#endif
+
 #define configUSE_PREEMPTION                                                      1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION                                   1
 #define configUSE_TICKLESS_IDLE                                                   1
@@ -60,7 +65,6 @@
 #define configTICK_RATE_HZ                                                        1024
 #define configMAX_PRIORITIES                                                      ( 5 )
 #define configMINIMAL_STACK_SIZE                                                  ( 60 )
-#define configTOTAL_HEAP_SIZE                                                     ( 32768 )
 #define configMAX_TASK_NAME_LEN                                                   ( 4 )
 #define configUSE_16_BIT_TICKS                                                    0
 #define configIDLE_SHOULD_YIELD                                                   1
@@ -73,20 +77,41 @@
 #define configUSE_TIME_SLICING                                                    1
 #define configUSE_NEWLIB_REENTRANT                                                0
 #define configENABLE_BACKWARD_COMPATIBILITY                                       1
+/* Set to 1 to place the kernel tasks, LEDTask and the deferred log task in
+ * .bss. The heap then only holds the objects created by the epSDK library.
+ * The idle task, the timer task and its queue and LEDTask take 5704 bytes of
+ * heap_4 with their block headers, and 5648 bytes of .bss once static. The
+ * heap is only cut by 4 KB, the other 1.5 KB are left for the library objects
+ * until their heap use is measured, so heap and .bss together grow by about
+ * 1.5 KB: the gain is a heap that cannot fail for these objects, not RAM. */
 #define configSUPPORT_STATIC_ALLOCATION                                           0
 #define configSUPPORT_DYNAMIC_ALLOCATION                                          1
+#if configSUPPORT_STATIC_ALLOCATION
+#define configTOTAL_HEAP_SIZE                                                     ( 28672 )
+#else
+#define configTOTAL_HEAP_SIZE                                                     ( 32768 )
+#endif
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                                                       1
 #define configUSE_TICK_HOOK                                                       0
-#define configCHECK_FOR_STACK_OVERFLOW                                            0
+#define configCHECK_FOR_STACK_OVERFLOW                                            ( RTOS_STATS_ENABLED ? 2 : 0 )
 #define configUSE_MALLOC_FAILED_HOOK                                              0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS                                             0
-#define configUSE_TRACE_FACILITY                                                  0
+#define configGENERATE_RUN_TIME_STATS                                             RTOS_STATS_ENABLED
+#define configUSE_TRACE_FACILITY                                                  RTOS_STATS_ENABLED
 #define configUSE_STATS_FORMATTING_FUNCTIONS                                      0
 
+#if RTOS_STATS_ENABLED
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()                                  rtos_stats_clock_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()                                          rtos_stats_clock()
+#define traceTASK_SWITCHED_IN()                                                   rtos_stats_task_switched_in( pxCurrentTCB->uxTCBNumber )
+/* The port calls traceISR_ENTER()/traceISR_EXIT() from the tick interrupt only */
+#define traceISR_ENTER()                                                          rtos_stats_tick_isr_enter()
+#define traceISR_EXIT()                                                           rtos_stats_tick_isr_exit()
+#endif
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                                                     0
 #define configMAX_CO_ROUTINE_PRIORITIES                                           ( 2 )
@@ -178,6 +203,9 @@ standard names - or at least those used in the unmodified vector table. */
 #if !(defined(__ASSEMBLY__) || defined(__ASSEMBLER__))
     #include "nrf.h"
     #include "nrf_assert.h"
+    #if RTOS_STATS_ENABLED
+        #include "rtos_stats.h"
+    #endif
 
     /* This part of definitions may be problematic in assembly - it uses definitions from files that are not assembly compatible. */
     /* Cortex-M specific definitions. */
@@ -4560,6 +4560,18 @@
 #define SEND_LOG_OVER_SWO 0
 #endif
 
+// <e> RETARGET_TX_BATCH_ENABLED - Send _write output in chunks instead of one byte per UART transfer
+//==========================================================
+#ifndef RETARGET_TX_BATCH_ENABLED
+#define RETARGET_TX_BATCH_ENABLED 1
+#endif
+// <o> RETARGET_TX_BATCH_SIZE - Size of each half of the double-buffered transmit buffer
+#ifndef RETARGET_TX_BATCH_SIZE
+#define RETARGET_TX_BATCH_SIZE 128
+#endif
+
+// </e>
+
 // <o> NRFX_TWI_DEFAULT_CONFIG_FREQUENCY  - Frequency
  
 // <26738688=> 100k 
@@ -4657,6 +4669,16 @@
 #define NRF_LIBUARTE_DRV_UARTE1 1
 #endif
 
+// <q> NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED  - Start a buffer queued with nrf_libuarte_drv_tx_next() on ENDTX over PPI
+ 
+
+// <i> Takes one PPI channel per instance. Without it the segments of nrf_libuarte_async_txv()
+// <i> are started one after the other from the TX done interrupt.
+
+#ifndef NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED
+#define NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED 0
+#endif
+
 // <e> NRFX_UARTE_ENABLED - nrfx_uarte - UARTE peripheral driver
 //==========================================================
 #ifndef NRFX_UARTE_ENABLED
@@ -6416,6 +6438,40 @@
 #define APP_SCHEDULER_WITH_PROFILER 0
 #endif
 
+// <e> APP_SCHEDULER_WITH_PRIORITIES - Enabling priority levels and bulk drain
+
+// <i> Each priority level gets its own ring of variable length events. The events
+// <i> of a higher level are executed first, app_sched_drain() executes all pending
+// <i> events of one handler with a single bulk handler call.
+//==========================================================
+#ifndef APP_SCHEDULER_WITH_PRIORITIES
+#define APP_SCHEDULER_WITH_PRIORITIES 0
+#endif
+// <o> APP_SCHEDULER_PRIORITY_LEVELS - Number of priority levels  <2-8>
+
+
+#ifndef APP_SCHEDULER_PRIORITY_LEVELS
+#define APP_SCHEDULER_PRIORITY_LEVELS 3
+#endif
+
+// <o> APP_SCHEDULER_DEFAULT_PRIORITY - Priority of app_sched_event_put(), 0 is the highest  <0-7>
+
+
+#ifndef APP_SCHEDULER_DEFAULT_PRIORITY
+#define APP_SCHEDULER_DEFAULT_PRIORITY 1
+#endif
+
+// <o> APP_SCHEDULER_DRAIN_BATCH - Maximum events per bulk handler call  <1-64>
+
+
+// <i> app_sched_drain() collects this many events on the stack before calling the bulk handler.
+
+#ifndef APP_SCHEDULER_DRAIN_BATCH
+#define APP_SCHEDULER_DRAIN_BATCH 16
+#endif
+
+// </e>
+
 // </e>
 
 // <e> APP_SDCARD_ENABLED - app_sdcard - SD/MMC card support using SPI
@@ -6536,6 +6592,27 @@
 #define APP_TIMER_SAFE_WINDOW_MS 300000
 #endif
 
+// <e> APP_TIMER_CONFIG_FREERTOS_WHEEL - Use the timing wheel app_timer variant with FreeRTOS
+// <i> Keeps all app timers in one hierarchical timing wheel driven by a single
+// <i> RTC compare instead of one FreeRTOS software timer per app timer.
+// <i> Start and stop take constant time and queue no timer command. The CPU is
+// <i> woken as often as with the software timers, at each tick a timer is due.
+// <i> Timeouts are limited to 2^23 ticks.
+//==========================================================
+#ifndef APP_TIMER_CONFIG_FREERTOS_WHEEL
+#define APP_TIMER_CONFIG_FREERTOS_WHEEL 0
+#endif
+// <o> APP_TIMER_WHEEL_CONFIG_RTC_INSTANCE  - RTC instance driving the wheel
+// <i> RTC1 is the FreeRTOS tick and RTC2 is used by time_helper.
+// <i> The selected instance must be enabled in the RTC driver configuration.
+// <0=> RTC0
+
+#ifndef APP_TIMER_WHEEL_CONFIG_RTC_INSTANCE
+#define APP_TIMER_WHEEL_CONFIG_RTC_INSTANCE 0
+#endif
+
+// </e>
+
 // <h> App Timer Legacy configuration - Legacy configuration.
 
 //==========================================================
@@ -6899,12 +6976,24 @@
 #define CRC16_ENABLED 0
 #endif
 
-// <q> CRC32_ENABLED  - crc32 - CRC32 calculation routines
- 
-
+// <e> CRC32_ENABLED - crc32 - CRC32 calculation routines
+//==========================================================
 #ifndef CRC32_ENABLED
 #define CRC32_ENABLED 0
 #endif
+// <o> CRC32_CONFIG_IMPLEMENTATION  - Implementation used by crc32_compute
+ 
+// <0=> Bitwise (no table) 
+// <1=> Nibble table (64 bytes) 
+// <2=> Byte table (1 KB) 
+// <3=> Slice-by-4 (4 KB) 
+// <4=> Slice-by-8 (8 KB) 
+
+#ifndef CRC32_CONFIG_IMPLEMENTATION
+#define CRC32_CONFIG_IMPLEMENTATION 2
+#endif
+
+// </e>
 
 // <q> ECC_ENABLED  - ecc - Elliptic Curve Cryptography Library
  
@@ -6985,9 +7074,75 @@
 #define FDS_OP_QUEUE_SIZE 4
 #endif
 
+// <o> FDS_BATCH_BUFFER_WORDS - Size of the fds_record_write_batch() write buffer, in 4-byte words. 
+// <i> Record headers and data of a batch are copied to this buffer and written one buffer at a time.
+// <i> A batch that fits in the buffer takes two flash writes.
+
+#ifndef FDS_BATCH_BUFFER_WORDS
+#define FDS_BATCH_BUFFER_WORDS 64
+#endif
+
 // </h> 
 //==========================================================
 
+// <h> Index - Record index
+
+//==========================================================
+// <e> FDS_INDEX_ENABLED - Keep an index of the records in RAM.
+// <i> fds_record_find() looks records up by file ID and record key in the index instead of
+// <i> reading the record headers of every page. Flash is only read for the records found.
+// <i> The index is built when fds is initialized and kept up to date by writes, updates,
+// <i> deletions and garbage collection.
+//==========================================================
+#ifndef FDS_INDEX_ENABLED
+#define FDS_INDEX_ENABLED 0
+#endif
+// <o> FDS_INDEX_SIZE - Number of index entries. Must be a power of two.
+// <i> Each entry takes 8 bytes of RAM. The index holds up to 7/8 of this many records;
+// <i> with more records, searches fall back to reading the pages until records are deleted
+// <i> and garbage collection is run.
+
+#ifndef FDS_INDEX_SIZE
+#define FDS_INDEX_SIZE 256
+#endif
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> GC - Garbage collection
+
+//==========================================================
+// <e> FDS_GC_INCREMENTAL - Let other operations run while garbage is collected.
+// <i> Garbage collection stops after copying FDS_GC_STEP_WORDS words, and before and after erasing a page,
+// <i> if other operations are queued. It continues after them. Without this, operations queued
+// <i> after fds_gc() wait until garbage collection of all pages is complete.
+//==========================================================
+#ifndef FDS_GC_INCREMENTAL
+#define FDS_GC_INCREMENTAL 0
+#endif
+// <o> FDS_GC_STEP_WORDS - Words copied by garbage collection before it lets other operations run. 
+// <i> Writing a word takes about 41 us on the nRF52840, and erasing a page about 85 ms.
+
+#ifndef FDS_GC_STEP_WORDS
+#define FDS_GC_STEP_WORDS 128
+#endif
+
+// </e>
+
+// <o> FDS_GC_AUTO_WORDS - Start garbage collection when this many words can be freed. 
+// <i> Counted over the pages without open records, from records deleted, updated or left
+// <i> incomplete. fds queues garbage collection after the operation that passes the threshold,
+// <i> and sends FDS_EVT_GC when it completes. 0 disables it.
+
+#ifndef FDS_GC_AUTO_WORDS
+#define FDS_GC_AUTO_WORDS 0
+#endif
+
+// </h>
+//==========================================================
+
 // <h> CRC - CRC functionality
 
 //==========================================================
@@ -7501,6 +7656,27 @@
 #define NRF_GFX_ENABLED 0
 #endif
 
+// <q> NRF_GFX_SPAN_BLIT_ENABLED  - Draw the glyphs of nrf_gfx_print() as horizontal runs
+ 
+
+// <i> Each run of set bits in a glyph row is drawn with one lcd_rect_draw call of height 1,
+// <i> instead of one lcd_pixel_draw call per bit. The pixels drawn are the same.
+
+#ifndef NRF_GFX_SPAN_BLIT_ENABLED
+#define NRF_GFX_SPAN_BLIT_ENABLED 1
+#endif
+
+// <q> NRF_GFX_DIRTY_RECT_ENABLED  - Flush only the drawn area in nrf_gfx_display()
+ 
+
+// <i> The bounding rectangle of everything drawn since the last nrf_gfx_display() is tracked.
+// <i> For LCDs that implement lcd_display_rect, nrf_gfx_display() flushes that rectangle only,
+// <i> and nothing when nothing was drawn. Other LCDs get lcd_display as before.
+
+#ifndef NRF_GFX_DIRTY_RECT_ENABLED
+#define NRF_GFX_DIRTY_RECT_ENABLED 1
+#endif
+
 // <q> NRF_MEMOBJ_ENABLED  - nrf_memobj - Linked memory allocator module
  
 
@@ -7659,6 +7835,16 @@
 #define NRF_SORTLIST_ENABLED 1
 #endif
 
+// <q> NRF_SORTLIST_CONFIG_HEAP  - Keep nrf_sortlist items in a pairing heap
+ 
+
+// <i> Adding takes constant time, popping and removing logarithmic time instead of
+// <i> walking the list. Items take four pointers instead of one.
+
+#ifndef NRF_SORTLIST_CONFIG_HEAP
+#define NRF_SORTLIST_CONFIG_HEAP 0
+#endif
+
 // <q> NRF_SPI_MNGR_ENABLED  - nrf_spi_mngr - SPI transaction manager
  
 
@@ -7666,6 +7852,18 @@
 #define NRF_SPI_MNGR_ENABLED 0
 #endif
 
+// <q> NRF_SPI_MNGR_STREAMING_ENABLED  - Start the next queued SPI transaction before the end callback of the current one
+ 
+
+// <i> When a transaction ends and the next queued one needs no chip select change (no begin
+// <i> callback on either, same configuration), its first transfer is started first and the end
+// <i> callback runs while the bus is busy. End callbacks must not change the data of transactions
+// <i> already scheduled.
+
+#ifndef NRF_SPI_MNGR_STREAMING_ENABLED
+#define NRF_SPI_MNGR_STREAMING_ENABLED 0
+#endif
+
 // <q> NRF_STRERROR_ENABLED  - nrf_strerror - Library for converting error code to string.
  
 
@@ -7899,6 +8097,17 @@
 #define NRF_FPRINTF_DOUBLE_ENABLED 0
 #endif
 
+// <q> NRF_FPRINTF_SPAN_COPY_ENABLED  - Copy literal text, strings, digits and padding to the IO buffer in spans.
+ 
+
+// <i> Literal text up to the next conversion, strings and padding are copied with memcpy/memset
+// <i> and integers are rendered in a local buffer, instead of adding and checking one character
+// <i> at a time. The output is the same.
+
+#ifndef NRF_FPRINTF_SPAN_COPY_ENABLED
+#define NRF_FPRINTF_SPAN_COPY_ENABLED 1
+#endif
+
 // </h> 
 //==========================================================
 
@@ -7941,6 +8150,16 @@
 
 // </e>
 
+// <q> NRF_LOG_BACKEND_DEBUG_UART_ENABLED  - uart_log_backend - Log backend on the epSDK debug UART
+ 
+
+// <i> Deferred logs are formatted by a log task and sent through
+// <i> xDebugUartTxQueue of uart_helper. See source/uart_log_backend.h.
+
+#ifndef NRF_LOG_BACKEND_DEBUG_UART_ENABLED
+#define NRF_LOG_BACKEND_DEBUG_UART_ENABLED 0
+#endif
+
 // <e> NRF_LOG_BACKEND_UART_ENABLED - nrf_log_backend_uart - Log UART backend
 //==========================================================
 #ifndef NRF_LOG_BACKEND_UART_ENABLED
@@ -8027,6 +8246,19 @@
 #define NRF_LOG_ALLOW_OVERFLOW 1
 #endif
 
+// <q> NRF_LOG_LOCK_FREE  - Reserve buffer space without a critical region.
+ 
+
+// <i> If set then a log call claims its entry with a compare-and-swap
+// <i> on the write index, so interrupts of any priority can log without
+// <i> masking each other. Entries are processed in the order they were
+// <i> claimed, each once it is complete. When the buffer is full new
+// <i> logs are dropped and counted. Requires NRF_LOG_ALLOW_OVERFLOW = 0.
+
+#ifndef NRF_LOG_LOCK_FREE
+#define NRF_LOG_LOCK_FREE 0
+#endif
+
 // <o> NRF_LOG_BUFSIZE  - Size of the buffer for storing logs (in bytes).
  
 
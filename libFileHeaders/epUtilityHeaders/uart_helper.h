@@ -47,6 +47,11 @@ extern QueueHandle_t xDebugUartTxQueue;
 #define DEBUG_UART_TX_QUEUE_ITEM_SIZE   1024
 #define DEBUG_UART_TX_QUEUE_SIZE   10
 
+/* Set to 1 to format debug messages in a background task instead of the caller (see uart_deferred_log.h) */
+#ifndef DEBUG_UART_DEFERRED_LOG
+#define DEBUG_UART_DEFERRED_LOG    0
+#endif
+
 /* Semaphore to indicate that a TX transmission has been completed. This is needed to flag retarget.c that it can move on to the next */
 extern SemaphoreHandle_t xDebugUartTxSemaphore;
 
@@ -82,11 +87,12 @@ typedef enum{
 } debug_header_style;
 
 // At this time give main and 4 tasks ability to control uart/swo
+// epBlinkyLibrary.a has one tracker per id below NUM_OF_TASKS and does not check the id: share these, do not add ids
 #define MAIN_LOOP   0 // main and initialization loop
-#define TASK_1      1 // sensor_sample task
+#define TASK_1      1 // sensor_sample task, LED task and rtos_stats snapshot of the blinky example
 #define TASK_2      2 // cell task
-#define TASK_3      3 // LED task
-#define TASK_4      4 // BLE
+#define TASK_3      3 // LED task, nrf_log debug UART backend task of the blinky example
+#define TASK_4      4 // BLE, deferred debug log task of the blinky example
 #define NUM_OF_TASKS    5
 
 //Expose uart_helper globally
@@ -131,10 +137,21 @@ volatile extern UART_HELPER_STRUCT uart_helper;
 // that are defined only for debug printing.  To supress the warning these vaiables can be created with
 // a "[[maybe_unused]]" suffix.  For example: "uint8_t rxdata [[maybe_unused]];" will prevent rxdata
 // from throwing the "unused" variable warning
+//
+//Setting DEBUG_UART_DEFERRED_LOG to 1 switches the macros to deferred logging (see uart_deferred_log.h).
+// The format string and the argument types of each call are then described at compile time, the caller only
+// copies the arguments, and the message is formatted later by a low priority task.
 void tx_enqueue(const char* ansi_color, const char* msg_type, const char* func, int line, const char* format, ...);
+#if DEBUG_UART_DEFERRED_LOG
+#include "uart_deferred_log.h"
+#define DBGI(...) if (uart_helper.dbgi == true){DEFERRED_LOG(DEFERRED_LOG_INFO, __VA_ARGS__);}
+#define DBGW(...) if (uart_helper.dbgw == true){DEFERRED_LOG(DEFERRED_LOG_WARNING, __VA_ARGS__);}
+#define DBGE(...) if (uart_helper.dbge == true){DEFERRED_LOG(DEFERRED_LOG_ERROR, __VA_ARGS__);}
+#else
 #define DBGI(...) if (uart_helper.dbgi == true){tx_enqueue(ANSI_COLOR_RST, "[INF]", __func__, __LINE__, __VA_ARGS__);}
 #define DBGW(...) if (uart_helper.dbgw == true){tx_enqueue(ANSI_COLOR_BLUB, "[WRN]", __func__, __LINE__, __VA_ARGS__);}
 #define DBGE(...) if (uart_helper.dbge == true){tx_enqueue(ANSI_COLOR_REDB, "[ERR]", __func__, __LINE__, __VA_ARGS__);}
+#endif
 
 
 /**
@@ -322,14 +322,16 @@ void * nrf_balloc_alloc(nrf_balloc_t const * p_pool)
     return p_block;
 }
 
-void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
-{
-    ASSERT(p_pool != NULL);
-    ASSERT(p_element != NULL)
-
-    NRF_LOG_INST_DEBUG(p_pool->p_log, "Freeing element: 0x%08X", p_element);
-
 #if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+/**@brief  Validate an element that is being freed and mark its block memory as free.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[in]   p_element   Pointer to the element.
+ *
+ * @return      Pointer to the beginning of the block.
+ */
+static void * nrf_balloc_free_check(nrf_balloc_t const * p_pool, void * p_element)
+{
     void * p_block = nrf_balloc_element_wrap(p_pool, p_element);
 
     // These checks could be done outside critical region as they use only pool configuration data.
@@ -355,14 +357,21 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
             APP_ERROR_CHECK_BOOL(false);
         }
     }
-#else
-    void * p_block = p_element;
-#endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
 
-    CRITICAL_REGION_ENTER();
+    return p_block;
+}
 
-#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
-    // These checks have to be done in critical region as they use p_pool->p_stack_pointer.
+/**@brief  Check the allocation stack before a block is pushed back. Must be called in the
+ *         critical region.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[in]   p_block     Pointer to the beginning of the block.
+ * @param[in]   p_element   Pointer to the element, for the error messages.
+ */
+static void nrf_balloc_free_stack_check(nrf_balloc_t const * p_pool,
+                                        void const         * p_block,
+                                        void const         * p_element)
+{
     if (NRF_BALLOC_DEBUG_BASIC_CHECKS_GET(p_pool->debug_flags))
     {
         // Check for allocated/free ballance.
@@ -388,6 +397,27 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
             }
         }
     }
+}
+#endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
+
+void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
+{
+    ASSERT(p_pool != NULL);
+    ASSERT(p_element != NULL)
+
+    NRF_LOG_INST_DEBUG(p_pool->p_log, "Freeing element: 0x%08X", p_element);
+
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+    void * p_block = nrf_balloc_free_check(p_pool, p_element);
+#else
+    void * p_block = p_element;
+#endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
+
+    CRITICAL_REGION_ENTER();
+
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+    // These checks have to be done in critical region as they use p_pool->p_stack_pointer.
+    nrf_balloc_free_stack_check(p_pool, p_block, p_element);
 #endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
 
     // Free the element.
@@ -396,4 +426,89 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
     CRITICAL_REGION_EXIT();
 }
 
+ret_code_t nrf_balloc_alloc_n(nrf_balloc_t const * p_pool, void ** pp_elements, uint8_t count)
+{
+    ASSERT(p_pool != NULL);
+    ASSERT((pp_elements != NULL) || (count == 0));
+
+    ret_code_t ret = NRF_ERROR_NO_MEM;
+    uint8_t    i;
+
+    CRITICAL_REGION_ENTER();
+
+    if ((p_pool->p_cb->p_stack_pointer - p_pool->p_stack_base) >= count)
+    {
+        // Allocate blocks.
+        for (i = 0; i < count; i++)
+        {
+            pp_elements[i] = nrf_balloc_idx2block(p_pool, *--(p_pool->p_cb->p_stack_pointer));
+        }
+
+        // Update utilization statistics.
+        uint8_t utilization = p_pool->p_stack_limit - p_pool->p_cb->p_stack_pointer;
+        if (p_pool->p_cb->max_utilization < utilization)
+        {
+            p_pool->p_cb->max_utilization = utilization;
+        }
+
+        ret = NRF_SUCCESS;
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    if (ret != NRF_SUCCESS)
+    {
+        NRF_LOG_INST_DEBUG(p_pool->p_log, "Allocating %u elements failed", count);
+        return ret;
+    }
+
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+    for (i = 0; i < count; i++)
+    {
+        pp_elements[i] = nrf_balloc_block_unwrap(p_pool, pp_elements[i]);
+    }
+#endif
+
+    NRF_LOG_INST_DEBUG(p_pool->p_log, "Allocating %u elements", count);
+
+    return NRF_SUCCESS;
+}
+
+void nrf_balloc_free_n(nrf_balloc_t const * p_pool, void * const * pp_elements, uint8_t count)
+{
+    ASSERT(p_pool != NULL);
+    ASSERT((pp_elements != NULL) || (count == 0));
+
+    uint8_t i;
+
+    NRF_LOG_INST_DEBUG(p_pool->p_log, "Freeing %u elements", count);
+
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+    for (i = 0; i < count; i++)
+    {
+        ASSERT(pp_elements[i] != NULL);
+        (void)nrf_balloc_free_check(p_pool, pp_elements[i]);
+    }
+#endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
+
+    CRITICAL_REGION_ENTER();
+
+    for (i = 0; i < count; i++)
+    {
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+        uint32_t head_words = NRF_BALLOC_DEBUG_HEAD_GUARD_WORDS_GET(p_pool->debug_flags);
+        void *   p_block    = (uint32_t *)pp_elements[i] - head_words;
+
+        nrf_balloc_free_stack_check(p_pool, p_block, pp_elements[i]);
+#else
+        void *   p_block    = pp_elements[i];
+#endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
+
+        // Free the element.
+        *(p_pool->p_cb->p_stack_pointer)++ = nrf_balloc_block2idx(p_pool, p_block);
+    }
+
+    CRITICAL_REGION_EXIT();
+}
+
 #endif // NRF_MODULE_ENABLED(NRF_BALLOC)
@@ -311,6 +311,32 @@ void * nrf_balloc_alloc(nrf_balloc_t const * p_pool);
  */
 void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element);
 
+/**@brief Function for allocating several elements from the pool at once.
+ *
+ * All elements are taken from the pool in a single critical region. Either all @p count
+ * elements are allocated or none.
+ *
+ * @note    This module guarantees that the returned memory is aligned to 4.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool from which the elements will be allocated.
+ * @param[out]  pp_elements Array of at least @p count pointers to be filled with the elements.
+ * @param[in]   count       Number of elements to allocate.
+ *
+ * @retval  NRF_SUCCESS         All elements allocated.
+ * @retval  NRF_ERROR_NO_MEM    Fewer than @p count elements left in the pool, nothing allocated.
+ */
+ret_code_t nrf_balloc_alloc_n(nrf_balloc_t const * p_pool, void ** pp_elements, uint8_t count);
+
+/**@brief Function for freeing several elements back to the pool at once.
+ *
+ * All elements are returned to the pool in a single critical region.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[in]   pp_elements Array of @p count elements to be freed.
+ * @param[in]   count       Number of elements to free.
+ */
+void nrf_balloc_free_n(nrf_balloc_t const * p_pool, void * const * pp_elements, uint8_t count);
+
 /**@brief Function for getting maximum memory pool utilization.
  *
  * @param[in]   p_pool Pointer to the memory pool instance.
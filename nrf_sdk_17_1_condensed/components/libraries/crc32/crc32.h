@@ -55,6 +55,16 @@
 extern "C" {
 #endif
 
+/**@brief CRC-32 implementations selectable with CRC32_CONFIG_IMPLEMENTATION.
+ *
+ * All implementations give identical results, they differ in speed and flash usage.
+ */
+#define CRC32_IMPLEMENTATION_BITWISE     0  /**< Bit at a time, no table. */
+#define CRC32_IMPLEMENTATION_NIBBLE      1  /**< 16-entry table, 4 bits at a time (64 bytes of flash). */
+#define CRC32_IMPLEMENTATION_TABLE       2  /**< 256-entry table, 1 byte at a time (1 KB of flash). */
+#define CRC32_IMPLEMENTATION_SLICE_BY_4  3  /**< Four 256-entry tables, 4 bytes at a time (4 KB of flash). */
+#define CRC32_IMPLEMENTATION_SLICE_BY_8  4  /**< Eight 256-entry tables, 8 bytes at a time (8 KB of flash). */
+
 /**@brief Function for calculating CRC-32 in blocks.
  *
  * Feed each consecutive data block into this function, along with the current value of p_crc as
@@ -118,6 +118,44 @@ ret_code_t nrf_crypto_hash_update(nrf_crypto_hash_context_t   * const p_context,
 }
 
 
+ret_code_t nrf_crypto_hash_updatev(nrf_crypto_hash_context_t       * const p_context,
+                                   nrf_crypto_hash_segment_t const *       p_segments,
+                                   size_t                                  count)
+{
+    ret_code_t                              ret_val;
+    nrf_crypto_hash_internal_context_t    * p_int_context
+        = (nrf_crypto_hash_internal_context_t *) p_context;
+
+    ret_val = verify_context(p_int_context);
+    if (ret_val != NRF_SUCCESS)
+    {
+        return ret_val;
+    }
+
+    VERIFY_TRUE((p_segments != NULL) || (count == 0), NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (p_segments[i].size == 0)
+        {
+            continue;
+        }
+
+        VERIFY_TRUE(p_segments[i].p_data != NULL, NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        ret_val = p_int_context->p_info->update_fn(p_context,
+                                                   p_segments[i].p_data,
+                                                   p_segments[i].size);
+        if (ret_val != NRF_SUCCESS)
+        {
+            return ret_val;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 ret_code_t nrf_crypto_hash_finalize(nrf_crypto_hash_context_t * const p_context,
                                     uint8_t                         * p_digest,
                                     size_t                    * const p_digest_size)
@@ -166,6 +166,37 @@ ret_code_t nrf_crypto_hash_update(nrf_crypto_hash_context_t   * const p_context,
                                   uint8_t                     const * p_data,
                                   size_t                              data_size);
 
+
+/**@brief Data segment for @ref nrf_crypto_hash_updatev. */
+typedef struct
+{
+    uint8_t const * p_data;     //!< Pointer to the data to be hashed.
+    size_t          size;       //!< Length of the data to be hashed.
+} nrf_crypto_hash_segment_t;
+
+
+/**@brief Function for updating the hash calculation with several data segments.
+ *
+ * @details Equivalent to calling @ref nrf_crypto_hash_update for each segment in order, for
+ *          records or image chunks that are not contiguous in memory, such as a header and a
+ *          payload received separately. The segments are hashed in place, nothing is copied to
+ *          a staging buffer.
+ *
+ * @param[in,out]   p_context       Pointer to structure holding context information for
+ *                                  the hash calculation.
+ * @param[in]       p_segments      Array of segments. Segments of zero length are skipped.
+ * @param[in]       count           Number of segments.
+ *
+ * @retval  NRF_SUCCESS                 All segments were hashed.
+ * @retval  NRF_ERROR_CRYPTO_INPUT_NULL p_segments or the data pointer of a non-empty segment was
+ *                                      NULL.
+ * @return  Any other error of @ref nrf_crypto_hash_update. The segments before the failing one
+ *          are part of the hash.
+ */
+ret_code_t nrf_crypto_hash_updatev(nrf_crypto_hash_context_t       * const p_context,
+                                   nrf_crypto_hash_segment_t const *       p_segments,
+                                   size_t                                  count);
+
 /**@brief Function for finalizing computation of a hash digest from arbitrary data.
  *
  * @details This function is called to get the calculated
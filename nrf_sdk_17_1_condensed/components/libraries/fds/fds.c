@@ -99,6 +99,18 @@ static fds_swap_page_t      m_swap_page;
 // Garbage collection data.
 static fds_gc_data_t        m_gc;
 
+// Headers and data of the batch being written, see batch_buffer_fill().
+static uint32_t             m_batch_buf[FDS_BATCH_BUFFER_WORDS];
+
+#if (FDS_BATCH_BUFFER_WORDS < 2 * FDS_HEADER_SIZE)
+    #error "FDS_BATCH_BUFFER_WORDS must hold at least two record headers."
+#endif
+
+#if (FDS_INDEX_ENABLED)
+// Index of the valid records, used by record_find().
+static fds_index_t          m_index;
+#endif
+
 
 static void event_send(fds_evt_t const * const p_evt)
 {
@@ -162,6 +174,22 @@ static void event_prepare(fds_op_t const * const p_op, fds_evt_t * const p_evt)
 }
 
 
+// Send one write event per record of a batch. The record IDs follow the one of the batch.
+static void batch_events_send(fds_op_t const * const p_op, fds_evt_t * const p_evt)
+{
+    for (uint16_t i = 0; i < p_op->batch.count; i++)
+    {
+        p_evt->id                      = FDS_EVT_WRITE;
+        p_evt->write.file_id           = p_op->batch.p_records[i].file_id;
+        p_evt->write.record_key        = p_op->batch.p_records[i].key;
+        p_evt->write.record_id         = p_op->batch.header.record_id + 1 + i;
+        p_evt->write.is_record_updated = 0;
+
+        event_send(p_evt);
+    }
+}
+
+
 static bool header_has_next(fds_header_t const * p_hdr, uint32_t const * p_page_end)
 {
     uint32_t const * const p_hdr32 = (uint32_t*)p_hdr;
@@ -202,11 +230,18 @@ static fds_header_status_t header_check(fds_header_t const * p_hdr, uint32_t con
 }
 
 
+// A valid header with this file ID encloses the records of a batch. Their headers follow it.
+static bool header_is_batch(fds_header_t const * const p_hdr)
+{
+    return (p_hdr->file_id == FDS_FILE_ID_BATCH);
+}
+
+
 static bool address_is_valid(uint32_t const * const p_addr)
 {
     return ((p_addr != NULL) &&
-            (p_addr >= (uint32_t*)m_fs.start_addr) &&
-            (p_addr <= (uint32_t*)m_fs.end_addr)   &&
+            (p_addr >= (uint32_t*)(uintptr_t)m_fs.start_addr) &&
+            (p_addr <= (uint32_t*)(uintptr_t)m_fs.end_addr)   &&
             (is_word_aligned(p_addr)));
 }
 
@@ -299,10 +334,12 @@ static ret_code_t page_from_record(uint16_t * const p_page, uint32_t const * con
 // Scan a page to determine how many words have been written to it.
 // This information is used to set the page write offset during initialization.
 // Additionally, this function updates the latest record ID as it proceeds.
-// If an invalid record header is found, the can_gc argument is set to true.
+// If an invalid record header is found, the can_gc argument is set to true,
+// and the words it takes are added to freeable_words.
 static void page_scan(uint32_t const *       p_addr,
                       uint16_t       * const words_written,
-                      bool           * const can_gc)
+                      bool           * const can_gc,
+                      uint16_t       * const freeable_words)
 {
     uint32_t const * const p_page_end = p_addr + FDS_PAGE_SIZE;
 
@@ -322,6 +359,14 @@ static void page_scan(uint32_t const *       p_addr,
             {
                 m_latest_rec_id = p_header->record_id;
             }
+
+            if (header_is_batch(p_header))
+            {
+                // Scan the records of the batch.
+                *words_written += FDS_HEADER_SIZE;
+                p_header        = (fds_header_t*)((uint32_t*)p_header + FDS_HEADER_SIZE);
+                continue;
+            }
         }
         else
         {
@@ -332,6 +377,11 @@ static void page_scan(uint32_t const *       p_addr,
 
             if (hdr == FDS_HEADER_CORRUPT)
             {
+                if (freeable_words != NULL)
+                {
+                    *freeable_words += FDS_PAGE_SIZE - *words_written;
+                }
+
                 // It could happen that a record has a corrupt header which would set a
                 // wrong offset for this page. In such cases, update this value to its maximum,
                 // to ensure that no new records will be written to this page and to enable
@@ -341,6 +391,11 @@ static void page_scan(uint32_t const *       p_addr,
                 // We can't continue to scan this page.
                 return;
             }
+
+            if (freeable_words != NULL)
+            {
+                *freeable_words += (FDS_HEADER_SIZE + p_header->length_words);
+            }
         }
 
         *words_written += (FDS_HEADER_SIZE + p_header->length_words);
@@ -370,7 +425,7 @@ static ret_code_t page_tag_write_swap(void)
 {
     // The tag needs to be statically allocated since it is not buffered by fstorage.
     static uint32_t const page_tag_swap[] = {FDS_PAGE_TAG_MAGIC, FDS_PAGE_TAG_SWAP};
-    return nrf_fstorage_write(&m_fs, (uint32_t)m_swap_page.p_addr, page_tag_swap, FDS_PAGE_TAG_SIZE * sizeof(uint32_t), NULL);
+    return nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)m_swap_page.p_addr, page_tag_swap, FDS_PAGE_TAG_SIZE * sizeof(uint32_t), NULL);
 }
 
 
@@ -379,7 +434,7 @@ static ret_code_t page_tag_write_data(uint32_t const * const p_page_addr)
 {
     // The tag needs to be statically allocated since it is not buffered by fstorage.
     static uint32_t const page_tag_data[] = {FDS_PAGE_TAG_MAGIC, FDS_PAGE_TAG_DATA};
-    return nrf_fstorage_write(&m_fs, (uint32_t)p_page_addr, page_tag_data, FDS_PAGE_TAG_SIZE * sizeof(uint32_t), NULL);
+    return nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)p_page_addr, page_tag_data, FDS_PAGE_TAG_SIZE * sizeof(uint32_t), NULL);
 }
 
 
@@ -459,6 +514,12 @@ static bool record_find_next(uint16_t page, uint32_t const ** p_record)
         switch (header_check(p_header, p_page_end))
         {
             case FDS_HEADER_VALID:
+                if (header_is_batch(p_header))
+                {
+                    // Search the records of the batch.
+                    p_header = (fds_header_t*)((uint32_t*)p_header + FDS_HEADER_SIZE);
+                    break;
+                }
                 *p_record = (uint32_t*)p_header;
                 return true;
 
@@ -515,6 +576,263 @@ static bool record_find_by_desc(fds_record_desc_t * const p_desc, uint16_t * con
 }
 
 
+#if (FDS_INDEX_ENABLED)
+
+#define INDEX_MASK  (FDS_INDEX_SIZE - 1)
+
+// The slot where the probe sequence for a file ID and record key starts.
+static uint32_t index_slot(uint16_t file_id, uint16_t record_key)
+{
+    uint32_t const hash = (((uint32_t)file_id << 16) | record_key) * 0x9E3779B1;
+
+    // Fold the high bits, which depend on both keys, into the low bits.
+    return (hash ^ (hash >> 16)) & INDEX_MASK;
+}
+
+
+// Adds a valid record to the index.
+// If the index is full, it is no longer valid and record_find() scans the pages instead.
+static void index_add(uint32_t const * const p_record)
+{
+    fds_header_t const * const p_header = (fds_header_t*)p_record;
+
+    CRITICAL_SECTION_ENTER();
+    if (m_index.valid && (m_index.count == FDS_INDEX_MAX_RECORDS))
+    {
+        m_index.valid = false;
+    }
+    if (m_index.valid)
+    {
+        uint32_t slot = index_slot(p_header->file_id, p_header->record_key);
+
+        while (m_index.entries[slot].p_record != NULL)
+        {
+            slot = (slot + 1) & INDEX_MASK;
+        }
+
+        m_index.entries[slot].p_record   = p_record;
+        m_index.entries[slot].file_id    = p_header->file_id;
+        m_index.entries[slot].record_key = p_header->record_key;
+        m_index.count++;
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Frees an entry. The entries after it in its probe sequence are moved back as far as their
+// own probe sequences allow, so that every entry can still be reached from its first slot.
+// NOTE: Must be called from within a critical section.
+static void index_entry_free(uint32_t slot)
+{
+    uint32_t next = slot;
+
+    while (true)
+    {
+        next = (next + 1) & INDEX_MASK;
+
+        fds_index_entry_t const * const p_entry = &m_index.entries[next];
+
+        if (p_entry->p_record == NULL)
+        {
+            break;
+        }
+
+        // The entry can be moved to the free slot if the slot is part of its probe sequence.
+        uint32_t const first = index_slot(p_entry->file_id, p_entry->record_key);
+
+        if (((next - first) & INDEX_MASK) >= ((next - slot) & INDEX_MASK))
+        {
+            m_index.entries[slot] = *p_entry;
+            slot                  = next;
+        }
+    }
+
+    m_index.entries[slot].p_record = NULL;
+    m_index.count--;
+}
+
+
+// Removes a record from the index. Must be called before the record is flagged as dirty,
+// while its header still holds its file ID and record key.
+static void index_remove(uint32_t const * const p_record)
+{
+    fds_header_t const * const p_header = (fds_header_t*)p_record;
+
+    CRITICAL_SECTION_ENTER();
+    if (m_index.valid)
+    {
+        uint32_t slot = index_slot(p_header->file_id, p_header->record_key);
+
+        while (m_index.entries[slot].p_record != NULL)
+        {
+            if (m_index.entries[slot].p_record == p_record)
+            {
+                index_entry_free(slot);
+                break;
+            }
+            slot = (slot + 1) & INDEX_MASK;
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Replaces the old copy of an updated record with the new copy, which may have another file ID
+// or record key. Both changes are made in one critical section, so that a search finds either
+// copy, as a page scan would. Must be called before the old copy is flagged as dirty.
+static void index_replace(uint32_t const * const p_old, uint32_t const * const p_new)
+{
+    CRITICAL_SECTION_ENTER();
+    index_remove(p_old);
+    index_add(p_new);
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Updates the index after garbage collection has moved the records of a page, which
+// was at p_old_addr, to the page now at m_pages[page].p_addr.
+static void index_page_move(uint16_t page, uint32_t const * const p_old_addr)
+{
+    uint32_t const * p_record = NULL;
+
+    CRITICAL_SECTION_ENTER();
+    if (m_index.valid)
+    {
+        uint32_t slot = 0;
+
+        while (slot < FDS_INDEX_SIZE)
+        {
+            uint32_t const * const p_entry_record = m_index.entries[slot].p_record;
+
+            if ((p_entry_record >= p_old_addr) && (p_entry_record < p_old_addr + FDS_PAGE_SIZE))
+            {
+                // Another entry may have been moved to this slot; check it again.
+                index_entry_free(slot);
+                continue;
+            }
+            slot++;
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+
+    while (record_find_next(page, &p_record))
+    {
+        index_add(p_record);
+    }
+}
+
+
+// Indexes the records of all data pages.
+static void index_build(void)
+{
+    CRITICAL_SECTION_ENTER();
+    memset(&m_index, 0x00, sizeof(m_index));
+    m_index.valid = true;
+    CRITICAL_SECTION_EXIT();
+
+    for (uint16_t page = 0; page < FDS_DATA_PAGES; page++)
+    {
+        uint32_t const * p_record = NULL;
+
+        if (m_pages[page].page_type != FDS_PAGE_DATA)
+        {
+            continue;
+        }
+
+        while (record_find_next(page, &p_record))
+        {
+            index_add(p_record);
+        }
+    }
+}
+
+
+// Called when an operation fails: the records in flash may no longer match the index.
+static void index_invalidate(void)
+{
+    m_index.valid   = false;
+    m_index.rebuild = true;
+}
+
+
+// The position of a record in the order in which record_find() visits records.
+static uint32_t index_position(uint16_t page, uint32_t const * const p_record)
+{
+    return (uint32_t)page * FDS_PAGE_SIZE + (uint32_t)(p_record - m_pages[page].p_addr);
+}
+
+
+// Same as record_find() with both a file ID and a record key, using the index. Records are
+// found in the same order and the token is updated the same way, so that a search can be
+// continued by scanning the pages.
+static ret_code_t index_find(uint16_t                  file_id,
+                             uint16_t                  record_key,
+                             fds_record_desc_t       * p_desc,
+                             fds_find_token_t        * p_token)
+{
+    uint32_t         slot      = index_slot(file_id, record_key);
+    uint32_t         after;
+    uint32_t         best      = UINT32_MAX;
+    uint32_t const * p_best    = NULL;
+    uint16_t         best_page = 0;
+
+    if (p_token->page >= FDS_DATA_PAGES)
+    {
+        return FDS_ERR_NOT_FOUND;
+    }
+
+    // Records follow the page tag, so they are all after the start of their page.
+    after = index_position(p_token->page, (p_token->p_addr != NULL) ?
+                                          p_token->p_addr : m_pages[p_token->page].p_addr);
+
+    CRITICAL_SECTION_ENTER();
+    // All records with these keys are in the probe sequence, which ends at a free entry.
+    while (m_index.entries[slot].p_record != NULL)
+    {
+        fds_index_entry_t const * const p_entry = &m_index.entries[slot];
+        uint16_t                        page;
+
+        slot = (slot + 1) & INDEX_MASK;
+
+        if ((p_entry->file_id    != file_id)    ||
+            (p_entry->record_key != record_key) ||
+            (page_from_record(&page, p_entry->p_record) != NRF_SUCCESS))
+        {
+            continue;
+        }
+
+        uint32_t const position = index_position(page, p_entry->p_record);
+
+        if ((position > after) && (position < best))
+        {
+            best      = position;
+            best_page = page;
+            p_best    = p_entry->p_record;
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+
+    if (p_best == NULL)
+    {
+        // As at the end of a scan.
+        p_token->page   = FDS_DATA_PAGES;
+        p_token->p_addr = NULL;
+        return FDS_ERR_NOT_FOUND;
+    }
+
+    p_token->page   = best_page;
+    p_token->p_addr = p_best;
+
+    p_desc->record_id    = ((fds_header_t*)p_best)->record_id;
+    p_desc->p_record     = p_best;
+    p_desc->gc_run_count = m_gc.run_count;
+
+    return NRF_SUCCESS;
+}
+
+#endif // FDS_INDEX_ENABLED
+
+
 // Search for a record and return its descriptor.
 // If p_file_id is NULL, only the record key will be used for matching.
 // If p_record_key is NULL, only the file ID will be used for matching.
@@ -534,6 +852,24 @@ static ret_code_t record_find(uint16_t          const * p_file_id,
         return FDS_ERR_NULL_ARG;
     }
 
+#if (FDS_INDEX_ENABLED)
+    // The index is keyed on both. Searches by one of them visit every record anyway,
+    // and continue a scan of the pages from where the last one stopped.
+    if ((p_file_id != NULL) && (p_record_key != NULL))
+    {
+        // Rebuilding while an operation is executing could index a record it is about to change.
+        if (!m_index.valid && m_index.rebuild && (m_queued_op_cnt == 0))
+        {
+            index_build();
+        }
+
+        if (m_index.valid)
+        {
+            return index_find(*p_file_id, *p_record_key, p_desc, p_token);
+        }
+    }
+#endif
+
     // Begin (or resume) searching for a record.
     for (; p_token->page < FDS_DATA_PAGES; p_token->page++)
     {
@@ -599,6 +935,13 @@ static void records_stat(uint16_t   page,
                 break;
 
             case FDS_HEADER_VALID:
+                if (header_is_batch(p_header))
+                {
+                    // Garbage collection copies the records of a batch, but not its header.
+                    *p_freeable_words += FDS_HEADER_SIZE;
+                    p_header = (fds_header_t*)((uint32_t*)p_header + FDS_HEADER_SIZE);
+                    break;
+                }
                 *p_valid_records += 1;
                 p_header = header_jump(p_header);
                 break;
@@ -624,7 +967,11 @@ static fds_op_t * queue_buf_get(nrf_atfifo_item_put_t * p_iput_ctx)
 {
     fds_op_t * const p_op = (fds_op_t*) nrf_atfifo_item_alloc(m_queue, p_iput_ctx);
 
-    memset(p_op, 0x00, sizeof(fds_op_t));
+    // NULL if the queue is full.
+    if (p_op != NULL)
+    {
+        memset(p_op, 0x00, sizeof(fds_op_t));
+    }
     return p_op;
 }
 
@@ -670,7 +1017,7 @@ static fds_init_opts_t pages_init(void)
 
     for (uint16_t i = 0; i < FDS_VIRTUAL_PAGES; i++)
     {
-        uint32_t        const * const p_page_addr = (uint32_t*)m_fs.start_addr + (i * FDS_PAGE_SIZE);
+        uint32_t        const * const p_page_addr = (uint32_t*)(uintptr_t)m_fs.start_addr + (i * FDS_PAGE_SIZE);
         fds_page_type_t const         page_type   = page_identify(p_page_addr);
 
         switch (page_type)
@@ -720,7 +1067,8 @@ static fds_init_opts_t pages_init(void)
 
                 // Scan the page to compute its write offset and determine whether or not the page
                 // can be garbage collected. Additionally, update the latest kwown record ID.
-                page_scan(p_page_addr, &m_pages[page].write_offset, &m_pages[page].can_gc);
+                page_scan(p_page_addr, &m_pages[page].write_offset, &m_pages[page].can_gc,
+                          &m_pages[page].freeable_words);
 
                 ret |= PAGE_DATA;
                 page++;
@@ -743,7 +1091,7 @@ static fds_init_opts_t pages_init(void)
                 m_swap_page.p_addr = p_page_addr;
                 // If the swap is promoted, this offset should be kept, otherwise,
                 // it should be set to FDS_PAGE_TAG_SIZE.
-                page_scan(p_page_addr, &m_swap_page.write_offset, NULL);
+                page_scan(p_page_addr, &m_swap_page.write_offset, NULL, NULL);
 
                 ret |= (m_swap_page.write_offset == FDS_PAGE_TAG_SIZE) ?
                         PAGE_SWAP_CLEAN : PAGE_SWAP_DIRTY;
@@ -772,7 +1120,7 @@ static ret_code_t record_header_write_begin(fds_op_t * const p_op, uint32_t * co
     // Write the record ID next.
     p_op->write.step = FDS_OP_WRITE_RECORD_ID;
 
-    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_TL),
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)(p_addr + FDS_OFFSET_TL),
         &p_op->write.header.record_key, FDS_HEADER_SIZE_TL * sizeof(uint32_t), NULL);
 
     return (ret == NRF_SUCCESS) ? NRF_SUCCESS : FDS_ERR_BUSY;
@@ -788,7 +1136,7 @@ static ret_code_t record_header_write_id(fds_op_t * const p_op, uint32_t * const
     p_op->write.step = (p_op->write.p_data != NULL) ?
                         FDS_OP_WRITE_DATA : FDS_OP_WRITE_HEADER_FINALIZE;
 
-    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_ID),
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)(p_addr + FDS_OFFSET_ID),
         &p_op->write.header.record_id, FDS_HEADER_SIZE_ID * sizeof(uint32_t), NULL);
 
     return (ret == NRF_SUCCESS) ? NRF_SUCCESS : FDS_ERR_BUSY;
@@ -804,31 +1152,46 @@ static ret_code_t record_header_write_finalize(fds_op_t * const p_op, uint32_t *
     p_op->write.step = (p_op->op_code == FDS_OP_UPDATE) ?
                         FDS_OP_WRITE_FLAG_DIRTY : FDS_OP_WRITE_DONE;
 
-    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_IC),
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)(p_addr + FDS_OFFSET_IC),
         &p_op->write.header.file_id, FDS_HEADER_SIZE_IC * sizeof(uint32_t), NULL);
 
     return (ret == NRF_SUCCESS) ? NRF_SUCCESS : FDS_ERR_BUSY;
 }
 
 
-static ret_code_t record_header_flag_dirty(uint32_t * const p_record, uint16_t page_to_gc)
+// Zeroes the record key of a header, which makes the record dirty.
+static ret_code_t header_flag_dirty_write(uint32_t const * const p_record)
 {
     // Used to flag a record as dirty, i.e. ready for garbage collection.
     // Must be statically allocated since it will be written to flash.
     __ALIGN(4) static uint32_t const dirty_header = {0xFFFF0000};
 
+    return nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)p_record,
+        &dirty_header, FDS_HEADER_SIZE_TL * sizeof(uint32_t), NULL);
+}
+
+
+static ret_code_t record_header_flag_dirty(uint32_t * const p_record, uint16_t page_to_gc)
+{
     // Flag the record as dirty.
     ret_code_t ret;
 
-    ret = nrf_fstorage_write(&m_fs, (uint32_t)p_record,
-        &dirty_header, FDS_HEADER_SIZE_TL * sizeof(uint32_t), NULL);
+    ret = header_flag_dirty_write(p_record);
 
     if (ret != NRF_SUCCESS)
     {
         return FDS_ERR_BUSY;
     }
 
-    m_pages[page_to_gc].can_gc = true;
+    m_pages[page_to_gc].can_gc          = true;
+    m_pages[page_to_gc].freeable_words += FDS_HEADER_SIZE + ((fds_header_t*)p_record)->length_words;
+
+    if ((m_gc.state != GC_BEGIN) && (page_to_gc == m_gc.cur_page))
+    {
+        // Garbage collection of this page was interrupted, and the record
+        // may have been copied to the swap already. See gc_copy_find_stale().
+        m_gc.page_touched = true;
+    }
 
     return NRF_SUCCESS;
 }
@@ -854,6 +1217,10 @@ static ret_code_t record_find_and_delete(fds_op_t * const p_op)
         p_op->del.file_id    = p_header->file_id;
         p_op->del.record_key = p_header->record_key;
 
+#if (FDS_INDEX_ENABLED)
+        index_remove(desc.p_record);
+#endif
+
         // Flag the record as dirty.
         ret = record_header_flag_dirty((uint32_t*)desc.p_record, page);
     }
@@ -881,6 +1248,9 @@ static ret_code_t file_find_and_delete(fds_op_t * const p_op)
 
     if (ret == NRF_SUCCESS)
     {
+#if (FDS_INDEX_ENABLED)
+        index_remove(desc.p_record);
+#endif
          // A record was found: flag it as dirty.
         ret = record_header_flag_dirty((uint32_t*)desc.p_record, tok.page);
     }
@@ -901,7 +1271,7 @@ static ret_code_t record_write_data(fds_op_t * const p_op, uint32_t * const p_ad
 
     p_op->write.step = FDS_OP_WRITE_HEADER_FINALIZE;
 
-    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_DATA),
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)(p_addr + FDS_OFFSET_DATA),
         p_op->write.p_data,  p_op->write.header.length_words * sizeof(uint32_t), NULL);
 
     return (ret == NRF_SUCCESS) ? NRF_SUCCESS : FDS_ERR_BUSY;
@@ -930,8 +1300,9 @@ static bool crc_verify_success(uint16_t crc, uint16_t len_words, uint32_t const
 static void gc_init(void)
 {
     m_gc.run_count++;
-    m_gc.cur_page = 0;
-    m_gc.resume   = false;
+    m_gc.cur_page   = 0;
+    m_gc.resume     = false;
+    m_gc.step_words = 0;
 
     // Setup which pages to GC. Defer checking for open records and the can_gc flag,
     // as other operations might change those while GC is running.
@@ -958,7 +1329,9 @@ static bool gc_page_next(uint16_t * const p_next_page)
             // Only GC pages with no open records and with some records which have been deleted.
             if ((m_pages[i].records_open == 0) && (m_pages[i].can_gc == true))
             {
-                *p_next_page = i;
+                *p_next_page         = i;
+                m_gc.page_touched    = false;
+                m_gc.copies_freeable = 0;
                 ret = true;
                 break;
             }
@@ -974,7 +1347,7 @@ static ret_code_t gc_swap_erase(void)
     m_gc.state               = GC_DISCARD_SWAP;
     m_swap_page.write_offset = FDS_PAGE_TAG_SIZE;
 
-    return nrf_fstorage_erase(&m_fs, (uint32_t)m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
+    return nrf_fstorage_erase(&m_fs, (uint32_t)(uintptr_t)m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
 }
 
 
@@ -989,7 +1362,7 @@ static ret_code_t gc_page_erase(void)
     {
         m_gc.state = GC_ERASE_PAGE;
 
-        ret = nrf_fstorage_erase(&m_fs, (uint32_t)m_pages[gc].p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
+        ret = nrf_fstorage_erase(&m_fs, (uint32_t)(uintptr_t)m_pages[gc].p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
     }
     else
     {
@@ -1013,21 +1386,85 @@ static ret_code_t gc_record_copy(void)
 
     // Copy the record to swap; it is guaranteed to fit in the destination page,
     // so there is no need to check its size. This will either succeed or timeout.
-    return nrf_fstorage_write(&m_fs, (uint32_t)p_dest, m_gc.p_record_src,
+    return nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)p_dest, m_gc.p_record_src,
                               record_len * sizeof(uint32_t),
                               NULL);
 }
 
 
+// Finds a record in the swap whose original was flagged dirty after it was copied.
+// Records are copied in the order they are stored, so the copies and the page being
+// garbage collected can be walked together.
+static uint32_t const * gc_copy_find_stale(void)
+{
+    uint32_t     const * const p_copies_end = m_swap_page.p_addr + m_swap_page.write_offset;
+    uint32_t     const * const p_swap_end   = m_swap_page.p_addr + FDS_PAGE_SIZE;
+    uint32_t     const * const p_page_end   = m_pages[m_gc.cur_page].p_addr + FDS_PAGE_SIZE;
+    fds_header_t const *       p_copy = (fds_header_t*)(m_swap_page.p_addr + FDS_PAGE_TAG_SIZE);
+    fds_header_t const *       p_orig = (fds_header_t*)(m_pages[m_gc.cur_page].p_addr + FDS_PAGE_TAG_SIZE);
+
+    while ((uint32_t*)p_copy < p_copies_end)
+    {
+        fds_header_status_t status;
+
+        if (!header_has_next(p_orig, p_page_end))
+        {
+            break;
+        }
+
+        status = header_check(p_orig, p_page_end);
+        if (status == FDS_HEADER_CORRUPT)
+        {
+            break;
+        }
+
+        if (p_orig->record_id != p_copy->record_id)
+        {
+            // Not copied. The records of a batch follow its header.
+            p_orig = ((status == FDS_HEADER_VALID) && header_is_batch(p_orig)) ?
+                     (fds_header_t*)((uint32_t*)p_orig + FDS_HEADER_SIZE) : header_jump(p_orig);
+            continue;
+        }
+
+        if ((status == FDS_HEADER_DIRTY) &&
+            (header_check(p_copy, p_swap_end) == FDS_HEADER_VALID))
+        {
+            return (uint32_t*)p_copy;
+        }
+
+        p_orig = header_jump(p_orig);
+        p_copy = header_jump(p_copy);
+    }
+
+    return NULL;
+}
+
+
+// Flag a copy dirty, so that the record is not restored when the swap is promoted.
+static ret_code_t gc_copy_flag_dirty(uint32_t const * const p_copy)
+{
+    m_gc.state            = GC_FLAG_COPY_DIRTY;
+    m_gc.copies_freeable += FDS_HEADER_SIZE + ((fds_header_t*)p_copy)->length_words;
+
+    return header_flag_dirty_write(p_copy);
+}
+
+
 static ret_code_t gc_record_find_next(void)
 {
-    ret_code_t ret;
+    ret_code_t       ret;
+    uint32_t const * p_copy;
 
     // Find the next valid record to copy.
     if (record_find_next(m_gc.cur_page, &m_gc.p_record_src))
     {
         ret = gc_record_copy();
     }
+    else if (m_gc.page_touched && ((p_copy = gc_copy_find_stale()) != NULL))
+    {
+        // Records were deleted while garbage collection was interrupted.
+        ret = gc_copy_flag_dirty(p_copy);
+    }
     else
     {
         // No more records left to copy on this page; swap pages.
@@ -1064,6 +1501,11 @@ static ret_code_t gc_next_page(void)
         m_gc.cur_page     = 0;
         m_gc.p_record_src = NULL;
 
+#if (FDS_INDEX_ENABLED)
+        // If the index was full, records may have been deleted since.
+        m_index.rebuild = true;
+#endif
+
         return FDS_OP_COMPLETED;
     }
 
@@ -1078,6 +1520,7 @@ static void gc_update_swap_offset(void)
     uint16_t     const         record_len = FDS_HEADER_SIZE + p_header->length_words;
 
     m_swap_page.write_offset += record_len;
+    m_gc.step_words          += record_len;
 }
 
 
@@ -1095,7 +1538,12 @@ static void gc_swap_pages(void)
     m_swap_page.write_offset            = FDS_PAGE_TAG_SIZE;
 
     // Page has been garbage collected
-    m_pages[m_gc.cur_page].can_gc = false;
+    m_pages[m_gc.cur_page].can_gc         = (m_gc.copies_freeable > 0);
+    m_pages[m_gc.cur_page].freeable_words = m_gc.copies_freeable;
+
+    // Records have moved. Descriptors obtained while garbage collection was
+    // interrupted must look their records up again.
+    m_gc.run_count++;
 }
 
 
@@ -1116,8 +1564,26 @@ static void gc_state_advance(void)
 
         // A page was successfully erased. Prepare to promote the swap.
         case GC_ERASE_PAGE:
+        {
+#if (FDS_INDEX_ENABLED)
+            uint32_t const * const p_old_addr = m_pages[m_gc.cur_page].p_addr;
+
             gc_swap_pages();
+            index_page_move(m_gc.cur_page, p_old_addr);
+#else
+            gc_swap_pages();
+#endif
             m_gc.state = GC_PROMOTE_SWAP;
+
+#if (FDS_GC_INCREMENTAL)
+            // Let other operations run once this page is done.
+            m_gc.step_words = FDS_GC_STEP_WORDS;
+#endif
+        } break;
+
+        // A copy was flagged dirty. Look for more.
+        case GC_FLAG_COPY_DIRTY:
+            m_gc.state = GC_FIND_NEXT_RECORD;
             break;
 
         // Swap was discarded because the page being GC'ed had open records.
@@ -1176,6 +1642,9 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
             }
             if (!write_reqd)
             {
+#if (FDS_INDEX_ENABLED)
+                index_build();
+#endif
                 m_flags.initialized  = true;
                 m_flags.initializing = false;
                 return FDS_OP_COMPLETED;
@@ -1188,7 +1657,7 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
             p_op->init.step          = FDS_OP_INIT_TAG_SWAP;
             m_swap_page.write_offset = FDS_PAGE_TAG_SIZE;
 
-            ret = nrf_fstorage_erase(&m_fs, (uint32_t)m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
+            ret = nrf_fstorage_erase(&m_fs, (uint32_t)(uintptr_t)m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
         } break;
 
         case FDS_OP_INIT_PROMOTE_SWAP:
@@ -1291,12 +1760,25 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
 
         case FDS_OP_WRITE_FLAG_DIRTY:
             p_op->write.step = FDS_OP_WRITE_DONE;
+#if (FDS_INDEX_ENABLED)
+            // The new copy is complete: it takes the place of the old one in the index.
+            index_replace(desc.p_record, p_write_addr);
+#endif
             ret = record_header_flag_dirty((uint32_t*)desc.p_record, page);
             break;
 
         case FDS_OP_WRITE_DONE:
             ret = FDS_OP_COMPLETED;
 
+#if (FDS_INDEX_ENABLED)
+            // The record is valid from now on, even if its CRC check fails.
+            // An update indexed it already, in FDS_OP_WRITE_FLAG_DIRTY.
+            if (p_op->op_code != FDS_OP_UPDATE)
+            {
+                index_add(p_write_addr);
+            }
+#endif
+
 #if (FDS_CRC_CHECK_ON_WRITE)
             if (!crc_verify_success(p_op->write.header.crc16,
                                     p_op->write.header.length_words,
@@ -1324,6 +1806,220 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
 }
 
 
+// Builds the header of a record of a batch.
+static void batch_record_header(fds_op_t const * const p_op, uint16_t record, fds_header_t * const p_hdr)
+{
+    fds_record_t const * const p_record = &p_op->batch.p_records[record];
+    uint16_t                   crc      = 0;
+
+    p_hdr->record_key   = p_record->key;
+    p_hdr->length_words = p_record->data.length_words;
+    p_hdr->file_id      = p_record->file_id;
+    p_hdr->record_id    = p_op->batch.header.record_id + 1 + record;
+
+#if (FDS_CRC_CHECK_ON_READ)
+    // Same as for a single record, see write_enqueue().
+    crc = crc16_compute((uint8_t*)p_hdr,            6, NULL);
+    crc = crc16_compute((uint8_t*)&p_hdr->record_id, 4, &crc);
+    crc = crc16_compute((uint8_t*)p_record->data.p_data,
+                        p_record->data.length_words * sizeof(uint32_t), &crc);
+#endif
+
+    p_hdr->crc16 = crc;
+}
+
+
+// Copies the next part of the batch to m_batch_buf and returns its length in words.
+// The batch is the header of the enclosing record, with the file ID left erased,
+// followed by the header and the data of each record.
+static uint16_t batch_buffer_fill(fds_op_t * const p_op)
+{
+    uint16_t words = 0;
+
+    if (p_op->batch.words_written == 0)
+    {
+        fds_header_t header = p_op->batch.header;
+
+        // Written last, by batch_commit().
+        header.file_id = FDS_FILE_ID_INVALID;
+        header.crc16   = 0xFFFF;
+
+        memcpy(m_batch_buf, &header, FDS_HEADER_SIZE * sizeof(uint32_t));
+        words = FDS_HEADER_SIZE;
+    }
+
+    while ((words < FDS_BATCH_BUFFER_WORDS) && (p_op->batch.record < p_op->batch.count))
+    {
+        fds_record_t const * const p_record   = &p_op->batch.p_records[p_op->batch.record];
+        uint16_t             const record_len = FDS_HEADER_SIZE + p_record->data.length_words;
+        uint16_t             const offset     = p_op->batch.record_offset;
+        uint16_t                   chunk;
+
+        if (offset < FDS_HEADER_SIZE)
+        {
+            fds_header_t header;
+
+            batch_record_header(p_op, p_op->batch.record, &header);
+            chunk = MIN(FDS_HEADER_SIZE - offset, FDS_BATCH_BUFFER_WORDS - words);
+            memcpy(&m_batch_buf[words], (uint32_t*)&header + offset, chunk * sizeof(uint32_t));
+        }
+        else
+        {
+            uint32_t const * const p_data = (uint32_t const *)p_record->data.p_data;
+
+            chunk = MIN(record_len - offset, FDS_BATCH_BUFFER_WORDS - words);
+            memcpy(&m_batch_buf[words], p_data + (offset - FDS_HEADER_SIZE), chunk * sizeof(uint32_t));
+        }
+
+        words                     += chunk;
+        p_op->batch.record_offset += chunk;
+
+        if (p_op->batch.record_offset == record_len)
+        {
+            p_op->batch.record++;
+            p_op->batch.record_offset = 0;
+        }
+    }
+
+    return words;
+}
+
+
+// Writes the next part of the batch.
+static ret_code_t batch_write_records(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t     ret;
+    uint16_t const offset = p_op->batch.words_written;
+    uint16_t const words  = batch_buffer_fill(p_op);
+
+    p_op->batch.words_written += words;
+
+    if (p_op->batch.words_written == FDS_HEADER_SIZE + p_op->batch.header.length_words)
+    {
+        p_op->batch.step = FDS_OP_BATCH_COMMIT;
+    }
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)(p_addr + offset),
+        m_batch_buf, words * sizeof(uint32_t), NULL);
+
+    if (ret != NRF_SUCCESS)
+    {
+        // Nothing was written.
+        p_op->batch.words_written = offset;
+        return FDS_ERR_BUSY;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+// Writes the file ID of the enclosing record, which commits all records of the batch.
+static ret_code_t batch_commit(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret;
+
+    p_op->batch.step = FDS_OP_BATCH_DONE;
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(uintptr_t)(p_addr + FDS_OFFSET_IC),
+        &p_op->batch.header.file_id, FDS_HEADER_SIZE_IC * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? NRF_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+static void batch_offsets_update(fds_page_t * const p_page, fds_op_t const * p_op, bool committed)
+{
+    uint16_t const batch_len = FDS_HEADER_SIZE + p_op->batch.header.length_words;
+
+    // Once anything has been written, the space is used. A batch that was not committed
+    // is dirty, and it will be removed the next time garbage collection is run.
+    if (p_op->batch.words_written > 0)
+    {
+        p_page->write_offset += batch_len;
+
+        if (!committed)
+        {
+            p_page->can_gc          = true;
+            p_page->freeable_words += batch_len;
+        }
+    }
+
+    p_page->words_reserved -= batch_len;
+}
+
+
+// Executes batch write operations.
+static ret_code_t batch_execute(uint32_t prev_ret, fds_op_t * const p_op)
+{
+    ret_code_t         ret;
+    fds_page_t * const p_page       = &m_pages[p_op->batch.page];
+    uint32_t   * const p_write_addr = (uint32_t*)(p_page->p_addr + p_page->write_offset);
+
+    if (prev_ret != NRF_SUCCESS)
+    {
+        // The previous operation has timed out, update offsets.
+        batch_offsets_update(p_page, p_op, false);
+        return FDS_ERR_OPERATION_TIMEOUT;
+    }
+
+    switch (p_op->batch.step)
+    {
+        case FDS_OP_BATCH_WRITE_RECORDS:
+            ret = batch_write_records(p_op, p_write_addr);
+            break;
+
+        case FDS_OP_BATCH_COMMIT:
+            ret = batch_commit(p_op, p_write_addr);
+            break;
+
+        case FDS_OP_BATCH_DONE:
+        {
+            ret = FDS_OP_COMPLETED;
+
+#if (FDS_INDEX_ENABLED)
+            uint32_t const * p_indexed = p_write_addr + FDS_HEADER_SIZE;
+
+            for (uint16_t i = 0; i < p_op->batch.count; i++)
+            {
+                index_add(p_indexed);
+                p_indexed += FDS_HEADER_SIZE + ((fds_header_t*)p_indexed)->length_words;
+            }
+#endif
+
+#if (FDS_CRC_CHECK_ON_WRITE)
+            uint32_t const * p_record = p_write_addr + FDS_HEADER_SIZE;
+
+            for (uint16_t i = 0; i < p_op->batch.count; i++)
+            {
+                fds_header_t const * const p_header = (fds_header_t*)p_record;
+
+                if (!crc_verify_success(p_header->crc16, p_header->length_words, p_record))
+                {
+                    ret = FDS_ERR_CRC_CHECK_FAILED;
+                    break;
+                }
+                p_record += FDS_HEADER_SIZE + p_header->length_words;
+            }
+#endif
+        } break;
+
+        default:
+            ret = FDS_ERR_INTERNAL;
+            break;
+    }
+
+    if (ret != FDS_OP_EXECUTING)
+    {
+        // There won't be another callback for this operation, so update the page offset now.
+        // The batch is committed if the commit step was reached and did not fail to start.
+        batch_offsets_update(p_page, p_op,
+                             (p_op->batch.step == FDS_OP_BATCH_DONE) && (ret != FDS_ERR_BUSY));
+    }
+
+    return ret;
+}
+
+
 static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
 {
     ret_code_t ret;
@@ -1363,6 +2059,91 @@ static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
 }
 
 
+#if (FDS_GC_INCREMENTAL) || (FDS_GC_AUTO_WORDS > 0)
+// Queues an operation from within queue_process(), which will run it after the others.
+static bool queue_append(fds_op_code_t op_code)
+{
+    nrf_atfifo_item_put_t iput_ctx;
+    fds_op_t * const      p_op = queue_buf_get(&iput_ctx);
+
+    if (p_op == NULL)
+    {
+        return false;
+    }
+
+    p_op->op_code = op_code;
+    queue_buf_store(&iput_ctx);
+
+    // queue_process() is running, so there is no need to start it.
+    (void)nrf_atomic_u32_add(&m_queued_op_cnt, 1);
+
+    return true;
+}
+#endif
+
+
+#if (FDS_GC_INCREMENTAL)
+// Once FDS_GC_STEP_WORDS words have been copied, garbage collection is queued again behind
+// the operations that are waiting, and continues after them. A page erase takes as long as a
+// whole step, so it also stops before one, unless nothing was done since it continued. It only
+// stops between two records, or between two pages.
+static bool gc_yield(void)
+{
+    if ((m_queued_op_cnt < 2) ||
+        ((m_gc.state != GC_FIND_NEXT_RECORD) && (m_gc.state != GC_NEXT_PAGE)))
+    {
+        return false;
+    }
+
+    if (m_gc.step_words < FDS_GC_STEP_WORDS)
+    {
+        uint32_t const * p_record = m_gc.p_record_src;
+
+        if (   (m_gc.step_words == 0)
+            || (m_gc.state != GC_FIND_NEXT_RECORD)
+            || record_find_next(m_gc.cur_page, &p_record))
+        {
+            return false;
+        }
+    }
+
+    // Start with the current step when garbage collection runs again.
+    m_gc.step_words = 0;
+    m_gc.resume     = true;
+
+    return true;
+}
+#endif
+
+
+#if (FDS_GC_AUTO_WORDS > 0)
+// Queues garbage collection once it can free FDS_GC_AUTO_WORDS words.
+static void gc_auto_start(void)
+{
+    uint32_t freeable_words = 0;
+
+    if (m_gc.auto_queued || (m_gc.state != GC_BEGIN))
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < FDS_DATA_PAGES; i++)
+    {
+        // Pages with open records are not garbage collected.
+        if ((m_pages[i].page_type == FDS_PAGE_DATA) && (m_pages[i].records_open == 0))
+        {
+            freeable_words += m_pages[i].freeable_words;
+        }
+    }
+
+    if ((freeable_words >= FDS_GC_AUTO_WORDS) && queue_append(FDS_OP_GC))
+    {
+        m_gc.auto_queued = true;
+    }
+}
+#endif
+
+
 static ret_code_t gc_execute(uint32_t prev_ret)
 {
     ret_code_t ret;
@@ -1381,6 +2162,13 @@ static ret_code_t gc_execute(uint32_t prev_ret)
         gc_state_advance();
     }
 
+#if (FDS_GC_INCREMENTAL)
+    if (gc_yield())
+    {
+        return FDS_OP_YIELDED;
+    }
+#endif
+
     switch (m_gc.state)
     {
         case GC_NEXT_PAGE:
@@ -1388,6 +2176,7 @@ static ret_code_t gc_execute(uint32_t prev_ret)
             break;
 
         case GC_FIND_NEXT_RECORD:
+        case GC_FLAG_COPY_DIRTY:
             ret = gc_record_find_next();
             break;
 
@@ -1460,6 +2249,10 @@ static void queue_process(ret_code_t result)
                 result = gc_execute(result);
                 break;
 
+            case FDS_OP_WRITE_BATCH:
+                result = batch_execute(result, m_p_cur_op);
+                break;
+
             default:
                 result = FDS_ERR_INTERNAL;
                 break;
@@ -1471,6 +2264,38 @@ static void queue_process(ret_code_t result)
             break;
         }
 
+#if (FDS_GC_INCREMENTAL)
+        if (result == FDS_OP_YIELDED)
+        {
+            // Garbage collection continues from a queue element put behind the others, in
+            // place of this one, so that it finds room even in a full queue. There is no
+            // event for this one.
+            m_p_cur_op = NULL;
+            result     = NRF_SUCCESS;
+
+            CRITICAL_SECTION_ENTER();
+            queue_free(&m_iget_ctx);
+            (void)queue_append(FDS_OP_GC);
+            CRITICAL_SECTION_EXIT();
+
+            // Counted again by queue_append(). Other operations are queued, see gc_yield().
+            (void)queue_has_next();
+            continue;
+        }
+#endif
+
+#if (FDS_INDEX_ENABLED)
+        // Unless nothing was changed, or the record was written but failed the CRC check,
+        // flash may be left in a state the index does not know.
+        if ((result != FDS_OP_COMPLETED)          &&
+            (result != FDS_ERR_NOT_FOUND)         &&
+            (result != FDS_ERR_CRC_CHECK_FAILED)  &&
+            (m_p_cur_op->op_code != FDS_OP_INIT))
+        {
+            index_invalidate();
+        }
+#endif
+
         // The operation has completed (either successfully or with an error).
         // - send an event to the user
         // - free the operation buffer
@@ -1486,8 +2311,26 @@ static void queue_process(ret_code_t result)
             .result = (result == FDS_OP_COMPLETED) ? NRF_SUCCESS : result,
         };
 
-        event_prepare(m_p_cur_op, &evt);
-        event_send(&evt);
+        if (m_p_cur_op->op_code == FDS_OP_WRITE_BATCH)
+        {
+            batch_events_send(m_p_cur_op, &evt);
+        }
+        else
+        {
+            event_prepare(m_p_cur_op, &evt);
+            event_send(&evt);
+        }
+
+        if (m_p_cur_op->op_code == FDS_OP_GC)
+        {
+            m_gc.auto_queued = false;
+        }
+#if (FDS_GC_AUTO_WORDS > 0)
+        else if (m_p_cur_op->op_code != FDS_OP_INIT)
+        {
+            gc_auto_start();
+        }
+#endif
 
         // Zero the pointer to the current operation so that this function
         // will fetch a new one from the queue next time it is run.
@@ -1548,6 +2391,7 @@ static ret_code_t write_enqueue(fds_record_desc_t         * const p_desc,
     }
 
     if ((p_record->file_id == FDS_FILE_ID_INVALID) ||
+        (p_record->file_id == FDS_FILE_ID_BATCH)   ||
         (p_record->key     == FDS_RECORD_KEY_DIRTY))
     {
         return FDS_ERR_INVALID_ARG;
@@ -1753,6 +2597,9 @@ ret_code_t fds_init(void)
         case ALREADY_INSTALLED:
         {
             // No initialization is necessary. Notify the application immediately.
+#if (FDS_INDEX_ENABLED)
+            index_build();
+#endif
             m_flags.initialized  = true;
             m_flags.initializing = false;
             event_send(&evt_success);
@@ -1979,6 +2826,104 @@ ret_code_t fds_record_write_reserved(fds_record_desc_t         * const p_desc,
 }
 
 
+ret_code_t fds_record_write_batch(fds_record_desc_t       * const p_descs,
+                                  fds_record_t      const * const p_records,
+                                  uint16_t                        count)
+{
+    ret_code_t              ret;
+    uint16_t                page;
+    uint32_t                length_words = 0;
+    uint32_t                record_id;
+    fds_op_t              * p_op;
+    nrf_atfifo_item_put_t   iput_ctx;
+
+    if (!m_flags.initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+
+    if (p_records == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if (count == 0)
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if ((p_records[i].file_id == FDS_FILE_ID_INVALID) ||
+            (p_records[i].file_id == FDS_FILE_ID_BATCH)   ||
+            (p_records[i].key     == FDS_RECORD_KEY_DIRTY))
+        {
+            return FDS_ERR_INVALID_ARG;
+        }
+
+        if (!is_word_aligned(p_records[i].data.p_data))
+        {
+            return FDS_ERR_UNALIGNED_ADDR;
+        }
+
+        length_words += FDS_HEADER_SIZE + p_records[i].data.length_words;
+    }
+
+    // The records are the data of the enclosing record, which must fit in one page.
+    if (length_words > FDS_PAGE_SIZE - FDS_PAGE_TAG_SIZE - FDS_HEADER_SIZE)
+    {
+        return FDS_ERR_RECORD_TOO_LARGE;
+    }
+
+    ret = write_space_reserve((uint16_t)length_words, &page);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    p_op = queue_buf_get(&iput_ctx);
+    if (p_op == NULL)
+    {
+        CRITICAL_SECTION_ENTER();
+        write_space_free((uint16_t)length_words, page);
+        CRITICAL_SECTION_EXIT();
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    // One record ID for the enclosing record, followed by one for each record.
+    record_id = nrf_atomic_u32_add(&m_latest_rec_id, count + 1) - count;
+
+    // The record key of the enclosing record is the number of records. It is not used.
+    p_op->op_code                   = FDS_OP_WRITE_BATCH;
+    p_op->batch.step                = FDS_OP_BATCH_WRITE_RECORDS;
+    p_op->batch.page                = page;
+    p_op->batch.p_records           = p_records;
+    p_op->batch.count               = count;
+    p_op->batch.header.record_id    = record_id;
+    p_op->batch.header.file_id      = FDS_FILE_ID_BATCH;
+    p_op->batch.header.record_key   = count;
+    p_op->batch.header.length_words = (uint16_t)length_words;
+    p_op->batch.header.crc16        = 0;
+
+    queue_buf_store(&iput_ctx);
+
+    if (p_descs != NULL)
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            p_descs[i].p_record       = NULL;
+            p_descs[i].record_id      = record_id + 1 + i;
+            p_descs[i].record_is_open = false;
+            p_descs[i].gc_run_count   = m_gc.run_count;
+        }
+    }
+
+    queue_start();
+
+    return NRF_SUCCESS;
+}
+
+
 ret_code_t fds_record_update(fds_record_desc_t       * const p_desc,
                              fds_record_t      const * const p_record)
 {
@@ -78,6 +78,15 @@ extern "C" {
 #define FDS_RECORD_KEY_DIRTY    (0x0000)
 
 
+/**@brief   File ID of the record that holds a batch written by @ref fds_record_write_batch.
+ *
+ * The records of a batch are stored inside one enclosing record with this file ID, whose file ID
+ * is written last to commit the whole batch. This value must not be used as a file ID by the
+ * application.
+ */
+#define FDS_FILE_ID_BATCH       (0xFFFE)
+
+
 /**@brief   FDS return values.
  */
 enum
@@ -187,7 +196,7 @@ typedef struct
 typedef enum
 {
     FDS_EVT_INIT,       //!< Event for @ref fds_init.
-    FDS_EVT_WRITE,      //!< Event for @ref fds_record_write and @ref fds_record_write_reserved.
+    FDS_EVT_WRITE,      //!< Event for @ref fds_record_write, @ref fds_record_write_reserved and @ref fds_record_write_batch.
     FDS_EVT_UPDATE,     //!< Event for @ref fds_record_update.
     FDS_EVT_DEL_RECORD, //!< Event for @ref fds_record_delete.
     FDS_EVT_DEL_FILE,   //!< Event for @ref fds_file_delete.
@@ -412,6 +421,48 @@ ret_code_t fds_record_write_reserved(fds_record_desc_t         * p_desc,
                                      fds_reserve_token_t const * p_token);
 
 
+/**@brief   Function for writing several records to flash at once, atomically.
+ *
+ * The records are stored contiguously on one page, inside an enclosing record with the file ID
+ * @ref FDS_FILE_ID_BATCH, and are written with as few flash operations as possible: their headers
+ * and data are copied to a buffer of @ref FDS_BATCH_BUFFER_WORDS words and written one buffer at
+ * a time. The batch is committed by a single word, written last. If the device powers off before
+ * that word is written, none of the records exist after reboot; afterwards, all of them do.
+ *
+ * Once written, the records behave like records written with @ref fds_record_write: they can be
+ * found, opened, updated and deleted one by one, and garbage collection moves them out of the
+ * batch. The file ID and record key rules of @ref fds_record_write apply to every record, and
+ * @ref FDS_FILE_ID_BATCH must not be used as a file ID.
+ *
+ * Neither the array of records nor their data is buffered internally; both must be kept in memory
+ * until the events for the operation have been received. The batch uses a single entry of the
+ * operation queue. Together with a header of 3 words per record plus 3 words for the batch, the
+ * records must fit in one virtual page.
+ *
+ * This function is asynchronous. Completion is reported through one @ref FDS_EVT_WRITE event per
+ * record, in order, all with the same result.
+ *
+ * @param[out]  p_descs     Array of @p count descriptors of the records that were written. Pass
+ *                          NULL if you do not need the descriptors.
+ * @param[in]   p_records   Array of @p count records to be written to flash.
+ * @param[in]   count       The number of records.
+ *
+ * @retval  NRF_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_records is NULL.
+ * @retval  FDS_ERR_INVALID_ARG         If @p count is zero, or the file ID or the record key of
+ *                                      a record is invalid.
+ * @retval  FDS_ERR_UNALIGNED_ADDR      If the data of a record is not aligned to a 4 byte boundary.
+ * @retval  FDS_ERR_RECORD_TOO_LARGE    If the records do not fit in one virtual page.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ * @retval  FDS_ERR_NO_SPACE_IN_FLASH   If there is not enough free space in flash to store the
+ *                                      records.
+ */
+ret_code_t fds_record_write_batch(fds_record_desc_t       * p_descs,
+                                  fds_record_t      const * p_records,
+                                  uint16_t                  count);
+
+
 /**@brief   Function for deleting a record.
  *
  * Deleted records cannot be located using @ref fds_record_find, @ref fds_record_find_by_key, or
@@ -632,6 +683,11 @@ ret_code_t fds_record_close(fds_record_desc_t * p_desc);
  * This function is asynchronous. Completion is reported through the @ref FDS_EVT_GC event that
  * is sent to the registered event handler function.
  *
+ * With @ref FDS_GC_INCREMENTAL, operations queued after this function do not wait for garbage
+ * collection to complete: it lets them run every @ref FDS_GC_STEP_WORDS words copied, and around
+ * every page erase. Descriptors obtained meanwhile remain usable. With @ref FDS_GC_AUTO_WORDS,
+ * fds also runs garbage collection by itself, and sends @ref FDS_EVT_GC for it as well.
+ *
  * @retval  NRF_SUCCESS                 If the operation was queued successfully.
  * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
  * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
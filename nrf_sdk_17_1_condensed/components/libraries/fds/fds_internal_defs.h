@@ -75,6 +75,7 @@ extern "C" {
 
 #define FDS_OP_EXECUTING        (NRF_SUCCESS)
 #define FDS_OP_COMPLETED        (0x1D1D)
+#define FDS_OP_YIELDED          (0x1D1E) // Garbage collection was queued again, behind other operations.
 
 #define NRF_FSTORAGE_NVMC       1
 #define NRF_FSTORAGE_SD         2
@@ -136,6 +137,7 @@ typedef struct
     uint16_t                words_reserved; // The amount of words reserved.
     uint32_t volatile       records_open;   // The number of open records.
     bool                    can_gc;         // Indicates that there are some records that have been deleted.
+    uint16_t                freeable_words; // Words of deleted and incomplete records, as far as known.
 } fds_page_t;
 
 
@@ -155,7 +157,8 @@ typedef enum
     FDS_OP_UPDATE,      // Update a record.
     FDS_OP_DEL_RECORD,  // Delete a record.
     FDS_OP_DEL_FILE,    // Delete a file.
-    FDS_OP_GC           // Run garbage collection.
+    FDS_OP_GC,          // Run garbage collection.
+    FDS_OP_WRITE_BATCH  // Write several records atomically.
 } fds_op_code_t;
 
 
@@ -180,6 +183,14 @@ typedef enum
 } fds_write_step_t;
 
 
+typedef enum
+{
+    FDS_OP_BATCH_WRITE_RECORDS,     // Write the batch header and the records, one buffer at a time.
+    FDS_OP_BATCH_COMMIT,            // Write the file ID of the batch header.
+    FDS_OP_BATCH_DONE,
+} fds_batch_step_t;
+
+
 typedef enum
 {
     FDS_OP_DEL_RECORD_FLAG_DIRTY,   // Flag a record as dirty.
@@ -215,6 +226,17 @@ typedef struct
             uint32_t          record_to_delete; // The record to delete in case this is an update.
         } write;
         struct
+        {
+            fds_header_t             header;        // The header of the enclosing record.
+            fds_record_t     const * p_records;
+            uint16_t                 count;
+            uint16_t                 page;          // The page the flash space for this command was reserved.
+            fds_batch_step_t         step;          // The current step the operation is at.
+            uint16_t                 words_written; // Words of the batch written so far.
+            uint16_t                 record;        // The record being copied to the write buffer.
+            uint16_t                 record_offset; // Words of that record copied so far.
+        } batch;
+        struct
         {
             fds_delete_step_t step;
             uint16_t          file_id;
@@ -292,7 +314,8 @@ typedef enum
     GC_ERASE_PAGE,          // Erase the page being garbage collected.
     GC_DISCARD_SWAP,        // Erase (discard) the swap page.
     GC_PROMOTE_SWAP,        // Tag the swap as valid.
-    GC_TAG_NEW_SWAP         // Tag a freshly erased (GCed) page as swap.
+    GC_TAG_NEW_SWAP,        // Tag a freshly erased (GCed) page as swap.
+    GC_FLAG_COPY_DIRTY      // Flag dirty a copy whose original was deleted after it was copied.
 } fds_gc_state_t;
 
 
@@ -305,9 +328,43 @@ typedef struct
     uint16_t         run_count;                  // Total number of times GC was run.
     bool             do_gc_page[FDS_DATA_PAGES]; // Controls which pages to garbage collect.
     bool             resume;                     // Whether or not GC should be resumed.
+    bool             page_touched;               // Records of the current page were flagged dirty.
+    uint16_t         copies_freeable;            // Words of the copies flagged dirty.
+    uint16_t         step_words;                 // Words copied since GC last yielded.
+    bool             auto_queued;                // GC was queued by fds, see gc_auto_start().
 } fds_gc_data_t;
 
 
+#if (FDS_INDEX_ENABLED)
+
+#if ((FDS_INDEX_SIZE & (FDS_INDEX_SIZE - 1)) != 0) || (FDS_INDEX_SIZE < 8)
+    #error "FDS_INDEX_SIZE must be a power of two, and at least 8."
+#endif
+
+// The index holds at most this many records, so that probe sequences stay short.
+#define FDS_INDEX_MAX_RECORDS       (FDS_INDEX_SIZE - FDS_INDEX_SIZE / 8)
+
+// An entry of the record index: where a valid record is, and the keys it can be found by.
+typedef struct
+{
+    uint32_t const * p_record;      // Record address, NULL if the entry is free.
+    uint16_t         file_id;
+    uint16_t         record_key;
+} fds_index_entry_t;
+
+
+// Open addressing hash table of the valid records on data pages, keyed on file ID and record key.
+typedef struct
+{
+    fds_index_entry_t entries[FDS_INDEX_SIZE];
+    uint32_t          count;        // Records in the index.
+    bool              valid;        // The index holds every valid record; if not, scan the pages.
+    bool              rebuild;      // Rebuild the index at the next search when fds is idle.
+} fds_index_t;
+
+#endif
+
+
 // Macros to enable and disable application interrupts.
 #if defined (FDS_THREADS)
 
@@ -51,6 +51,36 @@
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
 
+#if NRF_GFX_DIRTY_RECT_ENABLED
+static void dirty_add(nrf_lcd_t const * p_instance,
+                      uint16_t x,
+                      uint16_t y,
+                      uint16_t width,
+                      uint16_t height)
+{
+    lcd_cb_t * p_lcd_cb = p_instance->p_lcd_cb;
+
+    if ((width == 0) || (height == 0))
+    {
+        return;
+    }
+
+    if (p_lcd_cb->dirty_x_end == p_lcd_cb->dirty_x_start)
+    {
+        p_lcd_cb->dirty_x_start = x;
+        p_lcd_cb->dirty_y_start = y;
+        p_lcd_cb->dirty_x_end = x + width;
+        p_lcd_cb->dirty_y_end = y + height;
+        return;
+    }
+
+    p_lcd_cb->dirty_x_start = MIN(p_lcd_cb->dirty_x_start, x);
+    p_lcd_cb->dirty_y_start = MIN(p_lcd_cb->dirty_y_start, y);
+    p_lcd_cb->dirty_x_end = MAX(p_lcd_cb->dirty_x_end, x + width);
+    p_lcd_cb->dirty_y_end = MAX(p_lcd_cb->dirty_y_end, y + height);
+}
+#endif
+
 static inline void pixel_draw(nrf_lcd_t const * p_instance,
                               uint16_t x,
                               uint16_t y,
@@ -64,6 +94,9 @@ static inline void pixel_draw(nrf_lcd_t const * p_instance,
         return;
     }
 
+#if NRF_GFX_DIRTY_RECT_ENABLED
+    dirty_add(p_instance, x, y, 1, 1);
+#endif
     p_instance->lcd_pixel_draw(x, y, color);
 }
 
@@ -92,6 +125,9 @@ static void rect_draw(nrf_lcd_t const * p_instance,
         height = lcd_height - y;
     }
 
+#if NRF_GFX_DIRTY_RECT_ENABLED
+    dirty_add(p_instance, x, y, width, height);
+#endif
     p_instance->lcd_rect_draw(x, y, width, height, color);
 }
 
@@ -170,6 +206,46 @@ static void write_character(nrf_lcd_t const * p_instance,
         return;
     }
 
+#if NRF_GFX_SPAN_BLIT_ENABLED
+    for (uint16_t i = 0; i < p_font->height; i++)
+    {
+        uint8_t const * p_line =
+            &p_font->data[p_font->charInfo[char_idx].offset + i * bytes_in_line];
+        uint16_t run_start = 0;
+        uint16_t run_length = 0;
+
+        // One rectangle of height 1 per run of set bits.
+        for (uint16_t j = 0; j < bytes_in_line; j++)
+        {
+            if ((p_line[j] == 0) && (run_length == 0))
+            {
+                continue;
+            }
+
+            for (uint8_t k = 0; k < 8; k++)
+            {
+                if ((1 << (7 - k)) & p_line[j])
+                {
+                    if (run_length == 0)
+                    {
+                        run_start = j * 8 + k;
+                    }
+                    run_length++;
+                }
+                else if (run_length > 0)
+                {
+                    rect_draw(p_instance, *p_x + run_start, y + i, run_length, 1, font_color);
+                    run_length = 0;
+                }
+            }
+        }
+
+        if (run_length > 0)
+        {
+            rect_draw(p_instance, *p_x + run_start, y + i, run_length, 1, font_color);
+        }
+    }
+#else
     for (uint16_t i = 0; i < p_font->height; i++)
     {
         for (uint16_t j = 0; j < bytes_in_line; j++)
@@ -184,6 +260,7 @@ static void write_character(nrf_lcd_t const * p_instance,
             }
         }
     }
+#endif
 
     *p_x += p_font->charInfo[char_idx].widthBits + p_font->spacePixels;
 }
@@ -208,6 +285,10 @@ ret_code_t nrf_gfx_init(nrf_lcd_t const * p_instance)
     if (err_code == NRF_SUCCESS)
     {
         p_instance->p_lcd_cb->state = NRFX_DRV_STATE_INITIALIZED;
+#if NRF_GFX_DIRTY_RECT_ENABLED
+        // The frame buffer was never displayed.
+        dirty_add(p_instance, 0, 0, nrf_gfx_width_get(p_instance), nrf_gfx_height_get(p_instance));
+#endif
     }
 
     return err_code;
@@ -502,6 +583,25 @@ void nrf_gfx_display(nrf_lcd_t const * p_instance)
 {
     ASSERT(p_instance != NULL);
 
+#if NRF_GFX_DIRTY_RECT_ENABLED
+    lcd_cb_t * p_lcd_cb = p_instance->p_lcd_cb;
+
+    if (p_instance->lcd_display_rect != NULL)
+    {
+        if (p_lcd_cb->dirty_x_end != p_lcd_cb->dirty_x_start)
+        {
+            p_instance->lcd_display_rect(p_lcd_cb->dirty_x_start,
+                                         p_lcd_cb->dirty_y_start,
+                                         p_lcd_cb->dirty_x_end - p_lcd_cb->dirty_x_start,
+                                         p_lcd_cb->dirty_y_end - p_lcd_cb->dirty_y_start);
+        }
+
+        p_lcd_cb->dirty_x_end = p_lcd_cb->dirty_x_start;
+        p_lcd_cb->dirty_y_end = p_lcd_cb->dirty_y_start;
+        return;
+    }
+#endif
+
     p_instance->lcd_display();
 }
 
@@ -541,6 +641,12 @@ void nrf_gfx_rotation_set(nrf_lcd_t const * p_instance, nrf_lcd_rotation_t rotat
     }
 
     p_instance->lcd_rotation_set(rotation);
+
+#if NRF_GFX_DIRTY_RECT_ENABLED
+    // The edges of the dirty rectangle moved with the rotation.
+    p_instance->p_lcd_cb->dirty_x_end = p_instance->p_lcd_cb->dirty_x_start;
+    dirty_add(p_instance, 0, 0, nrf_gfx_width_get(p_instance), nrf_gfx_height_get(p_instance));
+#endif
 }
 
 void nrf_gfx_invert(nrf_lcd_t const * p_instance, bool invert)
@@ -261,6 +261,9 @@ void nrf_gfx_background_set(nrf_lcd_t const * p_instance, uint16_t const * img_b
 /**
  * @brief Function for displaying data from an internal frame buffer.
  *
+ * With NRF_GFX_DIRTY_RECT_ENABLED set and an LCD that implements @ref nrf_lcd_t::lcd_display_rect,
+ * only the rectangle drawn since the last call is displayed, and nothing if nothing was drawn.
+ *
  * @param[in] p_instance            Pointer to the LCD instance.
  */
 void nrf_gfx_display(nrf_lcd_t const * p_instance);
@@ -71,6 +71,10 @@ typedef struct
     uint16_t height;                /**< LCD height. */
     uint16_t width;                 /**< LCD width. */
     nrf_lcd_rotation_t rotation;    /**< LCD rotation. */
+    uint16_t dirty_x_start;         /**< Left edge of the area drawn since the last display. */
+    uint16_t dirty_y_start;         /**< Top edge of the area drawn since the last display. */
+    uint16_t dirty_x_end;           /**< Right edge, exclusive. Equal to dirty_x_start if nothing was drawn. */
+    uint16_t dirty_y_end;           /**< Bottom edge, exclusive. */
 }lcd_cb_t;
 
 /**
@@ -137,6 +141,19 @@ typedef struct
      * @brief Pointer to the LCD instance control block.
      */
     lcd_cb_t * p_lcd_cb;
+
+    /**
+     * @brief Function for displaying a part of an internal frame buffer. Optional.
+     *
+     * Used instead of lcd_display when NRF_GFX_DIRTY_RECT_ENABLED is set, with the rectangle
+     * drawn since the last display. Coordinates are those of the drawing functions, after rotation.
+     *
+     * @param[in] x             Horizontal coordinate of the rectangle.
+     * @param[in] y             Vertical coordinate of the rectangle.
+     * @param[in] width         Width of the rectangle.
+     * @param[in] height        Height of the rectangle.
+     */
+    void (* lcd_display_rect)(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
 }nrf_lcd_t;
 
 /* @} */
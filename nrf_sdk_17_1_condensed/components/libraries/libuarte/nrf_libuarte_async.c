@@ -46,6 +46,7 @@
 #include "nrfx_ppi.h"
 #include "nrf_uart.h"
 #include "nrf_queue.h"
+#include "app_util_platform.h"
 #define NRF_LOG_MODULE_NAME libUARTE_async
 #if NRF_LIBUARTE_CONFIG_LOG_ENABLED
 #define NRF_LOG_LEVEL       NRF_LIBUARTE_CONFIG_LOG_LEVEL
@@ -69,6 +70,111 @@ NRF_LOG_MODULE_REGISTER();
 #define TIMER_IN_USE 0
 #endif
 
+/** @brief Scatter-gather transmission state.
+ *
+ * Kept per UARTE instance outside of @ref nrf_libuarte_async_ctrl_blk_t so that the layout of the
+ * control block, which may be defined in prebuilt libraries, does not change.
+ */
+typedef struct {
+    nrf_libuarte_async_data_t const * p_segments; ///< Segments of the ongoing transfer, NULL if none.
+    size_t                            count;      ///< Number of segments.
+    size_t                            idx;        ///< Segment currently being sent.
+    size_t                            next;       ///< Segment queued in the driver after it, count if none.
+    size_t                            length;     ///< Total number of bytes in all segments.
+    size_t                            sent;       ///< Bytes of the segments sent so far.
+} nrf_libuarte_async_txv_t;
+
+static nrf_libuarte_async_txv_t m_txv[2];
+
+static nrf_libuarte_async_txv_t * txv_get(const nrf_libuarte_async_t * const p_libuarte)
+{
+    return &m_txv[p_libuarte->p_libuarte->uarte == NRF_UARTE0 ? 0 : 1];
+}
+
+/** @brief Handler taking over the received data, see @ref nrf_libuarte_async_rx_handler_set.
+ *
+ * Kept per UARTE instance outside of @ref nrf_libuarte_async_ctrl_blk_t, as the TX segments.
+ */
+typedef struct {
+    nrf_libuarte_async_evt_handler_t handler; ///< Handler of RX data events, NULL if none.
+    void *                           context; ///< Context passed to the handler.
+} nrf_libuarte_async_rx_handler_t;
+
+static nrf_libuarte_async_rx_handler_t m_rx_handler[2];
+
+static void rx_data_evt_send(const nrf_libuarte_async_t * const p_libuarte,
+                             nrf_libuarte_async_evt_t *         p_evt)
+{
+    nrf_libuarte_async_rx_handler_t * p_rx =
+        &m_rx_handler[p_libuarte->p_libuarte->uarte == NRF_UARTE0 ? 0 : 1];
+
+    if (p_rx->handler != NULL)
+    {
+        p_rx->handler(p_rx->context, p_evt);
+    }
+    else
+    {
+        p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, p_evt);
+    }
+}
+
+/** @brief Find the first non-empty segment of a scatter-gather transfer, from @p idx on.
+ *
+ * @return Index of the segment, count if there is none.
+ */
+static size_t txv_next_get(nrf_libuarte_async_txv_t const * p_txv, size_t idx)
+{
+    while ((idx < p_txv->count) && (p_txv->p_segments[idx].length == 0))
+    {
+        idx++;
+    }
+    return idx;
+}
+
+/** @brief Queue the segment following the one being sent in the driver, to be started on ENDTX.
+ *
+ * A segment the driver cannot queue, longer than one EasyDMA transfer, is started on TX done.
+ */
+static void txv_queue(const nrf_libuarte_async_t * const p_libuarte,
+                      nrf_libuarte_async_txv_t *         p_txv)
+{
+    size_t next = txv_next_get(p_txv, p_txv->idx + 1);
+
+    p_txv->next = p_txv->count;
+    if ((next < p_txv->count) &&
+        (nrf_libuarte_drv_tx_next(p_libuarte->p_libuarte,
+                                  p_txv->p_segments[next].p_data,
+                                  p_txv->p_segments[next].length) == NRF_SUCCESS))
+    {
+        p_txv->next = next;
+    }
+}
+
+/** @brief Start the first non-empty segment of a scatter-gather transfer from @p idx on, and
+ *         queue the one following it.
+ *
+ * @retval NRF_SUCCESS Segment started.
+ * @return Error of @ref nrf_libuarte_drv_tx.
+ */
+static ret_code_t txv_next_start(const nrf_libuarte_async_t * const p_libuarte,
+                                 nrf_libuarte_async_txv_t *         p_txv,
+                                 size_t                             idx)
+{
+    nrf_libuarte_async_data_t const * p_seg;
+    ret_code_t                        ret;
+
+    p_txv->idx = txv_next_get(p_txv, idx);
+    ASSERT(p_txv->idx < p_txv->count);
+    p_seg = &p_txv->p_segments[p_txv->idx];
+
+    ret = nrf_libuarte_drv_tx(p_libuarte->p_libuarte, p_seg->p_data, p_seg->length);
+    if (ret == NRF_SUCCESS)
+    {
+        txv_queue(p_libuarte, p_txv);
+    }
+    return ret;
+}
+
 #define FAULT_IRQ_LEVEL 0xFF
 
 /** Macro is setting up PPI channel set which consist of event, task and optional fork.
@@ -208,9 +314,47 @@ static void uart_evt_handler(void * context, nrf_libuarte_drv_evt_t * p_evt)
                 }
             }
         };
+
+        nrf_libuarte_async_txv_t * p_txv = txv_get(p_libuarte);
+        if (p_txv->p_segments)
+        {
+            // Segments the driver could not queue are started here, the user is notified once.
+            p_txv->sent += p_evt->data.rxtx.length;
+            if (txv_next_get(p_txv, p_txv->idx + 1) < p_txv->count)
+            {
+                ret = txv_next_start(p_libuarte, p_txv, p_txv->idx + 1);
+                if (ret == NRF_SUCCESS)
+                {
+                    break;
+                }
+                NRF_LOG_ERROR("(evt) Failed to start TX segment %d (%d).", p_txv->idx, ret);
+                nrf_libuarte_async_evt_t err_evt = {
+                    .type = NRF_LIBUARTE_ASYNC_EVT_TX_ERROR,
+                    .data = {
+                        .rxtx = p_txv->p_segments[p_txv->idx]
+                    }
+                };
+                p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, &err_evt);
+            }
+            evt.data.rxtx.p_data = p_txv->p_segments[0].p_data;
+            evt.data.rxtx.length = p_txv->sent;
+            p_txv->p_segments    = NULL;
+        }
         p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, &evt);
         break;
     }
+    case NRF_LIBUARTE_DRV_EVT_TX_NEXT_STARTED:
+    {
+        // The queued segment took over on ENDTX, queue the one after it
+        nrf_libuarte_async_txv_t * p_txv = txv_get(p_libuarte);
+        if (p_txv->p_segments)
+        {
+            p_txv->sent += p_evt->data.rxtx.length;
+            p_txv->idx   = p_txv->next;
+            txv_queue(p_libuarte, p_txv);
+        }
+        break;
+    }
     case NRF_LIBUARTE_DRV_EVT_RX_BUF_REQ:
     {
         if (p_libuarte->p_ctrl_blk->rx_halted)
@@ -267,7 +411,7 @@ static void uart_evt_handler(void * context, nrf_libuarte_drv_evt_t * p_evt)
                 APP_ERROR_CHECK_BOOL(false);
             }
 
-            p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, &evt);
+            rx_data_evt_send(p_libuarte, &evt);
         }
         else
         {
@@ -333,7 +477,7 @@ void nrf_libuarte_async_timeout_handler(const nrf_libuarte_async_t * p_libuarte)
 
         p_libuarte->p_ctrl_blk->sub_rx_count += rx_amount;
         p_libuarte->p_ctrl_blk->rx_count = capt_rx_count;
-        p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, &evt);
+        rx_data_evt_send(p_libuarte, &evt);
     }
 
     NRFX_IRQ_ENABLE((IRQn_Type)NRFX_IRQ_NUMBER_GET(p_libuarte->p_libuarte->uarte));
@@ -519,7 +663,7 @@ ret_code_t nrf_libuarte_async_init(const nrf_libuarte_async_t * const p_libuarte
         PPI_CH_SETUP(p_libuarte->p_ctrl_blk->ppi_channels[NRF_LIBUARTE_ASYNC_PPI_CH_COMPARE_SHUTDOWN],
                      tmr_compare_evt,
                      tmr_stop_tsk,
-                     (uint32_t)&p_libuarte->p_libuarte->timer.p_reg->TASKS_CAPTURE[3]);
+                     (uint32_t)(uintptr_t)&p_libuarte->p_libuarte->timer.p_reg->TASKS_CAPTURE[3]);
         /*lint -restore */
     }
 
@@ -644,6 +788,47 @@ ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
     return nrf_libuarte_drv_tx(p_libuarte->p_libuarte, p_data, length);
 }
 
+ret_code_t nrf_libuarte_async_txv(const nrf_libuarte_async_t * const p_libuarte,
+                                  nrf_libuarte_async_data_t const *  p_segments,
+                                  size_t                             count)
+{
+    nrf_libuarte_async_txv_t * p_txv = txv_get(p_libuarte);
+    size_t                     length = 0;
+    ret_code_t                 ret;
+
+    ASSERT(p_segments != NULL);
+
+    if (p_txv->p_segments || p_libuarte->p_libuarte->ctrl_blk->p_tx)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        length += p_segments[i].length;
+    }
+    if (length == 0)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_txv->count  = count;
+    p_txv->length = length;
+    p_txv->sent   = 0;
+    p_txv->p_segments = p_segments;
+
+    // The interrupt must not see the first segment done before the second one is queued
+    CRITICAL_REGION_ENTER();
+    ret = txv_next_start(p_libuarte, p_txv, 0);
+    if (ret != NRF_SUCCESS)
+    {
+        p_txv->p_segments = NULL;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
 void nrf_libuarte_async_rx_free(const nrf_libuarte_async_t * const p_libuarte, uint8_t * p_data, size_t length)
 {
     p_libuarte->p_ctrl_blk->rx_free_cnt += length;
@@ -680,6 +865,20 @@ void nrf_libuarte_async_rx_free(const nrf_libuarte_async_t * const p_libuarte, u
 
 }
 
+void nrf_libuarte_async_rx_handler_set(const nrf_libuarte_async_t * const p_libuarte,
+                                       nrf_libuarte_async_evt_handler_t   rx_handler,
+                                       void *                             context)
+{
+    nrf_libuarte_async_rx_handler_t * p_rx =
+        &m_rx_handler[p_libuarte->p_libuarte->uarte == NRF_UARTE0 ? 0 : 1];
+
+    // RX data events come from the UARTE interrupt and from the timer or RTC interrupt
+    CRITICAL_REGION_ENTER();
+    p_rx->handler = rx_handler;
+    p_rx->context = context;
+    CRITICAL_REGION_EXIT();
+}
+
 void nrf_libuarte_async_rts_clear(const nrf_libuarte_async_t * const p_libuarte)
 {
     nrf_libuarte_drv_rts_clear(p_libuarte->p_libuarte);
@@ -74,7 +74,8 @@ typedef enum
     NRF_LIBUARTE_ASYNC_EVT_RX_DATA,  ///< Requested TX transfer completed.
     NRF_LIBUARTE_ASYNC_EVT_TX_DONE,  ///< Requested RX transfer completed.
     NRF_LIBUARTE_ASYNC_EVT_ERROR,    ///< Error reported by UARTE peripheral.
-    NRF_LIBUARTE_ASYNC_EVT_OVERRUN_ERROR  ///< Error reported by the driver.
+    NRF_LIBUARTE_ASYNC_EVT_OVERRUN_ERROR, ///< Error reported by the driver.
+    NRF_LIBUARTE_ASYNC_EVT_TX_ERROR  ///< Segment of @ref nrf_libuarte_async_txv could not be started.
 } nrf_libuarte_async_evt_type_t;
 
 typedef enum
@@ -370,6 +371,35 @@ void nrf_libuarte_async_rts_set(const nrf_libuarte_async_t * const p_libuarte);
 ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
                                  uint8_t * p_data, size_t length);
 
+/**
+ * @brief Function for sending several buffers asynchronously over UARTE without copying them.
+ *
+ * Segments are sent in order. Each next segment is queued in the driver while the previous one is
+ * sent and started by its ENDTX event over PPI, so there is no copy, no application wakeup and no
+ * gap on the line between segments. A segment longer than one EasyDMA transfer is started when the
+ * previous one is done instead. A single @ref NRF_LIBUARTE_ASYNC_EVT_TX_DONE event is generated
+ * when all segments are sent, with p_data set to the first segment and length set to the total
+ * number of bytes.
+ *
+ * If a segment cannot be started, @ref NRF_LIBUARTE_ASYNC_EVT_TX_ERROR is generated with that
+ * segment, and the transfer ends with @ref NRF_LIBUARTE_ASYNC_EVT_TX_DONE with the number of bytes
+ * sent before it.
+ *
+ * @param[in] p_libuarte Libuarte_async instance.
+ * @param[in] p_segments Array of segments, in RAM. The array and the data it points to must stay
+ *                       valid until @ref NRF_LIBUARTE_ASYNC_EVT_TX_DONE. Segments of zero length
+ *                       are skipped. A segment must take longer to send than the interrupt latency.
+ * @param[in] count      Number of segments.
+ *
+ * @retval NRF_ERROR_BUSY           Data is transferring.
+ * @retval NRF_ERROR_INVALID_LENGTH All segments are empty.
+ * @retval NRF_SUCCESS              Segments set for sending.
+ * @return Other errors of @ref nrf_libuarte_drv_tx when the first segment cannot be started.
+ */
+ret_code_t nrf_libuarte_async_txv(const nrf_libuarte_async_t * const p_libuarte,
+                                  nrf_libuarte_async_data_t const *  p_segments,
+                                  size_t                             count);
+
 /**
  * @brief Function for deallocating received buffer data.
  *
@@ -380,6 +410,23 @@ ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
 void nrf_libuarte_async_rx_free(const nrf_libuarte_async_t * const p_libuarte,
                                 uint8_t * p_data, size_t length);
 
+/**
+ * @brief Function for taking over the received data of an instance.
+ *
+ * Once set, @ref NRF_LIBUARTE_ASYNC_EVT_RX_DATA events are passed to @p rx_handler instead of the
+ * event handler given to @ref nrf_libuarte_async_init, which still gets the other events. This
+ * lets a consumer take received data directly from the RX buffers when the owner of the instance
+ * cannot be changed. The new handler must free the data with @ref nrf_libuarte_async_rx_free,
+ * in the order it was received.
+ *
+ * @param[in] p_libuarte Libuarte_async instance.
+ * @param[in] rx_handler Handler of the received data, NULL to give it back to the event handler.
+ * @param[in] context    Context passed to @p rx_handler.
+ */
+void nrf_libuarte_async_rx_handler_set(const nrf_libuarte_async_t * const p_libuarte,
+                                       nrf_libuarte_async_evt_handler_t   rx_handler,
+                                       void *                             context);
+
 /** @} */
 
 #endif //UART_ASYNC_H
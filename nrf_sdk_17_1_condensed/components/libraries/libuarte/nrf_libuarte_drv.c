@@ -41,6 +41,7 @@
 #include "nrf_libuarte_drv.h"
 #include "nrf_uarte.h"
 #include "nrf_gpio.h"
+#include "app_util_platform.h"
 #include <nrfx_gpiote.h>
 #include <../src/prs/nrfx_prs.h>
 
@@ -57,12 +58,33 @@ NRF_LOG_MODULE_REGISTER();
 
 #define MAX_DMA_XFER_LEN    ((1UL << UARTE0_EASYDMA_MAXCNT_SIZE) - 1)
 
+#ifndef NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED
+#define NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED 0
+#endif
+
 #define INTERRUPTS_MASK  \
     (NRF_UARTE_INT_ENDRX_MASK | NRF_UARTE_INT_RXSTARTED_MASK | NRF_UARTE_INT_ERROR_MASK | \
      NRF_UARTE_INT_ENDTX_MASK | NRF_UARTE_INT_TXSTOPPED_MASK)
 
 static const nrf_libuarte_drv_t * m_libuarte_instance[2];
 
+/** @brief Buffer queued to follow the ongoing transfer, see @ref nrf_libuarte_drv_tx_next.
+ *
+ * Kept per UARTE instance, indexed like m_libuarte_instance, so that the layout of
+ * @ref nrf_libuarte_drv_ctrl_blk_t, which may be defined in prebuilt libraries, does not change.
+ */
+typedef struct {
+    uint8_t * p_data; ///< Queued buffer, NULL if none.
+    size_t    len;    ///< Length of the queued buffer.
+} tx_next_t;
+
+static tx_next_t m_tx_next[2];
+
+static tx_next_t * tx_next_get(const nrf_libuarte_drv_t * const p_libuarte)
+{
+    return &m_tx_next[p_libuarte->uarte == NRF_UARTE0 ? 0 : 1];
+}
+
 /* if it is defined it means that PRS for uart is not used. */
 #ifdef nrfx_uarte_0_irq_handler
 #define libuarte_0_irq_handler UARTE0_UART0_IRQHandler
@@ -262,7 +284,10 @@ static ret_code_t ppi_configure(const nrf_libuarte_drv_t * const p_libuarte,
         p_libuarte->ctrl_blk->ppi_groups[i] = (nrf_ppi_channel_group_t)PPI_GROUP_NUM;
     }
 
-    if (MAX_DMA_XFER_LEN < UINT16_MAX)
+    /* Starts the next EasyDMA chunk of a long transfer, or the buffer queued by
+     * nrf_libuarte_drv_tx_next(). Without chaining, only allocated where one EasyDMA
+     * transfer is shorter than 64 kB. */
+    if (NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED || (MAX_DMA_XFER_LEN < UINT16_MAX))
     {
         ret = ppi_channel_configure(
                 &p_libuarte->ctrl_blk->ppi_channels[NRF_LIBUARTE_DRV_PPI_CH_ENDTX_STARTTX],
@@ -422,6 +447,7 @@ ret_code_t nrf_libuarte_drv_init(const nrf_libuarte_drv_t * const p_libuarte,
     p_libuarte->ctrl_blk->p_next_rx = NULL;
     p_libuarte->ctrl_blk->p_next_next_rx = NULL;
     p_libuarte->ctrl_blk->p_tx = NULL;
+    tx_next_get(p_libuarte)->p_data = NULL;
     p_libuarte->ctrl_blk->context = context;
     p_libuarte->ctrl_blk->rts_pin = RTS_PIN_DISABLED;
 
@@ -533,6 +559,7 @@ void nrf_libuarte_drv_uninit(const nrf_libuarte_drv_t * const p_libuarte)
     {}
  
     p_libuarte->ctrl_blk->p_tx = NULL;
+    tx_next_get(p_libuarte)->p_data = NULL;
     p_libuarte->ctrl_blk->p_cur_rx = NULL;
 
     nrf_uarte_disable(p_libuarte->uarte);
@@ -568,6 +595,12 @@ ret_code_t nrf_libuarte_drv_tx(const nrf_libuarte_drv_t * const p_libuarte,
     {
         return NRF_ERROR_BUSY;
     }
+    /* The chunks after the first one are started over the ENDTX/STARTTX channel */
+    if ((len > MAX_DMA_XFER_LEN) &&
+        (p_libuarte->ctrl_blk->ppi_channels[NRF_LIBUARTE_DRV_PPI_CH_ENDTX_STARTTX] >= PPI_CH_NUM))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
     p_libuarte->ctrl_blk->p_tx = p_data;
     p_libuarte->ctrl_blk->tx_len = len;
     p_libuarte->ctrl_blk->tx_cur_idx = 0;
@@ -603,6 +636,52 @@ ret_code_t nrf_libuarte_drv_tx(const nrf_libuarte_drv_t * const p_libuarte,
     return NRF_SUCCESS;
 }
 
+ret_code_t nrf_libuarte_drv_tx_next(const nrf_libuarte_drv_t * const p_libuarte,
+                                    uint8_t * p_data, size_t len)
+{
+    tx_next_t * p_next = tx_next_get(p_libuarte);
+    ret_code_t  ret    = NRF_SUCCESS;
+
+    if (!NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    if ((len == 0) || (len > MAX_DMA_XFER_LEN))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if ((p_libuarte->ctrl_blk->p_tx == NULL) ||
+        (p_libuarte->ctrl_blk->tx_cur_idx == p_libuarte->ctrl_blk->tx_len) ||
+        (p_libuarte->ctrl_blk->tx_chunk8 != 0))
+    {
+        ret = NRF_ERROR_INVALID_STATE;
+    }
+    else if (p_next->p_data)
+    {
+        ret = NRF_ERROR_BUSY;
+    }
+    else
+    {
+        /* TXD.PTR can be changed once the ongoing transfer has started. TXSTARTED is left set by
+         * the interrupt handler when it takes over a queued buffer. */
+        while (nrf_uarte_event_check(p_libuarte->uarte, NRF_UARTE_EVENT_TXSTARTED) == 0)
+        {
+        }
+        nrf_uarte_event_clear(p_libuarte->uarte, NRF_UARTE_EVENT_TXSTARTED);
+        p_next->p_data = p_data;
+        p_next->len    = len;
+        nrf_uarte_tx_buffer_set(p_libuarte->uarte, p_data, len);
+        tx_ppi_enable(p_libuarte);
+        NRF_LOG_DEBUG("TX next queued, length:%d", len);
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
 ret_code_t nrf_libuarte_drv_rx_start(const nrf_libuarte_drv_t * const p_libuarte,
                                      uint8_t * p_data, size_t len, bool ext_trigger_en)
 {
@@ -635,7 +714,7 @@ ret_code_t nrf_libuarte_drv_rx_start(const nrf_libuarte_drv_t * const p_libuarte
     if (LIBUARTE_DRV_WITH_HWFC && (p_libuarte->ctrl_blk->rts_pin != RTS_PIN_DISABLED))
     {
         uint32_t rx_limit = len - NRF_LIBUARTE_DRV_HWFC_BYTE_LIMIT;
-        *(uint32_t *)nrfx_gpiote_clr_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
+        *(uint32_t *)(uintptr_t)nrfx_gpiote_clr_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
         nrfx_timer_compare(&p_libuarte->timer, NRF_TIMER_CC_CHANNEL2, rx_limit, false);
     }
 
@@ -670,7 +749,7 @@ void nrf_libuarte_drv_rx_buf_rsp(const nrf_libuarte_drv_t * const p_libuarte,
         nrfx_timer_compare(&p_libuarte->timer, NRF_TIMER_CC_CHANNEL2, rx_limit, false);
         if (p_libuarte->ctrl_blk->rts_manual == false)
         {
-            *(uint32_t *)nrfx_gpiote_clr_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
+            *(uint32_t *)(uintptr_t)nrfx_gpiote_clr_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
         }
     }
 }
@@ -682,7 +761,7 @@ void nrf_libuarte_drv_rx_stop(const nrf_libuarte_drv_t * const p_libuarte)
     NRF_LOG_DEBUG("RX stopped.");
     if (LIBUARTE_DRV_WITH_HWFC && (p_libuarte->ctrl_blk->rts_pin != RTS_PIN_DISABLED))
     {
-        *(uint32_t *)nrfx_gpiote_set_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
+        *(uint32_t *)(uintptr_t)nrfx_gpiote_set_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
     }
     p_libuarte->ctrl_blk->p_cur_rx = NULL;
     nrf_uarte_task_trigger(p_libuarte->uarte, NRF_UARTE_TASK_STOPRX);
@@ -692,7 +771,7 @@ void nrf_libuarte_drv_rts_clear(const nrf_libuarte_drv_t * const p_libuarte)
 {
     if (LIBUARTE_DRV_WITH_HWFC && (p_libuarte->ctrl_blk->rts_pin != RTS_PIN_DISABLED))
     {
-        *(uint32_t *)nrfx_gpiote_clr_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
+        *(uint32_t *)(uintptr_t)nrfx_gpiote_clr_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
         p_libuarte->ctrl_blk->rts_manual = false;
     }
 }
@@ -702,7 +781,7 @@ void nrf_libuarte_drv_rts_set(const nrf_libuarte_drv_t * const p_libuarte)
     if (LIBUARTE_DRV_WITH_HWFC && (p_libuarte->ctrl_blk->rts_pin != RTS_PIN_DISABLED))
     {
         p_libuarte->ctrl_blk->rts_manual = true;
-        *(uint32_t *)nrfx_gpiote_set_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
+        *(uint32_t *)(uintptr_t)nrfx_gpiote_set_task_addr_get(p_libuarte->ctrl_blk->rts_pin) = 1;
     }
 }
 
@@ -810,6 +889,7 @@ static void irq_handler(const nrf_libuarte_drv_t * const p_libuarte)
            }
        };
        p_libuarte->ctrl_blk->p_tx = NULL;
+       tx_next_get(p_libuarte)->p_data = NULL;
        p_libuarte->ctrl_blk->evt_handler(p_libuarte->ctrl_blk->context, &evt);
     }
 
@@ -820,7 +900,34 @@ static void irq_handler(const nrf_libuarte_drv_t * const p_libuarte)
 
         NRF_LOG_DEBUG("(evt) TX completed (%d)", amount);
         p_libuarte->ctrl_blk->tx_cur_idx += amount;
-        if (p_libuarte->ctrl_blk->tx_cur_idx == p_libuarte->ctrl_blk->tx_len)
+        if ((p_libuarte->ctrl_blk->tx_cur_idx == p_libuarte->ctrl_blk->tx_len) &&
+            tx_next_get(p_libuarte)->p_data)
+        {
+            tx_next_t * p_next = tx_next_get(p_libuarte);
+            nrf_libuarte_drv_evt_t evt = {
+                .type = NRF_LIBUARTE_DRV_EVT_TX_NEXT_STARTED,
+                .data = {
+                    .rxtx = {
+                        .p_data = p_libuarte->ctrl_blk->p_tx,
+                        .length = p_libuarte->ctrl_blk->tx_len
+                    }
+                }
+            };
+
+            /* The queued buffer was started over PPI, unless the transfer ended before it was
+             * queued. TXSTARTED is left set for nrf_libuarte_drv_tx_next(). */
+            tx_ppi_disable(p_libuarte);
+            if (nrf_uarte_event_check(p_libuarte->uarte, NRF_UARTE_EVENT_TXSTARTED) == 0)
+            {
+                nrf_uarte_task_trigger(p_libuarte->uarte, NRF_UARTE_TASK_STARTTX);
+            }
+            p_libuarte->ctrl_blk->p_tx       = p_next->p_data;
+            p_libuarte->ctrl_blk->tx_len     = p_next->len;
+            p_libuarte->ctrl_blk->tx_cur_idx = 0;
+            p_next->p_data = NULL;
+            p_libuarte->ctrl_blk->evt_handler(p_libuarte->ctrl_blk->context, &evt);
+        }
+        else if (p_libuarte->ctrl_blk->tx_cur_idx == p_libuarte->ctrl_blk->tx_len)
         {
             nrf_uarte_event_clear(p_libuarte->uarte, NRF_UARTE_EVENT_TXSTOPPED);
             nrf_uarte_task_trigger(p_libuarte->uarte, NRF_UARTE_TASK_STOPTX);
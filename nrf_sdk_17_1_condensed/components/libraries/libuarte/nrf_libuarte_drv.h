@@ -65,7 +65,8 @@ typedef enum
     NRF_LIBUARTE_DRV_EVT_RX_BUF_REQ, ///< Requesting new buffer for receiving data.
     NRF_LIBUARTE_DRV_EVT_TX_DONE,    ///< Requested TX transfer completed.
     NRF_LIBUARTE_DRV_EVT_ERROR,      ///< Error reported by the UARTE peripheral.
-    NRF_LIBUARTE_DRV_EVT_OVERRUN_ERROR    ///< Error reported by the driver.
+    NRF_LIBUARTE_DRV_EVT_OVERRUN_ERROR,   ///< Error reported by the driver.
+    NRF_LIBUARTE_DRV_EVT_TX_NEXT_STARTED  ///< Buffer queued with @ref nrf_libuarte_drv_tx_next started, the previous one is sent.
 } nrf_libuarte_drv_evt_type_t;
 
 /**
@@ -210,13 +211,41 @@ void nrf_libuarte_drv_uninit(const nrf_libuarte_drv_t * const p_libuarte);
  * @param[in] p_data     Pointer to data.
  * @param[in] len        Number of bytes to send.
  *
- * @retval NRF_ERROR_BUSY      Data is transferring.
- * @retval NRF_ERROR_INTERNAL  Error during PPI channel configuration.
- * @retval NRF_SUCCESS         Buffer set for sending.
+ * @retval NRF_ERROR_BUSY           Data is transferring.
+ * @retval NRF_ERROR_INVALID_LENGTH Longer than one EasyDMA transfer, with no PPI channel to start
+ *                                  the next chunk: see NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED.
+ * @retval NRF_ERROR_INTERNAL       Error during PPI channel configuration.
+ * @retval NRF_SUCCESS              Buffer set for sending.
  */
 ret_code_t nrf_libuarte_drv_tx(const nrf_libuarte_drv_t * const p_libuarte,
                                uint8_t * p_data, size_t len);
 
+/**
+ * @brief Function for queuing a buffer to be sent right after the ongoing transfer.
+ *
+ * The ENDTX event of the ongoing transfer starts the queued buffer over PPI, so there is no gap
+ * on the line between the two. @ref NRF_LIBUARTE_DRV_EVT_TX_NEXT_STARTED is then generated with
+ * the buffer that was sent, and the next buffer can be queued from the event handler. The event
+ * handler must run before the queued buffer is sent, so a queued buffer must take longer to send
+ * than the interrupt latency. @ref NRF_LIBUARTE_DRV_EVT_TX_DONE is generated once, for the last
+ * buffer.
+ *
+ * Available with NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED, which takes one more PPI channel per instance.
+ *
+ * @param[in] p_libuarte Pointer to libuarte instance.
+ * @param[in] p_data     Pointer to data, in RAM.
+ * @param[in] len        Number of bytes to send, at most the maximum length of one EasyDMA transfer.
+ *
+ * @retval NRF_ERROR_INVALID_LENGTH Buffer empty or too long for one EasyDMA transfer.
+ * @retval NRF_ERROR_INVALID_STATE  No transfer to follow: none ongoing, its end already handled,
+ *                                  or sent in several EasyDMA transfers.
+ * @retval NRF_ERROR_BUSY           A buffer is already queued.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Built without NRF_LIBUARTE_DRV_TX_CHAIN_ENABLED.
+ * @retval NRF_SUCCESS              Buffer queued.
+ */
+ret_code_t nrf_libuarte_drv_tx_next(const nrf_libuarte_drv_t * const p_libuarte,
+                                    uint8_t * p_data, size_t len);
+
 /**
  * @brief Function for starting receiving data with additional configuration of external
  *        trigger to start receiving.
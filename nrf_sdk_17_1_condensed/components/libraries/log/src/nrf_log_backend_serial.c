@@ -49,8 +49,6 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
                                uint32_t  length,
                                nrf_fprintf_fwrite tx_func)
 {
-    nrf_memobj_get(p_msg);
-
     nrf_fprintf_ctx_t fprintf_ctx = {
             .p_io_buffer = (char *)p_buffer,
             .io_buffer_size = length,
@@ -60,6 +58,15 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
             .fwrite = tx_func
     };
 
+    nrf_log_backend_serial_ctx_put(p_backend, p_msg, &fprintf_ctx);
+}
+
+void nrf_log_backend_serial_ctx_put(nrf_log_backend_t const * p_backend,
+                                    nrf_log_entry_t * p_msg,
+                                    nrf_fprintf_ctx_t * p_fprintf_ctx)
+{
+    nrf_memobj_get(p_msg);
+
     nrf_log_str_formatter_entry_params_t params;
 
     nrf_log_header_t header;
@@ -88,7 +95,7 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
                                   args,
                                   nargs,
                                   &params,
-                                  &fprintf_ctx);
+                                  p_fprintf_ctx);
 
     }
     else if (header.base.generic.type == HEADER_TYPE_HEXDUMP)
@@ -107,7 +114,7 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
             nrf_log_hexdump_entry_process(data_buf,
                                          chunk_len,
                                          &params,
-                                         &fprintf_ctx);
+                                         p_fprintf_ctx);
         } while (data_len > 0);
     }
     nrf_memobj_put(p_msg);
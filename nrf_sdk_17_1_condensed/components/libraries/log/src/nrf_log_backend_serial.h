@@ -68,6 +68,17 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
                                uint32_t  length,
                                nrf_fprintf_fwrite tx_func);
 
+/**
+ * @brief A function for processing logger entry into a fprintf context owned by the backend.
+ *
+ * Each log line ends with a soft flush, @ref nrf_fprintf_buffer_flush_soft. A context with a
+ * flush_threshold thus collects several lines before calling fwrite, the backend flushes the
+ * rest with @ref nrf_fprintf_buffer_flush once it has no more entries to process.
+ */
+void nrf_log_backend_serial_ctx_put(nrf_log_backend_t const * p_backend,
+                                    nrf_log_entry_t * p_msg,
+                                    nrf_fprintf_ctx_t * p_fprintf_ctx);
+
 #endif //NRF_LOG_BACKEND_SERIAL_H
 
 #ifdef __cplusplus
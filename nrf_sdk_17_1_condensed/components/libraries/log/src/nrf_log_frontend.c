@@ -83,6 +83,10 @@ NRF_RINGBUF_DEF(m_log_push_ringbuf, NRF_LOG_STR_PUSH_BUFFER_SIZE);
  */
 static uint32_t m_buffer_mask =  NRF_LOG_BUF_WORDS - 1; // Size of buffer (must be power of 2) presented as mask
 
+#if NRF_LOG_LOCK_FREE && NRF_LOG_ALLOW_OVERFLOW
+#error "NRF_LOG_LOCK_FREE requires NRF_LOG_ALLOW_OVERFLOW to be disabled."
+#endif
+
 /**
  * brief An internal control block of the logger
  *
@@ -315,6 +319,7 @@ nrf_log_severity_t nrf_log_module_filter_get(uint32_t backend_id,
     }
     return severity;
 }
+#if !NRF_LOG_LOCK_FREE
 /**
  * Function examines current header and omits packets which are in progress.
  */
@@ -398,6 +403,7 @@ static uint32_t log_skip(void)
 
     return (uint32_t)dropped;
 }
+#endif // !NRF_LOG_LOCK_FREE
 
 /**
  * @brief Function for getting number of dropped logs. Dropped counter is reset after reading.
@@ -411,6 +417,18 @@ static inline uint32_t dropped_sat16_get(void)
 }
 
 
+/**
+ * @brief Publishes the main header of an entry with a single word store, after its content.
+ */
+static inline void header_commit(uint32_t wr_idx, uint32_t mask, uint32_t raw)
+{
+#if NRF_LOG_LOCK_FREE
+    // The content must be visible before the consumer sees the entry as complete.
+    __DMB();
+#endif
+    ((nrf_log_main_header_t volatile *)&m_log_data.buffer[wr_idx & mask])->raw = raw;
+}
+
 static inline void std_header_set(uint32_t severity_mid,
                                       char const * const p_str,
                                       uint32_t nargs,
@@ -430,12 +448,14 @@ static inline void std_header_set(uint32_t severity_mid,
         m_log_data.buffer[(wr_idx + 2) & mask] = m_log_data.timestamp_func();
     }
 
-    nrf_log_header_t * p_header    = (nrf_log_header_t *)&m_log_data.buffer[wr_idx & mask];
-    p_header->base.std.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
-    p_header->base.std.nargs       = nargs;
-    p_header->base.std.addr        = ((uint32_t)(p_str) & STD_ADDR_MASK);
-    p_header->base.std.type        = HEADER_TYPE_STD;
-    p_header->base.std.in_progress = 0;
+    nrf_log_main_header_t header;
+    header.raw             = 0;
+    header.std.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
+    header.std.nargs       = nargs;
+    header.std.addr        = ((uint32_t)(uintptr_t)(p_str) & STD_ADDR_MASK);
+    header.std.type        = HEADER_TYPE_STD;
+    header.std.in_progress = 0;
+    header_commit(wr_idx, mask, header.raw);
 }
 
 #if NRF_LOG_DEFERRED
@@ -462,6 +482,25 @@ __WEAK void log_pending_hook( void )
 static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool std)
 {
     uint32_t req_len = content_len + HEADER_SIZE;
+#if NRF_LOG_LOCK_FREE
+    // The claimed words are zero, so the entry reads as not ready until its header is committed.
+    uint32_t wr_idx = ((volatile log_data_t *)&m_log_data)->wr_idx;
+    UNUSED_PARAMETER(std);
+    do
+    {
+        uint32_t available_words =
+            (m_buffer_mask + 1) - (wr_idx - ((volatile log_data_t *)&m_log_data)->rd_idx);
+        if (req_len > available_words)
+        {
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, 1));
+            return false;
+        }
+    } while (!nrf_atomic_u32_cmp_exch((nrf_atomic_u32_t *)&m_log_data.wr_idx,
+                                      &wr_idx,
+                                      wr_idx + req_len));
+    *p_wr_idx = wr_idx;
+    return true;
+#else
     bool     ret            = true;
     CRITICAL_REGION_ENTER();
     *p_wr_idx = m_log_data.wr_idx;
@@ -510,6 +549,7 @@ static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool
 
     CRITICAL_REGION_EXIT();
     return ret;
+#endif // NRF_LOG_LOCK_FREE
 }
 
 char const * nrf_log_push(char * const p_str)
@@ -697,12 +737,14 @@ void nrf_log_frontend_hexdump(uint32_t           severity_mid,
         uint32_t dropped   = dropped_sat16_get();
         m_log_data.buffer[(header_wr_idx + 1) & mask] = module_id | (dropped << 16);
         //Header prepare
-        nrf_log_header_t * p_header = (nrf_log_header_t *)&m_log_data.buffer[header_wr_idx & mask];
-        p_header->base.hexdump.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
-        p_header->base.hexdump.offset      = 0;
-        p_header->base.hexdump.len         = length;
-        p_header->base.hexdump.type        = HEADER_TYPE_HEXDUMP;
-        p_header->base.hexdump.in_progress = 0;
+        nrf_log_main_header_t header;
+        header.raw                 = 0;
+        header.hexdump.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
+        header.hexdump.offset      = 0;
+        header.hexdump.len         = length;
+        header.hexdump.type        = HEADER_TYPE_HEXDUMP;
+        header.hexdump.in_progress = 0;
+        header_commit(header_wr_idx, mask, header.raw);
     }
 
     if (m_log_data.autoflush)
@@ -729,6 +771,43 @@ bool buffer_is_empty(void)
     return (m_log_data.rd_idx == m_log_data.wr_idx);
 }
 
+#if NRF_LOG_LOCK_FREE
+/**
+ * @brief Checks if the oldest entry has been committed by its producer.
+ *
+ * Producers may complete entries out of order. The consumer waits for the oldest one
+ * instead of skipping it, because it cannot tell an abandoned entry from a slow one.
+ */
+static bool head_is_ready(nrf_log_header_t const * p_header)
+{
+    nrf_log_main_header_t header;
+    header.raw = ((nrf_log_main_header_t const volatile *)&p_header->base)->raw;
+    if ((header.generic.type == 0) || header.generic.in_progress)
+    {
+        return false;
+    }
+    // Content is read only after the header was seen complete.
+    __DMB();
+    return true;
+}
+
+/**
+ * @brief Gives processed words back to the producers.
+ *
+ * Words are zeroed first so that a claimed but not yet committed entry never looks ready.
+ */
+static void buf_release(uint32_t rd_idx)
+{
+    uint32_t i;
+    for (i = m_log_data.rd_idx; i != rd_idx; i++)
+    {
+        m_log_data.buffer[i & m_buffer_mask] = 0;
+    }
+    __DMB();
+    ((volatile log_data_t *)&m_log_data)->rd_idx = rd_idx;
+}
+#endif
+
 bool nrf_log_frontend_dequeue(void)
 {
 
@@ -747,6 +826,13 @@ bool nrf_log_frontend_dequeue(void)
     size_t             memobj_offset = 0;
     uint32_t           severity = 0;
 
+#if NRF_LOG_LOCK_FREE
+    if (!head_is_ready(p_header))
+    {
+        // The producer notifies again once it commits the entry.
+        return false;
+    }
+#else
     // Skip any in progress packets.
     do {
         if (invalid_packets_omit(p_header, &rd_idx) && (m_log_data.log_skipped == 0))
@@ -765,6 +851,7 @@ bool nrf_log_frontend_dequeue(void)
             break;
         }
     } while (true);
+#endif // NRF_LOG_LOCK_FREE
 
     uint32_t i;
     for (i = 0; i < HEADER_SIZE; i++)
@@ -903,7 +990,11 @@ bool nrf_log_frontend_dequeue(void)
             }
             else
             {
+#if NRF_LOG_LOCK_FREE
+                buf_release(rd_idx);
+#else
                 m_log_data.rd_idx = rd_idx;
+#endif
             }
         }
     }
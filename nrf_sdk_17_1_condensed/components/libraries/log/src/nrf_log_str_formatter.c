@@ -147,7 +147,7 @@ static void postfix_process(nrf_log_str_formatter_entry_params_t * p_params,
     {
         nrf_fprintf(p_ctx, "\r\n");
     }
-    nrf_fprintf_buffer_flush(p_ctx);
+    nrf_fprintf_buffer_flush_soft(p_ctx);
 }
 
 void nrf_log_std_entry_process(char const * p_str,
@@ -42,6 +42,11 @@
 #include "nrf_atomic.h"
 #include "nrf_assert.h"
 
+/** @brief Number of chunks taken from or returned to the pool in one critical region. */
+#ifndef NRF_MEMOBJ_ALLOC_BATCH
+#define NRF_MEMOBJ_ALLOC_BATCH 16
+#endif
+
 typedef struct memobj_elem_s memobj_elem_t;
 
 /** @brief Standard chunk header. */
@@ -96,37 +101,47 @@ nrf_memobj_t * nrf_memobj_alloc(nrf_memobj_pool_t const * p_pool,
     uint32_t bsize = (uint32_t)NRF_BALLOC_ELEMENT_SIZE((nrf_balloc_t const *)p_pool) - sizeof(memobj_header_t);
     uint8_t num_of_chunks = (uint8_t)CEIL_DIV(size + sizeof(memobj_head_header_t), bsize);
 
-    memobj_head_t * p_head = nrf_balloc_alloc((nrf_balloc_t const *)p_pool);
-    if (p_head == NULL)
-    {
-        return NULL;
-    }
-    p_head->head_header.data.fields.user_cnt = 0;
-    p_head->head_header.data.fields.chunk_cnt = 1;
-    p_head->head_header.data.fields.chunk_size = bsize;
-
-    memobj_header_t * p_prev = (memobj_header_t *)p_head;
+    memobj_head_t *   p_head = NULL;
+    memobj_header_t * p_prev = NULL;
     memobj_header_t * p_curr;
-    uint32_t i;
-    uint32_t chunk_less1 = (uint32_t)num_of_chunks - 1;
+    void *            p_chunks[NRF_MEMOBJ_ALLOC_BATCH];
+    uint32_t          left = num_of_chunks;
+    uint32_t          i;
 
-    p_prev->p_next =  (memobj_elem_t *)p_pool;
-    for (i = 0; i < chunk_less1; i++)
+    // Chunks are taken from the pool in batches, each batch in a single critical region.
+    while (left > 0)
     {
-        p_curr = (memobj_header_t *)nrf_balloc_alloc((nrf_balloc_t const *)p_pool);
-        if (p_curr)
-        {
-            (p_head->head_header.data.fields.chunk_cnt)++;
-            p_prev->p_next = (memobj_elem_t *)p_curr;
-            p_curr->p_next = (memobj_elem_t *)p_pool;
-            p_prev = p_curr;
-        }
-        else
+        uint8_t count = (uint8_t)MIN(left, NRF_MEMOBJ_ALLOC_BATCH);
+
+        if (nrf_balloc_alloc_n((nrf_balloc_t const *)p_pool, p_chunks, count) != NRF_SUCCESS)
         {
             //Could not allocate all requested buffers
-            nrf_memobj_free((nrf_memobj_t *)p_head);
+            if (p_head != NULL)
+            {
+                nrf_memobj_free((nrf_memobj_t *)p_head);
+            }
             return NULL;
         }
+
+        for (i = 0; i < count; i++)
+        {
+            p_curr = (memobj_header_t *)p_chunks[i];
+            p_curr->p_next = (memobj_elem_t *)p_pool;
+            if (p_prev == NULL)
+            {
+                p_head = (memobj_head_t *)p_curr;
+                p_head->head_header.data.fields.user_cnt = 0;
+                p_head->head_header.data.fields.chunk_cnt = 1;
+                p_head->head_header.data.fields.chunk_size = bsize;
+            }
+            else
+            {
+                (p_head->head_header.data.fields.chunk_cnt)++;
+                p_prev->p_next = (memobj_elem_t *)p_curr;
+            }
+            p_prev = p_curr;
+        }
+        left -= count;
     }
     return (nrf_memobj_t *)p_head;
 }
@@ -137,7 +152,8 @@ void nrf_memobj_free(nrf_memobj_t * p_obj)
     uint8_t chunk_cnt = p_head->head_header.data.fields.chunk_cnt;
     uint32_t i;
     memobj_header_t * p_curr = (memobj_header_t *)p_obj;
-    memobj_header_t * p_next;
+    void * p_chunks[NRF_MEMOBJ_ALLOC_BATCH];
+    uint32_t count = 0;
     uint32_t chunk_less1 = (uint32_t)chunk_cnt - 1;
 
     for (i = 0; i < chunk_less1; i++)
@@ -149,9 +165,13 @@ void nrf_memobj_free(nrf_memobj_t * p_obj)
     p_curr = (memobj_header_t *)p_obj;
     for (i = 0; i < chunk_cnt; i++)
     {
-        p_next = (memobj_header_t *)p_curr->p_next;
-        nrf_balloc_free(p_pool2, p_curr);
-        p_curr = p_next;
+        p_chunks[count++] = p_curr;
+        p_curr = (memobj_header_t *)p_curr->p_next;
+        if ((count == NRF_MEMOBJ_ALLOC_BATCH) || (i == chunk_less1))
+        {
+            nrf_balloc_free_n(p_pool2, p_chunks, (uint8_t)count);
+            count = 0;
+        }
     }
 }
 
@@ -78,7 +78,7 @@ extern "C" {
 @endverbatim
  *
  */
-#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(uint32_t)
+#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(void *)
 
 /**
  * @brief Macro for creating an nrf_memobj pool.
@@ -122,6 +122,9 @@ ret_code_t nrf_memobj_pool_init(nrf_memobj_pool_t const * p_pool);
  * the user. If a memory object is successfully allocated, then the users can use the memory.
  * However, it is fragmented into multiple objects so it must be accessed through the API:
  * @ref nrf_memobj_write and @ref nrf_memobj_read.
+ *
+ * The elements are taken from the pool with @ref nrf_balloc_alloc_n, up to NRF_MEMOBJ_ALLOC_BATCH
+ * elements per critical region.
  * 
  * @param[in] p_pool     Pointer to the memobj pool instance structure.
  * @param[in] size       Data size of requested object.
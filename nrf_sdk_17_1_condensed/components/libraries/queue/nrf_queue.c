@@ -93,7 +93,9 @@ static void nrf_queue_status(nrf_cli_t const * p_cli, size_t argc, char **argv)
                         p_name, element_size,
                         100ul * util/size, util,size,
                         100ul * max_util/size, max_util,size,
-                        (p_instance->mode == NRF_QUEUE_MODE_OVERFLOW) ? "Overflow" : "No overflow");
+                        (p_instance->mode == NRF_QUEUE_MODE_OVERFLOW) ? "Overflow" :
+                        (p_instance->mode == NRF_QUEUE_MODE_SPSC) ? "Single producer/consumer" :
+                                                                    "No overflow");
 
     }
 }
@@ -147,6 +149,151 @@ __STATIC_INLINE size_t queue_utilization_get(nrf_queue_t const * p_queue)
         (circullar_buffer_size_get(p_queue) - front + back);
 }
 
+/**@brief Update maximum utilization of the queue.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ * @param[in]   utilization Current queue utilization.
+ */
+__STATIC_INLINE void queue_max_utilization_update(nrf_queue_t const * p_queue, size_t utilization)
+{
+    if (p_queue->p_cb->max_utilization < utilization)
+    {
+        p_queue->p_cb->max_utilization = utilization;
+    }
+}
+
+/**@brief Write elements to a single producer, single consumer queue.
+ *
+ * Only the producer modifies the back index and only the consumer modifies the front index, so
+ * the elements are copied with interrupts enabled. The new back index is published after the
+ * elements are copied.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[in]   p_data              Pointer to the buffer with elements to write.
+ * @param[in]   element_count       Number of elements to write.
+ * @param[in]   partial             If true, write as many elements as fit. If false, write
+ *                                  nothing if not all elements fit.
+ *
+ * @return      The number of written elements.
+ */
+static size_t spsc_in(nrf_queue_t const * p_queue,
+                      void const        * p_data,
+                      size_t              element_count,
+                      bool                partial)
+{
+    size_t front     = p_queue->p_cb->front;
+    size_t back      = p_queue->p_cb->back;
+    size_t buf_size  = circullar_buffer_size_get(p_queue);
+    size_t used      = (back >= front) ? (back - front) : (buf_size - front + back);
+    size_t available = p_queue->size - used;
+
+    if (element_count > available)
+    {
+        if (!partial)
+        {
+            return 0;
+        }
+        element_count = available;
+    }
+
+    if (element_count == 0)
+    {
+        return 0;
+    }
+
+    // At most two segments: up to the end of the buffer, then from its beginning.
+    size_t first = MIN(element_count, buf_size - back);
+    memcpy((void *)((size_t)p_queue->p_buffer + back * p_queue->element_size),
+           p_data,
+           first * p_queue->element_size);
+    if (element_count > first)
+    {
+        memcpy(p_queue->p_buffer,
+               (void const *)((size_t)p_data + first * p_queue->element_size),
+               (element_count - first) * p_queue->element_size);
+    }
+
+    back += element_count;
+    if (back >= buf_size)
+    {
+        back -= buf_size;
+    }
+
+    // Elements must be visible to the consumer before the index that publishes them.
+    __DMB();
+    p_queue->p_cb->back = back;
+
+    queue_max_utilization_update(p_queue, used + element_count);
+
+    return element_count;
+}
+
+/**@brief Read elements from a single producer, single consumer queue.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[out]  p_data              Pointer to the buffer where elements will be copied.
+ * @param[in]   element_count       Number of elements to read.
+ * @param[in]   partial             If true, read as many elements as available. If false, read
+ *                                  nothing if there are not enough elements.
+ * @param[in]   just_peek           If true, the elements are not removed from the queue.
+ *
+ * @return      The number of read elements.
+ */
+static size_t spsc_out(nrf_queue_t const * p_queue,
+                       void              * p_data,
+                       size_t              element_count,
+                       bool                partial,
+                       bool                just_peek)
+{
+    size_t front    = p_queue->p_cb->front;
+    size_t back     = p_queue->p_cb->back;
+    size_t buf_size = circullar_buffer_size_get(p_queue);
+    size_t used     = (back >= front) ? (back - front) : (buf_size - front + back);
+
+    if (element_count > used)
+    {
+        if (!partial)
+        {
+            return 0;
+        }
+        element_count = used;
+    }
+
+    if (element_count == 0)
+    {
+        return 0;
+    }
+
+    // Do not read the elements before the index that published them.
+    __DMB();
+
+    size_t first = MIN(element_count, buf_size - front);
+    memcpy(p_data,
+           (void const *)((size_t)p_queue->p_buffer + front * p_queue->element_size),
+           first * p_queue->element_size);
+    if (element_count > first)
+    {
+        memcpy((void *)((size_t)p_data + first * p_queue->element_size),
+               p_queue->p_buffer,
+               (element_count - first) * p_queue->element_size);
+    }
+
+    if (!just_peek)
+    {
+        front += element_count;
+        if (front >= buf_size)
+        {
+            front -= buf_size;
+        }
+
+        // Elements must be copied out before the producer is allowed to overwrite them.
+        __DMB();
+        p_queue->p_cb->front = front;
+    }
+
+    return element_count;
+}
+
 bool nrf_queue_is_full(nrf_queue_t const * p_queue)
 {
     ASSERT(p_queue != NULL);
@@ -163,6 +310,13 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
     ASSERT(p_queue != NULL);
     ASSERT(p_element != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_in(p_queue, p_element, 1, false) == 1) ? NRF_SUCCESS : NRF_ERROR_NO_MEM;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "pushed element 0x%08X, status:%d", p_element, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
     bool is_full = nrf_queue_is_full(p_queue);
 
@@ -205,11 +359,7 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
         }
 
         // Update utilization.
-        size_t utilization = queue_utilization_get(p_queue);
-        if (p_queue->p_cb->max_utilization < utilization)
-        {
-            p_queue->p_cb->max_utilization = utilization;
-        }
+        queue_max_utilization_update(p_queue, queue_utilization_get(p_queue));
     }
     else
     {
@@ -231,6 +381,15 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
     ASSERT(p_queue      != NULL);
     ASSERT(p_element    != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_out(p_queue, p_element, 1, false, just_peek) == 1) ? NRF_SUCCESS
+                                                                         : NRF_ERROR_NOT_FOUND;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "%s element 0x%08X, status:%d",
+                                             just_peek ? "peeked" : "popped", p_element, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (!nrf_queue_is_empty(p_queue))
@@ -345,11 +504,7 @@ static void queue_write(nrf_queue_t const * p_queue, void const * p_data, uint32
     }
 
     // Update utilization.
-    size_t utilization = queue_utilization_get(p_queue);
-    if (p_queue->p_cb->max_utilization < utilization)
-    {
-        p_queue->p_cb->max_utilization = utilization;
-    }
+    queue_max_utilization_update(p_queue, queue_utilization_get(p_queue));
 }
 
 ret_code_t nrf_queue_write(nrf_queue_t const * p_queue,
@@ -367,6 +522,15 @@ ret_code_t nrf_queue_write(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_in(p_queue, p_data, element_count, false) == element_count)
+               ? NRF_SUCCESS : NRF_ERROR_NO_MEM;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Write %d elements (start address: 0x%08X), status:%d",
+                                           element_count, p_data, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if ((nrf_queue_available_get(p_queue) >= element_count)
@@ -401,6 +565,14 @@ size_t nrf_queue_in(nrf_queue_t const * p_queue,
         return 0;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        element_count = spsc_in(p_queue, p_data, element_count, true);
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Put in %d elements (start address: 0x%08X), requested :%d",
+                                           element_count, p_data, req_element_count);
+        return element_count;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (p_queue->mode == NRF_QUEUE_MODE_OVERFLOW)
@@ -477,6 +649,15 @@ ret_code_t nrf_queue_read(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_out(p_queue, p_data, element_count, false, false) == element_count)
+               ? NRF_SUCCESS : NRF_ERROR_NOT_FOUND;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Read %d elements (start address: 0x%08X), status :%d",
+                                           element_count, p_data, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (element_count <= queue_utilization_get(p_queue))
@@ -509,6 +690,14 @@ size_t nrf_queue_out(nrf_queue_t const * p_queue,
         return 0;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        element_count = spsc_out(p_queue, p_data, element_count, true, false);
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Out %d elements (start address: 0x%08X), requested :%d",
+                                           element_count, p_data, req_element_count);
+        return element_count;
+    }
+
     CRITICAL_REGION_ENTER();
 
     size_t utilization = queue_utilization_get(p_queue);
@@ -541,6 +730,12 @@ size_t nrf_queue_utilization_get(nrf_queue_t const * p_queue)
     size_t utilization;
     ASSERT(p_queue != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        // Front and back are read once each, the result is a consistent snapshot.
+        return queue_utilization_get(p_queue);
+    }
+
     CRITICAL_REGION_ENTER();
 
     utilization = queue_utilization_get(p_queue);
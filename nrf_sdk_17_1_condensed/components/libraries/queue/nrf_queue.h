@@ -78,6 +78,9 @@ typedef enum
 {
     NRF_QUEUE_MODE_OVERFLOW,        //!< If the queue is full, new element will overwrite the oldest.
     NRF_QUEUE_MODE_NO_OVERFLOW,     //!< If the queue is full, new element will not be accepted.
+    NRF_QUEUE_MODE_SPSC,            //!< Single producer, single consumer. If the queue is full, new element
+                                    //!< will not be accepted. Interrupts are not masked while elements are
+                                    //!< copied; only one context may write and only one context may read.
 } nrf_queue_mode_t;
 
 /**@brief Instance of the queue. */
@@ -107,6 +110,10 @@ typedef struct
  * @param[in]   _name       Name of the queue.
  * @param[in]   _size       Size of the queue.
  * @param[in]   _mode       Mode of the queue.
+ *
+ * @note  In @ref NRF_QUEUE_MODE_SPSC, push, write and in may only be called from one context (for
+ *        example a single interrupt) and pop, peek, read and out from one other context. In this mode
+ *        the queue does not use critical regions, except in @ref nrf_queue_reset.
  */
 #define NRF_QUEUE_DEF(_type, _name, _size, _mode)                                        \
     static _type             CONCAT_2(_name, _nrf_queue_buffer[(_size) + 1]);            \
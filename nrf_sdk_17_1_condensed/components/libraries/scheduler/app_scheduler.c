@@ -47,6 +47,51 @@
 #include "nrf_assert.h"
 #include "app_util_platform.h"
 
+#if APP_SCHEDULER_WITH_PRIORITIES
+
+/**@brief Flags of an event record. */
+#define RECORD_READY    0x0001  /**< Event data written, the record can be executed. */
+#define RECORD_DONE     0x0002  /**< Event already executed by app_sched_drain(). */
+#define RECORD_WRAP     0x0004  /**< Padding up to the end of the ring, the next record is at 0. */
+
+/**@brief Alignment of the event records, and so of the event data. */
+#define RECORD_ALIGN    sizeof(void *)
+
+/**@brief Structure for holding a scheduled event record header, followed by the event data. */
+typedef struct
+{
+    app_sched_event_handler_t handler;          /**< Pointer to event handler to receive the event. */
+    uint16_t                  event_data_size;  /**< Size of event data. */
+    volatile uint16_t         flags;            /**< RECORD_ flags, RECORD_READY is set last. */
+} record_header_t;
+
+STATIC_ASSERT(sizeof(record_header_t) <= APP_SCHED_EVENT_HEADER_SIZE);
+STATIC_ASSERT(sizeof(record_header_t) % RECORD_ALIGN == 0);
+STATIC_ASSERT(APP_SCHEDULER_DEFAULT_PRIORITY < APP_SCHEDULER_PRIORITY_LEVELS);
+
+/**@brief Ring of event records of one priority level.
+ *
+ * @details Producers reserve records at the write offset inside a critical region and fill them
+ *          in afterwards. The consumer only moves the read offset, once the record was executed.
+ *          The ring is empty when both offsets are equal, so it is never filled completely.
+ */
+typedef struct
+{
+    uint8_t *         p_buffer;     /**< Ring memory, RECORD_ALIGN aligned. */
+    volatile uint32_t read;         /**< Offset of the oldest record. */
+    volatile uint32_t write;        /**< Offset of the next record to be reserved. */
+} event_ring_t;
+
+static event_ring_t m_rings[APP_SCHEDULER_PRIORITY_LEVELS]; /**< One ring per priority level. */
+static uint32_t     m_ring_size;                            /**< Size of each ring, in bytes. */
+static uint16_t     m_queue_event_size;                     /**< Maximum event size in queue. */
+
+#if APP_SCHEDULER_WITH_PROFILER
+static uint16_t m_queue_utilization;        /**< Number of events in queue. */
+#endif
+
+#else
+
 /**@brief Structure for holding a scheduled event header. */
 typedef struct
 {
@@ -63,6 +108,8 @@ static volatile uint8_t m_queue_end_index;      /**< Index of queue entry at the
 static uint16_t         m_queue_event_size;     /**< Maximum event size in queue. */
 static uint16_t         m_queue_size;           /**< Number of queue entries. */
 
+#endif // APP_SCHEDULER_WITH_PRIORITIES
+
 #if APP_SCHEDULER_WITH_PROFILER
 static uint16_t m_max_queue_utilization;    /**< Maximum observed queue utilization. */
 #endif
@@ -72,6 +119,291 @@ static uint32_t m_scheduler_paused_counter = 0; /**< Counter storing the differe
                                                      and resuming the scheduler. */
 #endif
 
+#if APP_SCHEDULER_WITH_PRIORITIES
+
+/**@brief Function for getting the size of the record holding an event.
+ *
+ * @param[in]   event_data_size   Size of event data.
+ *
+ * @return      Record size, including the header and the alignment padding.
+ */
+static __INLINE uint32_t record_size(uint16_t event_data_size)
+{
+    return ALIGN_NUM(RECORD_ALIGN, sizeof(record_header_t) + event_data_size);
+}
+
+
+/**@brief Function for getting the offset of the record following a record, and handle wrap-around.
+ *
+ * @param[in]   offset     Offset of the record.
+ * @param[in]   p_header   Header of the record.
+ *
+ * @return      Offset of the next record.
+ */
+static __INLINE uint32_t record_next(uint32_t offset, record_header_t const * p_header)
+{
+    offset += record_size(p_header->event_data_size);
+    return (offset < m_ring_size) ? offset : 0;
+}
+
+
+/**@brief Function for getting a record of a ring.
+ *
+ * @details A record can not start in the last bytes of the ring that are too small for a header,
+ *          the producer continued at the start of the ring then.
+ *
+ * @param[in]   p_ring   Ring.
+ * @param[in]   offset   Offset of the record, updated when it wraps around.
+ *
+ * @return      Header of the record.
+ */
+static __INLINE record_header_t * record_get(event_ring_t const * p_ring, uint32_t * p_offset)
+{
+    if (m_ring_size - *p_offset < sizeof(record_header_t))
+    {
+        *p_offset = 0;
+    }
+    return (record_header_t *)&p_ring->p_buffer[*p_offset];
+}
+
+
+/**@brief Function for reserving a record at the end of a ring.
+ *
+ * @details Must be called from a critical region. An empty ring is restarted at its beginning.
+ *          When the record does not fit before the end of the ring, the rest of the ring is padded
+ *          and the record is placed at the start.
+ *
+ * @param[in]   p_ring   Ring.
+ * @param[in]   size     Record size.
+ *
+ * @return      Header of the reserved record, or NULL if the ring is full.
+ */
+static record_header_t * ring_reserve(event_ring_t * p_ring, uint32_t size)
+{
+    uint32_t read  = p_ring->read;
+    uint32_t write = p_ring->write;
+    uint32_t offset;
+
+    if (write == read)
+    {
+        // Nothing pending, so the whole ring is free. ring_head() does not store the read offset
+        // when it finds the ring empty, so it can not overwrite this.
+        read         = 0;
+        write        = 0;
+        p_ring->read = 0;
+    }
+    offset = write;
+
+    if (write >= read)
+    {
+        // Free space up to the end of the ring, and from the start up to the read offset. The
+        // write offset may only reach the end of the ring if it does not wrap onto read.
+        if ((write + size < m_ring_size) || ((write + size == m_ring_size) && (read != 0)))
+        {
+            write = (write + size < m_ring_size) ? (write + size) : 0;
+        }
+        else if (size < read)
+        {
+            if (m_ring_size - write >= sizeof(record_header_t))
+            {
+                record_header_t * p_pad = (record_header_t *)&p_ring->p_buffer[write];
+
+                p_pad->flags = RECORD_WRAP | RECORD_READY;
+            }
+            offset = 0;
+            write  = size;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else if (write + size < read)
+    {
+        write += size;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    p_ring->write = write;
+    return (record_header_t *)&p_ring->p_buffer[offset];
+}
+
+
+/**@brief Function for getting the oldest pending event of a ring.
+ *
+ * @details Moves the read offset over padding and over events already executed by
+ *          app_sched_drain(), so their space is released.
+ *
+ * @param[in]   p_ring   Ring.
+ *
+ * @return      Header of the oldest event, or NULL if there is none ready for execution.
+ */
+static record_header_t * ring_head(event_ring_t * p_ring)
+{
+    uint32_t start = p_ring->read;
+    uint32_t read  = start;
+
+    while (read != p_ring->write)
+    {
+        record_header_t * p_header = record_get(p_ring, &read);
+        uint16_t          flags    = p_header->flags;
+
+        if ((flags & RECORD_READY) == 0)
+        {
+            // Reserved, but the producer has not finished writing the event yet
+            break;
+        }
+        if ((flags & (RECORD_WRAP | RECORD_DONE)) == 0)
+        {
+            p_ring->read = read;
+            return p_header;
+        }
+        read = (flags & RECORD_WRAP) ? 0 : record_next(read, p_header);
+    }
+
+    // Only stored when moved, as ring_reserve() restarts a ring found empty at offset 0
+    if (read != start)
+    {
+        p_ring->read = read;
+    }
+    return NULL;
+}
+
+
+uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
+{
+    // Check that buffer is correctly aligned
+    if (!is_word_aligned(p_event_buffer))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Initialize event scheduler, the buffer is split into one ring per priority level
+    m_ring_size        = APP_SCHED_BUF_SIZE(event_size, queue_size) / APP_SCHEDULER_PRIORITY_LEVELS;
+    m_queue_event_size = event_size;
+
+    for (uint32_t i = 0; i < APP_SCHEDULER_PRIORITY_LEVELS; i++)
+    {
+        m_rings[i].p_buffer = &((uint8_t *)p_event_buffer)[i * m_ring_size];
+        m_rings[i].read     = 0;
+        m_rings[i].write    = 0;
+    }
+
+#if APP_SCHEDULER_WITH_PROFILER
+    m_queue_utilization     = 0;
+    m_max_queue_utilization = 0;
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+uint16_t app_sched_queue_space_get_prio(uint8_t priority)
+{
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
+    {
+        return 0;
+    }
+
+    event_ring_t const * p_ring = &m_rings[priority];
+    uint32_t             read   = p_ring->read;
+    uint32_t             write  = p_ring->write;
+    uint32_t             used   = (write >= read) ? (write - read) : (m_ring_size + write - read);
+
+    // In events of the maximum size, one is always kept back for the wrap-around padding
+    uint32_t free_space = (m_ring_size - used) / record_size(m_queue_event_size);
+
+    return (free_space > 0) ? (uint16_t)(free_space - 1) : 0;
+}
+
+
+uint16_t app_sched_queue_space_get()
+{
+    return app_sched_queue_space_get_prio(APP_SCHEDULER_DEFAULT_PRIORITY);
+}
+
+
+#if APP_SCHEDULER_WITH_PROFILER
+uint16_t app_sched_queue_utilization_get(void)
+{
+    return m_max_queue_utilization;
+}
+#endif // APP_SCHEDULER_WITH_PROFILER
+
+
+uint32_t app_sched_event_put_prio(void const              * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    record_header_t * p_header;
+
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (event_data_size > m_queue_event_size)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    if (p_event_data == NULL)
+    {
+        event_data_size = 0;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    p_header = ring_reserve(&m_rings[priority], record_size(event_data_size));
+    if (p_header != NULL)
+    {
+        p_header->flags = 0;
+
+    #if APP_SCHEDULER_WITH_PROFILER
+        if (++m_queue_utilization > m_max_queue_utilization)
+        {
+            m_max_queue_utilization = m_queue_utilization;
+        }
+    #endif
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    if (p_header == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    // NOTE: The record is reserved, so the event is copied outside the critical region. The
+    //       consumer skips the record, and the ones after it, until RECORD_READY is set. The
+    //       consumer runs on the same core, so a compiler barrier orders the flag last.
+    p_header->handler         = handler;
+    p_header->event_data_size = event_data_size;
+    if (event_data_size > 0)
+    {
+        memcpy(p_header + 1, p_event_data, event_data_size);
+    }
+    __COMPILER_BARRIER();
+    p_header->flags = RECORD_READY;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_sched_event_put(void const              * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+{
+    return app_sched_event_put_prio(p_event_data,
+                                    event_data_size,
+                                    handler,
+                                    APP_SCHEDULER_DEFAULT_PRIORITY);
+}
+
+#else
+
 /**@brief Function for incrementing a queue index, and handle wrap-around.
  *
  * @param[in]   index   Old index.
@@ -219,6 +551,8 @@ uint32_t app_sched_event_put(void const              * p_event_data,
     return err_code;
 }
 
+#endif // APP_SCHEDULER_WITH_PRIORITIES
+
 
 #if APP_SCHEDULER_WITH_PAUSE
 void app_sched_pause(void)
@@ -260,6 +594,146 @@ static __INLINE bool is_app_sched_paused(void)
 }
 
 
+#if APP_SCHEDULER_WITH_PRIORITIES
+
+/**@brief Function for releasing executed events in the profiler count.
+ *
+ * @param[in]   count   Number of events executed.
+ */
+static __INLINE void queue_utilization_release(uint16_t count)
+{
+#if APP_SCHEDULER_WITH_PROFILER
+    CRITICAL_REGION_ENTER();
+    m_queue_utilization -= count;
+    CRITICAL_REGION_EXIT();
+#else
+    UNUSED_PARAMETER(count);
+#endif
+}
+
+
+void app_sched_execute(void)
+{
+    while (!is_app_sched_paused())
+    {
+        event_ring_t    * p_ring   = NULL;
+        record_header_t * p_header = NULL;
+
+        // Priorities are checked again after every event, so an event put from an interrupt
+        // waits for at most one event of a lower priority.
+        for (uint32_t i = 0; (i < APP_SCHEDULER_PRIORITY_LEVELS) && (p_header == NULL); i++)
+        {
+            p_ring   = &m_rings[i];
+            p_header = ring_head(p_ring);
+        }
+        if (p_header == NULL)
+        {
+            break;
+        }
+
+        p_header->handler(p_header + 1, p_header->event_data_size);
+
+        // Event processed, now it is safe to move the read offset, so the record occupied by
+        // this event can be used to store a next one.
+        p_ring->read = record_next(p_ring->read, p_header);
+        queue_utilization_release(1);
+    }
+}
+
+
+/**@brief Function for passing a batch of events to a bulk handler and marking them executed.
+ *
+ * @param[in]   bulk_handler   Bulk handler to receive the events.
+ * @param[in]   p_events       Events.
+ * @param[in]   pp_headers     Records of the events.
+ * @param[in]   count          Number of events.
+ */
+static void drain_batch(app_sched_bulk_handler_t  bulk_handler,
+                        app_sched_event_t const * p_events,
+                        record_header_t * const * pp_headers,
+                        uint16_t                  count)
+{
+    bulk_handler(p_events, count);
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        pp_headers[i]->flags |= RECORD_DONE;
+    }
+    queue_utilization_release(count);
+}
+
+
+uint16_t app_sched_drain(app_sched_event_handler_t handler, app_sched_bulk_handler_t bulk_handler)
+{
+    app_sched_event_t events[APP_SCHEDULER_DRAIN_BATCH];
+    record_header_t * headers[APP_SCHEDULER_DRAIN_BATCH];
+    uint32_t          write[APP_SCHEDULER_PRIORITY_LEVELS];
+    uint16_t          count = 0;
+    uint16_t          total = 0;
+
+    if (is_app_sched_paused())
+    {
+        return 0;
+    }
+
+    // Events put by the bulk handler are left for the next call
+    for (uint32_t i = 0; i < APP_SCHEDULER_PRIORITY_LEVELS; i++)
+    {
+        write[i] = m_rings[i].write;
+    }
+
+    for (uint32_t i = 0; i < APP_SCHEDULER_PRIORITY_LEVELS; i++)
+    {
+        event_ring_t * p_ring = &m_rings[i];
+        uint32_t       offset = p_ring->read;
+
+        while (offset != write[i])
+        {
+            record_header_t * p_header = record_get(p_ring, &offset);
+            uint16_t          flags    = p_header->flags;
+
+            if ((flags & RECORD_READY) == 0)
+            {
+                break;
+            }
+            if (flags & RECORD_WRAP)
+            {
+                offset = 0;
+                continue;
+            }
+            if (((flags & RECORD_DONE) == 0) && (p_header->handler == handler))
+            {
+                events[count].p_event_data = p_header + 1;
+                events[count].event_size   = p_header->event_data_size;
+                headers[count]             = p_header;
+                if (++count == APP_SCHEDULER_DRAIN_BATCH)
+                {
+                    drain_batch(bulk_handler, events, headers, count);
+                    total += count;
+                    count  = 0;
+                }
+            }
+            offset = record_next(offset, p_header);
+        }
+    }
+
+    if (count > 0)
+    {
+        drain_batch(bulk_handler, events, headers, count);
+        total += count;
+    }
+
+    // Release the space of the executed events at the start of the rings
+    for (uint32_t i = 0; i < APP_SCHEDULER_PRIORITY_LEVELS; i++)
+    {
+        (void)ring_head(&m_rings[i]);
+    }
+
+    return total;
+}
+
+#else
+
 void app_sched_execute(void)
 {
     while (!is_app_sched_paused() && !APP_SCHED_QUEUE_EMPTY())
@@ -285,4 +759,6 @@ void app_sched_execute(void)
         m_queue_start_index = next_index(m_queue_start_index);
     }
 }
+
+#endif // APP_SCHEDULER_WITH_PRIORITIES
 #endif //NRF_MODULE_ENABLED(APP_SCHEDULER)
@@ -86,7 +86,29 @@
 extern "C" {
 #endif
 
-#define APP_SCHED_EVENT_HEADER_SIZE 8       /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
+#define APP_SCHED_EVENT_HEADER_SIZE (2 * sizeof(void *)) /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
+
+#if APP_SCHEDULER_WITH_PRIORITIES
+
+#define APP_SCHED_PRIORITY_HIGHEST  0                                   /**< Highest event priority. */
+#define APP_SCHED_PRIORITY_LOWEST   (APP_SCHEDULER_PRIORITY_LEVELS - 1) /**< Lowest event priority. */
+
+/**@brief Compute number of bytes required to hold the scheduler buffer.
+ *
+ * @details Each priority level has its own ring of variable length event records, dimensioned
+ *          to hold at least QUEUE_SIZE events of EVENT_SIZE. Smaller events take less space, so
+ *          more of them fit.
+ *
+ * @param[in] EVENT_SIZE   Maximum size of events to be passed through the scheduler.
+ * @param[in] QUEUE_SIZE   Number of maximum size events each priority level can hold.
+ *
+ * @return    Required scheduler buffer size (in bytes).
+ */
+#define APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE)                                                 \
+            (APP_SCHEDULER_PRIORITY_LEVELS * ((QUEUE_SIZE) + 2) *                                  \
+             (APP_SCHED_EVENT_HEADER_SIZE + sizeof(void *) * CEIL_DIV((EVENT_SIZE), sizeof(void *))))
+
+#else
 
 /**@brief Compute number of bytes required to hold the scheduler buffer.
  *
@@ -99,9 +121,21 @@ extern "C" {
 #define APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE)                                                 \
             (((EVENT_SIZE) + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 1))
 
+#endif // APP_SCHEDULER_WITH_PRIORITIES
+
 /**@brief Scheduler event handler type. */
 typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_size);
 
+/**@brief Event passed to an @ref app_sched_bulk_handler_t. */
+typedef struct
+{
+    void *   p_event_data;  /**< Pointer to the event data, valid until the bulk handler returns. */
+    uint16_t event_size;    /**< Size of the event data. */
+} app_sched_event_t;
+
+/**@brief Scheduler bulk event handler type, see @ref app_sched_drain. */
+typedef void (*app_sched_bulk_handler_t)(app_sched_event_t const * p_events, uint16_t count);
+
 /**@brief Macro for initializing the event scheduler.
  *
  * @details It will also handle dimensioning and allocation of the memory buffer required by the
@@ -137,6 +171,9 @@ typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_si
  * @note Normally initialization should be done using the APP_SCHED_INIT() macro, as that will both
  *       allocate the scheduler buffer, and also align the buffer correctly.
  *
+ * @note With @ref APP_SCHEDULER_WITH_PRIORITIES the buffer is split into one ring per priority
+ *       level, each holding at least @p queue_size events of @p max_event_size.
+ *
  * @retval      NRF_SUCCESS               Successful initialization.
  * @retval      NRF_ERROR_INVALID_PARAM   Invalid parameter (buffer not aligned to a 4 byte
  *                                        boundary).
@@ -147,6 +184,9 @@ uint32_t app_sched_init(uint16_t max_event_size, uint16_t queue_size, void * p_e
  *
  * @details This function must be called from within the main loop. It will execute all events
  *          scheduled since the last time it was called.
+ *
+ *          With @ref APP_SCHEDULER_WITH_PRIORITIES the highest priority pending event is executed
+ *          next, also when it was scheduled while a lower priority event was executing.
  */
 void app_sched_execute(void);
 
@@ -164,6 +204,51 @@ uint32_t app_sched_event_put(void const *              p_event_data,
                              uint16_t                  event_size,
                              app_sched_event_handler_t handler);
 
+/**@brief Function for scheduling an event with a priority.
+ *
+ * @details Puts an event into the event queue of the given priority level. Events of a higher
+ *          priority are executed before all pending events of a lower priority, events of the
+ *          same priority in the order they were put. The event data is copied outside of the
+ *          critical region.
+ *
+ * @note @ref APP_SCHEDULER_WITH_PRIORITIES must be enabled to use this functionality.
+ *       @ref app_sched_event_put uses @ref APP_SCHEDULER_DEFAULT_PRIORITY.
+ *
+ * @param[in]   p_event_data   Pointer to event data to be scheduled.
+ * @param[in]   event_size     Size of event data to be scheduled.
+ * @param[in]   handler        Event handler to receive the event.
+ * @param[in]   priority       Priority level, from @ref APP_SCHED_PRIORITY_HIGHEST to
+ *                             @ref APP_SCHED_PRIORITY_LOWEST.
+ *
+ * @retval      NRF_SUCCESS                 Event scheduled.
+ * @retval      NRF_ERROR_INVALID_PARAM     Invalid priority level.
+ * @retval      NRF_ERROR_INVALID_LENGTH    Event larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM            No space left at this priority level.
+ */
+uint32_t app_sched_event_put_prio(void const *              p_event_data,
+                                  uint16_t                  event_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority);
+
+/**@brief Function for executing all pending events of one handler at once.
+ *
+ * @details Collects the pending events scheduled with @p handler, highest priority first, and
+ *          passes them to @p bulk_handler in batches of up to @ref APP_SCHEDULER_DRAIN_BATCH
+ *          events. Events of other handlers stay queued in their order. Events scheduled while
+ *          draining are left for the next call.
+ *
+ *          Like @ref app_sched_execute, it must be called from the main loop, and not from
+ *          @p bulk_handler.
+ *
+ * @note @ref APP_SCHEDULER_WITH_PRIORITIES must be enabled to use this functionality.
+ *
+ * @param[in]   handler        Event handler the events were scheduled with.
+ * @param[in]   bulk_handler   Bulk handler to receive the events.
+ *
+ * @return      Number of events passed to @p bulk_handler.
+ */
+uint16_t app_sched_drain(app_sched_event_handler_t handler, app_sched_bulk_handler_t bulk_handler);
+
 /**@brief Function for getting the maximum observed queue utilization.
  *
  * Function for tuning the module and determining QUEUE_SIZE value and thus module RAM usage.
@@ -179,10 +264,28 @@ uint16_t app_sched_queue_utilization_get(void);
  * @details The real amount of free space may be less if entries are being added from an interrupt.
  *          To get the sxact value, this function should be called from the critical section.
  *
+ * @note With @ref APP_SCHEDULER_WITH_PRIORITIES the free space of the
+ *       @ref APP_SCHEDULER_DEFAULT_PRIORITY level is returned, the one used by
+ *       @ref app_sched_event_put. Use @ref app_sched_queue_space_get_prio for other levels.
+ *
  * @return Amount of free space in the queue.
  */
 uint16_t app_sched_queue_space_get(void);
 
+/**@brief Function for getting the current amount of free space of a priority level.
+ *
+ * @details Counted in events of the maximum size. The same limits as for
+ *          @ref app_sched_queue_space_get apply.
+ *
+ * @note @ref APP_SCHEDULER_WITH_PRIORITIES must be enabled to use this functionality.
+ *
+ * @param[in]   priority   Priority level, from @ref APP_SCHED_PRIORITY_HIGHEST to
+ *                         @ref APP_SCHED_PRIORITY_LOWEST.
+ *
+ * @return      Amount of free space at this priority level, 0 for an invalid level.
+ */
+uint16_t app_sched_queue_space_get_prio(uint8_t priority);
+
 /**@brief A function to pause the scheduler.
  *
  * @details When the scheduler is paused events are not pulled from the scheduler queue for
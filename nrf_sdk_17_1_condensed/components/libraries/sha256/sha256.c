@@ -38,6 +38,7 @@
  *
  */
 #include <stdlib.h>
+#include <string.h>
 #include "sha256.h"
 #include "sdk_errors.h"
 #include "sdk_common.h"
@@ -66,50 +67,80 @@ static const uint32_t k[64] = {
 };
 
 
-/**@brief Function for calculating the hash of a 64-byte section of data.
+/**@brief One round. The working variables are not rotated, the caller passes them in rotated
+ *        order instead, so a round only writes d and h.
+ */
+#define ROUND(a,b,c,d,e,f,g,h,i,w)                              \
+    do {                                                        \
+        uint32_t t1 = (h) + EP1(e) + CH(e,f,g) + k[i] + (w);    \
+        (d) += t1;                                              \
+        (h) = t1 + EP0(a) + MAJ(a,b,c);                         \
+    } while (0)
+
+/**@brief Message schedule word i >= 16, computed in place in a 16-word ring. */
+#define SCHEDULE(m,i) \
+    ((m)[(i) & 15] += SIG1((m)[((i) - 2) & 15]) + (m)[((i) - 7) & 15] + SIG0((m)[((i) - 15) & 15]))
+
+
+/**@brief Function for calculating the hash of one or more 64-byte sections of data.
+ *
+ * @details The message schedule is kept in a 16-word ring instead of all 64 words, so the stack
+ *          use is 64 bytes and more of it stays in registers. Eight rounds are unrolled so the
+ *          working variables are renamed instead of moved.
  *
- * @param[in,out] ctx   Hash instance.
- * @param[in]     data  Aray with data to be hashed. Assumed to be 64 bytes long.
+ * @param[in,out] ctx     Hash instance.
+ * @param[in]     data    Aray with data to be hashed. Assumed to be blocks * 64 bytes long.
+ * @param[in]     blocks  Number of 64-byte sections.
  */
-void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
+static void sha256_transform(sha256_context_t *ctx, const uint8_t * data, size_t blocks)
 {
-    uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
-
-    for (i = 0, j = 0; i < 16; ++i, j += 4)
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-    for ( ; i < 64; ++i)
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
-
-    a = ctx->state[0];
-    b = ctx->state[1];
-    c = ctx->state[2];
-    d = ctx->state[3];
-    e = ctx->state[4];
-    f = ctx->state[5];
-    g = ctx->state[6];
-    h = ctx->state[7];
-
-    for (i = 0; i < 64; ++i) {
-        t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-        t2 = EP0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
-    }
+    uint32_t a, b, c, d, e, f, g, h, i, j, m[16];
+
+    while (blocks-- > 0) {
+        for (i = 0, j = 0; i < 16; ++i, j += 4)
+            m[i] = ((uint32_t)data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+
+        a = ctx->state[0];
+        b = ctx->state[1];
+        c = ctx->state[2];
+        d = ctx->state[3];
+        e = ctx->state[4];
+        f = ctx->state[5];
+        g = ctx->state[6];
+        h = ctx->state[7];
+
+        for (i = 0; i < 16; i += 8) {
+            ROUND(a,b,c,d,e,f,g,h, i + 0, m[i + 0]);
+            ROUND(h,a,b,c,d,e,f,g, i + 1, m[i + 1]);
+            ROUND(g,h,a,b,c,d,e,f, i + 2, m[i + 2]);
+            ROUND(f,g,h,a,b,c,d,e, i + 3, m[i + 3]);
+            ROUND(e,f,g,h,a,b,c,d, i + 4, m[i + 4]);
+            ROUND(d,e,f,g,h,a,b,c, i + 5, m[i + 5]);
+            ROUND(c,d,e,f,g,h,a,b, i + 6, m[i + 6]);
+            ROUND(b,c,d,e,f,g,h,a, i + 7, m[i + 7]);
+        }
+        for ( ; i < 64; i += 8) {
+            ROUND(a,b,c,d,e,f,g,h, i + 0, SCHEDULE(m, i + 0));
+            ROUND(h,a,b,c,d,e,f,g, i + 1, SCHEDULE(m, i + 1));
+            ROUND(g,h,a,b,c,d,e,f, i + 2, SCHEDULE(m, i + 2));
+            ROUND(f,g,h,a,b,c,d,e, i + 3, SCHEDULE(m, i + 3));
+            ROUND(e,f,g,h,a,b,c,d, i + 4, SCHEDULE(m, i + 4));
+            ROUND(d,e,f,g,h,a,b,c, i + 5, SCHEDULE(m, i + 5));
+            ROUND(c,d,e,f,g,h,a,b, i + 6, SCHEDULE(m, i + 6));
+            ROUND(b,c,d,e,f,g,h,a, i + 7, SCHEDULE(m, i + 7));
+        }
+
+        ctx->state[0] += a;
+        ctx->state[1] += b;
+        ctx->state[2] += c;
+        ctx->state[3] += d;
+        ctx->state[4] += e;
+        ctx->state[5] += f;
+        ctx->state[6] += g;
+        ctx->state[7] += h;
 
-    ctx->state[0] += a;
-    ctx->state[1] += b;
-    ctx->state[2] += c;
-    ctx->state[3] += d;
-    ctx->state[4] += e;
-    ctx->state[5] += f;
-    ctx->state[6] += g;
-    ctx->state[7] += h;
+        data += 64;
+    }
 }
 
 
@@ -140,18 +171,35 @@ ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, size_t len
         return NRF_ERROR_NULL;
     }
 
-    uint32_t i;
+    // Complete the section left over from the previous call first.
+    if (ctx->datalen > 0) {
+        size_t fill = MIN(len, 64 - ctx->datalen);
 
-    for (i = 0; i < len; ++i) {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
-        if (ctx->datalen == 64) {
-            sha256_transform(ctx, ctx->data);
-            ctx->bitlen += 512;
-            ctx->datalen = 0;
-        }
+        memcpy(&ctx->data[ctx->datalen], data, fill);
+        ctx->datalen += fill;
+        data += fill;
+        len -= fill;
+        if (ctx->datalen < 64)
+            return NRF_SUCCESS;
+
+        sha256_transform(ctx, ctx->data, 1);
+        ctx->bitlen += 512;
+        ctx->datalen = 0;
     }
 
+    // Hash whole sections straight from the input, without copying.
+    if (len >= 64) {
+        size_t blocks = len / 64;
+
+        sha256_transform(ctx, data, blocks);
+        ctx->bitlen += (uint64_t)blocks * 512;
+        data += blocks * 64;
+        len -= blocks * 64;
+    }
+
+    memcpy(ctx->data, data, len);
+    ctx->datalen = len;
+
     return NRF_SUCCESS;
 }
 
@@ -175,7 +223,7 @@ ret_code_t sha256_final(sha256_context_t *ctx, uint8_t * hash, uint8_t le)
         ctx->data[i++] = 0x80;
         while (i < 64)
             ctx->data[i++] = 0x00;
-        sha256_transform(ctx, ctx->data);
+        sha256_transform(ctx, ctx->data, 1);
         memset(ctx->data, 0, 56);
     }
 
@@ -189,7 +237,7 @@ ret_code_t sha256_final(sha256_context_t *ctx, uint8_t * hash, uint8_t le)
     ctx->data[58] = ctx->bitlen >> 40;
     ctx->data[57] = ctx->bitlen >> 48;
     ctx->data[56] = ctx->bitlen >> 56;
-    sha256_transform(ctx, ctx->data);
+    sha256_transform(ctx, ctx->data, 1);
 
     if (le)
     {
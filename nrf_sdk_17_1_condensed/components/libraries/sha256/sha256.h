@@ -51,6 +51,12 @@
  *          After all data has been passed to @ref sha256_update, call @ref sha256_final to finalize
  *          and extract the hash value.
  *
+ *          Only the last partial 64-byte section is buffered in the context, whole sections are
+ *          hashed straight from the buffer given to @ref sha256_update. Images and records can
+ *          therefore be hashed as their chunks arrive from UART or flash. The same streaming
+ *          interface is available through nrf_crypto_hash with the nRF SW backend, which uses
+ *          this module, or with the CC310 and Oberon backends, selected in sdk_config.h.
+ *
  *          This code is adapted from code by Brad Conte, retrieved from
  *          https://github.com/B-Con/crypto-algorithms.
  *
@@ -61,6 +67,7 @@
 
 
 #include <stdint.h>
+#include <stddef.h>
 #include "sdk_errors.h"
 
 #ifdef __cplusplus
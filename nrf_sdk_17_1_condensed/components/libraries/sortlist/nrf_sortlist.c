@@ -53,6 +53,226 @@
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
 
+#if NRF_SORTLIST_CONFIG_HEAP
+
+/**
+ * @brief Function for melding two heaps.
+ *
+ * The root which should be higher stays root, the other one becomes its first child. On equal
+ * items @p p_a stays root.
+ *
+ * @param p_list   List instance.
+ * @param p_a      Root of the first heap.
+ * @param p_b      Root of the second heap.
+ *
+ * @return Root of the melded heap. Its p_next and p_prev are left to the caller.
+ */
+static nrf_sortlist_item_t * heap_meld(nrf_sortlist_t const * p_list,
+                                       nrf_sortlist_item_t   * p_a,
+                                       nrf_sortlist_item_t   * p_b)
+{
+    if (!(p_list->compare_func(p_a, p_b)))
+    {
+        nrf_sortlist_item_t * p_tmp = p_a;
+        p_a = p_b;
+        p_b = p_tmp;
+    }
+
+    p_b->p_prev = p_a;
+    p_b->p_next = p_a->p_child;
+    if (p_a->p_child != NULL)
+    {
+        p_a->p_child->p_prev = p_b;
+    }
+    p_a->p_child = p_b;
+
+    return p_a;
+}
+
+/**
+ * @brief Function for melding a list of siblings into one heap, in two passes.
+ *
+ * The first pass melds the siblings pairwise from left to right, the second pass melds the pairs
+ * from right to left. This keeps the amortized cost of popping logarithmic.
+ *
+ * @param p_list    List instance.
+ * @param p_first   First sibling, or NULL.
+ *
+ * @return Root of the heap, or NULL.
+ */
+static nrf_sortlist_item_t * heap_merge_pairs(nrf_sortlist_t const * p_list,
+                                              nrf_sortlist_item_t   * p_first)
+{
+    nrf_sortlist_item_t * p_pairs = NULL;
+    nrf_sortlist_item_t * p_root;
+
+    // First pass, the melded pairs are chained in reverse order through p_next
+    while (p_first != NULL)
+    {
+        nrf_sortlist_item_t * p_a = p_first;
+        nrf_sortlist_item_t * p_b = p_a->p_next;
+
+        if (p_b != NULL)
+        {
+            p_first = p_b->p_next;
+            p_a     = heap_meld(p_list, p_a, p_b);
+        }
+        else
+        {
+            p_first = NULL;
+        }
+        p_a->p_next = p_pairs;
+        p_pairs     = p_a;
+    }
+
+    if (p_pairs == NULL)
+    {
+        return NULL;
+    }
+
+    // Second pass, from the last pair back to the first one
+    p_root  = p_pairs;
+    p_pairs = p_pairs->p_next;
+    while (p_pairs != NULL)
+    {
+        nrf_sortlist_item_t * p_next = p_pairs->p_next;
+
+        p_root  = heap_meld(p_list, p_root, p_pairs);
+        p_pairs = p_next;
+    }
+
+    p_root->p_next = NULL;
+    p_root->p_prev = NULL;
+    return p_root;
+}
+
+void nrf_sortlist_add(nrf_sortlist_t const * p_list, nrf_sortlist_item_t * p_item)
+{
+    ASSERT(p_list);
+    ASSERT(p_item);
+
+    nrf_sortlist_item_t * p_head = p_list->p_cb->p_head;
+
+    p_item->p_next  = NULL;
+    p_item->p_child = NULL;
+    p_item->p_prev  = NULL;
+    p_item->p_cb    = p_list->p_cb;
+
+    if (p_head != NULL)
+    {
+        p_head = heap_meld(p_list, p_head, p_item);
+        p_head->p_prev = NULL;
+    }
+    else
+    {
+        p_head = p_item;
+    }
+    p_list->p_cb->p_head = p_head;
+
+    NRF_LOG_INFO("List:%s, adding element:%08X, head:%08X", p_list->p_name, p_item, p_head);
+}
+
+nrf_sortlist_item_t * nrf_sortlist_pop(nrf_sortlist_t const * p_list)
+{
+    ASSERT(p_list);
+    nrf_sortlist_item_t * ret = p_list->p_cb->p_head;
+    if (ret != NULL)
+    {
+        p_list->p_cb->p_head = heap_merge_pairs(p_list, ret->p_child);
+        ret->p_child = NULL;
+        ret->p_cb    = NULL;
+    }
+    NRF_LOG_INFO("List:%s, poping element:%08X", p_list->p_name, ret);
+    return ret;
+}
+
+nrf_sortlist_item_t const * nrf_sortlist_peek(nrf_sortlist_t const * p_list)
+{
+    ASSERT(p_list);
+    return p_list->p_cb->p_head;
+}
+
+nrf_sortlist_item_t const * nrf_sortlist_next(nrf_sortlist_item_t const * p_item)
+{
+    ASSERT(p_item);
+
+    // Pre-order walk: first child, else next sibling of the item or of its closest ancestor
+    if (p_item->p_child != NULL)
+    {
+        return p_item->p_child;
+    }
+    while (p_item != NULL)
+    {
+        nrf_sortlist_item_t const * p_first = p_item;
+
+        if (p_item->p_next != NULL)
+        {
+            return p_item->p_next;
+        }
+        while ((p_first->p_prev != NULL) && (p_first->p_prev->p_child != p_first))
+        {
+            p_first = p_first->p_prev;
+        }
+        p_item = p_first->p_prev;
+    }
+    return NULL;
+}
+
+bool nrf_sortlist_remove(nrf_sortlist_t const * p_list, nrf_sortlist_item_t * p_item)
+{
+    ASSERT(p_list);
+    ASSERT(p_item);
+    bool ret = true;
+
+    if (p_item->p_cb != p_list->p_cb)
+    {
+        // Not in this list, the links belong to another one or to none
+        ret = false;
+    }
+    else if (p_item == p_list->p_cb->p_head)
+    {
+        (void)nrf_sortlist_pop(p_list);
+    }
+    else
+    {
+        nrf_sortlist_item_t * p_subheap;
+
+        // Unlink the item with its subheap from the siblings
+        if (p_item->p_prev->p_child == p_item)
+        {
+            p_item->p_prev->p_child = p_item->p_next;
+        }
+        else
+        {
+            p_item->p_prev->p_next = p_item->p_next;
+        }
+        if (p_item->p_next != NULL)
+        {
+            p_item->p_next->p_prev = p_item->p_prev;
+        }
+
+        p_subheap = heap_merge_pairs(p_list, p_item->p_child);
+        if (p_subheap != NULL)
+        {
+            nrf_sortlist_item_t * p_head = heap_meld(p_list, p_list->p_cb->p_head, p_subheap);
+
+            p_head->p_prev       = NULL;
+            p_list->p_cb->p_head = p_head;
+        }
+
+        p_item->p_next  = NULL;
+        p_item->p_child = NULL;
+        p_item->p_prev  = NULL;
+        p_item->p_cb    = NULL;
+    }
+
+    NRF_LOG_INFO("List:%s, removing element:%08X %s",
+                                  p_list->p_name, p_item, ret ? "succeeded" : "not found");
+    return ret;
+}
+
+#else
+
 void nrf_sortlist_add(nrf_sortlist_t const * p_list, nrf_sortlist_item_t * p_item)
 {
     ASSERT(p_list);
@@ -123,4 +343,6 @@ bool nrf_sortlist_remove(nrf_sortlist_t const * p_list, nrf_sortlist_item_t * p_
                                   p_list->p_name, p_item, ret ? "succeeded" : "not found");
     return ret;
 }
+
+#endif // NRF_SORTLIST_CONFIG_HEAP
 #endif //NRF_SORTLIST_ENABLED
@@ -52,6 +52,13 @@ extern "C" {
  * @{
  * @ingroup app_common
  * @brief Module for storing items in the ordered list.
+ *
+ * @details By default the items are kept in a singly linked list, so adding and removing an item
+ *          takes linear time. With @ref NRF_SORTLIST_CONFIG_HEAP the items form a pairing heap
+ *          instead: adding and peeking take constant time, popping and removing take logarithmic
+ *          amortized time. Each item then holds four pointers instead of one, and
+ *          @ref nrf_sortlist_next visits the items in heap order instead of sorted order. Items
+ *          comparing equal are not popped in the order they were added.
  */
 
 /**
@@ -59,6 +66,11 @@ extern "C" {
  */
 typedef struct nrf_sortlist_item_s nrf_sortlist_item_t;
 
+/**
+ * @brief Forward declaration of sorted list control block.
+ */
+typedef struct nrf_sortlist_cb_s nrf_sortlist_cb_t;
+
 /** @brief Prototype of a function which compares two elements.
  *
  * @param p_item0 Item 0.
@@ -74,7 +86,12 @@ typedef bool (*nrf_sortlist_compare_func_t)(nrf_sortlist_item_t * p_item0, nrf_s
  */
 struct nrf_sortlist_item_s
 {
-    nrf_sortlist_item_t * p_next;             /* Pointer to the next item in the list. */
+    nrf_sortlist_item_t * p_next;             /* Pointer to the next item in the list, or to the next sibling in the heap. */
+#if NRF_SORTLIST_CONFIG_HEAP
+    nrf_sortlist_item_t * p_child;            /* Pointer to the first child in the heap. */
+    nrf_sortlist_item_t * p_prev;             /* Pointer to the previous sibling, or to the parent of a first child. NULL for the head and for items not in a list. */
+    nrf_sortlist_cb_t   * p_cb;               /* Control block of the list holding the item. NULL for items not in a list. */
+#endif
 };
 
 /**
@@ -82,10 +99,10 @@ struct nrf_sortlist_item_s
  *
  * Control block contains instance data which must be located in read/write memory.
  */
-typedef struct
+struct nrf_sortlist_cb_s
 {
     nrf_sortlist_item_t *       p_head;       /* List head.*/
-} nrf_sortlist_cb_t;
+};
 /**
  * @brief Structure for sorted list instance.
  *
@@ -152,6 +169,9 @@ nrf_sortlist_item_t const * nrf_sortlist_peek(nrf_sortlist_t const * p_list);
 /**
  * @brief Function for iterating over the list.
  *
+ * @note With @ref NRF_SORTLIST_CONFIG_HEAP only the first item, from @ref nrf_sortlist_peek, is in
+ *       order. The others are visited in heap order.
+ *
  * @param p_item   Item in the list.
  *
  * @return Pointer to the next item in the list.
@@ -161,6 +181,10 @@ nrf_sortlist_item_t const * nrf_sortlist_next(nrf_sortlist_item_t const * p_item
 /**
  * @brief Function for removing an item from the queue.
  *
+ * @note With @ref NRF_SORTLIST_CONFIG_HEAP an item that was never added must be zero-initialized,
+ *       an item records the list holding it, which is checked in constant time. Popped and removed
+ *       items are cleared.
+ *
  * @param p_list   List instance.
  * @param p_item   Item.
  *
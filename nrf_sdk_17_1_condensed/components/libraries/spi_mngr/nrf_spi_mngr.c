@@ -50,22 +50,94 @@ typedef volatile struct
     uint8_t transaction_result;
 } nrf_spi_mngr_cb_data_t;
 
-static ret_code_t start_transfer(nrf_spi_mngr_t const * p_nrf_spi_mngr)
+static void bulk_read_begin(void * p_user_data);
+static void bulk_read_end(ret_code_t result, void * p_user_data);
+
+// Gets the descriptor of a transfer of a transaction. Returns false past its last transfer.
+// The transfers of a bulk read are made from its descriptor.
+static bool transfer_get(nrf_spi_mngr_transaction_t const * p_transaction,
+                         uint16_t                           transfer_idx,
+                         nrf_spi_mngr_transfer_t *          p_transfer)
 {
-    ASSERT(p_nrf_spi_mngr != NULL);
+    if (p_transaction->end_callback == bulk_read_end)
+    {
+        nrf_spi_mngr_bulk_t const * p_bulk = (nrf_spi_mngr_bulk_t const *)p_transaction->p_user_data;
+
+        if (transfer_idx == 0)
+        {
+            *p_transfer = (nrf_spi_mngr_transfer_t)
+                NRF_SPI_MNGR_TRANSFER(p_bulk->p_cmd, p_bulk->cmd_length, NULL, 0);
+            return true;
+        }
+
+        uint32_t offset = (uint32_t)(transfer_idx - 1) * p_bulk->chunk_size;
+        if (offset >= p_bulk->length)
+        {
+            return false;
+        }
+        *p_transfer = (nrf_spi_mngr_transfer_t)
+            NRF_SPI_MNGR_TRANSFER(NULL, 0, p_bulk->p_data + offset,
+                                  MIN(p_bulk->chunk_size, p_bulk->length - offset));
+        return true;
+    }
+
+    if (transfer_idx >= p_transaction->number_of_transfers)
+    {
+        return false;
+    }
+    *p_transfer = p_transaction->p_transfers[transfer_idx];
+    return true;
+}
 
-    // use a local variable to avoid using two volatile variables in one
-    // expression
-    uint8_t curr_transfer_idx = p_nrf_spi_mngr->p_nrf_spi_mngr_cb->current_transfer_idx;
-    nrf_spi_mngr_transfer_t const * p_transfer =
-        &p_nrf_spi_mngr->p_nrf_spi_mngr_cb->p_current_transaction->p_transfers[curr_transfer_idx];
 
+static ret_code_t transfer_start(nrf_spi_mngr_t const *          p_nrf_spi_mngr,
+                                 nrf_spi_mngr_transfer_t const * p_transfer)
+{
     return nrf_drv_spi_transfer(&p_nrf_spi_mngr->spi,
                                 p_transfer->p_tx_data, p_transfer->tx_length,
                                 p_transfer->p_rx_data, p_transfer->rx_length);
 }
 
 
+// Starts the first transfer of the current transaction. The descriptor of the second one is
+// prepared first, as the transfer may end before this function returns.
+static ret_code_t start_transfer(nrf_spi_mngr_t const * p_nrf_spi_mngr)
+{
+    ASSERT(p_nrf_spi_mngr != NULL);
+
+    nrf_spi_mngr_cb_t *     p_cb = p_nrf_spi_mngr->p_nrf_spi_mngr_cb;
+    nrf_spi_mngr_transfer_t transfer;
+
+    p_cb->current_transfer_idx = 0;
+    UNUSED_RETURN_VALUE(transfer_get(p_cb->p_current_transaction, 0, &transfer));
+    p_cb->next_transfer_ready = transfer_get(p_cb->p_current_transaction, 1, &p_cb->next_transfer);
+
+    return transfer_start(p_nrf_spi_mngr, &transfer);
+}
+
+
+// Starts the next transfer of the current transaction, from the event handler, then prepares
+// the descriptor of the one after it while the bus is busy.
+static ret_code_t start_next_transfer(nrf_spi_mngr_t const * p_nrf_spi_mngr)
+{
+    nrf_spi_mngr_cb_t * p_cb = p_nrf_spi_mngr->p_nrf_spi_mngr_cb;
+
+    ret_code_t result = transfer_start(p_nrf_spi_mngr, &p_cb->next_transfer);
+    if (result == NRF_SUCCESS)
+    {
+        // use a local variable to avoid using two volatile variables in one
+        // expression
+        uint16_t curr_transfer_idx = p_cb->current_transfer_idx + 1;
+
+        p_cb->current_transfer_idx = curr_transfer_idx;
+        p_cb->next_transfer_ready  = transfer_get(p_cb->p_current_transaction,
+                                                  curr_transfer_idx + 1,
+                                                  &p_cb->next_transfer);
+    }
+    return result;
+}
+
+
 static void transaction_begin_signal(nrf_spi_mngr_t const * p_nrf_spi_mngr)
 {
     ASSERT(p_nrf_spi_mngr != NULL);
@@ -82,18 +154,15 @@ static void transaction_begin_signal(nrf_spi_mngr_t const * p_nrf_spi_mngr)
 }
 
 
-static void transaction_end_signal(nrf_spi_mngr_t const * p_nrf_spi_mngr,
-                                   ret_code_t             result)
+static void transaction_end_signal(nrf_spi_mngr_transaction_t const * p_transaction,
+                                   ret_code_t                         result)
 {
-    ASSERT(p_nrf_spi_mngr != NULL);
-
-    nrf_spi_mngr_transaction_t const * p_current_transaction =
-        p_nrf_spi_mngr->p_nrf_spi_mngr_cb->p_current_transaction;
+    ASSERT(p_transaction != NULL);
 
-    if (p_current_transaction->end_callback != NULL)
+    if (p_transaction->end_callback != NULL)
     {
-        void * p_user_data = p_current_transaction->p_user_data;
-        p_current_transaction->end_callback(result, p_user_data);
+        void * p_user_data = p_transaction->p_user_data;
+        p_transaction->end_callback(result, p_user_data);
     }
 }
 
@@ -161,11 +230,10 @@ static void start_pending_transaction(nrf_spi_mngr_t const * p_nrf_spi_mngr,
             p_cb->p_current_configuration = p_instance_cfg;
         }
 
-        // Try to start first transfer for this new transaction.
-        p_cb->current_transfer_idx = 0;
-
         // Execute user code if available before starting transaction
         transaction_begin_signal(p_nrf_spi_mngr);
+
+        // Try to start first transfer for this new transaction.
         result = start_transfer(p_nrf_spi_mngr);
 
         // If transaction started successfully there is nothing more to do here now.
@@ -177,13 +245,66 @@ static void start_pending_transaction(nrf_spi_mngr_t const * p_nrf_spi_mngr,
         // Transfer failed to start - notify user that this transaction
         // cannot be started and try with next one (in next iteration of
         // the loop).
-        transaction_end_signal(p_nrf_spi_mngr, result);
+        transaction_end_signal(p_cb->p_current_transaction, result);
 
         switch_transaction = true;
     }
 }
 
 
+#if NRF_SPI_MNGR_STREAMING_ENABLED
+// This function starts the next queued transaction right after the last transfer of the current
+// one, before its end callback, so the bus does not wait for the callback. It is only done when
+// no chip select has to change in between: neither transaction has a begin callback, and the
+// next one uses the current configuration. Returns false if the next transaction was not
+// started and the current one is still to be ended.
+static bool chain_pending_transaction(nrf_spi_mngr_t const * p_nrf_spi_mngr)
+{
+    nrf_spi_mngr_cb_t *                p_cb    = p_nrf_spi_mngr->p_nrf_spi_mngr_cb;
+    nrf_spi_mngr_transaction_t const * p_ended = p_cb->p_current_transaction;
+    nrf_spi_mngr_transaction_t const * p_next;
+    bool                               chain   = false;
+
+    if (p_ended->begin_callback != NULL)
+    {
+        return false;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if ((nrf_queue_peek(p_nrf_spi_mngr->p_queue, (void *)(&p_next)) == NRF_SUCCESS) &&
+        (p_next->begin_callback == NULL))
+    {
+        nrf_drv_spi_config_t const * p_next_cfg = (p_next->p_required_spi_cfg == NULL) ?
+                                                  &p_cb->default_configuration :
+                                                  p_next->p_required_spi_cfg;
+
+        if (memcmp(p_cb->p_current_configuration, p_next_cfg, sizeof(*p_next_cfg)) == 0)
+        {
+            UNUSED_RETURN_VALUE(nrf_queue_pop(p_nrf_spi_mngr->p_queue, (void *)(&p_next)));
+            p_cb->p_current_transaction = p_next;
+            chain = true;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    ret_code_t result = start_transfer(p_nrf_spi_mngr);
+
+    transaction_end_signal(p_ended, NRF_SUCCESS);
+    if (result != NRF_SUCCESS)
+    {
+        transaction_end_signal(p_next, result);
+        start_pending_transaction(p_nrf_spi_mngr, true);
+    }
+    return true;
+}
+#endif // NRF_SPI_MNGR_STREAMING_ENABLED
+
+
 // This function shall be called to handle SPI events. It shall be mainly used by SPI IRQ for
 // finished tranfer.
 static void spi_event_handler(nrf_drv_spi_evt_t const * p_event,
@@ -203,16 +324,11 @@ static void spi_event_handler(nrf_drv_spi_evt_t const * p_event,
         result = NRF_SUCCESS;
 
         // Transfer finished successfully. If there is another one to be
-        // performed in the current transaction, start it now.
-        // use a local variable to avoid using two volatile variables in one
-        // expression
-        uint8_t curr_transfer_idx = p_cb->current_transfer_idx;
-        ++curr_transfer_idx;
-        if (curr_transfer_idx < p_cb->p_current_transaction->number_of_transfers)
+        // performed in the current transaction, start it now. Its descriptor
+        // was prepared while this one was running.
+        if (p_cb->next_transfer_ready)
         {
-            p_cb->current_transfer_idx = curr_transfer_idx;
-
-            result = start_transfer(((nrf_spi_mngr_t const *)p_context));
+            result = start_next_transfer((nrf_spi_mngr_t const *)p_context);
 
             if (result == NRF_SUCCESS)
             {
@@ -223,6 +339,14 @@ static void spi_event_handler(nrf_drv_spi_evt_t const * p_event,
             // if the next transfer could not be started due to some error
             // we finish the transaction with this error code as the result
         }
+#if NRF_SPI_MNGR_STREAMING_ENABLED
+        else if (chain_pending_transaction((nrf_spi_mngr_t const *)p_context))
+        {
+            // The next transaction is running and the current one has been
+            // ended.
+            return;
+        }
+#endif
     }
     else
     {
@@ -231,7 +355,7 @@ static void spi_event_handler(nrf_drv_spi_evt_t const * p_event,
 
     // The current transaction has been completed or interrupted by some error.
     // Notify the user and start next one (if there is any).
-    transaction_end_signal(((nrf_spi_mngr_t const *)p_context), result);
+    transaction_end_signal(p_cb->p_current_transaction, result);
     // we switch transactions here ('p_nrf_spi_mngr->p_current_transaction' is set
     // to NULL only if there is nothing more to do) in order to not generate
     // spurious idle status (even for a moment)
@@ -297,6 +421,62 @@ ret_code_t nrf_spi_mngr_schedule(nrf_spi_mngr_t const *             p_nrf_spi_mn
 }
 
 
+static void bulk_read_begin(void * p_user_data)
+{
+    nrf_spi_mngr_bulk_t const * p_bulk = (nrf_spi_mngr_bulk_t const *)p_user_data;
+
+    p_bulk->begin_callback(p_bulk->p_user_data);
+}
+
+
+static void bulk_read_end(ret_code_t result, void * p_user_data)
+{
+    nrf_spi_mngr_bulk_t const * p_bulk = (nrf_spi_mngr_bulk_t const *)p_user_data;
+
+    if (p_bulk->end_callback != NULL)
+    {
+        p_bulk->end_callback(result, p_bulk->p_user_data);
+    }
+}
+
+
+ret_code_t nrf_spi_mngr_bulk_read(nrf_spi_mngr_t const * p_nrf_spi_mngr,
+                                  nrf_spi_mngr_bulk_t *  p_bulk)
+{
+    ASSERT(p_nrf_spi_mngr != NULL);
+    ASSERT(p_bulk != NULL);
+    ASSERT(p_bulk->p_data != NULL);
+
+    // The command is transfer 0 and the index of a transfer is 16 bits.
+    if ((p_bulk->cmd_length == 0) || (p_bulk->length == 0) || (p_bulk->chunk_size == 0) ||
+        ((p_bulk->length - 1) / p_bulk->chunk_size >= UINT16_MAX - 1))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_bulk->transaction = (nrf_spi_mngr_transaction_t)
+    {
+        .begin_callback      = (p_bulk->begin_callback != NULL) ? bulk_read_begin : NULL,
+        .end_callback        = bulk_read_end,
+        .p_user_data         = (void *)p_bulk,
+        .p_transfers         = NULL,
+        .number_of_transfers = 0,
+        .p_required_spi_cfg  = p_bulk->p_required_spi_cfg
+    };
+
+    // Scheduled like any transaction, but it has no transfer array.
+    nrf_spi_mngr_transaction_t const * p_transaction = &p_bulk->transaction;
+
+    ret_code_t result = nrf_queue_push(p_nrf_spi_mngr->p_queue, (void *)(&p_transaction));
+    if (result == NRF_SUCCESS)
+    {
+        start_pending_transaction(p_nrf_spi_mngr, false);
+    }
+
+    return result;
+}
+
+
 static void spi_internal_transaction_cb(ret_code_t result, void * p_user_data)
 {
     nrf_spi_mngr_cb_data_t * p_cb_data = (nrf_spi_mngr_cb_data_t *)p_user_data;
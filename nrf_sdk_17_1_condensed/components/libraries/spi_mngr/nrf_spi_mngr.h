@@ -143,6 +143,51 @@ typedef struct
 } nrf_spi_mngr_transaction_t;
 
 
+/**
+ * @brief SPI bulk read descriptor.
+ *
+ * A bulk read sends a read command, then reads @ref length bytes as receive-only transfers of
+ * @ref chunk_size bytes, the largest a DMA transfer of the driver takes. The descriptors of the
+ * transfers are made as the read goes, so a read of any length needs no transfer array.
+ * Chip select must stay active for the whole read: control it with the callbacks and set the
+ * SS pin of the configuration to @ref NRF_DRV_SPI_PIN_NOT_USED.
+ *
+ * The descriptor must stay valid until @ref end_callback is called.
+ */
+typedef struct
+{
+    nrf_spi_mngr_transaction_t      transaction;
+    ///< Set up by @ref nrf_spi_mngr_bulk_read.
+
+    nrf_spi_mngr_callback_begin_t   begin_callback;
+    ///< User-specified function to be called before the command is sent.
+
+    nrf_spi_mngr_callback_end_t     end_callback;
+    ///< User-specified function to be called after the last chunk is read.
+
+    void *                          p_user_data;
+    ///< Pointer to user data to be passed to the callbacks.
+
+    uint8_t const *                 p_cmd;
+    ///< Pointer to the read command, for example an opcode and an address.
+
+    uint8_t                         cmd_length;
+    ///< Number of bytes of the command.
+
+    uint8_t *                       p_data;
+    ///< Pointer to a buffer for the data read.
+
+    uint32_t                        length;
+    ///< Number of bytes to read.
+
+    uint8_t                         chunk_size;
+    ///< Number of bytes read by each transfer.
+
+    nrf_drv_spi_config_t const *    p_required_spi_cfg;
+    ///< Pointer to instance hardware configuration.
+} nrf_spi_mngr_bulk_t;
+
+
 /**
  * @brief SPI instance control block.
  */
@@ -157,8 +202,14 @@ typedef struct
     nrf_drv_spi_config_t const *                p_current_configuration;
     ///< Pointer to current hardware configuration.
 
-    uint8_t volatile                            current_transfer_idx;
+    uint16_t volatile                           current_transfer_idx;
     ///< Index of currently performed transfer (within current transaction).
+
+    nrf_spi_mngr_transfer_t                     next_transfer;
+    ///< Descriptor of the transfer that follows the current one, prepared in advance.
+
+    bool volatile                               next_transfer_ready;
+    ///< The current transaction has a next transfer.
 } nrf_spi_mngr_cb_t;
 
 
@@ -246,6 +297,12 @@ void nrf_spi_mngr_uninit(nrf_spi_mngr_t const * p_nrf_spi_mngr);
  *       If @ref nrf_spi_mngr_transaction_t::p_required_spi_cfg is set to NULL then
  *       it will treat it as it would be set to @ref nrf_spi_mngr_cb_t::default_configuration.
  *
+ * @note With NRF_SPI_MNGR_STREAMING_ENABLED, when a transaction ends and the next one in the
+ *       queue uses the same configuration, and neither has a begin callback, the first transfer
+ *       of the next one is started before the end callback of the first one is called. The bus
+ *       then does not wait for the callback. The end callback must not change the data of
+ *       transactions already scheduled.
+ *
  * @param[in] p_nrf_spi_mngr    Pointer to the SPI transaction manager instance.
  * @param[in] p_transaction     Pointer to the descriptor of the transaction to be
  *                              scheduled.
@@ -284,6 +341,26 @@ ret_code_t nrf_spi_mngr_perform(nrf_spi_mngr_t const *          p_nrf_spi_mngr,
                                 void                            (* user_function)(void));
 
 
+/**
+ * @brief Function for scheduling a bulk read.
+ *
+ * The read is scheduled as one transaction: the command, then the chunks. It is started as soon
+ * as the SPI bus is available, like any transaction.
+ *
+ * @param[in] p_nrf_spi_mngr    Pointer to the SPI transaction manager instance.
+ * @param[in] p_bulk            Pointer to the descriptor of the read, with all fields but
+ *                              @ref nrf_spi_mngr_bulk_t::transaction set.
+ *
+ * @retval NRF_SUCCESS              If the read has been successfully scheduled.
+ * @retval NRF_ERROR_INVALID_LENGTH If the command, the length or the chunk size is 0, or the read
+ *                                  needs more than 65534 chunks.
+ * @retval NRF_ERROR_NO_MEM         If the queue is full (Only if queue in
+ *                                  @ref NRF_QUEUE_MODE_NO_OVERFLOW).
+ */
+ret_code_t nrf_spi_mngr_bulk_read(nrf_spi_mngr_t const * p_nrf_spi_mngr,
+                                  nrf_spi_mngr_bulk_t *  p_bulk);
+
+
 /**
  * @brief Function for getting the current state of an SPI transaction manager
  *        instance.
@@ -38,7 +38,7 @@
  *
  */
 #include "sdk_common.h"
-#if NRF_MODULE_ENABLED(APP_TIMER)
+#if NRF_MODULE_ENABLED(APP_TIMER) && !APP_TIMER_CONFIG_FREERTOS_WHEEL
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
@@ -240,4 +240,4 @@ uint32_t app_timer_stop(app_timer_id_t timer_id)
     pinfo->active = false;
     return NRF_SUCCESS;
 }
-#endif //NRF_MODULE_ENABLED(APP_TIMER)
+#endif //NRF_MODULE_ENABLED(APP_TIMER) && !APP_TIMER_CONFIG_FREERTOS_WHEEL
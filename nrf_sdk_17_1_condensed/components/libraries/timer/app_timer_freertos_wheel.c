@@ -0,0 +1,599 @@
+/**
+ * Copyright (c) 2014 - 2021, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(APP_TIMER) && APP_TIMER_CONFIG_FREERTOS_WHEEL
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "app_timer.h"
+#include <stdlib.h>
+#include <string.h>
+#include "nrf.h"
+#include "nrfx_rtc.h"
+#include "app_error.h"
+#include "app_util_platform.h"
+
+/**
+ * Hierarchical timing wheel variant of app_timer for FreeRTOS.
+ *
+ * All app timers live in one wheel of APP_TIMER_WHEEL_LEVELS levels with
+ * APP_TIMER_WHEEL_SLOTS slots each, driven by a single compare channel of
+ * a dedicated RTC running at configTICK_RATE_HZ, so app_timer ticks keep
+ * the meaning of APP_TIMER_TICKS() in the FreeRTOS build. Start and stop
+ * only link or unlink the timer node, no FreeRTOS timer command is queued
+ * and no memory is allocated.
+ *
+ * The RTC interrupt pends one call to the timer daemon task per expiry
+ * batch. Timeout handlers are therefore called from the timer task, as
+ * with the xTimerCreate based variant.
+ *
+ * The compare is armed for the next expiry only. A slot of an upper level
+ * is cascaded at the earliest expiry it holds rather than at its start, so
+ * the wheel does not wake the CPU when no timer is due: it wakes as often
+ * as the xTimerCreate based variant, the gain is the cost of start and stop.
+ */
+/* Check if RTC FreeRTOS version is used */
+#if configTICK_SOURCE != FREERTOS_USE_RTC
+#error app_timer in FreeRTOS variant have to be used with RTC tick source configuration. Default configuration have to be used in other case.
+#endif
+
+/* Check if freeRTOS timers are activated */
+#if configUSE_TIMERS == 0
+    #error app_timer for freeRTOS requires configUSE_TIMERS option to be activated.
+#endif
+
+#if INCLUDE_xTimerPendFunctionCall == 0
+    #error app_timer wheel for freeRTOS requires INCLUDE_xTimerPendFunctionCall option to be activated.
+#endif
+
+#define APP_TIMER_WHEEL_SLOT_BITS   6                                           /**< Number of time bits resolved by one wheel level. */
+#define APP_TIMER_WHEEL_SLOTS       (1UL << APP_TIMER_WHEEL_SLOT_BITS)          /**< Number of slots in one wheel level. */
+#define APP_TIMER_WHEEL_SLOT_MASK   (APP_TIMER_WHEEL_SLOTS - 1)
+#define APP_TIMER_WHEEL_LEVELS      4                                           /**< Number of wheel levels, together they cover the 24-bit RTC counter. */
+#define APP_TIMER_WHEEL_RTC_MASK    RTC_COUNTER_COUNTER_Msk                     /**< Width of the RTC counter. */
+#define APP_TIMER_WHEEL_MAX_TIMEOUT (1UL << 23)                                 /**< Longest accepted timeout, in ticks. */
+#define APP_TIMER_WHEEL_MAX_SLEEP   (1UL << 22)                                 /**< Longest time the RTC compare is armed ahead, in ticks. */
+#define APP_TIMER_WHEEL_MIN_DELAY   2                                           /**< Closest compare value that is guaranteed to generate an event. */
+#define APP_TIMER_WHEEL_RTC_CC      0                                           /**< RTC compare channel used by the wheel. */
+
+/**@brief This structure keeps information about one wheel timer.*/
+typedef struct app_timer_node_s
+{
+    struct app_timer_node_s   * p_next;
+    struct app_timer_node_s   * p_prev;
+    /**
+     * Head of the list the timer is linked on, NULL when the timer is not running.
+     * It is either a wheel slot or the list of timers expired in the current batch. */
+    struct app_timer_node_s  ** pp_list;
+    app_timer_timeout_handler_t func;
+    void                      * argument;
+    uint32_t                    expire;      /**< Wheel time at which the timer expires. */
+    uint32_t                    period;      /**< Reload value, 0 for single shot timers. */
+    bool                        single_shot;
+}app_timer_info_t;
+
+/**@brief Wheel state shared by the API functions and the expiry handler. */
+typedef struct
+{
+    app_timer_info_t * p_slots[APP_TIMER_WHEEL_LEVELS][APP_TIMER_WHEEL_SLOTS];
+    /**
+     * Earliest expiry in each slot of the upper levels, the time the slot is cascaded at.
+     * It is not raised when that timer stops, the slot is then cascaded early. */
+    uint32_t           first[APP_TIMER_WHEEL_LEVELS - 1][APP_TIMER_WHEEL_SLOTS];
+    uint64_t           occupied[APP_TIMER_WHEEL_LEVELS];  /**< One bit per non-empty slot. */
+    app_timer_info_t * p_expired;                         /**< Timers expired in the batch being processed. */
+    uint32_t           now;                               /**< Wheel time up to which all slots were processed. */
+    uint32_t           wakeup;                            /**< Wheel time the RTC compare is armed for. */
+    uint32_t           active;                            /**< Number of running timers. */
+    bool               armed;                             /**< RTC compare is armed. */
+    bool               pending;                           /**< Expiry batch is queued for the timer task. */
+}app_timer_wheel_t;
+
+/* Check if app_timer_t variable type can held our app_timer_info_t structure */
+STATIC_ASSERT(sizeof(app_timer_info_t) <= sizeof(app_timer_t));
+
+/* The wheel runs at the FreeRTOS tick rate, which must be derived from the 32768 Hz LFCLK */
+STATIC_ASSERT((APP_TIMER_CLOCK_FREQ % configTICK_RATE_HZ) == 0);
+
+static const nrfx_rtc_t  m_rtc = NRFX_RTC_INSTANCE(APP_TIMER_WHEEL_CONFIG_RTC_INSTANCE);
+static app_timer_wheel_t m_wheel;
+
+
+/**
+ * @brief Signed distance between two wheel times
+ */
+static inline int32_t wheel_diff(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b);
+}
+
+
+/**
+ * @brief Current time extended from the 24-bit RTC counter to the 32-bit wheel time
+ *
+ * Valid as long as the wheel is processed at least every 2^24 ticks, which
+ * APP_TIMER_WHEEL_MAX_SLEEP guarantees while any timer is running.
+ */
+static uint32_t wheel_time_get(void)
+{
+    uint32_t counter = nrfx_rtc_counter_get(&m_rtc);
+    return m_wheel.now + ((counter - m_wheel.now) & APP_TIMER_WHEEL_RTC_MASK);
+}
+
+
+static void wheel_list_add(app_timer_info_t ** pp_list, app_timer_info_t * pinfo)
+{
+    pinfo->pp_list = pp_list;
+    pinfo->p_prev  = NULL;
+    pinfo->p_next  = *pp_list;
+    if (*pp_list != NULL)
+    {
+        (*pp_list)->p_prev = pinfo;
+    }
+    *pp_list = pinfo;
+}
+
+
+/**
+ * @brief Unlinks a running timer from its slot or from the expired list
+ */
+static void wheel_remove(app_timer_info_t * pinfo)
+{
+    app_timer_info_t ** pp_list = pinfo->pp_list;
+
+    if (pinfo->p_next != NULL)
+    {
+        pinfo->p_next->p_prev = pinfo->p_prev;
+    }
+    if (pinfo->p_prev != NULL)
+    {
+        pinfo->p_prev->p_next = pinfo->p_next;
+    }
+    else
+    {
+        *pp_list = pinfo->p_next;
+    }
+
+    if ((*pp_list == NULL) && (pp_list != &m_wheel.p_expired))
+    {
+        uint32_t index = (uint32_t)(pp_list - &m_wheel.p_slots[0][0]);
+        m_wheel.occupied[index / APP_TIMER_WHEEL_SLOTS] &=
+            ~(1ULL << (index % APP_TIMER_WHEEL_SLOTS));
+    }
+
+    pinfo->pp_list = NULL;
+    m_wheel.active--;
+}
+
+
+/**
+ * @brief Links a timer into the slot matching its distance from the wheel time
+ *
+ * A timer expiring less than 64^(n+1) ticks ahead goes to level n, in the slot
+ * selected by its expiry time bits of that level. It is moved to a lower level
+ * when the wheel time reaches the earliest expiry of that slot.
+ */
+static void wheel_insert(app_timer_info_t * pinfo)
+{
+    uint32_t delta = pinfo->expire - m_wheel.now;
+    uint32_t level = 0;
+
+    while ((level < (APP_TIMER_WHEEL_LEVELS - 1)) &&
+           (delta >= (1UL << ((level + 1) * APP_TIMER_WHEEL_SLOT_BITS))))
+    {
+        level++;
+    }
+
+    uint32_t slot = (pinfo->expire >> (level * APP_TIMER_WHEEL_SLOT_BITS)) & APP_TIMER_WHEEL_SLOT_MASK;
+
+    if ((level > 0) &&
+        (!(m_wheel.occupied[level] & (1ULL << slot)) ||
+         (wheel_diff(pinfo->expire, m_wheel.first[level - 1][slot]) < 0)))
+    {
+        m_wheel.first[level - 1][slot] = pinfo->expire;
+    }
+
+    wheel_list_add(&m_wheel.p_slots[level][slot], pinfo);
+    m_wheel.occupied[level] |= (1ULL << slot);
+    m_wheel.active++;
+}
+
+
+/**
+ * @brief Finds the next wheel time at which a slot has to be expired or cascaded
+ *
+ * @param[out] p_time Wheel time of the next event.
+ *
+ * @return False if the wheel is empty.
+ */
+static bool wheel_next_event(uint32_t * p_time)
+{
+    bool found = false;
+
+    for (uint32_t level = 0; level < APP_TIMER_WHEEL_LEVELS; level++)
+    {
+        uint64_t occupied = m_wheel.occupied[level];
+        if (occupied == 0)
+        {
+            continue;
+        }
+
+        uint32_t shift = level * APP_TIMER_WHEEL_SLOT_BITS;
+        uint32_t base  = m_wheel.now >> shift;
+        uint32_t first = (base + 1) & APP_TIMER_WHEEL_SLOT_MASK;
+
+        /* Rotate so that bit 0 is the slot one step after the current one */
+        if (first != 0)
+        {
+            occupied = (occupied >> first) | (occupied << (APP_TIMER_WHEEL_SLOTS - first));
+        }
+
+        uint32_t step = (uint32_t)__builtin_ctzll(occupied);
+        uint32_t time = (base + 1 + step) << shift;
+
+        if (level > 0)
+        {
+            /* The slots after the current one are in time order. The current one, not cascaded
+             * yet, holds timers due in this turn of the level or in the next one. */
+            uint32_t current = base & APP_TIMER_WHEEL_SLOT_MASK;
+
+            time = m_wheel.first[level - 1][(first + step) & APP_TIMER_WHEEL_SLOT_MASK];
+            if ((m_wheel.occupied[level] & (1ULL << current)) &&
+                (wheel_diff(m_wheel.first[level - 1][current], time) < 0))
+            {
+                time = m_wheel.first[level - 1][current];
+            }
+        }
+
+        if (!found || (wheel_diff(time, *p_time) < 0))
+        {
+            *p_time = time;
+            found   = true;
+        }
+    }
+
+    return found;
+}
+
+
+/**
+ * @brief Advances the wheel time to the next wheel event
+ *
+ * Slots of the upper levels whose earliest expiry is reached are cascaded, then
+ * the level 0 slot is moved to the expired list.
+ */
+static void wheel_advance(uint32_t time)
+{
+    m_wheel.now = time;
+
+    for (uint32_t level = APP_TIMER_WHEEL_LEVELS - 1; level > 0; level--)
+    {
+        uint32_t shift = level * APP_TIMER_WHEEL_SLOT_BITS;
+        uint32_t slot  = (time >> shift) & APP_TIMER_WHEEL_SLOT_MASK;
+
+        if (!(m_wheel.occupied[level] & (1ULL << slot)) ||
+            (wheel_diff(m_wheel.first[level - 1][slot], time) > 0))
+        {
+            continue;
+        }
+
+        app_timer_info_t * pinfo = m_wheel.p_slots[level][slot];
+        m_wheel.p_slots[level][slot] = NULL;
+        m_wheel.occupied[level] &= ~(1ULL << slot);
+
+        while (pinfo != NULL)
+        {
+            app_timer_info_t * p_next = pinfo->p_next;
+            m_wheel.active--;
+            wheel_insert(pinfo);
+            pinfo = p_next;
+        }
+    }
+
+    uint32_t slot = time & APP_TIMER_WHEEL_SLOT_MASK;
+    if (m_wheel.occupied[0] & (1ULL << slot))
+    {
+        app_timer_info_t * pinfo = m_wheel.p_slots[0][slot];
+        m_wheel.p_slots[0][slot] = NULL;
+        m_wheel.occupied[0] &= ~(1ULL << slot);
+
+        while (pinfo != NULL)
+        {
+            app_timer_info_t * p_next = pinfo->p_next;
+            wheel_list_add(&m_wheel.p_expired, pinfo);
+            pinfo = p_next;
+        }
+    }
+}
+
+
+/**
+ * @brief Programs the RTC compare for the next wheel event
+ *
+ * Must be called inside a critical region. The compare is never armed further
+ * than APP_TIMER_WHEEL_MAX_SLEEP ahead, so the wheel time keeps track of the
+ * 24-bit counter, and never closer than APP_TIMER_WHEEL_MIN_DELAY, so the event
+ * cannot be missed.
+ */
+static void wheel_rearm(void)
+{
+    uint32_t next;
+
+    if (m_wheel.pending)
+    {
+        /* Expiry batch in progress, rearmed when it completes */
+        return;
+    }
+
+    if (!wheel_next_event(&next))
+    {
+        if (m_wheel.armed)
+        {
+            (void)nrfx_rtc_cc_disable(&m_rtc, APP_TIMER_WHEEL_RTC_CC);
+            m_wheel.armed = false;
+        }
+        return;
+    }
+
+    uint32_t now = wheel_time_get();
+    if (wheel_diff(next, now + APP_TIMER_WHEEL_MAX_SLEEP) > 0)
+    {
+        next = now + APP_TIMER_WHEEL_MAX_SLEEP;
+    }
+    if (wheel_diff(next, now + APP_TIMER_WHEEL_MIN_DELAY) < 0)
+    {
+        next = now + APP_TIMER_WHEEL_MIN_DELAY;
+    }
+
+    if (m_wheel.armed && (m_wheel.wakeup == next))
+    {
+        return;
+    }
+
+    m_wheel.wakeup = next;
+    m_wheel.armed  = true;
+    (void)nrfx_rtc_cc_set(&m_rtc, APP_TIMER_WHEEL_RTC_CC, next & APP_TIMER_WHEEL_RTC_MASK, true);
+}
+
+
+/**
+ * @brief Expiry batch, executed by the timer task
+ *
+ * Catches the wheel up with the RTC counter and calls the handlers of all
+ * timers expired on the way. Periodic timers are reinserted before their
+ * handler is called, so the handler may stop or restart them.
+ */
+static void app_timer_process(void * p_param1, uint32_t param2)
+{
+    UNUSED_PARAMETER(p_param1);
+    UNUSED_PARAMETER(param2);
+
+    uint32_t next;
+
+    CRITICAL_REGION_ENTER();
+    uint32_t now = wheel_time_get();
+    while (wheel_next_event(&next) && (wheel_diff(next, now) <= 0))
+    {
+        wheel_advance(next);
+    }
+    m_wheel.now = now;
+    CRITICAL_REGION_EXIT();
+
+    for (;;)
+    {
+        app_timer_timeout_handler_t func = NULL;
+        void *                      argument = NULL;
+
+        CRITICAL_REGION_ENTER();
+        app_timer_info_t * pinfo = m_wheel.p_expired;
+        if (pinfo != NULL)
+        {
+            wheel_remove(pinfo);
+            func     = pinfo->func;
+            argument = pinfo->argument;
+
+            if (!pinfo->single_shot)
+            {
+                pinfo->expire += pinfo->period;
+                if (wheel_diff(pinfo->expire, m_wheel.now) <= 0)
+                {
+                    /* Fell behind, skip the missed periods */
+                    pinfo->expire = m_wheel.now + pinfo->period;
+                }
+                wheel_insert(pinfo);
+            }
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (func == NULL)
+        {
+            break;
+        }
+        func(argument);
+    }
+
+    CRITICAL_REGION_ENTER();
+    m_wheel.pending = false;
+    wheel_rearm();
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**
+ * @brief RTC compare handler
+ *
+ * Defers the expiry batch to the timer task. If the timer command queue is
+ * full the compare is rearmed and the request is retried on the next event.
+ */
+static void rtc_handler(nrfx_rtc_int_type_t int_type)
+{
+    BaseType_t yieldReq = pdFALSE;
+
+    if (int_type != (nrfx_rtc_int_type_t)APP_TIMER_WHEEL_RTC_CC)
+    {
+        return;
+    }
+
+    CRITICAL_REGION_ENTER();
+    m_wheel.armed = false;
+    if (!m_wheel.pending)
+    {
+        if (xTimerPendFunctionCallFromISR(app_timer_process, NULL, 0, &yieldReq) == pdPASS)
+        {
+            m_wheel.pending = true;
+        }
+        else
+        {
+            wheel_rearm();
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    portYIELD_FROM_ISR(yieldReq);
+}
+
+
+uint32_t app_timer_init(void)
+{
+    nrfx_err_t        err_code;
+    nrfx_rtc_config_t config = NRFX_RTC_DEFAULT_CONFIG;
+
+    memset(&m_wheel, 0, sizeof(m_wheel));
+
+    config.prescaler          = RTC_FREQ_TO_PRESCALER(configTICK_RATE_HZ);
+    config.interrupt_priority = APP_TIMER_CONFIG_IRQ_PRIORITY;
+    config.reliable           = false;
+
+    err_code = nrfx_rtc_init(&m_rtc, &config, rtc_handler);
+    if (err_code != NRFX_SUCCESS)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    nrfx_rtc_enable(&m_rtc);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_create(app_timer_id_t const *      p_timer_id,
+                          app_timer_mode_t            mode,
+                          app_timer_timeout_handler_t timeout_handler)
+{
+    if ((timeout_handler == NULL) || (p_timer_id == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    app_timer_info_t * pinfo = (app_timer_info_t*)(*p_timer_id);
+
+    if (pinfo->func != NULL)
+    {
+        /* Keep the behaviour of the xTimerCreate based variant */
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    memset(pinfo, 0, sizeof(app_timer_info_t));
+    pinfo->single_shot = (mode == APP_TIMER_MODE_SINGLE_SHOT);
+    pinfo->func        = timeout_handler;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    app_timer_info_t * pinfo = (app_timer_info_t*)(timer_id);
+
+    if (pinfo->func == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if ((timeout_ticks == 0) || (timeout_ticks > APP_TIMER_WHEEL_MAX_TIMEOUT))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (pinfo->pp_list == NULL)
+    {
+        if (m_wheel.active == 0)
+        {
+            /* Nothing tracked the counter while the wheel was empty */
+            m_wheel.now = wheel_time_get();
+        }
+
+        pinfo->argument = p_context;
+        pinfo->period   = pinfo->single_shot ? 0 : timeout_ticks;
+        pinfo->expire   = wheel_time_get() + timeout_ticks;
+        wheel_insert(pinfo);
+
+        if (!m_wheel.armed || (wheel_diff(pinfo->expire, m_wheel.wakeup) < 0))
+        {
+            wheel_rearm();
+        }
+    }
+    // Timer already running - exit silently
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_timer_stop(app_timer_id_t timer_id)
+{
+    app_timer_info_t * pinfo = (app_timer_info_t*)(timer_id);
+
+    if (pinfo->func == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (pinfo->pp_list != NULL)
+    {
+        /* The compare stays armed, an early wakeup finds nothing to expire */
+        wheel_remove(pinfo);
+    }
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+#endif //NRF_MODULE_ENABLED(APP_TIMER) && APP_TIMER_CONFIG_FREERTOS_WHEEL
@@ -52,6 +52,7 @@
 #include "retarget.h"
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include "app_uart.h"
 #include "nrf_error.h"
 #include "nrf_delay.h"
@@ -60,6 +61,13 @@
 nrf_libuarte_async_t * debug_uart;
 volatile bool *txDone;
 
+#if RETARGET_TX_BATCH_ENABLED
+/* Two halves of a DMA-capable (RAM) transmit buffer. One half is filled while the other one is
+ * being sent by libuarte. The TX done event handled in uart_helper releases the half in flight. */
+static uint8_t m_tx_batch_buf[2][RETARGET_TX_BATCH_SIZE];
+static uint8_t m_tx_batch_idx;
+#endif
+
 #ifdef FREERTOS
 #include "FreeRTOS.h"
 #include "semphr.h"
@@ -67,14 +75,14 @@ volatile bool *txDone;
 SemaphoreHandle_t txSemaphore;
 SemaphoreHandle_t txLockSemaphore;
 void retarget_init(const nrf_libuarte_async_t * const p_libuarte, SemaphoreHandle_t dbg_tx_semaphore, SemaphoreHandle_t dbg_tx_lock_semaphore, volatile bool *tx_done){
-    debug_uart = p_libuarte;
+    debug_uart = (nrf_libuarte_async_t *)p_libuarte;
     txSemaphore = dbg_tx_semaphore;
     txLockSemaphore = dbg_tx_lock_semaphore;
     txDone = tx_done;
 }
 #else
 void retarget_init(const nrf_libuarte_async_t * const p_libuarte, bool* tx_done){
-    debug_uart = p_libuarte;
+    debug_uart = (nrf_libuarte_async_t *)p_libuarte;
     txDone = tx_done;
 }
 #endif
@@ -145,49 +153,139 @@ int __putchar(int ch, FILE * p_file)
 
 #elif defined(__GNUC__) && !defined(__SES_ARM)
 
+void retarget_write_polled(const char * p_char, size_t len)
+{
+    #if SEND_LOG_OVER_UART
+    #if RETARGET_TX_BATCH_ENABLED
+    for(size_t i = 0; i < len; ){
+        size_t    chunk = MIN(len - i, RETARGET_TX_BATCH_SIZE);
+        uint8_t * p_buf = m_tx_batch_buf[m_tx_batch_idx];
+
+        memcpy(p_buf, p_char + i, chunk);
+        while(*txDone == false){
+            //Wait for last TX transmission to complete
+        }
+        *txDone = false;
+        UNUSED_VARIABLE(nrf_libuarte_async_tx(debug_uart, p_buf, chunk));
+        m_tx_batch_idx ^= 1;
+        i += chunk;
+    }
+    #else
+    for(size_t i = 0; i < len; i++){
+        while(*txDone == false){
+            //Wait for last TX transmission to complete
+        }
+        *txDone = false;
+        UNUSED_VARIABLE(nrf_libuarte_async_tx(debug_uart, (uint8_t *)p_char + i, 1));
+    }
+    #endif // RETARGET_TX_BATCH_ENABLED
+    #endif
+}
+
+#if SEND_LOG_OVER_SWO
+static void swo_write(const char * p_char, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+            // SWO responds to the return character the
+            // same as a newline character, ignore return characters
+            if(*p_char != 13)
+            {
+                ITM_SendChar(*p_char);
+            }
+        p_char++;
+    }
+}
+#endif
+
 int _write(int file, const char * p_char, int len)
 {
     UNUSED_PARAMETER(file);
 
     #if SEND_LOG_OVER_UART
+    #if RETARGET_TX_BATCH_ENABLED
     #ifdef FREERTOS
     if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED){
         xSemaphoreTake(txLockSemaphore, portMAX_DELAY);
-        for(int i = 0; i < len; i++){
+        for(int i = 0; i < len; ){
+            size_t    chunk = MIN((size_t)(len - i), RETARGET_TX_BATCH_SIZE);
+            uint8_t * p_buf = m_tx_batch_buf[m_tx_batch_idx];
+
+            // Fill the free half while the previous chunk is still being transmitted.
+            memcpy(p_buf, p_char + i, chunk);
             xSemaphoreTake(txSemaphore, portMAX_DELAY);  //Semaphore is given back by the event handler in uart_helper.c in the ep-nrf repo
-            UNUSED_VARIABLE(nrf_libuarte_async_tx(debug_uart, p_char + i, 1));
+            UNUSED_VARIABLE(nrf_libuarte_async_tx(debug_uart, p_buf, chunk));
+            m_tx_batch_idx ^= 1;
+            i += chunk;
         }
         xSemaphoreGive(txLockSemaphore);
     }else{
     #endif
+        retarget_write_polled(p_char, len);
+    #ifdef FREERTOS
+    }
+    #endif
+    #else
+    #ifdef FREERTOS
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED){
+        xSemaphoreTake(txLockSemaphore, portMAX_DELAY);
         for(int i = 0; i < len; i++){
-            while(*txDone == false){
-                //Wait for last TX transmission to complete
-            }
-            *txDone = false;
-            UNUSED_VARIABLE(nrf_libuarte_async_tx(debug_uart, p_char + i, 1));
+            xSemaphoreTake(txSemaphore, portMAX_DELAY);  //Semaphore is given back by the event handler in uart_helper.c in the ep-nrf repo
+            UNUSED_VARIABLE(nrf_libuarte_async_tx(debug_uart, (uint8_t *)p_char + i, 1));
         }
+        xSemaphoreGive(txLockSemaphore);
+    }else{
+    #endif
+        retarget_write_polled(p_char, len);
     #ifdef FREERTOS
     }
     #endif
+    #endif // RETARGET_TX_BATCH_ENABLED
     #endif
     
     #if SEND_LOG_OVER_SWO
-    for (int i = 0; i < len; i++)
-    {
-            // SWO responds to the return character the
-            // same as a newline character, ignore return characters
-            if(*p_char != 13)
-            {
-                ITM_SendChar(*p_char);
-            }
-        p_char++;
-    }
+    swo_write(p_char, len);
     #endif
 
     return len;
 }
 
+#ifdef FREERTOS
+int retarget_writev(nrf_libuarte_async_data_t const * p_segments, size_t count)
+{
+    size_t len = 0;
+
+    for(size_t i = 0; i < count; i++){
+        len += p_segments[i].length;
+    }
+
+    #if SEND_LOG_OVER_UART
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED){
+        xSemaphoreTake(txLockSemaphore, portMAX_DELAY);
+        xSemaphoreTake(txSemaphore, portMAX_DELAY);  //Previous transfer done
+        if(nrf_libuarte_async_txv(debug_uart, p_segments, count) == NRF_SUCCESS){
+            // The segments belong to the caller again once the TX done event gave the semaphore back
+            xSemaphoreTake(txSemaphore, portMAX_DELAY);
+        }
+        xSemaphoreGive(txSemaphore);
+        xSemaphoreGive(txLockSemaphore);
+    }else{
+        for(size_t i = 0; i < count; i++){
+            retarget_write_polled((const char *)p_segments[i].p_data, p_segments[i].length);
+        }
+    }
+    #endif
+
+    #if SEND_LOG_OVER_SWO
+    for(size_t i = 0; i < count; i++){
+        swo_write((const char *)p_segments[i].p_data, p_segments[i].length);
+    }
+    #endif
+
+    return (int)len;
+}
+#endif
+
 int _read(int file, char * p_char, int len)
 {
     UNUSED_PARAMETER(file);
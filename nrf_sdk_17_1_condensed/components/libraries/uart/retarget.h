@@ -29,4 +29,29 @@ void retarget_init(const nrf_libuarte_async_t * const p_libuarte, SemaphoreHandl
 void retarget_init(const nrf_libuarte_async_t* const p_libuarte, bool *tx_done);
 
 #endif
+
+/**
+ * @brief Added by EP. Sends data on the debug uart without using the kernel, waiting for each
+ * transfer to complete, as _write does before the scheduler starts. Usable once the logger
+ * panicked. The debug uart must be initialized.
+ *
+ * @param p_char Data to send
+ * @param len    Number of bytes
+ */
+void retarget_write_polled(const char * p_char, size_t len);
+
+#ifdef FREERTOS
+/**
+ * @brief Added by EP. Sends several buffers on the debug uart as one scatter-gather transfer (see
+ * nrf_libuarte_async_txv), without copying them, and returns once they are sent. Writes of _write
+ * and other callers are not interleaved. Before the scheduler starts the buffers are sent as
+ * retarget_write_polled does.
+ *
+ * @param p_segments Buffers to send in order, in RAM as EasyDMA cannot read flash
+ * @param count      Number of buffers
+ * @return int Number of bytes sent
+ */
+int retarget_writev(nrf_libuarte_async_data_t const * p_segments, size_t count);
+#endif
+
 #endif
\ No newline at end of file
@@ -57,6 +57,36 @@ void nrf_fprintf_buffer_flush(nrf_fprintf_ctx_t * const p_ctx)
                   p_ctx->p_io_buffer,
                   p_ctx->io_buffer_cnt);
     p_ctx->io_buffer_cnt = 0;
+    p_ctx->pending = false;
+}
+
+void nrf_fprintf_buffer_flush_soft(nrf_fprintf_ctx_t * const p_ctx)
+{
+    ASSERT(p_ctx != NULL);
+
+    if (p_ctx->io_buffer_cnt >= p_ctx->flush_threshold)
+    {
+        nrf_fprintf_buffer_flush(p_ctx);
+    }
+}
+
+void nrf_fprintf_buffer_flush_stale(nrf_fprintf_ctx_t * const p_ctx, uint32_t timestamp)
+{
+    ASSERT(p_ctx != NULL);
+
+    if (p_ctx->io_buffer_cnt == 0)
+    {
+        p_ctx->pending = false;
+    }
+    else if (!p_ctx->pending)
+    {
+        p_ctx->pending       = true;
+        p_ctx->pending_since = timestamp;
+    }
+    else if ((uint32_t)(timestamp - p_ctx->pending_since) >= p_ctx->flush_timeout)
+    {
+        nrf_fprintf_buffer_flush(p_ctx);
+    }
 }
 
 void nrf_fprintf(nrf_fprintf_ctx_t * const p_ctx,
@@ -42,6 +42,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +63,11 @@ typedef struct nrf_fprintf_ctx
     void const * const p_user_ctx;  ///< Pointer to user data to be passed to the fwrite funciton.
 
     nrf_fprintf_fwrite fwrite;      ///< Pointer to function sending data stream.
+
+    size_t flush_threshold;         ///< Soft flushes send the IO buffer once it holds this many bytes, 0 sends it at every soft flush.
+    uint32_t flush_timeout;         ///< Age after which @ref nrf_fprintf_buffer_flush_stale sends the IO buffer, in the caller's time unit.
+    uint32_t pending_since;         ///< Time at which @ref nrf_fprintf_buffer_flush_stale first saw the IO buffer in use.
+    bool pending;                   ///< pending_since is valid.
 } nrf_fprintf_ctx_t;
 
 
@@ -105,6 +111,31 @@ void nrf_fprintf(nrf_fprintf_ctx_t * const p_ctx,
  */
 void nrf_fprintf_buffer_flush(nrf_fprintf_ctx_t * const p_ctx);
 
+/**
+ * @brief function flushing data stored in io_buffer once it holds at least flush_threshold bytes
+ * @ref nrf_fprintf_ctx_t
+ *
+ * Used in place of @ref nrf_fprintf_buffer_flush at the end of a line or of an auto_flush call,
+ * so that a context with a flush_threshold hands its output to fwrite in large chunks. With a
+ * flush_threshold of 0 it flushes like @ref nrf_fprintf_buffer_flush.
+ *
+ * @param p_ctx fprintf context
+ */
+void nrf_fprintf_buffer_flush_soft(nrf_fprintf_ctx_t * const p_ctx);
+
+/**
+ * @brief function flushing data held in io_buffer for at least flush_timeout
+ * @ref nrf_fprintf_ctx_t
+ *
+ * To be called periodically by the owner of a context with a flush_threshold, so that output
+ * below the threshold is not held back for long. The first call that finds data in the IO
+ * buffer records the time, a later call flushes once flush_timeout has elapsed since.
+ *
+ * @param p_ctx     fprintf context
+ * @param timestamp Current time, in the unit of flush_timeout.
+ */
+void nrf_fprintf_buffer_flush_stale(nrf_fprintf_ctx_t * const p_ctx, uint32_t timestamp);
+
 
 #ifdef __cplusplus
 }
@@ -106,51 +106,191 @@ static void buffer_add(nrf_fprintf_ctx_t * const p_ctx, char c)
     }
 }
 
+#if NRF_MODULE_ENABLED(NRF_FPRINTF_SPAN_COPY)
+
+/* Copies a span without LF, filling the IO buffer up to its end before each flush. */
+static void buffer_copy(nrf_fprintf_ctx_t * const p_ctx, char const * p_str, size_t len)
+{
+    size_t room = p_ctx->io_buffer_size - p_ctx->io_buffer_cnt;
+
+    while (len >= room)
+    {
+        memcpy(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], p_str, room);
+        p_ctx->io_buffer_cnt = p_ctx->io_buffer_size;
+        nrf_fprintf_buffer_flush(p_ctx);
+        p_str += room;
+        len   -= room;
+        room   = p_ctx->io_buffer_size;
+    }
+    memcpy(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], p_str, len);
+    p_ctx->io_buffer_cnt += len;
+}
+
+static void buffer_fill(nrf_fprintf_ctx_t * const p_ctx, char c, size_t count)
+{
+    size_t room = p_ctx->io_buffer_size - p_ctx->io_buffer_cnt;
+
+    while (count >= room)
+    {
+        memset(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], c, room);
+        p_ctx->io_buffer_cnt = p_ctx->io_buffer_size;
+        nrf_fprintf_buffer_flush(p_ctx);
+        count -= room;
+        room   = p_ctx->io_buffer_size;
+    }
+    memset(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], c, count);
+    p_ctx->io_buffer_cnt += count;
+}
+
+static void buffer_put(nrf_fprintf_ctx_t * const p_ctx, char const * p_str, size_t len)
+{
+#if NRF_MODULE_ENABLED(NRF_FPRINTF_FLAG_AUTOMATIC_CR_ON_LF)
+    while (len > 0)
+    {
+        char const * p_lf = memchr(p_str, '\n', len);
+        size_t       span = (p_lf != NULL) ? (size_t)(p_lf - p_str) : len;
+
+        buffer_copy(p_ctx, p_str, span);
+        p_str += span;
+        len   -= span;
+
+        if (len > 0)
+        {
+            buffer_copy(p_ctx, "\r\n", 2);
+            p_str++;
+            len--;
+        }
+    }
+#else
+    buffer_copy(p_ctx, p_str, len);
+#endif
+}
+
+#else
+
+static void buffer_put(nrf_fprintf_ctx_t * const p_ctx, char const * p_str, size_t len)
+{
+    for (; len > 0; len--)
+    {
+        buffer_add(p_ctx, *p_str++);
+    }
+}
+
+static void buffer_copy(nrf_fprintf_ctx_t * const p_ctx, char const * p_str, size_t len)
+{
+    buffer_put(p_ctx, p_str, len);
+}
+
+static void buffer_fill(nrf_fprintf_ctx_t * const p_ctx, char c, size_t count)
+{
+    for (; count > 0; count--)
+    {
+        buffer_add(p_ctx, c);
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_FPRINTF_SPAN_COPY)
+
 static void string_print(nrf_fprintf_ctx_t * const p_ctx,
                          char const *              p_str,
                          uint32_t                  FieldWidth,
                          uint32_t                  FormatFlags)
 {
     uint32_t Width = 0;
-    char c;
 
-    if ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY)
+    if (p_str != 0)
     {
-        while ((c = *p_str) != '\0')
-        {
-            p_str++;
-            Width++;
-            buffer_add(p_ctx, c);
-        }
+        Width = strlen(p_str);
+    }
+
+    if (((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u) && (FieldWidth > Width))
+    {
+        buffer_fill(p_ctx, ' ', FieldWidth - Width);
+    }
+
+    buffer_put(p_ctx, p_str, Width);
+
+    if (((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) &&
+        (FieldWidth > Width))
+    {
+        buffer_fill(p_ctx, ' ', FieldWidth - Width);
+    }
+}
+
+#if NRF_MODULE_ENABLED(NRF_FPRINTF_SPAN_COPY)
+
+static void unsigned_print(nrf_fprintf_ctx_t * const p_ctx,
+                           uint32_t                  v,
+                           uint32_t                  Base,
+                           uint32_t                  NumDigits,
+                           uint32_t                  FieldWidth,
+                           uint32_t                  FormatFlags)
+{
+    static const char _aV2C[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+                                   'A', 'B', 'C', 'D', 'E', 'F' };
+    char aDigits[10];   // UINT32_MAX in base 10
+    uint32_t Len;
+    uint32_t Width;
 
-        while ((FieldWidth > Width) && (FieldWidth > 0))
+    //
+    // Compute the digits, least significant first, at the end of aDigits.
+    // Base is 10 or 16: constant divisors avoid a division per digit.
+    //
+    Len = 0u;
+    if (Base == 16u)
+    {
+        do
         {
-            FieldWidth--;
-            buffer_add(p_ctx, ' ');
-        }
+            Len++;
+            aDigits[sizeof(aDigits) - Len] = _aV2C[v & 0xFu];
+            v >>= 4;
+        } while (v != 0u);
     }
     else
     {
-        if (p_str != 0)
+        do
         {
-            Width = strlen(p_str);
-        }
-
-        while ((FieldWidth > Width) && (FieldWidth > 0))
+            Len++;
+            aDigits[sizeof(aDigits) - Len] = _aV2C[v % 10u];
+            v /= 10u;
+        } while (v != 0u);
+    }
+    //
+    // Get actual field width
+    //
+    Width = (NumDigits > Len) ? NumDigits : Len;
+    //
+    // Print leading chars if necessary
+    //
+    if (((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u) && (FieldWidth > Width))
+    {
+        if (((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == NRF_CLI_FORMAT_FLAG_PAD_ZERO) &&
+            (NumDigits == 0u))
         {
-            FieldWidth--;
-            buffer_add(p_ctx, ' ');
+            buffer_fill(p_ctx, '0', FieldWidth - Width);
         }
-
-        while ((c = *p_str) != '\0')
+        else
         {
-            p_str++;
-            Width++;
-            buffer_add(p_ctx, c);
+            buffer_fill(p_ctx, ' ', FieldWidth - Width);
         }
     }
+    //
+    // Output digits, with the leading zeros of the precision
+    //
+    buffer_fill(p_ctx, '0', Width - Len);
+    buffer_copy(p_ctx, &aDigits[sizeof(aDigits) - Len], Len);
+    //
+    // Print trailing spaces if necessary
+    //
+    if (((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) &&
+        (FieldWidth > Width))
+    {
+        buffer_fill(p_ctx, ' ', FieldWidth - Width);
+    }
 }
 
+#else
+
 static void unsigned_print(nrf_fprintf_ctx_t * const p_ctx,
                            uint32_t                  v,
                            uint32_t                  Base,
@@ -256,6 +396,8 @@ static void unsigned_print(nrf_fprintf_ctx_t * const p_ctx,
     }
 }
 
+#endif // NRF_MODULE_ENABLED(NRF_FPRINTF_SPAN_COPY)
+
 static void int_print(nrf_fprintf_ctx_t * const p_ctx,
                       int32_t                   v,
                       uint32_t                  Base,
@@ -292,13 +434,10 @@ static void int_print(nrf_fprintf_ctx_t * const p_ctx,
     if ((((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == 0u) || (NumDigits != 0u)) &&
         ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u))
     {
-        if (FieldWidth != 0u)
+        if (FieldWidth > Width)
         {
-            while ((FieldWidth != 0u) && (Width < FieldWidth))
-            {
-                FieldWidth--;
-                buffer_add(p_ctx, ' ');
-            }
+            buffer_fill(p_ctx, ' ', FieldWidth - Width);
+            FieldWidth = Width;
         }
     }
     //
@@ -323,13 +462,10 @@ static void int_print(nrf_fprintf_ctx_t * const p_ctx,
     if (((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == NRF_CLI_FORMAT_FLAG_PAD_ZERO) &&
         ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u) && (NumDigits == 0u))
     {
-        if (FieldWidth != 0u)
+        if (FieldWidth > Width)
         {
-            while ((FieldWidth != 0u) && (Width < FieldWidth))
-            {
-                FieldWidth--;
-                buffer_add(p_ctx, '0');
-            }
+            buffer_fill(p_ctx, '0', FieldWidth - Width);
+            FieldWidth = Width;
         }
     }
     //
@@ -344,17 +480,7 @@ static void fill_space(nrf_fprintf_ctx_t * const p_ctx,
                        uint8_t len,
                        bool zeros)
 {
-    for (; len > 0; len--)
-    {
-        if (zeros)
-        {
-            buffer_add(p_ctx, '0');
-        }
-        else
-        {
-            buffer_add(p_ctx, ' ');
-        }
-    }
+    buffer_fill(p_ctx, zeros ? '0' : ' ', len);
 }
 
 static void float_print(nrf_fprintf_ctx_t * const p_ctx,
@@ -757,8 +883,7 @@ void nrf_fprintf_fmt(nrf_fprintf_ctx_t * const p_ctx,
                 }
                 case 'p':
                     v = va_arg(*p_args, int32_t);
-                    buffer_add(p_ctx, '0');
-                    buffer_add(p_ctx, 'x');
+                    buffer_copy(p_ctx, "0x", 2);
                     unsigned_print(p_ctx, (uint32_t)v, 16u, 8u, 8u, 0);
                     break;
                 case '%':
@@ -796,13 +921,27 @@ void nrf_fprintf_fmt(nrf_fprintf_ctx_t * const p_ctx,
         }
         else
         {
-            buffer_add(p_ctx, c);
+            //
+            // Literal text up to the next conversion or LF
+            //
+            char const * p_end = p_fmt - 1;
+            while ((*p_end != '\0') && (*p_end != '%') && (*p_end != '\n'))
+            {
+                p_end++;
+            }
+            buffer_copy(p_ctx, p_fmt - 1, (size_t)(p_end - p_fmt) + 1u);
+            p_fmt = p_end;
+            if (*p_fmt == '\n')
+            {
+                buffer_add(p_ctx, '\n');
+                p_fmt++;
+            }
         }
     } while (*p_fmt != '\0');
 
     if (p_ctx->auto_flush)
     {
-        nrf_fprintf_buffer_flush(p_ctx);
+        nrf_fprintf_buffer_flush_soft(p_ctx);
     }
 }
 
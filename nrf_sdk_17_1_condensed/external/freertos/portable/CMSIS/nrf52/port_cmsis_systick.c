@@ -113,6 +113,8 @@ void vPortSetupTimerInterrupt( void )
 
 void xPortSysTickHandler( void )
 {
+    traceISR_ENTER();
+
 #if configUSE_TICKLESS_IDLE == 1
     nrf_rtc_event_clear(portNRF_RTC_REG, NRF_RTC_EVENT_COMPARE_0);
 #endif
@@ -155,6 +157,8 @@ void xPortSysTickHandler( void )
     }
 
     portCLEAR_INTERRUPT_MASK_FROM_ISR( isrstate );
+
+    traceISR_EXIT();
 }
 
 /*
@@ -331,6 +331,17 @@ extern "C" {
 	#define traceTASK_SWITCHED_OUT()
 #endif
 
+#ifndef traceISR_ENTER
+	/* Called on entry to an instrumented interrupt handler, such as the port's
+	tick interrupt. */
+	#define traceISR_ENTER()
+#endif
+
+#ifndef traceISR_EXIT
+	/* Called on exit from an instrumented interrupt handler. */
+	#define traceISR_EXIT()
+#endif
+
 #ifndef traceTASK_PRIORITY_INHERIT
 	/* Called when a task attempts to take a mutex that is already held by a
 	lower priority task.  pxTCBOfMutexHolder is a pointer to the TCB of the task
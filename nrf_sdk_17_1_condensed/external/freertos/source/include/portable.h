@@ -133,6 +133,19 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Fragmentation report, implemented by heap_4.c and heap_tlsf.c.  Walks the
+ * free blocks, so it is meant for diagnostics and not for time critical code.
+ */
+typedef struct xHEAP_FRAGMENTATION_REPORT
+{
+	size_t xFreeBytes;			/*<< Same as xPortGetFreeHeapSize(). */
+	size_t xLargestFreeBlock;	/*<< Largest free block, header included. */
+	size_t xFreeBlocks;			/*<< Number of free blocks. */
+} HeapFragmentationReport_t;
+
+void vPortGetHeapFragmentationReport( HeapFragmentationReport_t *pxReport ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
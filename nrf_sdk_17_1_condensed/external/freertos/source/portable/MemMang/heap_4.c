@@ -327,6 +327,33 @@ void vPortInitialiseBlocks( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortGetHeapFragmentationReport( HeapFragmentationReport_t *pxReport )
+{
+BlockLink_t *pxBlock;
+size_t xLargestFreeBlock = 0, xFreeBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		if( pxEnd != NULL )
+		{
+			for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( pxBlock->xBlockSize > xLargestFreeBlock )
+				{
+					xLargestFreeBlock = pxBlock->xBlockSize;
+				}
+				xFreeBlocks++;
+			}
+		}
+
+		pxReport->xFreeBytes = xFreeBytesRemaining;
+		pxReport->xLargestFreeBlock = xLargestFreeBlock;
+		pxReport->xFreeBlocks = xFreeBlocks;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
 static void prvHeapInit( void )
 {
 BlockLink_t *pxFirstFreeBlock;
@@ -0,0 +1,575 @@
+/*
+ * FreeRTOS Kernel V10.0.0
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software. If you wish to use our Amazon
+ * FreeRTOS name, please do so in a fair use way that does not cause confusion.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A two level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree().  Like heap_4.c it coalesces adjacent free blocks, but the free
+ * blocks are kept in size segregated lists indexed by two bitmaps instead of
+ * one address ordered list, so both functions run in constant time whatever
+ * the number of free blocks.
+ *
+ * The first level splits the sizes into powers of two, the second level splits
+ * every power of two into heapSL_INDEX_COUNT equal ranges.  A request is
+ * rounded up to the next range so the first block of the first non-empty list
+ * found through the bitmaps always fits (good fit rather than first fit).
+ *
+ * vPortGetHeapFragmentationReport() reports the largest free block and the
+ * number of free blocks, it walks the free lists and is meant for diagnostics
+ * only.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Number of second level ranges per power of two, as a power of two.  More
+ranges waste less memory on rounding but cost more list heads. */
+#ifndef heapSL_INDEX_COUNT_LOG2
+	#define heapSL_INDEX_COUNT_LOG2		3
+#endif
+
+/* Log2 of the largest block the heap can hold, must cover configTOTAL_HEAP_SIZE. */
+#ifndef heapFL_INDEX_MAX
+	#define heapFL_INDEX_MAX			16
+#endif
+
+#if portBYTE_ALIGNMENT == 8
+	#define heapALIGNMENT_LOG2	3
+#elif portBYTE_ALIGNMENT == 4
+	#define heapALIGNMENT_LOG2	2
+#else
+	#error heap_tlsf.c supports a portBYTE_ALIGNMENT of 4 or 8
+#endif
+
+#define heapSL_INDEX_COUNT		( 1U << heapSL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT		( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+#if( configTOTAL_HEAP_SIZE >= ( 1UL << heapFL_INDEX_MAX ) )
+	#error heapFL_INDEX_MAX is too small for configTOTAL_HEAP_SIZE
+#endif
+
+/* Set in xBlockSize while the block is in a free list. */
+#define heapBLOCK_FREE_BIT		( ( size_t ) 1 )
+#define heapBLOCK_SIZE_MASK		( ~( size_t ) portBYTE_ALIGNMENT_MASK )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Header placed in front of every block.  pxPrevPhysBlock and xBlockSize are
+always valid, the free list links overlay the first bytes of the payload and
+are only valid while the block is free. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPrevPhysBlock;	/*<< The block just below this one in memory, NULL for the first block. */
+	size_t xBlockSize;						/*<< Payload size in bytes, heapBLOCK_FREE_BIT while free. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;	/*<< Next block of the same free list. */
+	struct A_TLSF_BLOCK *pxPrevFreeBlock;	/*<< Previous block of the same free list. */
+} TlsfBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Free list management, all in constant time.
+ */
+static void prvInsertFreeBlock( TlsfBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TlsfBlock_t *pxBlock );
+static TlsfBlock_t *prvFindFreeBlock( size_t xSize );
+
+/*-----------------------------------------------------------*/
+
+/* Offset from a block to its payload.  Only the two physical members are
+counted, the free list links live in the payload. */
+static const size_t xHeapStructSize = ( offsetof( TlsfBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The payload must hold the free list links once the block is freed. */
+static const size_t xMinimumPayloadSize = ( ( 2 * sizeof( TlsfBlock_t * ) ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* One bit per first level index with a non-empty list, one bit per second
+level index with a non-empty list. */
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmap[ heapFL_INDEX_COUNT ];
+
+/* Free list heads. */
+static TlsfBlock_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* Zero sized block closing the heap, so the last block always has a next. */
+static TlsfBlock_t *pxEnd = NULL;
+
+/* Keeps track of the number of free bytes remaining, headers included as in
+heap_4.c. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvFindLastSet( size_t xValue )
+{
+	/* Index of the most significant set bit, xValue must not be 0. */
+	return ( uint32_t ) ( ( sizeof( unsigned long ) * 8U ) - 1U - ( uint32_t ) __builtin_clzl( ( unsigned long ) xValue ) );
+}
+
+static uint32_t prvFindFirstSet( uint32_t ulValue )
+{
+	/* Index of the least significant set bit, ulValue must not be 0. */
+	return ( uint32_t ) __builtin_ctz( ulValue );
+}
+
+static TlsfBlock_t *prvNextPhysBlock( const TlsfBlock_t *pxBlock )
+{
+	return ( TlsfBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize + ( pxBlock->xBlockSize & heapBLOCK_SIZE_MASK ) );
+}
+
+/* Maps a block size to the list the block is kept in. */
+static void prvMappingInsert( size_t xSize, uint32_t *pulFirstLevel, uint32_t *pulSecondLevel )
+{
+uint32_t ulFirstLevel, ulSecondLevel;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are kept in linearly spaced lists of the first index. */
+		ulFirstLevel = 0;
+		ulSecondLevel = ( uint32_t ) ( xSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		ulFirstLevel = prvFindLastSet( xSize );
+		ulSecondLevel = ( uint32_t ) ( xSize >> ( ulFirstLevel - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+		ulFirstLevel -= ( heapFL_INDEX_SHIFT - 1 );
+	}
+
+	*pulFirstLevel = ulFirstLevel;
+	*pulSecondLevel = ulSecondLevel;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+TlsfBlock_t *pxBlock, *pxNewBlock;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize < configTOTAL_HEAP_SIZE ) )
+		{
+			/* Ensure that blocks are always aligned to the required number of
+			bytes and can hold the free list links once freed. */
+			if( xWantedSize < xMinimumPayloadSize )
+			{
+				xWantedSize = xMinimumPayloadSize;
+			}
+			else
+			{
+				xWantedSize = ( xWantedSize + portBYTE_ALIGNMENT_MASK ) & heapBLOCK_SIZE_MASK;
+			}
+
+			pxBlock = prvFindFreeBlock( xWantedSize );
+
+			if( pxBlock != NULL )
+			{
+				prvRemoveFreeBlock( pxBlock );
+
+				/* If the block is larger than required it can be split into
+				two, the remainder goes back to the free lists. */
+				if( pxBlock->xBlockSize >= ( xWantedSize + xHeapStructSize + xMinimumPayloadSize ) )
+				{
+					pxNewBlock = ( TlsfBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize + xWantedSize );
+					configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+					pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize - xHeapStructSize;
+					pxNewBlock->pxPrevPhysBlock = pxBlock;
+					prvNextPhysBlock( pxNewBlock )->pxPrevPhysBlock = pxNewBlock;
+					pxBlock->xBlockSize = xWantedSize;
+
+					prvInsertFreeBlock( pxNewBlock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize + xHeapStructSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+TlsfBlock_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a TlsfBlock_t header immediately
+		before it. */
+		pxBlock = ( TlsfBlock_t * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxBlock->xBlockSize & heapBLOCK_FREE_BIT ) == 0 );
+
+		if( ( pxBlock->xBlockSize & heapBLOCK_FREE_BIT ) == 0 )
+		{
+			vTaskSuspendAll();
+			{
+				xFreeBytesRemaining += pxBlock->xBlockSize + xHeapStructSize;
+				traceFREE( pv, pxBlock->xBlockSize );
+
+				/* Merge with the block above if it is free.  pxEnd is never
+				free so the next block always exists. */
+				pxNeighbour = prvNextPhysBlock( pxBlock );
+				if( ( pxNeighbour->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxBlock->xBlockSize += ( pxNeighbour->xBlockSize & heapBLOCK_SIZE_MASK ) + xHeapStructSize;
+					prvNextPhysBlock( pxBlock )->pxPrevPhysBlock = pxBlock;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Merge with the block below if it is free. */
+				pxNeighbour = pxBlock->pxPrevPhysBlock;
+				if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & heapBLOCK_FREE_BIT ) != 0 ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxNeighbour->xBlockSize += pxBlock->xBlockSize + xHeapStructSize;
+					pxBlock = pxNeighbour;
+					prvNextPhysBlock( pxBlock )->pxPrevPhysBlock = pxBlock;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvInsertFreeBlock( pxBlock );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapFragmentationReport( HeapFragmentationReport_t *pxReport )
+{
+TlsfBlock_t *pxBlock;
+uint32_t ulFirstLevel, ulSecondLevel;
+size_t xLargestFreeBlock = 0, xFreeBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		for( ulFirstLevel = 0; ulFirstLevel < heapFL_INDEX_COUNT; ulFirstLevel++ )
+		{
+			for( ulSecondLevel = 0; ulSecondLevel < heapSL_INDEX_COUNT; ulSecondLevel++ )
+			{
+				for( pxBlock = pxFreeLists[ ulFirstLevel ][ ulSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					/* Report the usable size the way heap_4.c does, header
+					included. */
+					if( ( pxBlock->xBlockSize & heapBLOCK_SIZE_MASK ) + xHeapStructSize > xLargestFreeBlock )
+					{
+						xLargestFreeBlock = ( pxBlock->xBlockSize & heapBLOCK_SIZE_MASK ) + xHeapStructSize;
+					}
+					xFreeBlocks++;
+				}
+			}
+		}
+
+		pxReport->xFreeBytes = xFreeBytesRemaining;
+		pxReport->xLargestFreeBlock = xLargestFreeBlock;
+		pxReport->xFreeBlocks = xFreeBlocks;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TlsfBlock_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd closes the heap.  It is never free, so freeing the last block does
+	not try to merge past the end of the heap. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock - xHeapStructSize;
+
+	pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+	pxEnd->xBlockSize = 0;
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize + xHeapStructSize;
+	xFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+	prvInsertFreeBlock( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TlsfBlock_t *pxBlock )
+{
+uint32_t ulFirstLevel, ulSecondLevel;
+TlsfBlock_t *pxHead;
+
+	prvMappingInsert( pxBlock->xBlockSize, &ulFirstLevel, &ulSecondLevel );
+
+	pxHead = pxFreeLists[ ulFirstLevel ][ ulSecondLevel ];
+	pxBlock->pxNextFreeBlock = pxHead;
+	pxBlock->pxPrevFreeBlock = NULL;
+	if( pxHead != NULL )
+	{
+		pxHead->pxPrevFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+	pxFreeLists[ ulFirstLevel ][ ulSecondLevel ] = pxBlock;
+
+	ulFirstLevelBitmap |= ( 1UL << ulFirstLevel );
+	ulSecondLevelBitmap[ ulFirstLevel ] |= ( 1UL << ulSecondLevel );
+
+	pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TlsfBlock_t *pxBlock )
+{
+uint32_t ulFirstLevel, ulSecondLevel;
+
+	pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+	prvMappingInsert( pxBlock->xBlockSize, &ulFirstLevel, &ulSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPrevFreeBlock != NULL )
+	{
+		pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the head of its list. */
+		pxFreeLists[ ulFirstLevel ][ ulSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSecondLevelBitmap[ ulFirstLevel ] &= ~( 1UL << ulSecondLevel );
+
+			if( ulSecondLevelBitmap[ ulFirstLevel ] == 0 )
+			{
+				ulFirstLevelBitmap &= ~( 1UL << ulFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TlsfBlock_t *prvFindFreeBlock( size_t xSize )
+{
+uint32_t ulFirstLevel, ulSecondLevel, ulMap;
+
+	/* Round the request up to the next list boundary, so any block of the
+	list found below is large enough. */
+	if( xSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xSize += ( ( size_t ) 1 << ( prvFindLastSet( xSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xSize, &ulFirstLevel, &ulSecondLevel );
+
+	if( ulFirstLevel >= heapFL_INDEX_COUNT )
+	{
+		return NULL;
+	}
+
+	/* First a list of the same first level with large enough blocks, then the
+	smallest non-empty larger first level. */
+	ulMap = ulSecondLevelBitmap[ ulFirstLevel ] & ( ~0UL << ulSecondLevel );
+
+	if( ulMap == 0 )
+	{
+		ulMap = ulFirstLevelBitmap & ( ~0UL << ( ulFirstLevel + 1 ) );
+
+		if( ulMap == 0 )
+		{
+			return NULL;
+		}
+
+		ulFirstLevel = prvFindFirstSet( ulMap );
+		ulMap = ulSecondLevelBitmap[ ulFirstLevel ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	ulSecondLevel = prvFindFirstSet( ulMap );
+
+	return pxFreeLists[ ulFirstLevel ][ ulSecondLevel ];
+}
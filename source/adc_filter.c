@@ -0,0 +1,129 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    adc_filter.c
+ * @version See Version in adc_filter.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Fixed-point decimation and filtering of SAADC sample blocks.
+ *
+ * Built for use with the nRF SDK 17.1
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "nrf.h"
+#include "nrf_assert.h"
+
+#include "adc_filter.h"
+
+void adc_filter_init(adc_filter_t * p_filter, adc_filter_channel_t const * p_channels,
+                     uint8_t channel_cnt, uint8_t resolution)
+{
+    ASSERT((channel_cnt > 0) && (channel_cnt <= ADC_FILTER_MAX_CHANNELS));
+    ASSERT((resolution >= 8) && (resolution <= 14));
+
+    memset(p_filter, 0, sizeof(*p_filter));
+    p_filter->p_channels  = p_channels;
+    p_filter->channel_cnt = channel_cnt;
+    p_filter->resolution  = resolution;
+}
+
+void adc_filter_block_process(adc_filter_t * p_filter, int16_t const * p_samples, uint32_t size)
+{
+    uint32_t channel_cnt = p_filter->channel_cnt;
+    uint32_t frames      = size / channel_cnt;
+    int32_t  sum[ADC_FILTER_MAX_CHANNELS] = {0};
+    int32_t  value_mv[ADC_FILTER_MAX_CHANNELS];
+
+    ASSERT((frames > 0) && (frames * channel_cnt == size));
+
+    // Decimation, the sum of 2^16 frames of 14 bit readings still fits
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        for (uint32_t channel = 0; channel < channel_cnt; channel++)
+        {
+            sum[channel] += p_samples[channel];
+        }
+        p_samples += channel_cnt;
+    }
+
+    for (uint32_t channel = 0; channel < channel_cnt; channel++)
+    {
+        adc_filter_channel_t const * p_channel = &p_filter->p_channels[channel];
+        int32_t                      average   = 0;
+
+        if (sum[channel] > 0)
+        {
+            average = (int32_t)(((int64_t)sum[channel] << 16) / frames);
+        }
+
+        if (!p_filter->primed)
+        {
+            p_filter->state[channel] = average;
+        }
+        else
+        {
+            p_filter->state[channel] += (average - p_filter->state[channel]) >> p_channel->shift;
+        }
+
+        // Rounded to the nearest millivolt
+        value_mv[channel] = (int32_t)(((int64_t)p_filter->state[channel] * p_channel->full_scale_mv +
+                                       ((int64_t)1 << (15 + p_filter->resolution))) >>
+                                      (16 + p_filter->resolution));
+    }
+    p_filter->primed = true;
+
+    // Readers retry while the sequence is odd or has changed
+    p_filter->sequence++;
+    __DMB();
+    for (uint32_t channel = 0; channel < channel_cnt; channel++)
+    {
+        p_filter->value_mv[channel] = value_mv[channel];
+    }
+    __DMB();
+    p_filter->sequence++;
+}
+
+bool adc_filter_read(adc_filter_t const * p_filter, int32_t * p_mv)
+{
+    uint32_t sequence;
+
+    do
+    {
+        sequence = p_filter->sequence;
+        __DMB();
+        for (uint32_t channel = 0; channel < p_filter->channel_cnt; channel++)
+        {
+            p_mv[channel] = p_filter->value_mv[channel];
+        }
+        __DMB();
+    } while ((sequence & 1) || (sequence != p_filter->sequence));
+
+    return sequence != 0;
+}
+
+int32_t adc_filter_value_get(adc_filter_t const * p_filter, uint8_t channel)
+{
+    ASSERT(channel < p_filter->channel_cnt);
+
+    // A single aligned word, published whole
+    return p_filter->value_mv[channel];
+}
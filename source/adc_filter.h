@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+
+/**
+ * @file    adc_filter.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Fixed-point decimation and filtering of SAADC sample blocks.
+ *
+ * A block holds frames of interleaved samples, one per channel in scan order, as the SAADC
+ * writes them in scan mode. adc_filter_block_process() averages the frames of a block per
+ * channel, smooths the averages with a first order low-pass filter and publishes the values in
+ * millivolts. All the arithmetic is in integers: the filter state is the raw reading in Q16.
+ *
+ * One writer, typically the SAADC interrupt, processes the blocks. Any number of readers get
+ * the values without a lock: a sequence number, odd while the writer publishes, tells readers
+ * to retry. The writer never waits.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ADC_FILTER_MAX_CHANNELS
+    #define ADC_FILTER_MAX_CHANNELS         4                   /** < Channels of a filter, at most the 8 of the SAADC */
+#endif
+
+/**
+ * @brief Conversion and smoothing of a channel.
+ */
+typedef struct {
+    uint32_t full_scale_mv;     /** < Millivolts at the input for a full scale reading, including any divider */
+    uint8_t  shift;             /** < Low-pass filter: each block moves the value by 1/2^shift of the difference, 0 for none */
+} adc_filter_channel_t;
+
+/**
+ * @brief Filter of up to ADC_FILTER_MAX_CHANNELS channels. Set up with adc_filter_init().
+ */
+typedef struct {
+    adc_filter_channel_t const * p_channels;
+    uint8_t                      channel_cnt;
+    uint8_t                      resolution;                            // Bits of a reading
+    bool                         primed;                                // The state holds a block
+    int32_t                      state[ADC_FILTER_MAX_CHANNELS];        // Raw reading in Q16
+    volatile uint32_t            sequence;                              // Odd while publishing
+    volatile int32_t             value_mv[ADC_FILTER_MAX_CHANNELS];
+} adc_filter_t;
+
+/**
+ * @brief Sets up a filter.
+ *
+ * @param p_filter    Filter
+ * @param p_channels  Channels in scan order, kept by the filter
+ * @param channel_cnt Number of channels, at most ADC_FILTER_MAX_CHANNELS
+ * @param resolution  Bits of a reading, 8 to 14
+ */
+void adc_filter_init(adc_filter_t * p_filter, adc_filter_channel_t const * p_channels,
+                     uint8_t channel_cnt, uint8_t resolution);
+
+/**
+ * @brief Decimates, filters and publishes a block. A negative average counts as 0.
+ *
+ * @param p_filter  Filter
+ * @param p_samples Frames of channel_cnt interleaved samples
+ * @param size      Samples in the block, a multiple of channel_cnt
+ */
+void adc_filter_block_process(adc_filter_t * p_filter, int16_t const * p_samples, uint32_t size);
+
+/**
+ * @brief Gets the latest values of all channels, published by the same block.
+ *
+ * @param p_filter Filter
+ * @param p_mv     Filled with channel_cnt values in millivolts
+ *
+ * @return bool true if a block was processed, false if there are no values yet
+ */
+bool adc_filter_read(adc_filter_t const * p_filter, int32_t * p_mv);
+
+/**
+ * @brief Gets the latest value of one channel.
+ *
+ * @param p_filter Filter
+ * @param channel  Channel, in scan order
+ *
+ * @return int32_t Millivolts, 0 before the first block
+ */
+int32_t adc_filter_value_get(adc_filter_t const * p_filter, uint8_t channel);
+
+#endif
@@ -0,0 +1,186 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    adc_sampler.c
+ * @version See Version in adc_sampler.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Continuous SAADC sampling of the battery and sensor inputs.
+ *
+ * Built for use with the nRF SDK 17.1
+ *
+ */
+
+#include <stdint.h>
+
+#include "sdk_common.h"
+#include "nrf_assert.h"
+#include "nrfx_saadc.h"
+#include "nrfx_timer.h"
+#include "nrfx_ppi.h"
+
+#include "adc_sampler.h"
+
+#define BUFFER_SIZE     (ADC_FILTER_MAX_CHANNELS * ADC_SAMPLER_DECIMATION)
+
+STATIC_ASSERT(BUFFER_SIZE <= UINT16_MAX);
+
+/* Bits of a reading, by nrf_saadc_resolution_t */
+static const uint8_t m_resolution_bits[] = {8, 10, 12, 14};
+
+static const nrfx_timer_t m_timer = NRFX_TIMER_INSTANCE(ADC_SAMPLER_TIMER_INSTANCE);
+
+static nrf_saadc_value_t  m_buffers[2][BUFFER_SIZE];
+static uint16_t           m_buffer_size;            // Samples used in each buffer
+static nrf_ppi_channel_t  m_ppi_channel;
+static adc_filter_t       m_filter;
+static adc_filter_channel_t m_filter_channels[ADC_FILTER_MAX_CHANNELS];
+
+/**
+ * @brief Filters a full buffer and gives it back to the SAADC. Runs in the SAADC interrupt.
+ */
+static void saadc_event_handler(nrfx_saadc_evt_t const * p_event)
+{
+    if (p_event->type == NRFX_SAADC_EVT_DONE)
+    {
+        adc_filter_block_process(&m_filter, p_event->data.done.p_buffer, p_event->data.done.size);
+
+        // The SAADC is filling the other buffer, this one is next
+        APP_ERROR_CHECK(nrfx_saadc_buffer_convert(p_event->data.done.p_buffer, p_event->data.done.size));
+    }
+}
+
+/**
+ * @brief Never called: the compare interrupt is left disabled, the compare event only triggers the
+ * SAADC, through PPI. nrfx_timer_init() asserts that a handler is given, so this one is empty.
+ */
+static void timer_event_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    UNUSED_PARAMETER(event_type);
+    UNUSED_PARAMETER(p_context);
+}
+
+ret_code_t adc_sampler_init(adc_sampler_channel_t const * p_channels, uint8_t channel_cnt)
+{
+    nrfx_saadc_config_t saadc_config = NRFX_SAADC_DEFAULT_CONFIG;
+    nrfx_timer_config_t timer_config = NRFX_TIMER_DEFAULT_CONFIG;
+    ret_code_t          err_code;
+
+    if ((channel_cnt == 0) || (channel_cnt > ADC_FILTER_MAX_CHANNELS))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Decimation is done by the filter, not by SAADC oversampling, which needs a single channel
+    saadc_config.resolution     = ADC_SAMPLER_RESOLUTION;
+    saadc_config.oversample     = NRF_SAADC_OVERSAMPLE_DISABLED;
+    saadc_config.low_power_mode = false;
+    err_code = nrfx_saadc_init(&saadc_config, saadc_event_handler);
+    VERIFY_SUCCESS(err_code);
+
+    for (uint8_t i = 0; i < channel_cnt; i++)
+    {
+        nrf_saadc_channel_config_t channel_config = NRFX_SAADC_DEFAULT_CHANNEL_CONFIG_SE(p_channels[i].input);
+
+        channel_config.gain     = p_channels[i].gain;
+        channel_config.acq_time = ADC_SAMPLER_ACQ_TIME;
+        err_code = nrfx_saadc_channel_init(i, &channel_config);
+        if (err_code != NRFX_SUCCESS)
+        {
+            nrfx_saadc_uninit();
+            return err_code;
+        }
+        m_filter_channels[i] = p_channels[i].filter;
+    }
+    adc_filter_init(&m_filter, m_filter_channels, channel_cnt, m_resolution_bits[ADC_SAMPLER_RESOLUTION]);
+
+    // Both buffers are queued, the SAADC switches to the second one by itself
+    m_buffer_size = channel_cnt * ADC_SAMPLER_DECIMATION;
+    err_code = nrfx_saadc_buffer_convert(m_buffers[0], m_buffer_size);
+    if (err_code == NRFX_SUCCESS)
+    {
+        err_code = nrfx_saadc_buffer_convert(m_buffers[1], m_buffer_size);
+    }
+    if (err_code != NRFX_SUCCESS)
+    {
+        nrfx_saadc_uninit();
+        return err_code;
+    }
+
+    timer_config.frequency = NRF_TIMER_FREQ_1MHz;
+    timer_config.bit_width = NRF_TIMER_BIT_WIDTH_32;
+    err_code = nrfx_timer_init(&m_timer, &timer_config, timer_event_handler);
+    if (err_code != NRFX_SUCCESS)
+    {
+        nrfx_saadc_uninit();
+        return err_code;
+    }
+    nrfx_timer_extended_compare(&m_timer, NRF_TIMER_CC_CHANNEL0,
+                                nrfx_timer_us_to_ticks(&m_timer, ADC_SAMPLER_INTERVAL_US),
+                                NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, false);
+
+    err_code = nrfx_ppi_channel_alloc(&m_ppi_channel);
+    if (err_code != NRFX_SUCCESS)
+    {
+        nrfx_timer_uninit(&m_timer);
+        nrfx_saadc_uninit();
+        return err_code;
+    }
+    err_code = nrfx_ppi_channel_assign(m_ppi_channel,
+                                       nrfx_timer_compare_event_address_get(&m_timer, NRF_TIMER_CC_CHANNEL0),
+                                       nrfx_saadc_sample_task_get());
+    if (err_code == NRFX_SUCCESS)
+    {
+        err_code = nrfx_ppi_channel_enable(m_ppi_channel);
+    }
+    if (err_code != NRFX_SUCCESS)
+    {
+        (void)nrfx_ppi_channel_free(m_ppi_channel);
+        nrfx_timer_uninit(&m_timer);
+        nrfx_saadc_uninit();
+        return err_code;
+    }
+
+    nrfx_timer_enable(&m_timer);
+
+    return NRF_SUCCESS;
+}
+
+void adc_sampler_uninit(void)
+{
+    nrfx_timer_disable(&m_timer);
+    (void)nrfx_ppi_channel_disable(m_ppi_channel);
+    (void)nrfx_ppi_channel_free(m_ppi_channel);
+    nrfx_timer_uninit(&m_timer);
+    nrfx_saadc_uninit();
+}
+
+bool adc_sampler_read(int32_t * p_mv)
+{
+    return adc_filter_read(&m_filter, p_mv);
+}
+
+int32_t adc_sampler_value_get(uint8_t channel)
+{
+    return adc_filter_value_get(&m_filter, channel);
+}
+
+float adc_sampler_battery_voltage(void)
+{
+    return adc_filter_value_get(&m_filter, ADC_SAMPLER_BATTERY_CHANNEL) / 1000.0f;
+}
@@ -0,0 +1,126 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+
+/**
+ * @file    adc_sampler.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Continuous SAADC sampling of the battery and sensor inputs.
+ *
+ * ep_bsp_read_battery_voltage() runs one blocking conversion per call. The sampler instead
+ * samples all its channels every ADC_SAMPLER_INTERVAL_US: a TIMER compare event triggers the
+ * SAADC SAMPLE task through PPI, with no CPU involvement, and the SAADC writes the readings by
+ * DMA into one of two buffers of ADC_SAMPLER_DECIMATION frames. When a buffer is full the SAADC
+ * interrupt hands it to adc_filter.c, which decimates and filters it in fixed point and
+ * publishes the values, then gives the buffer back while the SAADC fills the other one.
+ *
+ * Readers get the latest values at any time, from any task, without a lock.
+ *
+ * The sampler owns the SAADC: ep_bsp_read_battery_voltage() must not be called while it runs,
+ * use adc_sampler_battery_voltage() instead. The RTCs are taken by the SoftDevice, the FreeRTOS
+ * tick and libuarte, so a TIMER paces the sampling; it keeps the 1 MHz clock running, call
+ * adc_sampler_uninit() before sleeping for long.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sdk_errors.h"
+#include "nrf_saadc.h"
+
+#include "adc_filter.h"
+
+#ifndef ADC_SAMPLER_TIMER_INSTANCE
+    #define ADC_SAMPLER_TIMER_INSTANCE      4                   /** < TIMER triggering the samples, enabled in sdk_config.h */
+#endif
+#ifndef ADC_SAMPLER_INTERVAL_US
+    #define ADC_SAMPLER_INTERVAL_US         1000                /** < Time between two samples of every channel */
+#endif
+#ifndef ADC_SAMPLER_DECIMATION
+    #define ADC_SAMPLER_DECIMATION          64                  /** < Samples of a channel averaged into one published value */
+#endif
+#ifndef ADC_SAMPLER_RESOLUTION
+    #define ADC_SAMPLER_RESOLUTION          NRF_SAADC_RESOLUTION_12BIT
+#endif
+#ifndef ADC_SAMPLER_ACQ_TIME
+    #define ADC_SAMPLER_ACQ_TIME            NRF_SAADC_ACQTIME_40US  /** < As ep_bsp, for high impedance dividers */
+#endif
+#ifndef ADC_SAMPLER_BATTERY_CHANNEL
+    #define ADC_SAMPLER_BATTERY_CHANNEL     0                   /** < Channel read by adc_sampler_battery_voltage() */
+#endif
+
+/**
+ * @brief A sampled input.
+ *
+ * full_scale_mv is the input voltage of a full scale reading: 600 mV / gain with the internal
+ * reference, times the ratio of any divider. For example, NRF_SAADC_INPUT_VDDHDIV5 with
+ * NRF_SAADC_GAIN1_6 reads up to 3600 mV * 5 = 18000 mV.
+ */
+typedef struct {
+    nrf_saadc_input_t     input;
+    nrf_saadc_gain_t      gain;
+    adc_filter_channel_t  filter;
+} adc_sampler_channel_t;
+
+/**
+ * @brief Starts sampling the channels, with the internal reference.
+ *
+ * @param p_channels  Channels, in scan order
+ * @param channel_cnt Number of channels, at most ADC_FILTER_MAX_CHANNELS
+ *
+ * @return ret_code_t NRF_SUCCESS, or the error of the SAADC, TIMER or PPI driver
+ */
+ret_code_t adc_sampler_init(adc_sampler_channel_t const * p_channels, uint8_t channel_cnt);
+
+/**
+ * @brief Stops sampling and releases the SAADC, TIMER and PPI channel.
+ */
+void adc_sampler_uninit(void);
+
+/**
+ * @brief Gets the latest values of all channels, published together.
+ *
+ * @param p_mv Filled with one value per channel, in millivolts
+ *
+ * @return bool true if there are values, false before the first buffer is full
+ */
+bool adc_sampler_read(int32_t * p_mv);
+
+/**
+ * @brief Gets the latest value of a channel.
+ *
+ * @param channel Channel, in the order given to adc_sampler_init()
+ *
+ * @return int32_t Millivolts, 0 before the first buffer is full
+ */
+int32_t adc_sampler_value_get(uint8_t channel);
+
+/**
+ * @brief Gets the battery voltage, the latest value of ADC_SAMPLER_BATTERY_CHANNEL.
+ *
+ * @return float Battery voltage in volts
+ */
+float adc_sampler_battery_voltage(void);
+
+#endif
@@ -40,6 +40,8 @@
 #include "time_helper.h"
 #include "uart_helper.h"
 #include "led_helper.h"
+#include "rtos_stats.h"
+#include "uart_log_backend.h"
 
 #define mainLED_TASK_STACK_SIZE             128
 #define DEAD_BEEF                           0xDEADBEEF                              /**< Value used as error code on stack dump, can be used to identify stack location on stack unwind. */
@@ -52,6 +54,12 @@ uint8_t ep_serial[SERIAL_LENGTH] = {'\0'};
 /* Cell task handle */
 TaskHandle_t ledTaskHandle;
 
+#if configSUPPORT_STATIC_ALLOCATION
+/* LEDTask stack and TCB, placed in .bss instead of the FreeRTOS heap */
+static StackType_t ledTaskStack[mainLED_TASK_STACK_SIZE];
+static StaticTask_t ledTaskBuffer;
+#endif
+
 char updateVerStr[9];
 uint8_t updateVerMaj;
 uint8_t updateVerMin;
@@ -85,6 +93,38 @@ void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
 
 /*-----------------------------------------------------------*/
 
+#if configSUPPORT_STATIC_ALLOCATION
+/**@brief Provides the memory of the idle task, required by the kernel with static allocation.
+ */
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/**@brief Provides the memory of the timer service task, required by the kernel with static allocation.
+ */
+void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                     StackType_t ** ppxTimerTaskStackBuffer,
+                                     uint32_t * pulTimerTaskStackSize )
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+/*-----------------------------------------------------------*/
+#endif
+
 static void LEDTask( void * pvParameters )
 {
     // Initialize LED library
@@ -121,6 +161,11 @@ static void LEDTask( void * pvParameters )
 
         // Delay 5s
         vTaskDelay(pdMS_TO_TICKS(10000));
+
+#if RTOS_STATS_ENABLED
+        // Report the CPU time of the tasks once per pattern cycle, with the debug UART tracker of this task
+        rtos_stats_snapshot();
+#endif
     }
 
     vTaskDelete( NULL );
@@ -148,8 +193,6 @@ int main(void)
 // Taken from FreeRTOS demo: https://github.com/FreeRTOS/FreeRTOS/blob/main/FreeRTOS-Plus/Demo/FreeRTOS_Cellular_Interface_Windows_Simulator/Common/main.c
 static void prvMiscInitialization( void )
 {
-    nrfx_err_t error;
-
     #if defined(BOARD_GALAXIS)
     //Pullup the Rx line of Galaxis, otherwise noise is coupled
     // to the RX line and will generate a communication error:
@@ -168,6 +211,16 @@ static void prvMiscInitialization( void )
     //init_swo();
     uart_helper.dbgi = true;
 
+    #if DEBUG_UART_DEFERRED_LOG
+    // Start the task formatting deferred debug messages
+    deferred_log_init();
+    #endif
+
+    #if NRF_LOG_ENABLED && NRF_LOG_BACKEND_DEBUG_UART_ENABLED
+    // Start nrf_log and the task sending its deferred logs to the debug UART
+    APP_ERROR_CHECK_BOOL(uart_log_backend_init());
+    #endif
+
     // Start low frequency clock and rtc
     set_time(0);
 
@@ -180,12 +233,22 @@ static void prvMiscInitialization( void )
     DBGI("*************************************************");
 
     /* Create the task to run tests. */
+    #if configSUPPORT_STATIC_ALLOCATION
+    ledTaskHandle = xTaskCreateStatic( LEDTask,
+                                       "LEDTask",
+                                       mainLED_TASK_STACK_SIZE,
+                                       NULL,
+                                       tskIDLE_PRIORITY+1,
+                                       ledTaskStack,
+                                       &ledTaskBuffer );
+    #else
     xTaskCreate( LEDTask,
                 "LEDTask",
                 mainLED_TASK_STACK_SIZE,
                 NULL,
                 tskIDLE_PRIORITY+1,
                 &ledTaskHandle );
+    #endif
 
     // Put uart to sleep
     uninit_uart(MAIN_LOOP);
@@ -0,0 +1,329 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    rtos_stats.c
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Run-time statistics of the FreeRTOS tasks, see rtos_stats.h.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "app_error.h"
+#include "app_util.h"
+#include "uart_helper.h"
+#include "rtos_stats.h"
+
+#if RTOS_STATS_ENABLED
+
+#if RTOS_STATS_CLOCK == RTOS_STATS_CLOCK_TIMER
+#include "nrf_timer.h"
+#endif
+
+#define RTOS_STATS_RECORD_MAGIC     'R'
+#define RTOS_STATS_RECORD_VERSION   1
+#define RTOS_STATS_HEADER_SIZE      28
+#define RTOS_STATS_TASK_SIZE        24
+#define RTOS_STATS_NAME_SIZE        8
+#define RTOS_STATS_RECORD_SIZE      (RTOS_STATS_HEADER_SIZE + RTOS_STATS_MAX_TASKS * RTOS_STATS_TASK_SIZE + 2)
+#define RTOS_STATS_LINE_PREFIX      "@RTS "
+
+/* epBlinkyLibrary.a keeps one tracker per id below NUM_OF_TASKS and does not check the id */
+#if RTOS_STATS_UART_TASK_ID >= NUM_OF_TASKS
+#error "RTOS_STATS_UART_TASK_ID must be below NUM_OF_TASKS."
+#endif
+
+STATIC_ASSERT(sizeof(RTOS_STATS_LINE_PREFIX) + (RTOS_STATS_RECORD_SIZE + 2) / 3 * 4 + 2 <= DEBUG_UART_TX_QUEUE_ITEM_SIZE,
+              "RTOS_STATS_MAX_TASKS does not fit in one debug UART item");
+
+static uint32_t m_switches[RTOS_STATS_MAX_TASKS + 1];   // Indexed by task number, tasks beyond the table are not counted
+static uint32_t m_context_switches;
+static uint32_t m_tick_isr_nesting;
+static uint32_t m_tick_isr_start;
+static uint32_t m_tick_isr_time;
+static uint32_t m_tick_isr_count;
+
+/* Only used by rtos_stats_snapshot */
+static TaskStatus_t m_status[RTOS_STATS_MAX_TASKS];
+static uint8_t      m_record[RTOS_STATS_RECORD_SIZE];
+static char         m_line[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+
+/* Task name of the last stack overflow, for the debugger */
+static const char * volatile m_overflow_task;
+
+/*-----------------------------------------------------------*/
+
+#if RTOS_STATS_CLOCK == RTOS_STATS_CLOCK_DWT
+
+/* The cycle counter is extended to 64 bits on every read. It only runs while the CPU does, so
+   reads from the context switches and the tick interrupt are frequent enough to see each wrap. */
+#define RTOS_STATS_DWT_SHIFT        6       // 64 MHz core clock to microseconds
+
+static uint32_t m_cycles_high;
+static uint32_t m_cycles_last;
+
+void rtos_stats_clock_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t rtos_stats_clock(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint32_t    cycles = DWT->CYCCNT;
+    uint64_t    total;
+
+    if (cycles < m_cycles_last)
+    {
+        m_cycles_high++;
+    }
+    m_cycles_last = cycles;
+    total = ((uint64_t)m_cycles_high << 32) | cycles;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return (uint32_t)(total >> RTOS_STATS_DWT_SHIFT);
+}
+
+#elif RTOS_STATS_CLOCK == RTOS_STATS_CLOCK_TIMER
+
+void rtos_stats_clock_init(void)
+{
+    nrf_timer_mode_set(RTOS_STATS_TIMER, NRF_TIMER_MODE_TIMER);
+    nrf_timer_bit_width_set(RTOS_STATS_TIMER, NRF_TIMER_BIT_WIDTH_32);
+    nrf_timer_frequency_set(RTOS_STATS_TIMER, NRF_TIMER_FREQ_1MHz);
+    nrf_timer_task_trigger(RTOS_STATS_TIMER, NRF_TIMER_TASK_CLEAR);
+    nrf_timer_task_trigger(RTOS_STATS_TIMER, NRF_TIMER_TASK_START);
+}
+
+uint32_t rtos_stats_clock(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint32_t    us;
+
+    nrf_timer_task_trigger(RTOS_STATS_TIMER, nrf_timer_capture_task_get(NRF_TIMER_CC_CHANNEL3));
+    us = nrf_timer_cc_read(RTOS_STATS_TIMER, NRF_TIMER_CC_CHANNEL3);
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return us;
+}
+
+#endif // RTOS_STATS_CLOCK
+
+/*-----------------------------------------------------------*/
+
+void rtos_stats_task_switched_in(uint32_t task_number)
+{
+    // Called by the kernel with interrupts masked
+    m_context_switches++;
+    if (task_number <= RTOS_STATS_MAX_TASKS)
+    {
+        m_switches[task_number]++;
+    }
+}
+
+void rtos_stats_tick_isr_enter(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    if (m_tick_isr_nesting++ == 0)
+    {
+        m_tick_isr_start = rtos_stats_clock();
+    }
+    m_tick_isr_count++;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void rtos_stats_tick_isr_exit(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    if ((m_tick_isr_nesting > 0) && (--m_tick_isr_nesting == 0))
+    {
+        m_tick_isr_time += rtos_stats_clock() - m_tick_isr_start;
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char * pcTaskName)
+{
+    UNUSED_PARAMETER(xTask);
+
+    m_overflow_task = pcTaskName;
+    APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t * put_u8(uint8_t * p, uint32_t value)
+{
+    *p++ = (uint8_t)value;
+    return p;
+}
+
+static uint8_t * put_u16(uint8_t * p, uint32_t value)
+{
+    *p++ = (uint8_t)value;
+    *p++ = (uint8_t)(value >> 8);
+    return p;
+}
+
+static uint8_t * put_u32(uint8_t * p, uint32_t value)
+{
+    p = put_u16(p, value);
+    return put_u16(p, value >> 16);
+}
+
+/* Fletcher-16 of the record, checked by tools/rtos_stats.py */
+static uint16_t checksum(const uint8_t * p_data, uint32_t len)
+{
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        sum1 = (sum1 + p_data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+
+    return (uint16_t)((sum2 << 8) | sum1);
+}
+
+static uint32_t base64_encode(char * p_out, const uint8_t * p_in, uint32_t len)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char *            p = p_out;
+
+    for (uint32_t i = 0; i < len; i += 3)
+    {
+        uint32_t block = (uint32_t)p_in[i] << 16;
+
+        if (i + 1 < len) block |= (uint32_t)p_in[i + 1] << 8;
+        if (i + 2 < len) block |= p_in[i + 2];
+
+        *p++ = alphabet[(block >> 18) & 0x3F];
+        *p++ = alphabet[(block >> 12) & 0x3F];
+        *p++ = (i + 1 < len) ? alphabet[(block >> 6) & 0x3F] : '=';
+        *p++ = (i + 2 < len) ? alphabet[block & 0x3F] : '=';
+    }
+
+    return (uint32_t)(p - p_out);
+}
+
+/*
+ * Record layout, little endian:
+ *
+ *  Header, RTOS_STATS_HEADER_SIZE bytes
+ *   u8  magic 'R'          u8  version           u8  task count        u8  RTOS_STATS_CLOCK
+ *   u32 total run time     u32 tick ISR time     u32 tick ISR count    u32 context switches
+ *   u32 free heap          u32 minimum ever free heap
+ *  Per task, RTOS_STATS_TASK_SIZE bytes
+ *   u8  task number        u8  eTaskState        u8  priority          u8  base priority
+ *   char name[8]           u16 stack high-water mark in words          u16 reserved
+ *   u32 run time           u32 times switched in
+ *  Trailer
+ *   u16 Fletcher-16 of all bytes above
+ *
+ * All times are in microseconds of the run-time stats clock.
+ */
+bool rtos_stats_snapshot(void)
+{
+    UBaseType_t count;
+    uint32_t    total_time;
+    uint8_t *   p = m_record;
+    uint32_t    len;
+
+    count = uxTaskGetSystemState(m_status, RTOS_STATS_MAX_TASKS, &total_time);
+    if (count == 0)
+    {
+        // More tasks than RTOS_STATS_MAX_TASKS
+        return false;
+    }
+
+    p = put_u8(p, RTOS_STATS_RECORD_MAGIC);
+    p = put_u8(p, RTOS_STATS_RECORD_VERSION);
+    p = put_u8(p, count);
+    p = put_u8(p, RTOS_STATS_CLOCK);
+    p = put_u32(p, total_time);
+
+    taskENTER_CRITICAL();
+    p = put_u32(p, m_tick_isr_time);
+    p = put_u32(p, m_tick_isr_count);
+    p = put_u32(p, m_context_switches);
+    taskEXIT_CRITICAL();
+
+#if RTOS_STATS_HEAP_INFO
+    p = put_u32(p, xPortGetFreeHeapSize());
+    p = put_u32(p, xPortGetMinimumEverFreeHeapSize());
+#else
+    p = put_u32(p, 0);
+    p = put_u32(p, 0);
+#endif
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t * p_task = &m_status[i];
+        uint32_t             number = p_task->xTaskNumber;
+
+        p = put_u8(p, number);
+        p = put_u8(p, p_task->eCurrentState);
+        p = put_u8(p, p_task->uxCurrentPriority);
+        p = put_u8(p, p_task->uxBasePriority);
+        memset(p, 0, RTOS_STATS_NAME_SIZE);
+        strncpy((char *)p, p_task->pcTaskName, RTOS_STATS_NAME_SIZE);
+        p += RTOS_STATS_NAME_SIZE;
+        p = put_u16(p, MIN(p_task->usStackHighWaterMark, UINT16_MAX));
+        p = put_u16(p, 0);
+        p = put_u32(p, p_task->ulRunTimeCounter);
+        p = put_u32(p, (number <= RTOS_STATS_MAX_TASKS) ? m_switches[number] : 0);
+    }
+
+    len = (uint32_t)(p - m_record);
+    p   = put_u16(p, checksum(m_record, len));
+    len += 2;
+
+    // One text line, so the record passes through the debug UART like any other message
+    strcpy(m_line, RTOS_STATS_LINE_PREFIX);
+    p = (uint8_t *)m_line + strlen(RTOS_STATS_LINE_PREFIX);
+    p += base64_encode((char *)p, m_record, len);
+    strcpy((char *)p, "\r\n");
+
+    if (init_uart(RTOS_STATS_UART_TASK_ID) != 0)
+    {
+        return false;
+    }
+    xQueueSend(xDebugUartTxQueue, m_line, portMAX_DELAY);
+    uninit_uart(RTOS_STATS_UART_TASK_ID);
+
+    return true;
+}
+
+#endif // RTOS_STATS_ENABLED
@@ -0,0 +1,112 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    rtos_stats.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Run-time statistics of the FreeRTOS tasks.
+ *
+ * When RTOS_STATS_ENABLED is set to 1 in FreeRTOSConfig.h the kernel run-time stats are clocked
+ * by RTOS_STATS_CLOCK in microseconds, and this module counts the context switches per task and
+ * the time spent in the tick interrupt. The kernel stack overflow check is enabled as well.
+ *
+ * rtos_stats_snapshot() sends the CPU time, stack high-water mark and context switches of every
+ * task, plus the tick interrupt and heap totals, as one "@RTS <base64>" line on the debug UART.
+ * tools/rtos_stats.py decodes these lines from a captured log. The record layout is described
+ * above rtos_stats_snapshot() in rtos_stats.c.
+ *
+ * Only the tick interrupt is timed: traceISR_ENTER()/traceISR_EXIT() are called by
+ * xPortSysTickHandler() of the port and by no other handler. The UARTE, SAADC, TWI and GPIOTE
+ * interrupts are not counted, the UARTE one is in the prebuilt epSDK library. The per-task CPU
+ * time includes every interrupt that ran while the task was current, the tick ISR time is
+ * reported separately so that part can be subtracted.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef RTOS_STATS_H
+#define RTOS_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RTOS_STATS_CLOCK_DWT        0   /** < Cortex-M4 DWT cycle counter, stops while the CPU sleeps */
+#define RTOS_STATS_CLOCK_TIMER      1   /** < Free running TIMER at 1 MHz, keeps counting in sleep but holds HFCLK */
+#define RTOS_STATS_CLOCK_EXTERNAL   2   /** < rtos_stats_clock_init()/rtos_stats_clock() provided by the platform */
+
+#ifndef RTOS_STATS_CLOCK
+    #define RTOS_STATS_CLOCK            RTOS_STATS_CLOCK_DWT    /** < Source of the run-time stats clock */
+#endif
+
+#ifndef RTOS_STATS_TIMER
+    #define RTOS_STATS_TIMER            NRF_TIMER3              /** < TIMER used with RTOS_STATS_CLOCK_TIMER */
+#endif
+
+#ifndef RTOS_STATS_MAX_TASKS
+    #define RTOS_STATS_MAX_TASKS        16                      /** < Tasks reported by a snapshot */
+#endif
+
+#ifndef RTOS_STATS_HEAP_INFO
+    #define RTOS_STATS_HEAP_INFO        1                       /** < 0 when the heap has no xPortGetFreeHeapSize(), e.g. heap_3 */
+#endif
+
+#ifndef RTOS_STATS_UART_TASK_ID
+    #define RTOS_STATS_UART_TASK_ID     TASK_1                  /** < uart_helper task tracker of the task calling rtos_stats_snapshot */
+#endif
+
+/**
+ * @brief Starts the run-time stats clock. Called by the kernel through
+ * portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() when the scheduler starts.
+ */
+void rtos_stats_clock_init(void);
+
+/**
+ * @brief Gets the run-time stats clock. Called by the kernel through
+ * portGET_RUN_TIME_COUNTER_VALUE().
+ *
+ * @return uint32_t Microseconds since rtos_stats_clock_init, wraps after about 71 minutes
+ */
+uint32_t rtos_stats_clock(void);
+
+/**
+ * @brief Counts a context switch. Called by the kernel through traceTASK_SWITCHED_IN().
+ *
+ * @param task_number   uxTaskGetTaskNumber() of the task switched in
+ */
+void rtos_stats_task_switched_in(uint32_t task_number);
+
+/**
+ * @brief Marks the start and the end of the tick interrupt, through traceISR_ENTER() and
+ * traceISR_EXIT() of the port.
+ */
+void rtos_stats_tick_isr_enter(void);
+void rtos_stats_tick_isr_exit(void);
+
+/**
+ * @brief Sends a snapshot of the statistics as one line on the debug UART.
+ *
+ * Must be called from a task, blocks while the debug UART TX queue is full. The debug UART is
+ * taken with the tracker of the calling task, RTOS_STATS_UART_TASK_ID, so the call must not be
+ * made between the init_uart() and uninit_uart() of that task.
+ *
+ * @return bool true for success, false if the record could not be built
+ */
+bool rtos_stats_snapshot(void);
+
+#endif
@@ -0,0 +1,177 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    twi_poll.c
+ * @version See Version in twi_poll.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Polling of sensor registers over nrf_twi_mngr, in merged burst reads.
+ *
+ * Built for use with the nRF SDK 17.1
+ *
+ */
+
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_TWI_MNGR)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "nrf_assert.h"
+
+#include "twi_poll.h"
+
+/**
+ * @brief Copies the data of the reads from the bursts to the frame. Runs in the TWI interrupt.
+ */
+static void sweep_done(ret_code_t result, void * p_user_data)
+{
+    twi_poll_t * p_poll      = (twi_poll_t *)p_user_data;
+    uint32_t     frame_bytes = 0;
+
+    for (uint32_t i = 0; i < p_poll->read_cnt; i++)
+    {
+        memcpy(&p_poll->frame[frame_bytes], &p_poll->buffer[p_poll->offsets[i]], p_poll->p_reads[i].length);
+        frame_bytes += p_poll->p_reads[i].length;
+    }
+
+    p_poll->busy = false;
+    p_poll->callback(result, p_poll->frame, p_poll->p_context);
+}
+
+ret_code_t twi_poll_init(twi_poll_t * p_poll, nrf_twi_mngr_t const * p_twi_mngr,
+                         twi_poll_read_t const * p_reads, uint8_t read_cnt, uint8_t max_gap,
+                         twi_poll_callback_t callback, void * p_context)
+{
+    uint8_t  order[TWI_POLL_MAX_READS];
+    uint32_t frame_bytes  = 0;
+    uint32_t buffer_bytes = 0;
+    int32_t  burst        = -1;
+    uint32_t burst_start  = 0;              // First byte of the burst in buffer
+    uint32_t burst_end    = 0;              // Register after the last one of the burst
+
+    ASSERT((p_poll != NULL) && (p_twi_mngr != NULL) && (callback != NULL));
+
+    if ((read_cnt == 0) || (read_cnt > TWI_POLL_MAX_READS))
+    {
+        return (read_cnt == 0) ? NRF_ERROR_INVALID_PARAM : NRF_ERROR_NO_MEM;
+    }
+
+    // Reads by device and register, insertion sort of a short list
+    for (uint32_t i = 0; i < read_cnt; i++)
+    {
+        uint32_t j = i;
+
+        if (p_reads[i].length == 0)
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+        frame_bytes += p_reads[i].length;
+
+        while ((j > 0) &&
+               ((p_reads[order[j - 1]].dev_addr > p_reads[i].dev_addr) ||
+                ((p_reads[order[j - 1]].dev_addr == p_reads[i].dev_addr) &&
+                 (p_reads[order[j - 1]].reg_addr > p_reads[i].reg_addr))))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (uint8_t)i;
+    }
+    if (frame_bytes > TWI_POLL_FRAME_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    for (uint32_t i = 0; i < read_cnt; i++)
+    {
+        twi_poll_read_t const * p_read   = &p_reads[order[i]];
+        uint32_t                read_end = (uint32_t)p_read->reg_addr + p_read->length;
+
+        if ((burst >= 0) &&
+            (p_read->dev_addr == NRF_TWI_MNGR_OP_ADDRESS(p_poll->transfers[2 * burst].operation)) &&
+            (p_read->reg_addr <= burst_end + max_gap))
+        {
+            burst_end = MAX(burst_end, read_end);
+        }
+        else
+        {
+            if (++burst == TWI_POLL_MAX_BURSTS)
+            {
+                return NRF_ERROR_NO_MEM;
+            }
+            burst_start              = buffer_bytes;
+            burst_end                = read_end;
+            p_poll->reg_addrs[burst] = p_read->reg_addr;
+            p_poll->transfers[2 * burst] = (nrf_twi_mngr_transfer_t)
+                NRF_TWI_MNGR_WRITE(p_read->dev_addr, &p_poll->reg_addrs[burst], 1, NRF_TWI_MNGR_NO_STOP);
+        }
+
+        // Reads are sorted, so the burst only grows at its end
+        buffer_bytes = burst_start + (burst_end - p_poll->reg_addrs[burst]);
+        if ((buffer_bytes > TWI_POLL_BUFFER_SIZE) || (burst_end - p_poll->reg_addrs[burst] > UINT8_MAX))
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        p_poll->offsets[order[i]] = (uint8_t)(burst_start + (p_read->reg_addr - p_poll->reg_addrs[burst]));
+        p_poll->transfers[2 * burst + 1] = (nrf_twi_mngr_transfer_t)
+            NRF_TWI_MNGR_READ(p_read->dev_addr, &p_poll->buffer[burst_start],
+                              burst_end - p_poll->reg_addrs[burst], 0);
+    }
+
+    p_poll->p_twi_mngr = p_twi_mngr;
+    p_poll->callback   = callback;
+    p_poll->p_context  = p_context;
+    p_poll->p_reads    = p_reads;
+    p_poll->read_cnt   = read_cnt;
+    p_poll->busy       = false;
+    p_poll->transaction = (nrf_twi_mngr_transaction_t) {
+        .callback            = sweep_done,
+        .p_user_data         = p_poll,
+        .p_transfers         = p_poll->transfers,
+        .number_of_transfers = (uint8_t)(2 * (burst + 1)),
+        .p_required_twi_cfg  = NULL
+    };
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t twi_poll_sweep(twi_poll_t * p_poll)
+{
+    ret_code_t err_code;
+
+    if (p_poll->busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    p_poll->busy = true;
+    err_code = nrf_twi_mngr_schedule(p_poll->p_twi_mngr, &p_poll->transaction);
+    if (err_code != NRF_SUCCESS)
+    {
+        p_poll->busy = false;
+    }
+    return err_code;
+}
+
+uint8_t twi_poll_burst_cnt(twi_poll_t const * p_poll)
+{
+    return p_poll->transaction.number_of_transfers / 2;
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_TWI_MNGR)
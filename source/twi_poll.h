@@ -0,0 +1,149 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+
+/**
+ * @file    twi_poll.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Polling of sensor registers over nrf_twi_mngr, in merged burst reads.
+ *
+ * nrf_twi_sensor_reg_read() schedules one transaction per register read, each with its own
+ * START, addresses, STOP and interrupt. A poller is given the list of register reads once, in
+ * twi_poll_init(). It sorts them by device and register and merges the reads of a device that
+ * overlap, follow each other or are at most max_gap registers apart into one burst: a register
+ * address write and a read, which nrf_twi_mngr runs as one TXRX transfer. The bursts of all the
+ * devices are chained in a single transaction.
+ *
+ * twi_poll_sweep() schedules that transaction. When it is done the callback gets a packed frame:
+ * the data of every read, in the order of the list. The registers of a gap are read and
+ * dropped, so max_gap must be 0 for devices where reading a register has side effects. The
+ * devices must increment the register address on a burst read, as most sensors do.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef TWI_POLL_H
+#define TWI_POLL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sdk_errors.h"
+#include "nrf_twi_mngr.h"
+
+#ifndef TWI_POLL_MAX_READS
+    #define TWI_POLL_MAX_READS              16                  /** < Register reads of a poller */
+#endif
+#ifndef TWI_POLL_MAX_BURSTS
+    #define TWI_POLL_MAX_BURSTS             8                   /** < Burst reads of a sweep, after merging */
+#endif
+#ifndef TWI_POLL_BUFFER_SIZE
+    #define TWI_POLL_BUFFER_SIZE            64                  /** < Bytes read by a sweep, gaps included */
+#endif
+#ifndef TWI_POLL_FRAME_SIZE
+    #define TWI_POLL_FRAME_SIZE             64                  /** < Bytes of the frame, the sum of the read lengths */
+#endif
+#ifndef TWI_POLL_MAX_GAP
+    #define TWI_POLL_MAX_GAP                3                   /** < Suggested max_gap: 3 dropped bytes cost about the bus time of a new burst */
+#endif
+
+/**
+ * @brief A register read, as given to nrf_twi_sensor_reg_read().
+ */
+typedef struct {
+    uint8_t dev_addr;   /** < 7 bit device address */
+    uint8_t reg_addr;   /** < First register */
+    uint8_t length;     /** < Bytes to read */
+} twi_poll_read_t;
+
+/**
+ * @brief Macro for a register read.
+ */
+#define TWI_POLL_READ(_dev_addr, _reg_addr, _length) \
+    {.dev_addr = (_dev_addr), .reg_addr = (_reg_addr), .length = (_length)}
+
+/**
+ * @brief Called once per sweep, from the TWI interrupt.
+ *
+ * @param result    NRF_SUCCESS, or the error of nrf_twi_mngr
+ * @param p_frame   Data of the reads, packed in the order of the list. Valid during the call.
+ * @param p_context Context given to twi_poll_init()
+ */
+typedef void (* twi_poll_callback_t)(ret_code_t result, uint8_t const * p_frame, void * p_context);
+
+/**
+ * @brief Poller. Set up with twi_poll_init().
+ */
+typedef struct {
+    nrf_twi_mngr_t const *     p_twi_mngr;
+    twi_poll_callback_t        callback;
+    void *                     p_context;
+    twi_poll_read_t const *    p_reads;
+    uint8_t                    read_cnt;
+    volatile bool              busy;                                    // A sweep is scheduled
+    uint8_t                    offsets[TWI_POLL_MAX_READS];             // Data of each read in buffer
+    uint8_t                    reg_addrs[TWI_POLL_MAX_BURSTS];          // Written by the bursts
+    nrf_twi_mngr_transfer_t    transfers[2 * TWI_POLL_MAX_BURSTS];
+    nrf_twi_mngr_transaction_t transaction;
+    uint8_t                    buffer[TWI_POLL_BUFFER_SIZE];            // Read by the bursts
+    uint8_t                    frame[TWI_POLL_FRAME_SIZE];
+} twi_poll_t;
+
+/**
+ * @brief Sets up a poller and merges its reads into bursts.
+ *
+ * @param p_poll      Poller
+ * @param p_twi_mngr  TWI transaction manager of the bus
+ * @param p_reads     Register reads, kept by the poller
+ * @param read_cnt    Number of reads, at most TWI_POLL_MAX_READS
+ * @param max_gap     Registers between two reads of a device that are read and dropped to merge
+ *                    them, 0 to merge only reads that overlap or follow each other
+ * @param callback    Called with the frame of each sweep
+ * @param p_context   Passed to the callback
+ *
+ * @retval NRF_SUCCESS             Reads merged
+ * @retval NRF_ERROR_INVALID_PARAM No reads, or a read of 0 bytes
+ * @retval NRF_ERROR_NO_MEM        More than TWI_POLL_MAX_BURSTS bursts, TWI_POLL_BUFFER_SIZE bytes
+ *                                 read or TWI_POLL_FRAME_SIZE bytes of frame
+ */
+ret_code_t twi_poll_init(twi_poll_t * p_poll, nrf_twi_mngr_t const * p_twi_mngr,
+                         twi_poll_read_t const * p_reads, uint8_t read_cnt, uint8_t max_gap,
+                         twi_poll_callback_t callback, void * p_context);
+
+/**
+ * @brief Schedules a sweep of all the reads.
+ *
+ * @param p_poll Poller
+ *
+ * @retval NRF_SUCCESS    Sweep scheduled, the callback follows
+ * @retval NRF_ERROR_BUSY The previous sweep is not done
+ * @retval -              Error of nrf_twi_mngr_schedule()
+ */
+ret_code_t twi_poll_sweep(twi_poll_t * p_poll);
+
+/**
+ * @brief Gets the number of bursts a sweep makes.
+ *
+ * @param p_poll Poller
+ *
+ * @return uint8_t Bursts, each one TWI transfer
+ */
+uint8_t twi_poll_burst_cnt(twi_poll_t const * p_poll);
+
+#endif
@@ -0,0 +1,455 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    uart_deferred_log.c
+ * @version See Version in uart_deferred_log.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Deferred (binary) debug logging for the uart_helper DBGI/DBGW/DBGE macros.
+ *
+ * Built for use with the nRF SDK 17.1
+ *
+ */
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "retarget.h"
+#include "uart_helper.h"
+#include "uart_deferred_log.h"
+
+#if DEBUG_UART_DEFERRED_LOG
+
+/* epBlinkyLibrary.a keeps one tracker per id below NUM_OF_TASKS and does not check the id */
+#if DEFERRED_LOG_UART_TASK_ID >= NUM_OF_TASKS
+#error "DEFERRED_LOG_UART_TASK_ID must be below NUM_OF_TASKS."
+#endif
+
+/* Record header. A header with len == 0 marks the unused tail of the ring, the next record starts at offset 0. */
+typedef struct {
+    uint16_t                    len;        // Length of the record in bytes, header and arguments included
+    uint16_t                    reserved;
+    uint32_t                    timestamp;  // Tick count when the record was pushed
+    deferred_log_site_t const * p_site;     // Call site, see DEFERRED_LOG
+} deferred_log_hdr_t;
+
+/* Arguments follow the header, each padded to 4 bytes. Strings are stored NUL terminated. */
+#define ARG_SIZE_MAX            MAX(sizeof(uint64_t), ALIGN_NUM(sizeof(uint32_t), DEFERRED_LOG_MAX_STR_LEN + 1))
+#define RECORD_SIZE_MAX         (sizeof(deferred_log_hdr_t) + DEFERRED_LOG_MAX_ARGS * ARG_SIZE_MAX)
+#define ARG_TYPE(p_site, n)     (((p_site)->arg_types >> (4 * ((n) + 1))) & 0xF)
+
+STATIC_ASSERT((DEFERRED_LOG_RING_SIZE % sizeof(uint32_t)) == 0, "Ring size must be a multiple of 4");
+STATIC_ASSERT(DEFERRED_LOG_RING_SIZE >= RECORD_SIZE_MAX);
+STATIC_ASSERT(DEFERRED_LOG_MAX_ARGS <= 7, "arg_types holds the types of 7 arguments");
+
+static uint32_t m_ring[DEFERRED_LOG_RING_SIZE / sizeof(uint32_t)];
+static uint32_t m_wr_idx;       // Write offset in bytes
+static uint32_t m_rd_idx;       // Read offset in bytes
+static uint32_t m_used;         // Bytes in use, unused ring tail included
+static uint32_t m_dropped;      // Records dropped because the ring was full
+
+static TaskHandle_t m_task;
+
+#if configSUPPORT_STATIC_ALLOCATION
+static StackType_t  m_task_stack[DEFERRED_LOG_TASK_STACK_SIZE];
+static StaticTask_t m_task_buffer;
+#endif
+
+/* Only used by the formatting task. A line is sent in three segments: color and type, header and
+ * message from m_line, then the color reset. EasyDMA reads RAM only, so the constant segments are
+ * not const. */
+static char     m_prefix[][16] = {ANSI_COLOR_RST "[INF]", ANSI_COLOR_BLUB "[WRN]", ANSI_COLOR_REDB "[ERR]"};
+static char     m_suffix[]     = ANSI_COLOR_RST "\r\n";
+static char     m_line[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+static uint32_t m_record[CEIL_DIV(RECORD_SIZE_MAX, sizeof(uint32_t))];
+
+static uint8_t * ring_ptr(uint32_t offset)
+{
+    return (uint8_t *)m_ring + offset;
+}
+
+/**
+ * @brief Reads the arguments of a call by type and stores them, or only sizes them.
+ *
+ * @param p_site    Call site of the arguments
+ * @param args      Arguments following the format string
+ * @param p_dst     Where to store the arguments, NULL to only get their size
+ * @param p_str_len Length of each string argument, set when sizing and used when storing, so
+ *                  that a string changed in between cannot overrun the record
+ *
+ * @return uint32_t Size of the stored arguments in bytes
+ */
+static uint32_t args_store(deferred_log_site_t const * p_site, va_list args, uint8_t * p_dst,
+                           uint16_t * p_str_len)
+{
+    uint32_t len = 0;
+
+    for (uint32_t i = 0; i < p_site->nargs; i++)
+    {
+        union {
+            uint32_t    u32;
+            uint64_t    u64;
+            double      dbl;
+            void      * ptr;
+        } val;
+        const char * p_str = NULL;
+        uint32_t     size;
+
+        switch (ARG_TYPE(p_site, i))
+        {
+            case DEFERRED_ARG_U64:
+                val.u64 = va_arg(args, uint64_t);
+                size    = sizeof(uint64_t);
+                break;
+            case DEFERRED_ARG_DOUBLE:
+                val.dbl = va_arg(args, double);
+                size    = sizeof(double);
+                break;
+            case DEFERRED_ARG_PTR:
+                val.ptr = va_arg(args, void *);
+                size    = sizeof(void *);
+                break;
+            case DEFERRED_ARG_STR:
+                p_str = va_arg(args, const char *);
+                p_str = (p_str != NULL) ? p_str : "(null)";
+                if (p_dst == NULL)
+                {
+                    p_str_len[i] = (uint16_t)strnlen(p_str, DEFERRED_LOG_MAX_STR_LEN);
+                }
+                size  = p_str_len[i];
+                break;
+            default:
+                val.u32 = va_arg(args, uint32_t);
+                size    = sizeof(uint32_t);
+                break;
+        }
+
+        if (p_dst != NULL)
+        {
+            memcpy(&p_dst[len], (p_str != NULL) ? (const void *)p_str : (const void *)&val, size);
+            if (p_str != NULL)
+            {
+                p_dst[len + size] = '\0';
+            }
+        }
+        len += ALIGN_NUM(sizeof(uint32_t), size + ((p_str != NULL) ? 1 : 0));
+    }
+
+    return len;
+}
+
+void deferred_log_push(deferred_log_site_t const * p_site, const char* format, ...)
+{
+    deferred_log_hdr_t * p_hdr;
+    uint32_t             len;
+    uint32_t             pad;
+    bool                 wake = false;
+    uint16_t             str_len[DEFERRED_LOG_MAX_ARGS];
+    va_list              args;
+    va_list              args_sized;
+
+    va_start(args, format);
+    va_start(args_sized, format);
+    taskENTER_CRITICAL();
+
+    // Sized in the same critical section as the reservation, string lengths are kept for the copy
+    len = sizeof(deferred_log_hdr_t) + args_store(p_site, args_sized, NULL, str_len);
+
+    // If the record does not fit before the end of the ring, skip the tail and start over at 0
+    pad = (DEFERRED_LOG_RING_SIZE - m_wr_idx < len) ? (DEFERRED_LOG_RING_SIZE - m_wr_idx) : 0;
+
+    if (m_used + pad + len > DEFERRED_LOG_RING_SIZE)
+    {
+        m_dropped++;
+    }
+    else
+    {
+        wake = (m_used == 0);
+
+        if (pad)
+        {
+            ((deferred_log_hdr_t *)ring_ptr(m_wr_idx))->len = 0;
+            m_used  += pad;
+            m_wr_idx = 0;
+        }
+
+        p_hdr            = (deferred_log_hdr_t *)ring_ptr(m_wr_idx);
+        p_hdr->len       = (uint16_t)len;
+        p_hdr->timestamp = xTaskGetTickCount();
+        p_hdr->p_site    = p_site;
+        (void)args_store(p_site, args, (uint8_t *)(p_hdr + 1), str_len);
+
+        m_wr_idx = (m_wr_idx + len) % DEFERRED_LOG_RING_SIZE;
+        m_used  += len;
+    }
+
+    taskEXIT_CRITICAL();
+    va_end(args_sized);
+    va_end(args);
+
+    if (wake && (m_task != NULL))
+    {
+        xTaskNotifyGive(m_task);
+    }
+}
+
+uint32_t deferred_log_dropped_get(void)
+{
+    return m_dropped;
+}
+
+/**
+ * @brief Copies the oldest record out of the ring, to m_record, and releases its space.
+ *
+ * @return bool true if a record was copied, false if the ring is empty
+ */
+static bool record_pop(void)
+{
+    deferred_log_hdr_t * p_rec;
+
+    if (m_used == 0)
+    {
+        return false;
+    }
+
+    p_rec = (deferred_log_hdr_t *)ring_ptr(m_rd_idx);
+    if (p_rec->len == 0)
+    {
+        // Unused tail of the ring, the record continues at offset 0
+        taskENTER_CRITICAL();
+        m_used  -= DEFERRED_LOG_RING_SIZE - m_rd_idx;
+        taskEXIT_CRITICAL();
+        m_rd_idx = 0;
+        p_rec    = (deferred_log_hdr_t *)ring_ptr(0);
+    }
+
+    uint16_t len = p_rec->len;
+    memcpy(m_record, p_rec, len);
+
+    m_rd_idx = (m_rd_idx + len) % DEFERRED_LOG_RING_SIZE;
+    taskENTER_CRITICAL();
+    m_used -= len;
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/**
+ * @brief Formats the message of a record. Each conversion of the format string is printed by
+ * snprintf on its own, with its stored argument.
+ *
+ * @return size_t Number of characters written to p_buf, NUL excluded
+ */
+static size_t message_format(char * p_buf, size_t size, deferred_log_site_t const * p_site, uint8_t const * p_args)
+{
+    const char* p_fmt = p_site->format;
+    char        spec[16];
+    uint32_t    arg = 0;
+    size_t      n   = 0;
+
+    while ((*p_fmt != '\0') && (n + 1 < size))
+    {
+        size_t spec_len;
+        char   conv;
+        int    ret;
+
+        if (*p_fmt != '%')
+        {
+            p_buf[n++] = *p_fmt++;
+            continue;
+        }
+
+        // Flags, width, precision and length modifier, then the conversion character
+        spec_len = strspn(p_fmt + 1, "-+ #0123456789.hlLjzt") + 2;
+        conv     = p_fmt[spec_len - 1];
+        if ((conv == '\0') || (spec_len >= sizeof(spec)) || (strchr("diouxXcfFeEgGaAsp%", conv) == NULL) ||
+            ((conv != '%') && (arg >= p_site->nargs)))
+        {
+            // Not supported ('*', %n) or malformed, printed as is
+            p_buf[n++] = *p_fmt++;
+            continue;
+        }
+        memcpy(spec, p_fmt, spec_len);
+        spec[spec_len] = '\0';
+        p_fmt += spec_len;
+
+        if (conv == '%')
+        {
+            p_buf[n++] = '%';
+            continue;
+        }
+
+        switch (ARG_TYPE(p_site, arg))
+        {
+            case DEFERRED_ARG_U64:
+            {
+                uint64_t val;
+                memcpy(&val, p_args, sizeof(val));
+                p_args += sizeof(val);
+                ret = (conv == 'p') ? snprintf(&p_buf[n], size - n, spec, (void *)(uintptr_t)val)
+                                    : snprintf(&p_buf[n], size - n, spec, val);
+                break;
+            }
+            case DEFERRED_ARG_DOUBLE:
+            {
+                double val;
+                memcpy(&val, p_args, sizeof(val));
+                p_args += sizeof(val);
+                ret = snprintf(&p_buf[n], size - n, spec, val);
+                break;
+            }
+            case DEFERRED_ARG_PTR:
+            {
+                void * val;
+                memcpy(&val, p_args, sizeof(val));
+                p_args += ALIGN_NUM(sizeof(uint32_t), sizeof(val));
+                ret = snprintf(&p_buf[n], size - n, spec, val);
+                break;
+            }
+            case DEFERRED_ARG_STR:
+            {
+                size_t len = strlen((const char *)p_args);
+                ret = snprintf(&p_buf[n], size - n, spec, (const char *)p_args);
+                p_args += ALIGN_NUM(sizeof(uint32_t), len + 1);
+                break;
+            }
+            default:
+            {
+                uint32_t val;
+                memcpy(&val, p_args, sizeof(val));
+                p_args += sizeof(val);
+                ret = (conv == 'p') ? snprintf(&p_buf[n], size - n, spec, (void *)(uintptr_t)val)
+                                    : snprintf(&p_buf[n], size - n, spec, val);
+                break;
+            }
+        }
+        arg++;
+
+        if (ret > 0)
+        {
+            n = MIN(n + (size_t)ret, size - 1);
+        }
+    }
+
+    p_buf[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Formats the record in m_record the same way tx_enqueue formats a message, and sends it.
+ */
+static void record_send(void)
+{
+    deferred_log_hdr_t const * p_hdr  = (deferred_log_hdr_t const *)m_record;
+    deferred_log_site_t const * p_site = p_hdr->p_site;
+    uint8_t  level = MIN(p_site->level, DEFERRED_LOG_ERROR);
+    size_t   n     = 0;
+
+    if (uart_helper.dbg_header_style == DEBUG_HEADER_FULL)
+    {
+        // The file name is not stored in the record, the tick count of the call is printed instead
+        n += snprintf(&m_line[n], sizeof(m_line) - n, "[%s:%u @%lu]: ",
+                      p_site->func, (unsigned)p_site->line, (unsigned long)p_hdr->timestamp);
+    }
+    else if (uart_helper.dbg_header_style == DEBUG_HEADER_COMPACT)
+    {
+        n += snprintf(&m_line[n], sizeof(m_line) - n, "[%s:%u]: ", p_site->func, (unsigned)p_site->line);
+    }
+    else
+    {
+        n += snprintf(&m_line[n], sizeof(m_line) - n, ": ");
+    }
+
+    if (n < sizeof(m_line))
+    {
+        n += message_format(&m_line[n], sizeof(m_line) - n, p_site, (uint8_t const *)(p_hdr + 1));
+    }
+
+    nrf_libuarte_async_data_t const segments[] = {
+        {(uint8_t *)m_prefix[level], strlen(m_prefix[level])},
+        {(uint8_t *)m_line, MIN(n, sizeof(m_line) - 1)},
+        {(uint8_t *)m_suffix, sizeof(m_suffix) - 1},
+    };
+    (void)retarget_writev(segments, ARRAY_SIZE(segments));
+}
+
+static void deferred_log_task(void * pvParameters)
+{
+    uint32_t dropped_reported = 0;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        init_uart(DEFERRED_LOG_UART_TASK_ID);
+
+        while (record_pop())
+        {
+            record_send();
+        }
+
+        if (m_dropped != dropped_reported)
+        {
+            int n = snprintf(m_line, sizeof(m_line), "%s[WRN] %lu deferred log records dropped%s\r\n",
+                             ANSI_COLOR_BLUB, (unsigned long)(m_dropped - dropped_reported), ANSI_COLOR_RST);
+            nrf_libuarte_async_data_t const segment = {(uint8_t *)m_line, (size_t)n};
+
+            dropped_reported = m_dropped;
+            (void)retarget_writev(&segment, 1);
+        }
+
+        uninit_uart(DEFERRED_LOG_UART_TASK_ID);
+    }
+}
+
+bool deferred_log_init(void)
+{
+#if configSUPPORT_STATIC_ALLOCATION
+    m_task = xTaskCreateStatic(deferred_log_task,
+                               "DefLog",
+                               DEFERRED_LOG_TASK_STACK_SIZE,
+                               NULL,
+                               DEFERRED_LOG_TASK_PRIORITY,
+                               m_task_stack,
+                               &m_task_buffer);
+#else
+    if (xTaskCreate(deferred_log_task,
+                    "DefLog",
+                    DEFERRED_LOG_TASK_STACK_SIZE,
+                    NULL,
+                    DEFERRED_LOG_TASK_PRIORITY,
+                    &m_task) != pdPASS)
+    {
+        return false;
+    }
+#endif
+
+    // Flush anything pushed before the task existed
+    xTaskNotifyGive(m_task);
+
+    return true;
+}
+
+#endif // DEBUG_UART_DEFERRED_LOG
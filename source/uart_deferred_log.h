@@ -0,0 +1,160 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+
+/**
+ * @file    uart_deferred_log.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Deferred (binary) debug logging for the uart_helper DBGI/DBGW/DBGE macros.
+ *
+ * When DEBUG_UART_DEFERRED_LOG is set to 1 the debug macros no longer format the message in
+ * the caller's context. Everything known at compile time about a call site (format string,
+ * __func__, __LINE__, level and the type of each argument) goes into a constant
+ * deferred_log_site_t. The format string is checked against the arguments by the compiler
+ * (-Wformat). At run time the call only stores a pointer to the site, the tick count and the
+ * arguments, copied by type, in a variable length ring. A low priority task formats the records
+ * later and sends them with retarget_writev(), as segments of one libuarte transfer.
+ *
+ * Arguments are stored as 32-bit or 64-bit integers, doubles, pointers or strings. Strings
+ * are copied, up to DEFERRED_LOG_MAX_STR_LEN characters. Other pointers are stored as
+ * integers of their size.
+ *
+ * Limitations:
+ *  - format strings must be string literals,
+ *  - '*' field widths and precisions are not supported, nor is long double,
+ *  - the macros must not be used from an interrupt.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef UART_DEFERRED_LOG_H
+#define UART_DEFERRED_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_util.h"
+
+#ifndef DEFERRED_LOG_RING_SIZE
+    #define DEFERRED_LOG_RING_SIZE          1024                /** < Size of the record ring in bytes, must be a multiple of 4 */
+#endif
+
+#ifndef DEFERRED_LOG_MAX_ARGS
+    #define DEFERRED_LOG_MAX_ARGS           6                   /** < Maximum number of arguments of a call, 7 at most */
+#endif
+
+#ifndef DEFERRED_LOG_MAX_STR_LEN
+    #define DEFERRED_LOG_MAX_STR_LEN        64                  /** < Longer string arguments are truncated */
+#endif
+
+#ifndef DEFERRED_LOG_TASK_PRIORITY
+    #define DEFERRED_LOG_TASK_PRIORITY      (tskIDLE_PRIORITY)  /** < Priority of the task formatting the records */
+#endif
+
+#ifndef DEFERRED_LOG_TASK_STACK_SIZE
+    #define DEFERRED_LOG_TASK_STACK_SIZE    256                 /** < Stack size of the formatting task, in words */
+#endif
+
+#ifndef DEFERRED_LOG_UART_TASK_ID
+    #define DEFERRED_LOG_UART_TASK_ID       TASK_4              /** < uart_helper task tracker used by the formatting task, below NUM_OF_TASKS */
+#endif
+
+/**
+ * @brief Severity of a deferred record. Selects the color and type tag used when formatting.
+ */
+typedef enum{
+    DEFERRED_LOG_INFO,      /** < Formatted like DBGI */
+    DEFERRED_LOG_WARNING,   /** < Formatted like DBGW */
+    DEFERRED_LOG_ERROR      /** < Formatted like DBGE */
+} deferred_log_level_enum;
+
+/**
+ * @brief Type of a stored argument, 4 bits per argument in deferred_log_site_t::arg_types.
+ */
+typedef enum{
+    DEFERRED_ARG_U32    = 1,    /** < Integer of up to 32 bits */
+    DEFERRED_ARG_U64    = 2,    /** < 64-bit integer, or pointer other than void * and char * on a 64-bit host */
+    DEFERRED_ARG_DOUBLE = 3,    /** < float or double */
+    DEFERRED_ARG_PTR    = 4,    /** < void * */
+    DEFERRED_ARG_STR    = 5     /** < char *, copied */
+} deferred_log_arg_type_enum;
+
+/**
+ * @brief Constant description of a call site, built at compile time by DEFERRED_LOG.
+ */
+typedef struct {
+    const char* format;         /** < printf style format string */
+    const char* func;           /** < __func__ of the call */
+    uint16_t    line;           /** < __LINE__ of the call */
+    uint8_t     level;          /** < deferred_log_level_enum */
+    uint8_t     nargs;          /** < Number of arguments following the format string */
+    uint32_t    arg_types;      /** < deferred_log_arg_type_enum of argument n at bits 4n+4, the format at bits 0-3 */
+} deferred_log_site_t;
+
+/**
+ * @brief Creates the task that formats deferred records. Records pushed before this call, or
+ * before the scheduler starts, are kept in the ring and printed once the task runs.
+ *
+ * @return bool true for success, false for failure
+ */
+bool deferred_log_init(void);
+
+/**
+ * @brief Stores a record in the ring. Use through the DBGI/DBGW/DBGE macros.
+ *
+ * @param p_site    Call site, its arg_types select how each argument is read and stored
+ * @param format    Format string of the site, only passed for the compiler's format check
+ */
+void deferred_log_push(deferred_log_site_t const * p_site, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Gets the number of records dropped because the ring was full.
+ *
+ * @return uint32_t Number of dropped records since startup
+ */
+uint32_t deferred_log_dropped_get(void);
+
+/* _Generic sees arrays as pointers and does not evaluate its argument */
+#define DEFERRED_LOG_ARG_TYPE(arg) _Generic((arg),                                                  \
+    float:          DEFERRED_ARG_DOUBLE,                                                            \
+    double:         DEFERRED_ARG_DOUBLE,                                                            \
+    char *:         DEFERRED_ARG_STR,                                                               \
+    const char *:   DEFERRED_ARG_STR,                                                               \
+    void *:         DEFERRED_ARG_PTR,                                                               \
+    const void *:   DEFERRED_ARG_PTR,                                                               \
+    default:        ((sizeof(arg) > sizeof(uint32_t)) ? DEFERRED_ARG_U64 : DEFERRED_ARG_U32))
+
+#define DEFERRED_LOG_ARG_DESC(arg, n) | (DEFERRED_LOG_ARG_TYPE(arg) << (4 * (n)))
+
+#define DEFERRED_LOG(log_level, ...)                                                                  \
+    do {                                                                                            \
+        STATIC_ASSERT(NUM_VA_ARGS_LESS_1(__VA_ARGS__) <= DEFERRED_LOG_MAX_ARGS,                     \
+                      "Too many arguments for DEFERRED_LOG_MAX_ARGS");                              \
+        static const deferred_log_site_t deferred_log_site = {                                      \
+            .format    = GET_VA_ARG_1(__VA_ARGS__),                                                 \
+            .func      = __func__,                                                                  \
+            .line      = __LINE__,                                                                  \
+            .level     = (log_level),                                                               \
+            .nargs     = NUM_VA_ARGS_LESS_1(__VA_ARGS__),                                           \
+            .arg_types = 0 MACRO_MAP_FOR(DEFERRED_LOG_ARG_DESC, __VA_ARGS__),                       \
+        };                                                                                          \
+        deferred_log_push(&deferred_log_site, __VA_ARGS__);                                         \
+    } while (0)
+
+#endif
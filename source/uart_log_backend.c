@@ -0,0 +1,215 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    uart_log_backend.c
+ * @version See Version in uart_log_backend.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief nrf_log backend on the epSDK debug UART.
+ *
+ * Built for use with the nRF SDK 17.1
+ *
+ */
+
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_LOG) && NRF_MODULE_ENABLED(NRF_LOG_BACKEND_DEBUG_UART)
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "app_util_platform.h"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_backend_serial.h"
+#include "retarget.h"
+
+#include "uart_helper.h"
+#include "uart_log_backend.h"
+
+#if !NRF_LOG_DEFERRED
+#error "uart_log_backend sends from the log task, set NRF_LOG_DEFERRED to 1."
+#endif
+
+/* epBlinkyLibrary.a keeps one tracker per id below NUM_OF_TASKS and does not check the id */
+#if UART_LOG_BACKEND_UART_TASK_ID >= NUM_OF_TASKS
+#error "UART_LOG_BACKEND_UART_TASK_ID must be below NUM_OF_TASKS."
+#endif
+
+NRF_LOG_BACKEND_DEF(m_uart_log_backend, uart_log_backend_api, NULL);
+
+static TaskHandle_t m_task;
+static bool         m_panic;
+static bool         m_uart_on;      // The log task holds the debug UART, only used by the log task
+
+#if configSUPPORT_STATIC_ALLOCATION
+static StackType_t  m_task_stack[UART_LOG_BACKEND_TASK_STACK_SIZE];
+static StaticTask_t m_task_buffer;
+#endif
+
+/* Only used by the log task. One byte is kept for the terminating NUL of the queue item. */
+static char m_line[DEBUG_UART_TX_QUEUE_ITEM_SIZE];
+
+static void serial_tx(void const * p_context, char const * p_buffer, size_t len);
+
+/* Collects log lines in m_line, so that a queue item carries several of them */
+static nrf_fprintf_ctx_t m_fprintf_ctx = {
+        .p_io_buffer     = m_line,
+        .io_buffer_size  = sizeof(m_line) - 1,
+        .io_buffer_cnt   = 0,
+        .auto_flush      = false,
+        .p_user_ctx      = NULL,
+        .fwrite          = serial_tx,
+        .flush_threshold = UART_LOG_BACKEND_FLUSH_THRESHOLD,
+};
+
+/**
+ * @brief Called by the frontend after every log call. Wakes the log task, unless called from an
+ * interrupt: interrupts above the FreeRTOS syscall priority must not use the kernel, the task
+ * polls for their logs instead.
+ */
+void log_pending_hook(void)
+{
+    if ((m_task != NULL) && (current_int_priority_get() == APP_IRQ_PRIORITY_THREAD))
+    {
+        xTaskNotifyGive(m_task);
+    }
+}
+
+static void serial_tx(void const * p_context, char const * p_buffer, size_t len)
+{
+    if (m_panic)
+    {
+        // The kernel may not be usable any more, send from the caller
+        retarget_write_polled(p_buffer, len);
+        return;
+    }
+
+    // The debug UART is only held while there is something to send
+    if (!m_uart_on)
+    {
+        init_uart(UART_LOG_BACKEND_UART_TASK_ID);
+        m_uart_on = true;
+    }
+
+    // p_buffer is m_line, filled by nrf_fprintf
+    m_line[len] = '\0';
+    xQueueSend(xDebugUartTxQueue, m_line, portMAX_DELAY);
+}
+
+static void uart_log_backend_put(nrf_log_backend_t const * p_backend,
+                                 nrf_log_entry_t * p_msg)
+{
+    nrf_log_backend_serial_ctx_put(p_backend, p_msg, &m_fprintf_ctx);
+    if (m_panic)
+    {
+        // Nothing may be left behind once the logger panicked
+        nrf_fprintf_buffer_flush(&m_fprintf_ctx);
+    }
+}
+
+static void uart_log_backend_flush(nrf_log_backend_t const * p_backend)
+{
+    // Hands the collected lines to the debug UART before returning
+    nrf_fprintf_buffer_flush(&m_fprintf_ctx);
+}
+
+static void uart_log_backend_panic_set(nrf_log_backend_t const * p_backend)
+{
+    m_panic = true;
+}
+
+const nrf_log_backend_api_t uart_log_backend_api = {
+        .put       = uart_log_backend_put,
+        .flush     = uart_log_backend_flush,
+        .panic_set = uart_log_backend_panic_set,
+};
+
+#if NRF_LOG_USES_TIMESTAMP
+static uint32_t log_timestamp_get(void)
+{
+    return xTaskGetTickCountFromISR();
+}
+#endif
+
+static void uart_log_backend_task(void * pvParameters)
+{
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(UART_LOG_BACKEND_POLL_MS));
+
+        // serial_tx() initializes the debug UART with the first line to send
+        while (NRF_LOG_PROCESS())
+        {
+        }
+        nrf_fprintf_buffer_flush(&m_fprintf_ctx);
+
+        if (m_uart_on)
+        {
+            uninit_uart(UART_LOG_BACKEND_UART_TASK_ID);
+            m_uart_on = false;
+        }
+    }
+}
+
+bool uart_log_backend_init(void)
+{
+#if NRF_LOG_USES_TIMESTAMP
+    if (nrf_log_init(log_timestamp_get, configTICK_RATE_HZ) != NRF_SUCCESS)
+#else
+    if (nrf_log_init(NULL, 0) != NRF_SUCCESS)
+#endif
+    {
+        return false;
+    }
+
+    if (nrf_log_backend_add(&m_uart_log_backend, NRF_LOG_SEVERITY_DEBUG) < 0)
+    {
+        return false;
+    }
+    nrf_log_backend_enable(&m_uart_log_backend);
+
+#if configSUPPORT_STATIC_ALLOCATION
+    m_task = xTaskCreateStatic(uart_log_backend_task,
+                               "Log",
+                               UART_LOG_BACKEND_TASK_STACK_SIZE,
+                               NULL,
+                               UART_LOG_BACKEND_TASK_PRIORITY,
+                               m_task_stack,
+                               &m_task_buffer);
+#else
+    if (xTaskCreate(uart_log_backend_task,
+                    "Log",
+                    UART_LOG_BACKEND_TASK_STACK_SIZE,
+                    NULL,
+                    UART_LOG_BACKEND_TASK_PRIORITY,
+                    &m_task) != pdPASS)
+    {
+        return false;
+    }
+#endif
+
+    // Flush anything logged before the task existed
+    xTaskNotifyGive(m_task);
+
+    return true;
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_LOG) && NRF_MODULE_ENABLED(NRF_LOG_BACKEND_DEBUG_UART)
@@ -0,0 +1,79 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+
+/**
+ * @file    uart_log_backend.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief nrf_log backend on the epSDK debug UART.
+ *
+ * With NRF_LOG_BACKEND_DEBUG_UART_ENABLED set in sdk_config.h, NRF_LOG_INFO and the other
+ * nrf_log macros only store the format string pointer and the raw arguments in the nrf_log
+ * buffer (NRF_LOG_DEFERRED). A log task formats the entries and hands them to the debug UART
+ * TX queue of uart_helper, the same queue the DBGI/DBGW/DBGE macros use.
+ *
+ * With NRF_LOG_LOCK_FREE the entries are claimed without a critical region, so interrupts of
+ * any priority can log. A log call made from an interrupt does not wake the log task, the task
+ * picks the entry up within UART_LOG_BACKEND_POLL_MS. Log calls from tasks wake it at once.
+ * When the buffer is full new logs are dropped, and the number of dropped logs is printed with
+ * the next one.
+ *
+ * The log task collects the formatted lines in one debug UART queue item until it holds
+ * UART_LOG_BACKEND_FLUSH_THRESHOLD bytes or no log is left to process.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef UART_LOG_BACKEND_H
+#define UART_LOG_BACKEND_H
+
+#include <stdbool.h>
+#include "nrf_log_backend_interface.h"
+
+#ifndef UART_LOG_BACKEND_TASK_PRIORITY
+    #define UART_LOG_BACKEND_TASK_PRIORITY      (tskIDLE_PRIORITY)  /** < Priority of the task processing the logs */
+#endif
+
+#ifndef UART_LOG_BACKEND_TASK_STACK_SIZE
+    #define UART_LOG_BACKEND_TASK_STACK_SIZE    256                 /** < Stack size of the log task, in words */
+#endif
+
+#ifndef UART_LOG_BACKEND_POLL_MS
+    #define UART_LOG_BACKEND_POLL_MS            100                 /** < Period at which logs from interrupts are processed */
+#endif
+
+#ifndef UART_LOG_BACKEND_FLUSH_THRESHOLD
+    #define UART_LOG_BACKEND_FLUSH_THRESHOLD    768                 /** < Bytes of log lines collected before they are queued for the debug UART */
+#endif
+
+#ifndef UART_LOG_BACKEND_UART_TASK_ID
+    #define UART_LOG_BACKEND_UART_TASK_ID       TASK_3              /** < uart_helper task tracker used by the log task, below NUM_OF_TASKS */
+#endif
+
+extern const nrf_log_backend_api_t uart_log_backend_api;
+
+/**
+ * @brief Initializes nrf_log, registers this backend and creates the log task. Logs stored
+ * before the scheduler starts are printed once the task runs.
+ *
+ * @return bool true for success, false for failure
+ */
+bool uart_log_backend_init(void);
+
+#endif
@@ -0,0 +1,159 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+/**
+ * @file    uart_rx_spans.c
+ * @version See Version in uart_rx_spans.h
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Zero-copy receive path for the epSDK debug UART.
+ *
+ * Built for use with the nRF SDK 17.1
+ *
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "sdk_common.h"
+#include "nrf_assert.h"
+#include "nrf_libuarte_async.h"
+
+#include "uart_rx_spans.h"
+
+/* libuarte instance of the debug UART, set by uart_helper through retarget_init() */
+extern nrf_libuarte_async_t * debug_uart;
+
+/* Spans not taken by the consumer yet. Written by the RX interrupt, read by the consumer in a
+ * critical section, which masks the interrupt. */
+static uart_rx_span_t    m_queue[UART_RX_SPANS_QUEUE_SIZE];
+static uint32_t          m_head;        // Next span to take
+static uint32_t          m_count;       // Spans queued
+
+static SemaphoreHandle_t m_data_semaphore;
+
+#if configSUPPORT_STATIC_ALLOCATION
+static StaticSemaphore_t m_data_semaphore_buffer;
+#endif
+
+/**
+ * @brief Takes the NRF_LIBUARTE_ASYNC_EVT_RX_DATA events of the debug UART, in its interrupt.
+ */
+static void rx_handler(void * context, nrf_libuarte_async_evt_t * p_evt)
+{
+    BaseType_t       woken  = pdFALSE;
+    uint8_t        * p_data = p_evt->data.rxtx.p_data;
+    size_t           length = p_evt->data.rxtx.length;
+    uart_rx_span_t * p_last = &m_queue[(m_head + m_count + UART_RX_SPANS_QUEUE_SIZE - 1) % UART_RX_SPANS_QUEUE_SIZE];
+
+    if ((m_count > 0) && (&p_last->p_data[p_last->length] == p_data))
+    {
+        // More of the span the consumer has not taken yet
+        p_last->length += length;
+    }
+    else
+    {
+        // Spans follow each other within an RX buffer, so there are no more spans than buffers,
+        // which uart_rx_spans_init() checked against the queue
+        ASSERT(m_count < UART_RX_SPANS_QUEUE_SIZE);
+        m_queue[(m_head + m_count) % UART_RX_SPANS_QUEUE_SIZE] = (uart_rx_span_t){p_data, length};
+        m_count++;
+    }
+
+    xSemaphoreGiveFromISR(m_data_semaphore, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+bool uart_rx_spans_init(void)
+{
+    if (debug_uart == NULL)
+    {
+        return false;
+    }
+
+    // rx_handler() queues at most one span per RX buffer, the queue must hold them all
+    if ((size_t)(debug_uart->p_rx_pool->p_stack_limit - debug_uart->p_rx_pool->p_stack_base) > UART_RX_SPANS_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+#if configSUPPORT_STATIC_ALLOCATION
+    m_data_semaphore = xSemaphoreCreateBinaryStatic(&m_data_semaphore_buffer);
+#else
+    m_data_semaphore = xSemaphoreCreateBinary();
+#endif
+    if (m_data_semaphore == NULL)
+    {
+        return false;
+    }
+
+    nrf_libuarte_async_rx_handler_set(debug_uart, rx_handler, NULL);
+
+    return true;
+}
+
+bool uart_rx_span_get(uart_rx_span_t * p_span, TickType_t ticks_to_wait)
+{
+    for (;;)
+    {
+        bool taken = false;
+
+        taskENTER_CRITICAL();
+        if (m_count > 0)
+        {
+            *p_span = m_queue[m_head];
+            m_head  = (m_head + 1) % UART_RX_SPANS_QUEUE_SIZE;
+            m_count--;
+            taken   = true;
+        }
+        taskEXIT_CRITICAL();
+
+        if (taken)
+        {
+            return true;
+        }
+        if (xSemaphoreTake(m_data_semaphore, ticks_to_wait) != pdTRUE)
+        {
+            return false;
+        }
+    }
+}
+
+void uart_rx_span_release(uart_rx_span_t const * p_span)
+{
+    uint8_t * p_data = p_span->p_data;
+    size_t    length = p_span->length;
+
+    // A span can cross the end of an RX buffer when the next buffer follows it in memory.
+    // libuarte frees a buffer once all of its bytes are released, so release buffer by buffer.
+    while (length > 0)
+    {
+        size_t chunk;
+
+        // The RX interrupt allocates buffers from the same pool
+        taskENTER_CRITICAL();
+        chunk = MIN(length, debug_uart->rx_buf_size - debug_uart->p_ctrl_blk->rx_free_cnt);
+        nrf_libuarte_async_rx_free(debug_uart, p_data, chunk);
+        taskEXIT_CRITICAL();
+
+        p_data += chunk;
+        length -= chunk;
+    }
+}
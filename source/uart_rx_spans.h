@@ -0,0 +1,96 @@
+/****************************************************************************
+ * Copyright (c) 2023 Embedded Planet, Inc.                                 *
+ * SPDX-License-Identifier: Apache-2.0                                      *
+ *                                                                          *
+ * Licensed under the Apache License, Version 2.0 (the "License");          *
+ * you may not use this file except in compliance with the License.         *
+ * You may obtain a copy of the License at                                  *
+ *                                                                          *
+ *     http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                          *
+ * Unless required by applicable law or agreed to in writing, software      *
+ * distributed under the License is distributed on an "AS IS" BASIS,        *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ * See the License for the specific language governing permissions and      *
+ * limitations under the License.                                           *
+ ****************************************************************************/
+
+/**
+ * @file    uart_rx_spans.h
+ * @version 0.0.1
+ * @author  Embedded Planet, Inc.
+ * @date    17 OCT 2026
+ *
+ * @brief Zero-copy receive path for the epSDK debug UART.
+ *
+ * uart_helper copies every received byte into xDebugUartRxQueue, one xQueueSendFromISR per byte.
+ * Once uart_rx_spans_init() is called, the received data of the debug UART instance is taken
+ * over with nrf_libuarte_async_rx_handler_set() and handed to one consumer task as spans: a
+ * pointer into the libuarte RX buffer and a length. The interrupt only appends the data to the
+ * last queued span when it follows it in memory, or queues a new span, and gives a semaphore.
+ * libuarte reports data when its buffer is full and when the line has been idle for its
+ * timeout, so a burst of bytes arrives as one span.
+ *
+ * The consumer takes spans with uart_rx_span_get() and gives them back with
+ * uart_rx_span_release(), in the order it got them. Until then the data stays in the RX buffer:
+ * libuarte runs out of buffers, and reports an error, when the consumer holds them for too
+ * long. xDebugUartRxQueue is no longer fed.
+ *
+ * The consumer must keep the debug UART initialized, with init_uart() for its own task id,
+ * from uart_rx_spans_init() for as long as it uses the spans.
+ *
+ * The blinky example has no consumer, so the AGORA and GALAXIS Makefiles do not build this file.
+ * Add source/uart_rx_spans.c to SRC_FILES together with the consumer task.
+ *
+ * Built for use with the nRF5 SDK 17.1 and FreeRTOS.
+ */
+
+#ifndef UART_RX_SPANS_H
+#define UART_RX_SPANS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+
+#ifndef UART_RX_SPANS_QUEUE_SIZE
+    #define UART_RX_SPANS_QUEUE_SIZE        8                   /** < Spans queued for the consumer, at least the RX buffers of the debug UART */
+#endif
+
+/**
+ * @brief Received data, in an RX buffer of the debug UART.
+ */
+typedef struct {
+    uint8_t * p_data;
+    size_t    length;
+} uart_rx_span_t;
+
+/**
+ * @brief Takes over the received data of the debug UART. Call once, from the consumer task,
+ * after init_uart().
+ *
+ * @return bool true for success, false for failure, also when the debug UART has more RX
+ *              buffers than UART_RX_SPANS_QUEUE_SIZE
+ */
+bool uart_rx_spans_init(void);
+
+/**
+ * @brief Gets the oldest received data not taken yet.
+ *
+ * @param p_span        Filled with the data
+ * @param ticks_to_wait Ticks to wait for data when none is queued
+ *
+ * @return bool true if p_span was filled, false on timeout
+ */
+bool uart_rx_span_get(uart_rx_span_t * p_span, TickType_t ticks_to_wait);
+
+/**
+ * @brief Gives the data of a span back to libuarte. Spans must be released in the order they
+ * were taken.
+ *
+ * @param p_span Span filled by uart_rx_span_get()
+ */
+void uart_rx_span_release(uart_rx_span_t const * p_span);
+
+#endif
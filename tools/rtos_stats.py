@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023 Embedded Planet, Inc.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Decodes the "@RTS" lines written by rtos_stats_snapshot() (source/rtos_stats.c).
+
+Reads a captured debug UART log from the given file, or stdin, and prints one table per
+snapshot. From the second snapshot on, the CPU share and switch counts are taken over the
+interval since the previous snapshot. The ISR time and count are those of the tick interrupt
+only, other interrupts are part of the CPU time of the task they interrupted.
+
+    python3 tools/rtos_stats.py uart.log
+"""
+
+import argparse
+import base64
+import binascii
+import struct
+import sys
+
+LINE_PREFIX = "@RTS "
+RECORD_MAGIC = ord("R")
+RECORD_VERSION = 1
+HEADER = struct.Struct("<BBBB6I")
+TASK = struct.Struct("<BBBB8sHHII")
+
+CLOCKS = {0: "DWT", 1: "TIMER", 2: "external"}
+STATES = {0: "run", 1: "ready", 2: "blocked", 3: "susp", 4: "deleted"}
+U32 = 1 << 32
+
+
+def fletcher16(data):
+    sum1 = sum2 = 0
+    for byte in data:
+        sum1 = (sum1 + byte) % 255
+        sum2 = (sum2 + sum1) % 255
+    return (sum2 << 8) | sum1
+
+
+def decode(text):
+    """Returns the snapshot of one base64 record, or raises ValueError."""
+    try:
+        record = base64.b64decode(text, validate=True)
+    except binascii.Error as err:
+        raise ValueError(f"bad base64: {err}")
+    if len(record) < HEADER.size + 2:
+        raise ValueError("record too short")
+    body, (check,) = record[:-2], struct.unpack("<H", record[-2:])
+    if fletcher16(body) != check:
+        raise ValueError("checksum mismatch")
+
+    (magic, version, count, clock, total, tick_isr_time, tick_isr_count, switches,
+     free_heap, min_heap) = HEADER.unpack_from(body)
+    if magic != RECORD_MAGIC or version != RECORD_VERSION:
+        raise ValueError(f"unknown record {magic:#x} version {version}")
+    if len(body) != HEADER.size + count * TASK.size:
+        raise ValueError("record length does not match the task count")
+
+    tasks = {}
+    for i in range(count):
+        (number, state, prio, base_prio, name, stack, _, runtime,
+         task_switches) = TASK.unpack_from(body, HEADER.size + i * TASK.size)
+        tasks[number] = {
+            "name": name.rstrip(b"\0").decode("ascii", "replace"),
+            "state": STATES.get(state, str(state)),
+            "prio": prio,
+            "base_prio": base_prio,
+            "stack": stack,
+            "runtime": runtime,
+            "switches": task_switches,
+        }
+
+    return {
+        "clock": CLOCKS.get(clock, str(clock)),
+        "total": total,
+        "tick_isr_time": tick_isr_time,
+        "tick_isr_count": tick_isr_count,
+        "switches": switches,
+        "free_heap": free_heap,
+        "min_heap": min_heap,
+        "tasks": tasks,
+    }
+
+
+def delta(now, before, key):
+    """Counters are 32 bit and wrap."""
+    return (now[key] - (before[key] if before else 0)) % U32
+
+
+def report(index, snap, prev):
+    total = delta(snap, prev, "total")
+    span = "since the previous snapshot" if prev else "since start"
+    print(f"snapshot {index}: {total / 1000:.1f} ms {span}, {snap['clock']} clock")
+    print(f"  tick isr {delta(snap, prev, 'tick_isr_time')} us in {delta(snap, prev, 'tick_isr_count')} entries, "
+          f"{delta(snap, prev, 'switches')} context switches, "
+          f"heap free {snap['free_heap']} min {snap['min_heap']}")
+    print(f"  {'#':>3} {'name':<8} {'state':<8} {'prio':>5} {'stack':>6} {'cpu us':>10} {'cpu %':>7} {'switches':>9}")
+
+    for number in sorted(snap["tasks"]):
+        task = snap["tasks"][number]
+        before = prev["tasks"].get(number) if prev else None
+        if before and before["name"] != task["name"]:
+            before = None  # Task number reused by a new task
+        runtime = delta(task, before, "runtime")
+        share = 100.0 * runtime / total if total else 0.0
+        prio = f"{task['prio']}/{task['base_prio']}" if task["prio"] != task["base_prio"] else str(task["prio"])
+        print(f"  {number:>3} {task['name']:<8} {task['state']:<8} {prio:>5} {task['stack']:>6} "
+              f"{runtime:>10} {share:>6.1f}% {delta(task, before, 'switches'):>9}")
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", type=argparse.FileType("r", errors="replace"),
+                        default=sys.stdin, help="captured debug UART log (default: stdin)")
+    args = parser.parse_args()
+
+    prev = None
+    index = 0
+    for line_num, line in enumerate(args.log, 1):
+        start = line.find(LINE_PREFIX)
+        if start < 0:
+            continue
+        try:
+            snap = decode(line[start + len(LINE_PREFIX):].strip())
+        except ValueError as err:
+            print(f"line {line_num}: {err}", file=sys.stderr)
+            prev = None
+            continue
+        report(index, snap, prev)
+        prev = snap
+        index += 1
+
+    return 0 if index else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())